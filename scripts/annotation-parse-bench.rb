@@ -0,0 +1,122 @@
+#!/usr/bin/env ruby
+
+# Generate large GFF3, GTF and BED files with a simple gene model and
+# measure how fast gt gff3, gt gtf_to_gff3 and gt bed_to_gff3 parse them.
+# The throughput in MB/s of each tool (with output to /dev/null) is printed
+# as one JSON document, which can be compared with a report of an earlier run.
+
+require 'json'
+require 'optparse'
+require 'fileutils'
+
+options = {:gt => "bin/gt", :genes => 100000, :repeats => 3,
+           :workdir => "annotation-parse-bench.dir"}
+OptionParser.new do |opts|
+  opts.banner = "Usage: #{$0} [options]"
+  opts.on("--gt PATH", "gt binary (default #{options[:gt]})") do |v|
+    options[:gt] = v
+  end
+  opts.on("--genes NUM", Integer,
+          "number of genes per file (default #{options[:genes]})") do |v|
+    options[:genes] = v
+  end
+  opts.on("--repeats NUM", Integer,
+          "number of runs per tool, the fastest is reported") do |v|
+    options[:repeats] = v
+  end
+  opts.on("--workdir DIR", "directory for the generated files") do |v|
+    options[:workdir] = v
+  end
+end.parse!
+
+def run(cmd)
+  if not system(cmd)
+    STDERR.puts "#{$0}: FAILURE: #{cmd}"
+    exit 1
+  end
+end
+
+def exons(gene)
+  start = 1000 + gene * 10000
+  [[start, start + 499], [start + 2000, start + 2999],
+   [start + 5000, start + 5799]]
+end
+
+def phases(ex)
+  done = 0
+  ex.map do |s, e|
+    phase = (3 - done % 3) % 3
+    done += e - s + 1
+    phase
+  end
+end
+
+def write_gff3(filename, genes)
+  File.open(filename, "w") do |f|
+    f.puts "##gff-version 3"
+    f.puts "##sequence-region chr1 1 #{1000 + genes * 10000}"
+    genes.times do |g|
+      ex = exons(g)
+      f.puts ["chr1", "bench", "gene", ex.first[0], ex.last[1], ".", "+", ".",
+              "ID=gene#{g};Name=G#{g}"].join("\t")
+      f.puts ["chr1", "bench", "mRNA", ex.first[0], ex.last[1], ".", "+", ".",
+              "ID=mrna#{g};Parent=gene#{g}"].join("\t")
+      ex.zip(phases(ex)).each do |(s, e), phase|
+        f.puts ["chr1", "bench", "exon", s, e, ".", "+", ".",
+                "Parent=mrna#{g}"].join("\t")
+        f.puts ["chr1", "bench", "CDS", s, e, ".", "+", phase,
+                "Parent=mrna#{g}"].join("\t")
+      end
+    end
+  end
+end
+
+def write_gtf(filename, genes)
+  File.open(filename, "w") do |f|
+    genes.times do |g|
+      ex = exons(g)
+      ex.zip(phases(ex)).each do |(s, e), phase|
+        attribs = "gene_id \"gene#{g}\"; transcript_id \"mrna#{g}\";"
+        f.puts ["chr1", "bench", "exon", s, e, ".", "+", ".",
+                attribs].join("\t")
+        f.puts ["chr1", "bench", "CDS", s, e, ".", "+", phase,
+                attribs].join("\t")
+      end
+    end
+  end
+end
+
+def write_bed(filename, genes)
+  File.open(filename, "w") do |f|
+    genes.times do |g|
+      ex = exons(g)
+      start = ex.first[0] - 1
+      f.puts ["chr1", start, ex.last[1], "gene#{g}", 0, "+", start,
+              ex.last[1], 0, ex.length,
+              ex.map {|s, e| e - s + 1}.join(","),
+              ex.map {|s, e| s - 1 - start}.join(",")].join("\t")
+    end
+  end
+end
+
+FileUtils.mkdir_p(options[:workdir])
+Inputs = [["gff3", "gff3 -o /dev/null -force", :write_gff3],
+          ["gtf", "gtf_to_gff3 -o /dev/null -force", :write_gtf],
+          ["bed", "bed_to_gff3 -o /dev/null -force", :write_bed]]
+report = {"genes" => options[:genes], "runs" => []}
+Inputs.each do |suffix, tool, writer|
+  filename = File.join(options[:workdir], "bench.#{suffix}")
+  send(writer, filename, options[:genes])
+  size = File.size(filename)
+  best = nil
+  options[:repeats].times do
+    starttime = Time.now
+    run("#{options[:gt]} #{tool} #{filename}")
+    wall = Time.now - starttime
+    best = wall if best.nil? or wall < best
+  end
+  report["runs"].push({"tool" => tool.split(" ").first,
+                       "bytes" => size, "wall" => best.round(3),
+                       "mb_per_s" => (size / best / 1e6).round(2)})
+end
+puts JSON.pretty_generate(report)
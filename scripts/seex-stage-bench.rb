@@ -0,0 +1,107 @@
+#!/usr/bin/env ruby
+
+# Run gt seed_extend with -benchmark-json on a fixed set of files from
+# testdata, for each extension method and number of threads, and print the
+# stage reports as one JSON document. With --compare, the wall times of the
+# stages are compared with a report written by an earlier run, and the script
+# fails if a stage became slower by more than the given tolerance.
+
+require 'json'
+require 'optparse'
+require 'fileutils'
+
+Inputs = [["at1MB", ["at1MB"]],
+          ["U89959", ["U89959_genomic.fas"]],
+          ["reads", ["readjoiner/paired_reads_1.fas"]]]
+Methods = [["greedy", "-extendgreedy"],
+           ["xdrop", "-extendxdrop"]]
+
+options = {:gt => "bin/gt", :testdata => "testdata", :threads => [1, 2],
+           :workdir => "seex-stage-bench.dir", :compare => nil,
+           :tolerance => 20, :minwall => 0.05}
+OptionParser.new do |opts|
+  opts.banner = "Usage: #{$0} [options]"
+  opts.on("--gt PATH", "gt binary (default #{options[:gt]})") do |v|
+    options[:gt] = v
+  end
+  opts.on("--testdata DIR", "testdata directory") do |v|
+    options[:testdata] = v
+  end
+  opts.on("--threads LIST", Array, "numbers of threads, e.g. 1,2") do |v|
+    options[:threads] = v.map {|t| t.to_i}
+  end
+  opts.on("--workdir DIR", "directory for indexes and reports") do |v|
+    options[:workdir] = v
+  end
+  opts.on("--compare FILE", "report of an earlier run") do |v|
+    options[:compare] = v
+  end
+  opts.on("--tolerance PERCENT", Float,
+          "allowed slowdown of a stage (default 20)") do |v|
+    options[:tolerance] = v
+  end
+  opts.on("--minwall SECONDS", Float,
+          "ignore stages faster than this (default 0.05)") do |v|
+    options[:minwall] = v
+  end
+end.parse!
+
+def run(cmd)
+  if not system(cmd)
+    STDERR.puts "#{$0}: FAILURE: #{cmd}"
+    exit 1
+  end
+end
+
+FileUtils.mkdir_p(options[:workdir])
+report = {"runs" => []}
+Inputs.each do |name, files|
+  indexname = File.join(options[:workdir], name)
+  if not File.exist?("#{indexname}.esq")
+    db = files.map {|f| File.join(options[:testdata], f)}.join(" ")
+    run("#{options[:gt]} encseq encode -des no -sds no -md5 no " +
+        "-indexname #{indexname} #{db}")
+  end
+  Methods.each do |method, option|
+    options[:threads].each do |threads|
+      jsonfile = File.join(options[:workdir],
+                           "#{name}-#{method}-#{threads}.json")
+      run("#{options[:gt]} -j #{threads} seed_extend -ii #{indexname} " +
+          "#{option} -kmerfile no -benchmark-json #{jsonfile} > /dev/null")
+      run_report = JSON.parse(File.read(jsonfile))
+      run_report["input"] = name
+      run_report["method"] = method
+      report["runs"].push(run_report)
+    end
+  end
+end
+puts JSON.pretty_generate(report)
+
+if not options[:compare].nil?
+  baseline = JSON.parse(File.read(options[:compare]))
+  regressions = 0
+  baseline["runs"].each do |old_run|
+    new_run = report["runs"].find do |r|
+      r["input"] == old_run["input"] and r["method"] == old_run["method"] and
+        r["threads"] == old_run["threads"]
+    end
+    next if new_run.nil?
+    old_run["stages"].each do |old_stage|
+      new_stage = new_run["stages"].find {|s| s["name"] == old_stage["name"]}
+      old_wall = old_stage["wall_seconds"]
+      new_wall = new_stage["wall_seconds"]
+      next if [old_wall, new_wall].max < options[:minwall]
+      if new_wall > old_wall * (1.0 + options[:tolerance] / 100.0)
+        STDERR.puts "#{old_run["input"]} #{old_run["method"]} " +
+                    "-j #{old_run["threads"]} #{old_stage["name"]}: " +
+                    "%.3f s -> %.3f s" % [old_wall, new_wall]
+        regressions += 1
+      end
+    end
+  end
+  if regressions > 0
+    STDERR.puts "#{$0}: #{regressions} stage(s) slower than " +
+                "#{options[:tolerance]}% tolerance"
+    exit 1
+  end
+end
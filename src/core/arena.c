@@ -0,0 +1,200 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/arena.h"
+#include "core/assert_api.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/thread_api.h"
+
+#define GT_ARENA_BLOCKSIZE  ((size_t) 1 << 16)
+#define GT_ARENA_ALIGNMENT  sizeof (GtArenaAlign)
+#define GT_ARENA_ROUNDUP(S) \
+        (((S) + GT_ARENA_ALIGNMENT - 1) & ~(GT_ARENA_ALIGNMENT - 1))
+
+typedef union {
+  void *ptr;
+  double dbl;
+  GtUint64 u64;
+} GtArenaAlign;
+
+typedef struct GtArenaBlock GtArenaBlock;
+
+struct GtArenaBlock {
+  GtArenaBlock *next;
+  size_t size;
+};
+
+#define GT_ARENA_HEADERSIZE  GT_ARENA_ROUNDUP(sizeof (GtArenaBlock))
+
+struct GtArena {
+  GtArenaBlock *blocks; /* the current block is the first one */
+  char *nextfree,
+       *last; /* the last allocation */
+  size_t spaceleft,
+         size;
+  GtMutex *mutex;
+  unsigned int reference_count;
+};
+
+GtArena* gt_arena_new(void)
+{
+  GtArena *arena = gt_malloc(sizeof *arena);
+  arena->blocks = NULL;
+  arena->nextfree = arena->last = NULL;
+  arena->spaceleft = arena->size = 0;
+  arena->mutex = gt_mutex_new();
+  arena->reference_count = 0;
+  return arena;
+}
+
+GtArena* gt_arena_ref(GtArena *arena)
+{
+  gt_assert(arena);
+  gt_mutex_lock(arena->mutex);
+  arena->reference_count++;
+  gt_mutex_unlock(arena->mutex);
+  return arena;
+}
+
+void* gt_arena_alloc(GtArena *arena, size_t size)
+{
+  gt_assert(arena);
+  size = GT_ARENA_ROUNDUP(size > 0 ? size : 1);
+  if (size > arena->spaceleft) {
+    GtArenaBlock *block;
+    if (size > GT_ARENA_BLOCKSIZE / 4) {
+      /* a large allocation gets a block of its own, behind the current one,
+         so that the space left in the current block is not wasted */
+      block = gt_malloc(GT_ARENA_HEADERSIZE + size);
+      block->size = size;
+      if (arena->blocks) {
+        block->next = arena->blocks->next;
+        arena->blocks->next = block;
+      }
+      else {
+        block->next = NULL;
+        arena->blocks = block;
+      }
+      arena->last = NULL;
+      arena->size += size;
+      return (char*) block + GT_ARENA_HEADERSIZE;
+    }
+    block = gt_malloc(GT_ARENA_HEADERSIZE + GT_ARENA_BLOCKSIZE);
+    block->size = GT_ARENA_BLOCKSIZE;
+    block->next = arena->blocks;
+    arena->blocks = block;
+    arena->nextfree = (char*) block + GT_ARENA_HEADERSIZE;
+    arena->spaceleft = GT_ARENA_BLOCKSIZE;
+  }
+  arena->last = arena->nextfree;
+  arena->nextfree += size;
+  arena->spaceleft -= size;
+  arena->size += size;
+  return arena->last;
+}
+
+void* gt_arena_grow(GtArena *arena, void *ptr, size_t oldsize, size_t newsize)
+{
+  void *newptr;
+  gt_assert(arena && newsize >= oldsize);
+  if (ptr && ptr == arena->last) {
+    size_t oldrounded = arena->nextfree - arena->last,
+           newrounded = GT_ARENA_ROUNDUP(newsize);
+    gt_assert(oldsize <= oldrounded);
+    if (newrounded <= oldrounded)
+      return ptr;
+    if (newrounded - oldrounded <= arena->spaceleft) {
+      arena->nextfree += newrounded - oldrounded;
+      arena->spaceleft -= newrounded - oldrounded;
+      arena->size += newrounded - oldrounded;
+      return ptr;
+    }
+  }
+  newptr = gt_arena_alloc(arena, newsize);
+  if (oldsize > 0)
+    memcpy(newptr, ptr, oldsize);
+  return newptr;
+}
+
+size_t gt_arena_size(const GtArena *arena)
+{
+  gt_assert(arena);
+  return arena->size;
+}
+
+void gt_arena_delete(GtArena *arena)
+{
+  GtArenaBlock *block, *next;
+  if (!arena) return;
+  gt_mutex_lock(arena->mutex);
+  if (arena->reference_count) {
+    arena->reference_count--;
+    gt_mutex_unlock(arena->mutex);
+    return;
+  }
+  gt_mutex_unlock(arena->mutex);
+  for (block = arena->blocks; block != NULL; block = next) {
+    next = block->next;
+    gt_free(block);
+  }
+  gt_mutex_delete(arena->mutex);
+  gt_free(arena);
+}
+
+int gt_arena_unit_test(GtError *err)
+{
+  GtArena *arena;
+  char *a, *b, *c, *large;
+  size_t i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  arena = gt_arena_new();
+  gt_ensure(gt_arena_size(arena) == 0);
+  a = gt_arena_alloc(arena, 3);
+  gt_ensure(((size_t) a) % GT_ARENA_ALIGNMENT == 0);
+  memcpy(a, "ab", 3);
+  /* the last allocation grows in place */
+  b = gt_arena_grow(arena, a, 3, 5 * GT_ARENA_ALIGNMENT);
+  gt_ensure(b == a);
+  gt_ensure(!strcmp(b, "ab"));
+  /* an earlier allocation is copied */
+  c = gt_arena_alloc(arena, 1);
+  gt_ensure(c != b);
+  a = gt_arena_grow(arena, b, 3, 7 * GT_ARENA_ALIGNMENT);
+  gt_ensure(a != b && !strcmp(a, "ab"));
+  gt_ensure(gt_arena_size(arena) == 13 * GT_ARENA_ALIGNMENT);
+  /* a large allocation does not replace the current block */
+  large = gt_arena_alloc(arena, GT_ARENA_BLOCKSIZE);
+  memset(large, 'x', GT_ARENA_BLOCKSIZE);
+  c = gt_arena_alloc(arena, 1);
+  gt_ensure(c == a + 7 * GT_ARENA_ALIGNMENT);
+  /* fill several blocks */
+  for (i = 0; !had_err && i < 4 * GT_ARENA_BLOCKSIZE; i += 100) {
+    a = gt_arena_alloc(arena, 100);
+    gt_ensure(((size_t) a) % GT_ARENA_ALIGNMENT == 0);
+    memset(a, 'y', 100);
+  }
+  gt_ensure(large[GT_ARENA_BLOCKSIZE - 1] == 'x');
+  /* the arena is freed with its last reference */
+  (void) gt_arena_ref(arena);
+  gt_arena_delete(arena);
+  gt_ensure(!strcmp(b, "ab"));
+  gt_arena_delete(arena);
+  return had_err;
+}
@@ -0,0 +1,45 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdlib.h>
+#include "core/error_api.h"
+
+/* A <GtArena> hands out memory from large blocks. Single allocations are never
+   freed, all blocks are freed together when the last reference to the arena
+   is deleted. Objects allocated in an arena can therefore keep it alive by
+   holding a reference. Allocating is not thread-safe, referencing and
+   deleting is. */
+typedef struct GtArena GtArena;
+
+GtArena* gt_arena_new(void);
+GtArena* gt_arena_ref(GtArena *arena);
+/* Return <size> bytes of memory from <arena>, aligned for any type. */
+void*    gt_arena_alloc(GtArena *arena, size_t size);
+/* Enlarge the allocation <ptr> of <oldsize> bytes to <newsize> bytes and
+   return the new address. If <ptr> is the last allocation of <arena> and its
+   block has enough space left, <ptr> is enlarged in place. Otherwise the
+   content is copied to a new allocation. */
+void*    gt_arena_grow(GtArena *arena, void *ptr, size_t oldsize,
+                       size_t newsize);
+/* Return the number of bytes handed out by <arena> so far. */
+size_t   gt_arena_size(const GtArena *arena);
+void     gt_arena_delete(GtArena *arena);
+int      gt_arena_unit_test(GtError *err);
+
+#endif
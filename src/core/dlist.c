@@ -16,6 +16,7 @@
 */
 
 #include <limits.h>
+#include <string.h>
 #include "core/dlist.h"
 #include "core/ensure.h"
 #include "core/ma.h"
@@ -28,8 +29,10 @@
 struct GtDlist {
   GtCompareWithData cmp_func;
   GtDlistelem *first,
-              *last;
+              *last,
+              *unused; /* removed elements of a list in an arena */
   void *data;
+  GtArena *arena;
   GtUword size;
 };
 
@@ -55,6 +58,19 @@ GtDlist* gt_dlist_new(GtCompare cmp_func)
   return dlist;
 }
 
+GtDlist* gt_dlist_new_in_arena(GtCompare cmp_func, GtArena *arena)
+{
+  GtDlist *dlist;
+  gt_assert(arena);
+  dlist = gt_arena_alloc(arena, sizeof (GtDlist));
+  memset(dlist, 0, sizeof (GtDlist));
+  if (cmp_func != NULL)
+    dlist->cmp_func = gt_dlist_cmp_wrapper;
+  dlist->data = cmp_func;
+  dlist->arena = arena;
+  return dlist;
+}
+
 GtDlist* gt_dlist_new_with_data(GtCompareWithData cmp_func, void *data)
 {
   GtDlist *dlist = gt_calloc(1, sizeof (GtDlist));
@@ -100,7 +116,17 @@ void gt_dlist_add(GtDlist *dlist, void *data)
 {
   GtDlistelem *oldelem, *newelem;
   gt_assert(dlist); /* data can be null */
-  newelem = gt_calloc(1, sizeof (GtDlistelem));
+  if (!dlist->arena)
+    newelem = gt_calloc(1, sizeof (GtDlistelem));
+  else {
+    if (dlist->unused) {
+      newelem = dlist->unused;
+      dlist->unused = newelem->next;
+    }
+    else
+      newelem = gt_arena_alloc(dlist->arena, sizeof (GtDlistelem));
+    newelem->previous = newelem->next = NULL;
+  }
   newelem->data = data;
 
   if (!dlist->first) {
@@ -170,7 +196,12 @@ void gt_dlist_remove(GtDlist *dlist, GtDlistelem *dlistelem)
   if (dlistelem == dlist->last)
     dlist->last = dlistelem->previous;
   dlist->size--;
-  gt_free(dlistelem);
+  if (dlist->arena) {
+    dlistelem->next = dlist->unused;
+    dlist->unused = dlistelem;
+  }
+  else
+    gt_free(dlistelem);
 }
 
 static int intcompare(const void *a, const void *b)
@@ -359,13 +390,32 @@ int gt_dlist_unit_test(GtError *err)
     gt_dlist_delete(dlist);
   }
 
+  /* list in an arena: removed elements are reused */
+  if (!had_err) {
+    GtArena *arena = gt_arena_new();
+    size_t arenasize;
+    dlist = gt_dlist_new_in_arena(intcompare, arena);
+    gt_dlist_add(dlist, &elem_a);
+    gt_dlist_add(dlist, &elem_b);
+    gt_ensure(gt_dlist_size(dlist) == 2);
+    gt_ensure(*(int*) gt_dlistelem_get_data(gt_dlist_first(dlist)) == elem_b);
+    gt_dlist_remove(dlist, gt_dlist_first(dlist));
+    arenasize = gt_arena_size(arena);
+    gt_dlist_add(dlist, &elem_b);
+    gt_ensure(gt_arena_size(arena) == arenasize);
+    gt_ensure(*(int*) gt_dlistelem_get_data(gt_dlist_first(dlist)) == elem_b);
+    gt_ensure(*(int*) gt_dlistelem_get_data(gt_dlist_last(dlist)) == elem_a);
+    gt_dlist_delete(dlist);
+    gt_arena_delete(arena);
+  }
+
   return had_err;
 }
 
 void gt_dlist_delete(GtDlist *dlist)
 {
   GtDlistelem *elem;
-  if (!dlist) return;
+  if (!dlist || dlist->arena) return;
   elem = dlist->first;
   while (elem) {
     gt_free(elem->previous);
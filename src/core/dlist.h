@@ -18,10 +18,16 @@
 #ifndef DLIST_H
 #define DLIST_H
 
+#include "core/arena.h"
 #include "core/error.h"
 
 #include "core/dlist_api.h"
 
+/* Like <gt_dlist_new()>, but the list and its elements are allocated in
+   <arena>, which must not be deleted before the list. Removed elements are
+   kept for reuse. */
+GtDlist*      gt_dlist_new_in_arena(GtCompare compar, GtArena *arena);
+
 int           gt_dlist_unit_test(GtError*);
 
 #endif
@@ -53,7 +53,9 @@
 #include "core/mathsupport.h"
 #include "core/md5_encoder_api.h"
 #include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/progressbar.h"
+#include "core/sequence_buffer_encseq.h"
 #include "core/sequence_buffer_fasta.h"
 #include "core/sequence_buffer_plain.h"
 #include "core/str.h"
@@ -722,15 +724,11 @@ void gt_encseq_extract_encoded_with_reader(GtEncseqReader *esr,
                                GtUword frompos,
                                GtUword topos)
 {
-  GtUword idx, pos;
-
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
   gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
                                         frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
-  }
+  gt_encseq_reader_next_encoded_chars(esr, buffer, topos - frompos + 1);
 }
 
 void gt_encseq_extract_encoded(const GtEncseq *encseq,
@@ -739,16 +737,13 @@ void gt_encseq_extract_encoded(const GtEncseq *encseq,
                                GtUword topos)
 {
   GtEncseqReader *esr;
-  GtUword idx, pos;
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
   esr = gt_encseq_create_reader_with_readmode(encseq,
                                               GT_READMODE_FORWARD,
                                               frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
-  }
+  gt_encseq_reader_next_encoded_chars(esr, buffer, topos - frompos + 1);
   gt_encseq_reader_delete(esr);
 }
 
@@ -758,15 +753,11 @@ void gt_encseq_extract_decoded_with_reader(GtEncseqReader *esr,
                                            GtUword frompos,
                                            GtUword topos)
 {
-  GtUword idx, pos;
-
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
   gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
                                         frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
-  }
+  gt_encseq_reader_next_decoded_chars(esr, buffer, topos - frompos + 1);
 }
 
 void gt_encseq_extract_decoded(const GtEncseq *encseq,
@@ -775,16 +766,13 @@ void gt_encseq_extract_decoded(const GtEncseq *encseq,
                                GtUword topos)
 {
   GtEncseqReader *esr;
-  GtUword idx, pos;
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
   esr = gt_encseq_create_reader_with_readmode(encseq,
                                               GT_READMODE_FORWARD,
                                               frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
-  }
+  gt_encseq_reader_next_decoded_chars(esr, buffer, topos - frompos + 1);
   gt_encseq_reader_delete(esr);
 }
 
@@ -2051,6 +2039,142 @@ void gt_encseq_delete(GtEncseq *encseq)
   gt_free(encseq);
 }
 
+void gt_encseq_set_access_pattern(const GtEncseq *encseq,
+                                  GtEncseqAccessPattern pattern)
+{
+  GtFaAdvice advice;
+
+  gt_assert(encseq != NULL);
+  switch (pattern) {
+    case GT_ENCSEQ_ACCESS_SEQUENTIAL:
+      advice = GT_FA_ADVICE_SEQUENTIAL;
+      break;
+    case GT_ENCSEQ_ACCESS_RANDOM:
+      advice = GT_FA_ADVICE_RANDOM;
+      break;
+    default:
+      advice = GT_FA_ADVICE_NORMAL;
+  }
+  if (encseq->mappedptr != NULL)
+    gt_fa_madvise(encseq->mappedptr, 0, 0, advice);
+  if (encseq->ssptabmappedptr != NULL)
+    gt_fa_madvise(encseq->ssptabmappedptr, 0, 0, advice);
+  if (encseq->oistabmappedptr != NULL)
+    gt_fa_madvise(encseq->oistabmappedptr, 0, 0, advice);
+  if (encseq->destab != NULL && !encseq->hasallocateddestab)
+    gt_fa_madvise(encseq->destab, 0, 0, advice);
+  if (encseq->sdstab != NULL && !encseq->hasallocatedsdstab)
+    gt_fa_madvise(encseq->sdstab, 0, 0, advice);
+}
+
+static void gt_encseq_prefetch_mapped(const void *map, const void *ptr,
+                                      size_t len)
+{
+  gt_assert((const char *) ptr >= (const char *) map);
+  gt_fa_madvise(map, (size_t) ((const char *) ptr - (const char *) map),
+                len, GT_FA_ADVICE_WILLNEED);
+}
+
+/* Return the number of the sequence containing <pos>; a separator belongs
+   to the sequence before it. */
+static GtUword gt_encseq_prefetch_seqnum(const GtEncseq *encseq, GtUword pos)
+{
+  if (pos > 0 && gt_encseq_position_is_separator(encseq, pos,
+                                                 GT_READMODE_FORWARD))
+    pos--;
+  return gt_encseq_seqnum(encseq, pos);
+}
+
+static void gt_encseq_prefetch_range(const GtEncseq *encseq,
+                                     GtUword startpos, GtUword endpos)
+{
+  if (encseq->mappedptr != NULL) {
+    switch (encseq->sat) {
+      case GT_ACCESS_TYPE_DIRECTACCESS:
+        if (!encseq->hasplainseqptr)
+          gt_encseq_prefetch_mapped(encseq->mappedptr,
+                                    encseq->plainseq + startpos,
+                                    (size_t) (endpos - startpos + 1));
+        break;
+      case GT_ACCESS_TYPE_BYTECOMPRESS:
+        /* the bitpackarray is small compared to the other tables, so the
+           advice for the whole table suffices */
+        break;
+      default:
+        gt_encseq_prefetch_mapped(encseq->mappedptr,
+                                  encseq->twobitencoding
+                                    + startpos/GT_UNITSIN2BITENC,
+                                  sizeof (GtTwobitencoding) *
+                                  (size_t) (endpos/GT_UNITSIN2BITENC -
+                                            startpos/GT_UNITSIN2BITENC + 1));
+        if (encseq->specialbits != NULL)
+          gt_encseq_prefetch_mapped(encseq->mappedptr,
+                                    encseq->specialbits
+                                      + GT_DIVWORDSIZE(startpos),
+                                    sizeof (GtBitsequence) *
+                                    (size_t) (GT_DIVWORDSIZE(endpos) -
+                                              GT_DIVWORDSIZE(startpos) + 1));
+    }
+  }
+  if (encseq->destab != NULL && !encseq->hasallocateddestab) {
+    GtUword firstseqnum, lastseqnum, descstart = 0,
+            descend = encseq->destablength;
+
+    if (encseq->numofdbsequences > 1UL) {
+      if (encseq->sdstab == NULL || !gt_encseq_has_multiseq_support(encseq))
+        return;
+      firstseqnum = gt_encseq_prefetch_seqnum(encseq, startpos);
+      lastseqnum = gt_encseq_prefetch_seqnum(encseq, endpos);
+      if (firstseqnum > 0)
+        descstart = encseq->sdstab[firstseqnum - 1] + 1;
+      if (lastseqnum < encseq->numofdbsequences - 1)
+        descend = encseq->sdstab[lastseqnum] + 1;
+    }
+    gt_encseq_prefetch_mapped(encseq->destab, encseq->destab + descstart,
+                              (size_t) (descend - descstart));
+  }
+}
+
+void gt_encseq_prefetch(const GtEncseq *encseq, const GtRange *ranges,
+                        GtUword numofranges)
+{
+  GtUword idx, startpos, endpos;
+
+  gt_assert(encseq != NULL && (ranges != NULL || numofranges == 0));
+  for (idx = 0; idx < numofranges; idx++) {
+    gt_assert(ranges[idx].start <= ranges[idx].end &&
+              ranges[idx].end < encseq->logicaltotallength);
+    startpos = ranges[idx].start;
+    endpos = ranges[idx].end;
+    if (encseq->hasmirror && endpos >= encseq->totallength) {
+      /* the positions of the virtual reverse complement are delivered from
+         the corresponding forward positions */
+      GtUword mirrorend = encseq->logicaltotallength - 1 - endpos;
+
+      if (startpos < encseq->totallength)
+        endpos = encseq->totallength - 1;
+      else
+        endpos = MIN(encseq->logicaltotallength - 1 - startpos,
+                     encseq->totallength - 1);
+      startpos = MIN(MIN(startpos, mirrorend), endpos);
+    }
+    gt_encseq_prefetch_range(encseq, startpos, endpos);
+  }
+}
+
+int gt_encseq_lock_tables(const GtEncseq *encseq, GtError *err)
+{
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(encseq != NULL);
+  if (encseq->ssptabmappedptr != NULL)
+    had_err = gt_fa_mlock(encseq->ssptabmappedptr, err);
+  if (!had_err && encseq->sdstab != NULL && !encseq->hasallocatedsdstab)
+    had_err = gt_fa_mlock(encseq->sdstab, err);
+  return had_err;
+}
+
 static GtEncseqReaderViatablesinfo *assignSWstate(GtEncseqReader *esr,
                                                   KindofSWtable kindsw)
 {
@@ -4488,7 +4612,26 @@ int gt_encseq_seppos2ssptab(const char *indexname,
 
 #define SIZEOFFUNCTAB sizeof (encodedseqfunctab)/sizeof (encodedseqfunctab[0])
 
+/* Returns a sequence buffer delivering the sequences in the files of
+   <filenametab>. If <appendto> is not <NULL>, the buffer delivers the
+   sequences of <appendto> first, whose files are the first entries of
+   <filenametab>. */
+static GtSequenceBuffer *gt_encseq_sequence_buffer_new(
+                                                 const GtStrArray *filenametab,
+                                                 const GtEncseq *appendto,
+                                                 bool plainformat,
+                                                 GtError *err)
+{
+  if (appendto != NULL)
+    return gt_sequence_buffer_encseq_new(appendto, filenametab, plainformat,
+                                         err);
+  if (plainformat)
+    return gt_sequence_buffer_plain_new(filenametab);
+  return gt_sequence_buffer_new_guess_type(filenametab, err);
+}
+
 static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
+                                       const GtEncseq *appendto,
                                        const GtFilelengthvalues *filelengthtab,
                                        bool plainformat,
                                        GtUword totallength,
@@ -4557,12 +4700,8 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
     encseq->subsymbolmap = subsymbolmap;
     encseq->maxsubalphasize = maxsubalphasize;
     gt_assert(filenametab != NULL);
-    if (plainformat) {
-      fb = gt_sequence_buffer_plain_new(filenametab);
-    }
-    else {
-      fb = gt_sequence_buffer_new_guess_type(filenametab, err);
-    }
+    fb = gt_encseq_sequence_buffer_new(filenametab, appendto, plainformat,
+                                       err);
     if (!fb)
       haserr = true;
   }
@@ -5323,6 +5462,7 @@ static void determine_original_subdist(const GtAlphabet *alpha,
 static int countnumberofexceptionranges(const GtAlphabet *alpha,
                                         bool plainformat,
                                         const GtStrArray *filenametab,
+                                        const GtEncseq *appendto,
                                         GtSpecialcharinfo *specialcharinfo,
                                         char *maxchars,
                                         GtError *err)
@@ -5330,10 +5470,8 @@ static int countnumberofexceptionranges(const GtAlphabet *alpha,
   int had_err = 0;
   GtSequenceBuffer *fb;
   GtUword currentpos;
-  if (plainformat)
-    fb = gt_sequence_buffer_plain_new(filenametab);
-  else
-    fb = gt_sequence_buffer_new_guess_type(filenametab, err);
+
+  fb = gt_encseq_sequence_buffer_new(filenametab, appendto, plainformat, err);
   if (!fb) {
     gt_assert(gt_error_is_set(err));
     had_err = -1;
@@ -5380,6 +5518,414 @@ static int countnumberofexceptionranges(const GtAlphabet *alpha,
   return had_err;
 }
 
+/* The statistics of the input files determined by
+   <gt_inputfiles2sequencekeyvalues> can be computed for each file separately
+   and then be combined, if the files are in FASTA format and each file starts
+   with a header line: then each file starts a new sequence and the separator
+   between two files is the only position at which a file influences the
+   statistics of the following file. The following functions scan at most
+   <GT_ENCSEQ_FILESPERROUND> files at a time in <gt_jobs> threads and combine
+   the results in the order of the files, such that the resulting index files
+   are identical to those of a sequential scan. The descriptions, description
+   offsets and MD5 fingerprints of a file are written to temporary files and
+   copied to the index files when the file is combined. */
+
+#define GT_ENCSEQ_FILESPERROUND 64UL
+
+typedef struct {
+  GtStrArray *filenametab;
+  GtFilelengthvalues *filelengthtab;
+  GtSpecialcharinfo specialcharinfo;
+  Definedunsignedlong equallength;
+  GtUword length,
+          numofseparators,
+          minseqlen,
+          maxseqlen,
+          lastspecialrangelength,
+          lastwildcardrangelength,
+          lengthofcurrentsequence,
+          maxdesclength,
+          *characterdistribution,
+          *originaldistribution;
+  GtDiscDistri *distspecialrangelength,
+               *distwildcardrangelength;
+  GtDescBuffer *descqueue;
+  FILE *desfp,
+       *sdsfp,
+       *md5fp;
+  bool haserr;
+} GtEncseqFilescan;
+
+typedef struct {
+  GtEncseqFilescan *filescans;
+  GtUword numoffilescans,
+          nextfilescan;
+  GtMutex *mutex;
+  const GtAlphabet *alpha;
+  bool outoistab;
+} GtEncseqFilescanThreadinfo;
+
+static void gt_encseq_filescan_init(GtEncseqFilescan *filescan,
+                                    const GtAlphabet *alpha,
+                                    bool outdestab,
+                                    bool outsdstab,
+                                    bool outmd5tab,
+                                    bool clip_desc)
+{
+  memset(filescan, 0, sizeof (*filescan));
+  filescan->equallength.defined = true;
+  filescan->equallength.valueunsignedlong = 0;
+  filescan->minseqlen = filescan->maxseqlen = GT_UNDEF_UWORD;
+  filescan->characterdistribution
+    = gt_calloc((size_t) gt_alphabet_num_of_chars(alpha),
+                sizeof (*filescan->characterdistribution));
+  filescan->originaldistribution
+    = gt_calloc((size_t) UCHAR_MAX, sizeof (*filescan->originaldistribution));
+  filescan->distspecialrangelength = gt_disc_distri_new();
+  filescan->distwildcardrangelength = gt_disc_distri_new();
+  if (outdestab) {
+    filescan->descqueue = gt_desc_buffer_new();
+    if (clip_desc)
+      gt_desc_buffer_set_clip_at_whitespace(filescan->descqueue);
+    filescan->desfp = gt_xtmpfp_generic(NULL, TMPFP_AUTOREMOVE |
+                                              TMPFP_OPENBINARY);
+    if (outsdstab)
+      filescan->sdsfp = gt_xtmpfp_generic(NULL, TMPFP_AUTOREMOVE |
+                                                TMPFP_OPENBINARY);
+  }
+  if (outmd5tab)
+    filescan->md5fp = gt_xtmpfp_generic(NULL, TMPFP_AUTOREMOVE |
+                                              TMPFP_OPENBINARY);
+}
+
+static void gt_encseq_filescan_delete(GtEncseqFilescan *filescan)
+{
+  gt_str_array_delete(filescan->filenametab);
+  gt_free(filescan->characterdistribution);
+  gt_free(filescan->originaldistribution);
+  gt_disc_distri_delete(filescan->distspecialrangelength);
+  gt_disc_distri_delete(filescan->distwildcardrangelength);
+  gt_desc_buffer_delete(filescan->descqueue);
+  gt_fa_xfclose(filescan->desfp);
+  gt_fa_xfclose(filescan->sdsfp);
+  gt_fa_xfclose(filescan->md5fp);
+}
+
+/* Scan the single file of <filescan>. Scanning fails if the file does not
+   start with a FASTA header, if it does not contain a regular character, if
+   its last sequence is empty or if the sequential scan would report an error.
+   In these cases the files are scanned sequentially. */
+static void gt_encseq_scanfile(GtEncseqFilescan *filescan,
+                               const GtAlphabet *alpha,
+                               bool outoistab)
+{
+  GtSequenceBuffer *fb = NULL;
+  GtFile *file;
+  GtUchar charcode;
+  int retval;
+  GtUword currentpos = 0,
+          lastspecialrangelength = 0,
+          lastwildcardrangelength = 0,
+          lastnonspecialrangelength = 0,
+          lengthofcurrentsequence = 0,
+          md5_blockcount = 0,
+          *originaldistribution = filescan->originaldistribution,
+          *numofseparators = &filescan->numofseparators,
+          *minseqlen = &filescan->minseqlen,
+          *maxseqlen = &filescan->maxseqlen;
+  bool specialprefix = true, wildcardprefix = true, haserr = false;
+  const bool plainformat = false;
+  const GtStrArray *filenametab = filescan->filenametab;
+  const GtAlphabet *a = alpha;
+  GtSpecialcharinfo *specialcharinfo = &filescan->specialcharinfo;
+  Definedunsignedlong *equallength = &filescan->equallength;
+  GtDiscDistri *distspecialrangelength = filescan->distspecialrangelength,
+               *distwildcardrangelength = filescan->distwildcardrangelength;
+  GtDescBuffer *descqueue = filescan->descqueue;
+  GtMD5Encoder *md5enc = NULL;
+  GtError *err = gt_error_new();
+  char cc = '\0',
+       *desc,
+       md5_blockbuf[64],
+       md5_outbuf[33];
+  unsigned char md5_output[16];
+  FILE *desfp = filescan->desfp, *sdsfp = filescan->sdsfp,
+       *md5fp = filescan->md5fp;
+
+  file = gt_file_open(gt_file_mode_determine(gt_str_array_get(filenametab, 0)),
+                      gt_str_array_get(filenametab, 0), "rb", err);
+  if (file == NULL || gt_file_xread(file, &cc, (size_t) 1) != 1 || cc != '>')
+    haserr = true;
+  gt_file_delete(file);
+  if (!haserr) {
+    fb = gt_sequence_buffer_fasta_new(filenametab);
+    gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alpha));
+    gt_sequence_buffer_set_filelengthtab(fb, filescan->filelengthtab);
+    if (descqueue != NULL)
+      gt_sequence_buffer_set_desc_buffer(fb, descqueue);
+    gt_sequence_buffer_set_chardisttab(fb, filescan->characterdistribution);
+    if (md5fp != NULL)
+      md5enc = gt_md5_encoder_new();
+  }
+  for (currentpos = 0; !haserr; currentpos++) {
+    retval = gt_sequence_buffer_next_with_original(fb, &charcode, &cc, err);
+    if (retval > 0) {
+#define WITHEQUALLENGTH_DES_SSP
+#define WITHOISTAB
+#define WITHCOUNTMINMAX
+#define WITHORIGDIST
+#define WITHMD5FP
+#include "encseq_charproc.gen"
+    }
+    else {
+      if (retval < 0 || lengthofcurrentsequence == 0 || specialprefix) {
+        haserr = true;
+        break;
+      }
+      if (*maxseqlen == GT_UNDEF_UWORD
+            || lengthofcurrentsequence > *maxseqlen) {
+        *maxseqlen = lengthofcurrentsequence;
+      }
+      if (*minseqlen == GT_UNDEF_UWORD
+           || lengthofcurrentsequence < *minseqlen) {
+        *minseqlen = lengthofcurrentsequence;
+      }
+      if (lastnonspecialrangelength
+            > specialcharinfo->lengthoflongestnonspecial) {
+        specialcharinfo->lengthoflongestnonspecial = lastnonspecialrangelength;
+      }
+      if (md5enc != NULL) {
+        gt_md5_encoder_add_block(md5enc, md5_blockbuf, md5_blockcount);
+        gt_md5_encoder_finish(md5enc, md5_output, md5_outbuf);
+        gt_xfwrite(md5_outbuf, sizeof (char), (size_t) 33, md5fp);
+      }
+      if (equallength->defined) {
+        if (equallength->valueunsignedlong > 0) {
+          if (lengthofcurrentsequence != equallength->valueunsignedlong) {
+            equallength->defined = false;
+          }
+        }
+        else {
+          equallength->valueunsignedlong = lengthofcurrentsequence;
+        }
+      }
+      break;
+    }
+  }
+  filescan->length = currentpos;
+  filescan->lastspecialrangelength = lastspecialrangelength;
+  filescan->lastwildcardrangelength = lastwildcardrangelength;
+  filescan->lengthofcurrentsequence = lengthofcurrentsequence;
+  if (descqueue != NULL)
+    filescan->maxdesclength = gt_desc_buffer_max_length(descqueue);
+  filescan->haserr = haserr;
+  gt_md5_encoder_delete(md5enc);
+  gt_sequence_buffer_delete(fb);
+  gt_error_delete(err);
+}
+
+static void *gt_encseq_scanfile_thread(void *data)
+{
+  GtEncseqFilescanThreadinfo *threadinfo = (GtEncseqFilescanThreadinfo *) data;
+
+  while (true) {
+    GtUword idx;
+
+    gt_mutex_lock(threadinfo->mutex);
+    idx = threadinfo->nextfilescan;
+    if (idx < threadinfo->numoffilescans)
+      threadinfo->nextfilescan++;
+    gt_mutex_unlock(threadinfo->mutex);
+    if (idx >= threadinfo->numoffilescans)
+      break;
+    gt_encseq_scanfile(threadinfo->filescans + idx, threadinfo->alpha,
+                       threadinfo->outoistab);
+  }
+  return NULL;
+}
+
+typedef struct {
+  GtDiscDistri *dist;
+  GtUword skipkey;
+} GtEncseqDistriAddinfo;
+
+static void gt_encseq_distri_add(GtUword key, GtUint64 value, void *data)
+{
+  GtEncseqDistriAddinfo *addinfo = (GtEncseqDistriAddinfo *) data;
+
+  if (key == addinfo->skipkey)
+    value--;
+  if (value > 0)
+    gt_disc_distri_add_multi(addinfo->dist, key, value);
+}
+
+static void gt_encseq_copy_tmpfile(FILE *outfp, FILE *tmpfp)
+{
+  char buf[BUFSIZ];
+  size_t len;
+
+  gt_xfseek(tmpfp, 0, SEEK_SET);
+  while ((len = gt_xfread(buf, sizeof (char), sizeof (buf), tmpfp)) > 0)
+    gt_xfwrite(buf, sizeof (char), len, outfp);
+}
+
+/* Add the statistics of the scan of the next file <filescan> to <total>. */
+static void gt_encseq_filescan_add(GtEncseqFilescan *total,
+                                   GtEncseqFilescan *filescan,
+                                   bool firstfile,
+                                   unsigned int numofchars)
+{
+  GtEncseqDistriAddinfo addinfo;
+  GtUword idx;
+
+  addinfo.skipkey = 0;
+  if (firstfile) {
+    total->specialcharinfo.lengthofspecialprefix
+      = filescan->specialcharinfo.lengthofspecialprefix;
+    total->specialcharinfo.lengthofwildcardprefix
+      = filescan->specialcharinfo.lengthofwildcardprefix;
+  }
+  else {
+    /* the separator between the files joins the last special range of the
+       previous file and the first special range of this file */
+    total->length++;
+    total->numofseparators++;
+    total->specialcharinfo.specialcharacters++;
+    gt_disc_distri_add(total->distspecialrangelength,
+                       total->lastspecialrangelength + 1 +
+                       filescan->specialcharinfo.lengthofspecialprefix);
+    addinfo.skipkey = filescan->specialcharinfo.lengthofspecialprefix;
+    if (total->lastwildcardrangelength > 0)
+      gt_disc_distri_add(total->distwildcardrangelength,
+                         total->lastwildcardrangelength);
+    if (total->desfp != NULL) {
+      const char *desc = gt_desc_buffer_get_next(total->descqueue);
+      gt_xfputs(desc, total->desfp);
+      if (total->sdsfp != NULL) {
+        GtUword desoffset = (GtUword) ftello(total->desfp);
+        gt_xfwrite(&desoffset, sizeof desoffset, (size_t) 1, total->sdsfp);
+      }
+      gt_xfputc((int) '\n', total->desfp);
+    }
+  }
+  addinfo.dist = total->distspecialrangelength;
+  gt_disc_distri_foreach(filescan->distspecialrangelength,
+                         gt_encseq_distri_add, &addinfo);
+  addinfo.dist = total->distwildcardrangelength;
+  addinfo.skipkey = 0;
+  gt_disc_distri_foreach(filescan->distwildcardrangelength,
+                         gt_encseq_distri_add, &addinfo);
+  if (total->desfp != NULL) {
+    GtUword desbase = (GtUword) ftello(total->desfp), desoffset;
+
+    gt_encseq_copy_tmpfile(total->desfp, filescan->desfp);
+    if (total->sdsfp != NULL) {
+      gt_xfseek(filescan->sdsfp, 0, SEEK_SET);
+      while (gt_xfread_one(&desoffset, filescan->sdsfp) == (size_t) 1) {
+        desoffset += desbase;
+        gt_xfwrite_one(&desoffset, total->sdsfp);
+      }
+    }
+    gt_desc_buffer_delete(total->descqueue);
+    total->descqueue = filescan->descqueue;
+    filescan->descqueue = NULL;
+    total->maxdesclength = MAX(total->maxdesclength, filescan->maxdesclength);
+  }
+  if (total->md5fp != NULL)
+    gt_encseq_copy_tmpfile(total->md5fp, filescan->md5fp);
+  for (idx = 0; idx < (GtUword) numofchars; idx++)
+    total->characterdistribution[idx] += filescan->characterdistribution[idx];
+  for (idx = 0; idx < (GtUword) UCHAR_MAX; idx++)
+    total->originaldistribution[idx] += filescan->originaldistribution[idx];
+  total->length += filescan->length;
+  total->numofseparators += filescan->numofseparators;
+  total->specialcharinfo.specialcharacters
+    += filescan->specialcharinfo.specialcharacters;
+  total->specialcharinfo.wildcards += filescan->specialcharinfo.wildcards;
+  if (filescan->specialcharinfo.lengthoflongestnonspecial
+        > total->specialcharinfo.lengthoflongestnonspecial) {
+    total->specialcharinfo.lengthoflongestnonspecial
+      = filescan->specialcharinfo.lengthoflongestnonspecial;
+  }
+  if (total->maxseqlen == GT_UNDEF_UWORD
+        || filescan->maxseqlen > total->maxseqlen) {
+    total->maxseqlen = filescan->maxseqlen;
+  }
+  if (total->minseqlen == GT_UNDEF_UWORD
+        || filescan->minseqlen < total->minseqlen) {
+    total->minseqlen = filescan->minseqlen;
+  }
+  if (total->equallength.defined) {
+    if (!filescan->equallength.defined
+          || (!firstfile && filescan->equallength.valueunsignedlong
+                              != total->equallength.valueunsignedlong)) {
+      total->equallength.defined = false;
+    }
+    else {
+      total->equallength.valueunsignedlong
+        = filescan->equallength.valueunsignedlong;
+    }
+  }
+  total->lastspecialrangelength = filescan->lastspecialrangelength;
+  total->lastwildcardrangelength = filescan->lastwildcardrangelength;
+  total->lengthofcurrentsequence = filescan->lengthofcurrentsequence;
+}
+
+/* Scan the files in <filenametab> in parallel and add the statistics to
+   <total>, whose output files are written. Returns 0 on success, 1 if the
+   files must be scanned sequentially, and -1 if an error occurred. */
+static int gt_encseq_scanfiles(GtEncseqFilescan *total,
+                               const GtStrArray *filenametab,
+                               const GtAlphabet *alpha,
+                               bool outoistab,
+                               bool clip_desc,
+                               GtError *err)
+{
+  GtEncseqFilescanThreadinfo threadinfo;
+  GtUword numoffiles = gt_str_array_size(filenametab), firstfile, idx;
+  int retval = 0;
+
+  gt_error_check(err);
+  threadinfo.filescans = gt_malloc(sizeof (*threadinfo.filescans) *
+                                   MIN(numoffiles, GT_ENCSEQ_FILESPERROUND));
+  threadinfo.mutex = gt_mutex_new();
+  threadinfo.alpha = alpha;
+  threadinfo.outoistab = outoistab;
+  for (firstfile = 0; retval == 0 && firstfile < numoffiles;
+       firstfile += GT_ENCSEQ_FILESPERROUND) {
+    threadinfo.numoffilescans = MIN(numoffiles - firstfile,
+                                    GT_ENCSEQ_FILESPERROUND);
+    threadinfo.nextfilescan = 0;
+    for (idx = 0; idx < threadinfo.numoffilescans; idx++) {
+      GtEncseqFilescan *filescan = threadinfo.filescans + idx;
+
+      gt_encseq_filescan_init(filescan, alpha, total->desfp != NULL,
+                              total->sdsfp != NULL, total->md5fp != NULL,
+                              clip_desc);
+      filescan->filenametab = gt_str_array_new();
+      gt_str_array_add_cstr(filescan->filenametab,
+                            gt_str_array_get(filenametab, firstfile + idx));
+      filescan->filelengthtab = total->filelengthtab + firstfile + idx;
+    }
+    if (gt_multithread(gt_encseq_scanfile_thread, &threadinfo, err) != 0)
+      retval = -1;
+    for (idx = 0; retval == 0 && idx < threadinfo.numoffilescans; idx++) {
+      if (threadinfo.filescans[idx].haserr)
+        retval = 1;
+    }
+    for (idx = 0; retval == 0 && idx < threadinfo.numoffilescans; idx++) {
+      gt_encseq_filescan_add(total, threadinfo.filescans + idx,
+                             firstfile + idx == 0 ? true : false,
+                             gt_alphabet_num_of_chars(alpha));
+    }
+    for (idx = 0; idx < threadinfo.numoffilescans; idx++)
+      gt_encseq_filescan_delete(threadinfo.filescans + idx);
+  }
+  gt_mutex_delete(threadinfo.mutex);
+  gt_free(threadinfo.filescans);
+  return retval;
+}
+
 static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                            GtUword *totallength,
                                            GtSpecialcharinfo *specialcharinfo,
@@ -5388,6 +5934,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                            GtUword *specialrangestab,
                                            GtUword *wildcardrangestab,
                                            const GtStrArray *filenametab,
+                                           const GtEncseq *appendto,
                                            GtFilelengthvalues **filelengthtab,
                                            const GtAlphabet *alpha,
                                            bool customalphabet,
@@ -5420,8 +5967,10 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                 lengthofcurrentsequence = 0,
                 lengthofalphadef,
                 *originaldistribution = NULL,
-                md5_blockcount = 0;
-  bool specialprefix = true, wildcardprefix = true, haserr = false;
+                md5_blockcount = 0,
+                maxdesclength = 0;
+  bool specialprefix = true, wildcardprefix = true, haserr = false,
+       scanned = false;
   GtDiscDistri *distspecialrangelength = NULL, *distwildcardrangelength = NULL;
   GtDescBuffer *descqueue = NULL;
   GtMD5Encoder *md5enc = NULL;
@@ -5441,13 +5990,9 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
   specialcharinfo->lengthofwildcardprefix = 0;
   specialcharinfo->lengthofwildcardsuffix = 0;
 
-  if (plainformat) {
-    fb = gt_sequence_buffer_plain_new(filenametab);
+  if (plainformat)
     equallength->defined = false;
-  }
-  else {
-    fb = gt_sequence_buffer_new_guess_type(filenametab, err);
-  }
+  fb = gt_encseq_sequence_buffer_new(filenametab, appendto, plainformat, err);
   if (!fb)
     haserr = true;
   if (!haserr && outdestab) {
@@ -5484,7 +6029,93 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                      sizeof (GtUword));
     if (md5fp != NULL)
       md5enc = gt_md5_encoder_new();
-    for (currentpos = 0; !haserr; currentpos++) {
+#if defined (_LP64) || defined (_WIN64)
+    if (gt_jobs > 1U && !plainformat && appendto == NULL &&
+        gt_str_array_size(filenametab) > 1UL) {
+      GtEncseqFilescan total;
+
+      gt_encseq_filescan_init(&total, alpha, false, false, false, false);
+      total.filelengthtab = *filelengthtab;
+      total.desfp = desfp;
+      total.sdsfp = sdsfp;
+      total.md5fp = md5fp;
+      retval = gt_encseq_scanfiles(&total, filenametab, alpha, outoistab,
+                                   clip_desc, err);
+      if (retval < 0)
+        haserr = true;
+      else if (retval == 0) {
+        gt_log_log("scanned "GT_WU" input files in parallel",
+                   gt_str_array_size(filenametab));
+        scanned = true;
+        memcpy(characterdistribution, total.characterdistribution,
+               sizeof (*characterdistribution) *
+               gt_alphabet_num_of_chars(alpha));
+        memcpy(originaldistribution, total.originaldistribution,
+               sizeof (*originaldistribution) * UCHAR_MAX);
+        gt_disc_distri_delete(distspecialrangelength);
+        distspecialrangelength = total.distspecialrangelength;
+        total.distspecialrangelength = NULL;
+        gt_disc_distri_delete(distwildcardrangelength);
+        distwildcardrangelength = total.distwildcardrangelength;
+        total.distwildcardrangelength = NULL;
+        if (descqueue != NULL) {
+          gt_desc_buffer_delete(descqueue);
+          descqueue = total.descqueue;
+          total.descqueue = NULL;
+          maxdesclength = total.maxdesclength;
+        }
+        specialcharinfo->specialcharacters
+          = total.specialcharinfo.specialcharacters;
+        specialcharinfo->wildcards = total.specialcharinfo.wildcards;
+        specialcharinfo->lengthofspecialprefix
+          = total.specialcharinfo.lengthofspecialprefix;
+        specialcharinfo->lengthofwildcardprefix
+          = total.specialcharinfo.lengthofwildcardprefix;
+        specialcharinfo->lengthoflongestnonspecial
+          = total.specialcharinfo.lengthoflongestnonspecial;
+        *equallength = total.equallength;
+        *numofseparators = total.numofseparators;
+        *minseqlen = total.minseqlen;
+        *maxseqlen = total.maxseqlen;
+        currentpos = total.length;
+        lastspecialrangelength = total.lastspecialrangelength;
+        lastwildcardrangelength = total.lastwildcardrangelength;
+        lengthofcurrentsequence = total.lengthofcurrentsequence;
+        if (lastspecialrangelength > 0) {
+          gt_disc_distri_add(distspecialrangelength, lastspecialrangelength);
+        }
+        if (lastwildcardrangelength > 0) {
+          gt_disc_distri_add(distwildcardrangelength,
+                             lastwildcardrangelength);
+        }
+      }
+      else {
+        gt_log_log("scan input files sequentially");
+        /* start again with empty output files */
+        if (desfp != NULL) {
+          gt_fa_xfclose(desfp);
+          desfp = gt_fa_fopen_with_suffix(indexname, GT_DESTABFILESUFFIX,
+                                          "wb", err);
+        }
+        if (sdsfp != NULL) {
+          gt_fa_xfclose(sdsfp);
+          sdsfp = gt_fa_fopen_with_suffix(indexname, GT_SDSTABFILESUFFIX,
+                                          "wb", err);
+        }
+        if (md5fp != NULL) {
+          gt_fa_xfclose(md5fp);
+          md5fp = gt_fa_fopen_with_suffix(indexname, GT_MD5TABFILESUFFIX,
+                                          "wb", err);
+        }
+        if ((outdestab && desfp == NULL) || (outsdstab && sdsfp == NULL)
+            || (outmd5tab && md5fp == NULL))
+          haserr = true;
+      }
+      total.desfp = total.sdsfp = total.md5fp = NULL;
+      gt_encseq_filescan_delete(&total);
+    }
+#endif
+    for (/* Nothing */; !haserr && !scanned; currentpos++) {
 #if !(defined (_LP64) || defined (_WIN64))
 #define MAXSFXLENFOR32BIT 4294000000UL
       if (currentpos > MAXSFXLENFOR32BIT) {
@@ -5566,6 +6197,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                classstartpositions, originaldistribution);
     if (outoistab) {
       retval = countnumberofexceptionranges(alpha, plainformat, filenametab,
+                                            appendto,
                                             specialcharinfo, maxchars, err);
       if (retval != 0)
         haserr = true;
@@ -5576,7 +6208,8 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
       GtUword longestdesc,
                     fin = ~0UL;
       desc = (char*) gt_desc_buffer_get_next(descqueue);
-      longestdesc = gt_desc_buffer_max_length(descqueue) - 1;
+      longestdesc = MAX(gt_desc_buffer_max_length(descqueue),
+                        maxdesclength) - 1;
       gt_xfputs(desc, desfp);
       gt_xfputc((int) '\n', desfp);
       gt_xfwrite_one(&longestdesc, desfp);
@@ -6119,6 +6752,204 @@ GtUword gt_getnexttwobitencodingstoppos(GT_UNUSED bool fwd,
   return rawstoppos;
 }
 
+/* The following table maps each byte of a two bit encoding to the four
+   characters it encodes, the first character being stored in the two most
+   significant bits of the byte. */
+
+#define GT_BYTEDECODE4(A, B, C)\
+        {A, B, C, 0}, {A, B, C, 1}, {A, B, C, 2}, {A, B, C, 3}
+#define GT_BYTEDECODE3(A, B)\
+        GT_BYTEDECODE4(A, B, 0), GT_BYTEDECODE4(A, B, 1),\
+        GT_BYTEDECODE4(A, B, 2), GT_BYTEDECODE4(A, B, 3)
+#define GT_BYTEDECODE2(A)\
+        GT_BYTEDECODE3(A, 0), GT_BYTEDECODE3(A, 1),\
+        GT_BYTEDECODE3(A, 2), GT_BYTEDECODE3(A, 3)
+
+static const GtUchar gt_encseq_bytedecode[256][4] = {
+  GT_BYTEDECODE2(0), GT_BYTEDECODE2(1), GT_BYTEDECODE2(2), GT_BYTEDECODE2(3)
+};
+
+#undef GT_BYTEDECODE4
+#undef GT_BYTEDECODE3
+#undef GT_BYTEDECODE2
+
+/* Decode the <len> characters of <twobitencoding> beginning at position
+   <pos> into <buffer>. Complete units are decoded byte by byte using the
+   table above, which avoids the shift and mask per character. */
+static void gt_encseq_twobitencoding_decode(GtUchar *buffer,
+                                        const GtTwobitencoding *twobitencoding,
+                                        GtUword pos,
+                                        GtUword len)
+{
+  const GtUword endpos = pos + len;
+  const GtTwobitencoding *unitptr, *endunitptr;
+
+  while (pos < endpos && GT_MODBYUNITSIN2BITENC(pos) != 0) {
+    *buffer++ = (GtUchar) EXTRACTENCODEDCHAR(twobitencoding, pos);
+    pos++;
+  }
+  unitptr = twobitencoding + GT_DIVBYUNITSIN2BITENC(pos);
+  endunitptr = twobitencoding + GT_DIVBYUNITSIN2BITENC(endpos);
+  for (/* Nothing */; unitptr < endunitptr; unitptr++) {
+    GtTwobitencoding unit = *unitptr;
+    int shift;
+
+    for (shift = GT_INTWORDSIZE - CHAR_BIT; shift >= 0; shift -= CHAR_BIT) {
+      memcpy(buffer, gt_encseq_bytedecode[(unit >> shift) & 0xFF],
+             sizeof (gt_encseq_bytedecode[0]));
+      buffer += sizeof (gt_encseq_bytedecode[0]);
+    }
+    pos += GT_UNITSIN2BITENC;
+  }
+  while (pos < endpos) {
+    *buffer++ = (GtUchar) EXTRACTENCODEDCHAR(twobitencoding, pos);
+    pos++;
+  }
+}
+
+/* Replace the characters in <buffer> decoded from the two bit encoding
+   beginning at position <pos> by the special characters marked in the
+   special bits of <encseq>, as done by
+   <seqdelivercharViabitaccessSpecial>. */
+static void gt_encseq_patchspecialsViabitaccess(const GtEncseq *encseq,
+                                                GtUchar *buffer,
+                                                GtUword pos,
+                                                GtUword len)
+{
+  const GtUword endpos = pos + len;
+
+  while (pos < endpos) {
+    if (encseq->specialbits[GT_DIVWORDSIZE(pos)] == 0) {
+      /* no special character in the rest of the word */
+      GtUword nextword = GT_DIVWORDSIZE(pos) * GT_INTWORDSIZE + GT_INTWORDSIZE;
+
+      buffer += MIN(nextword, endpos) - pos;
+      pos = nextword;
+    } else {
+      if (*buffer <= (GtUchar) 1 && GT_ISIBITSET(encseq->specialbits, pos)) {
+        *buffer = (*buffer == (GtUchar) GT_TWOBITS_FOR_SEPARATOR)
+                    ? (GtUchar) SEPARATOR
+                    : (GtUchar) WILDCARD;
+      }
+      buffer++;
+      pos++;
+    }
+  }
+}
+
+void gt_encseq_reader_next_encoded_chars(GtEncseqReader *esr,
+                                         GtUchar *buffer,
+                                         GtUword len)
+{
+  const GtEncseq *encseq;
+  GtUword idx = 0;
+
+  gt_assert(esr != NULL && esr->encseq != NULL);
+  encseq = esr->encseq;
+  if (encseq->twobitencoding != NULL &&
+      (esr->readmode == GT_READMODE_FORWARD ||
+       esr->readmode == GT_READMODE_COMPL) &&
+      (gt_encseq_has_twobitencoding_stoppos_support(encseq) ||
+       !gt_encseq_has_specialranges(encseq))) {
+    /* the regular characters up to the next special position are decoded
+       from the two bit encoding at once, a range of wildcards is filled at
+       once, and all other special characters are delivered one by one, so
+       that the state of <esr> is maintained as if all characters were read
+       by <gt_encseq_reader_next_encoded_char> */
+    while (idx < len && esr->currentpos < encseq->totallength) {
+      GtUword stoppos = fwdgetnexttwobitencodingstoppos(esr), width;
+
+      if (stoppos > esr->currentpos) {
+        width = MIN(stoppos - esr->currentpos, len - idx);
+        gt_encseq_twobitencoding_decode(buffer + idx, encseq->twobitencoding,
+                                        esr->currentpos, width);
+        if (esr->readmode == GT_READMODE_COMPL) {
+          GtUword end;
+
+          for (end = idx + width; idx < end; idx++) {
+            buffer[idx] = GT_COMPLEMENTBASE(buffer[idx]);
+          }
+        } else {
+          idx += width;
+        }
+        esr->currentpos += width;
+      } else {
+        if (encseq->accesstype_via_utables &&
+            esr->wildcardrangestate != NULL &&
+            esr->wildcardrangestate->hasprevious &&
+            esr->wildcardrangestate->previousrange.start <= esr->currentpos &&
+            esr->currentpos < esr->wildcardrangestate->previousrange.end) {
+          width = MIN(esr->wildcardrangestate->previousrange.end -
+                      esr->currentpos, len - idx);
+          memset(buffer + idx, (int) WILDCARD, (size_t) width);
+          idx += width;
+          esr->currentpos += width;
+        } else {
+          buffer[idx++] = gt_encseq_reader_next_encoded_char(esr);
+        }
+      }
+    }
+  } else if (encseq->sat == GT_ACCESS_TYPE_BITACCESS &&
+      encseq->twobitencoding != NULL &&
+      (esr->readmode == GT_READMODE_FORWARD ||
+       esr->readmode == GT_READMODE_COMPL) &&
+      esr->currentpos < encseq->totallength) {
+    /* the reader has no state besides its position */
+    GtUword width = MIN(len, encseq->totallength - esr->currentpos);
+
+    gt_encseq_twobitencoding_decode(buffer, encseq->twobitencoding,
+                                    esr->currentpos, width);
+    if (encseq->specialbits != NULL) {
+      gt_encseq_patchspecialsViabitaccess(encseq, buffer, esr->currentpos,
+                                          width);
+    }
+    if (esr->readmode == GT_READMODE_COMPL) {
+      for (/* Nothing */; idx < width; idx++) {
+        if (!ISSPECIAL(buffer[idx]))
+          buffer[idx] = GT_COMPLEMENTBASE(buffer[idx]);
+      }
+    }
+    idx = width;
+    esr->currentpos += width;
+  }
+  while (idx < len) {
+    buffer[idx++] = gt_encseq_reader_next_encoded_char(esr);
+  }
+}
+
+void gt_encseq_reader_next_decoded_chars(GtEncseqReader *esr,
+                                         char *buffer,
+                                         GtUword len)
+{
+  GtUword idx;
+
+  gt_assert(esr != NULL && esr->encseq != NULL && esr->encseq->alpha != NULL);
+  if (!esr->encseq->has_exceptiontable) {
+    const GtUchar *characters = gt_alphabet_characters(esr->encseq->alpha);
+    const GtUchar wildcardshow = gt_alphabet_wildcard_show(esr->encseq->alpha),
+                  numofchars = (GtUchar)
+                               gt_alphabet_num_of_chars(esr->encseq->alpha);
+
+    /* decode in place as done by <gt_alphabet_decode> */
+    gt_encseq_reader_next_encoded_chars(esr, (GtUchar *) buffer, len);
+    for (idx = 0; idx < len; idx++) {
+      GtUchar cc = (GtUchar) buffer[idx];
+
+      if (cc < numofchars) {
+        buffer[idx] = (char) characters[cc];
+      } else {
+        if (cc != (GtUchar) SEPARATOR) {
+          buffer[idx] = (char) wildcardshow;
+        }
+      }
+    }
+  } else {
+    for (idx = 0; idx < len; idx++) {
+      buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
+    }
+  }
+}
+
 static GtUword gt_encseq_extract2bitenc(
                                             GtEndofTwobitencoding *ptbe,
                                             const GtEncseq *encseq,
@@ -7467,6 +8298,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                           const GtStr *str_smap,
                                           const GtStr *str_sat,
                                           GtStrArray *filenametab,
+                                          const GtEncseq *appendto,
                                           bool isdna,
                                           bool isprotein,
                                           bool isplain,
@@ -7519,7 +8351,10 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
     forcetable = 3U;
   }
   if (!haserr) {
-    if (isdna) {
+    if (appendto != NULL) {
+      customalphabet = appendto->alphatype == 2UL ? true : false;
+      alphabet = gt_alphabet_ref(appendto->alpha);
+    } else if (isdna) {
       alphabet = gt_alphabet_new_dna();
     } else if (isprotein) {
       alphabet = gt_alphabet_new_protein();
@@ -7548,6 +8383,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                         specialrangestab,
                                         wildcardrangestab,
                                         filenametab,
+                                        appendto,
                                         &filelengthtab,
                                         alphabet,
                                         customalphabet,
@@ -7609,6 +8445,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
   }
   if (!haserr) {
     encseq = files2encodedsequence(filenametab,
+                                   appendto,
                                    filelengthtab,
                                    isplain,
                                    totallength,
@@ -8448,6 +9285,7 @@ int gt_encseq_encoder_encode(GtEncseqEncoder *ee, GtStrArray *seqfiles,
                                     ee->smapfile,
                                     ee->sat,
                                     seqfiles,
+                                    NULL,
                                     ee->isdna,
                                     ee->isprotein,
                                     ee->isplain,
@@ -8466,6 +9304,161 @@ int gt_encseq_encoder_encode(GtEncseqEncoder *ee, GtStrArray *seqfiles,
   return 0;
 }
 
+/* the table files of an index, which are replaced by an append */
+static const char *gt_encseq_table_suffixes[] = {GT_ENCSEQFILESUFFIX,
+                                                 GT_SSPTABFILESUFFIX,
+                                                 GT_DESTABFILESUFFIX,
+                                                 GT_SDSTABFILESUFFIX,
+                                                 GT_OISTABFILESUFFIX,
+                                                 GT_MD5TABFILESUFFIX};
+
+#define GT_ENCSEQ_NOF_TABLES \
+        (sizeof (gt_encseq_table_suffixes) / \
+         sizeof (gt_encseq_table_suffixes[0]))
+
+static bool gt_encseq_table_exists(const char *indexname, const char *suffix)
+{
+  GtStr *filename = gt_str_new_cstr(indexname);
+  bool exists;
+  gt_str_append_cstr(filename, suffix);
+  exists = gt_file_exists(gt_str_get(filename));
+  gt_str_delete(filename);
+  return exists;
+}
+
+static void gt_encseq_table_unlink(const char *indexname, const char *suffix)
+{
+  GtStr *filename = gt_str_new_cstr(indexname);
+  gt_str_append_cstr(filename, suffix);
+  gt_xunlink(gt_str_get(filename));
+  gt_str_delete(filename);
+}
+
+static int gt_encseq_table_rename(const char *fromindexname,
+                                  const char *toindexname, const char *suffix,
+                                  GtError *err)
+{
+  GtStr *fromfilename = gt_str_new_cstr(fromindexname),
+        *tofilename = gt_str_new_cstr(toindexname);
+  int had_err = 0;
+  gt_str_append_cstr(fromfilename, suffix);
+  gt_str_append_cstr(tofilename, suffix);
+  if (rename(gt_str_get(fromfilename), gt_str_get(tofilename)) != 0) {
+    gt_error_set(err, "cannot rename \"%s\" to \"%s\": %s",
+                 gt_str_get(fromfilename), gt_str_get(tofilename),
+                 strerror(errno));
+    had_err = -1;
+  }
+  gt_str_delete(fromfilename);
+  gt_str_delete(tofilename);
+  return had_err;
+}
+
+int gt_encseq_encoder_append(GtEncseqEncoder *ee, GtStrArray *seqfiles,
+                             const char *indexname, GtError *err)
+{
+  GtEncseqLoader *el;
+  GtEncseq *appendto, *encseq = NULL;
+  GtStrArray *filenametab = NULL;
+  GtStr *tmpindexname, *backupindexname;
+  bool backedup[GT_ENCSEQ_NOF_TABLES] = {false},
+       installed[GT_ENCSEQ_NOF_TABLES] = {false};
+  GtUword filenum;
+  size_t idx;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(ee && seqfiles && indexname);
+  /* the tables are written with a temporary index name and renamed after
+     the existing index has been unmapped */
+  tmpindexname = gt_str_new_cstr(indexname);
+  gt_str_append_cstr(tmpindexname, ".append");
+  backupindexname = gt_str_new_cstr(indexname);
+  gt_str_append_cstr(backupindexname, ".backup");
+  el = gt_encseq_loader_new();
+  gt_encseq_loader_set_logger(el, ee->logger);
+  appendto = gt_encseq_loader_load(el, indexname, err);
+  if (appendto == NULL)
+    had_err = -1;
+  if (!had_err) {
+    bool outssptab;
+
+    filenametab = gt_str_array_new();
+    for (filenum = 0; filenum < appendto->numofdbfiles; filenum++) {
+      gt_str_array_add_cstr(filenametab,
+                            gt_str_array_get(appendto->filenametab, filenum));
+    }
+    for (filenum = 0; filenum < gt_str_array_size(seqfiles); filenum++)
+      gt_str_array_add_cstr(filenametab, gt_str_array_get(seqfiles, filenum));
+    /* an index of a single sequence has no separator positions to store */
+    outssptab = appendto->has_ssptab ||
+                (ee->ssptab && appendto->numofdbsequences == 1UL);
+    encseq = gt_encseq_new_from_files(ee->pt,
+                                      gt_str_get(tmpindexname),
+                                      ee->smapfile,
+                                      ee->sat,
+                                      filenametab,
+                                      appendto,
+                                      false,
+                                      false,
+                                      ee->isplain,
+                                      appendto->destab != NULL,
+                                      appendto->sdstab != NULL,
+                                      outssptab,
+                                      appendto->has_exceptiontable,
+                                      appendto->md5_tab != NULL,
+                                      ee->esq_no_header,
+                                      ee->clip_desc,
+                                      ee->logger,
+                                      err);
+    if (encseq == NULL)
+      had_err = -1;
+  }
+  gt_encseq_delete(encseq);
+  gt_encseq_delete(appendto);
+  gt_encseq_loader_delete(el);
+  /* the old tables are kept as backups until all new tables are in place,
+     such that the index can be restored if renaming fails */
+  for (idx = 0; !had_err && idx < GT_ENCSEQ_NOF_TABLES; idx++) {
+    if (gt_encseq_table_exists(indexname, gt_encseq_table_suffixes[idx])) {
+      had_err = gt_encseq_table_rename(indexname, gt_str_get(backupindexname),
+                                       gt_encseq_table_suffixes[idx], err);
+      if (!had_err)
+        backedup[idx] = true;
+    }
+  }
+  for (idx = 0; !had_err && idx < GT_ENCSEQ_NOF_TABLES; idx++) {
+    if (gt_encseq_table_exists(gt_str_get(tmpindexname),
+                               gt_encseq_table_suffixes[idx])) {
+      had_err = gt_encseq_table_rename(gt_str_get(tmpindexname), indexname,
+                                       gt_encseq_table_suffixes[idx], err);
+      if (!had_err)
+        installed[idx] = true;
+    }
+  }
+  for (idx = 0; idx < GT_ENCSEQ_NOF_TABLES; idx++) {
+    const char *suffix = gt_encseq_table_suffixes[idx];
+    if (had_err) {
+      if (installed[idx])
+        gt_encseq_table_unlink(indexname, suffix);
+      if (backedup[idx]) {
+        /* an error is already reported, if even restoring fails the backup
+           is left for the user */
+        (void) gt_encseq_table_rename(gt_str_get(backupindexname), indexname,
+                                      suffix, NULL);
+      }
+      if (gt_encseq_table_exists(gt_str_get(tmpindexname), suffix))
+        gt_encseq_table_unlink(gt_str_get(tmpindexname), suffix);
+    }
+    else if (backedup[idx])
+      gt_encseq_table_unlink(gt_str_get(backupindexname), suffix);
+  }
+  gt_str_array_delete(filenametab);
+  gt_str_delete(backupindexname);
+  gt_str_delete(tmpindexname);
+  return had_err;
+}
+
 void gt_encseq_encoder_delete(GtEncseqEncoder *ee)
 {
   if (!ee) return;
@@ -9443,6 +10436,13 @@ GtUint64 gt_encseq_effective_filelength(const GtEncseq *encseq,
   return (GtUint64) encseq->headerptr.filelengthtab[filenum].effectivelength;
 }
 
+GtUint64 gt_encseq_filelength(const GtEncseq *encseq, GtUword filenum)
+{
+  gt_assert(encseq != NULL && encseq->headerptr.filelengthtab != NULL);
+  gt_assert(filenum < encseq->numofdbfiles);
+  return (GtUint64) encseq->headerptr.filelengthtab[filenum].length;
+}
+
 GtUword gt_encseq_filenum(const GtEncseq *encseq,
                                 GtUword position)
 {
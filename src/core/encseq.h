@@ -61,6 +61,10 @@ GtEncseqLoader* gt_encseq_loader_new_from_options(GtEncseqOptions *opts,
 
 void gt_encseq_encoder_disable_esq_header(GtEncseqEncoder *ee);
 
+/* Returns the length of the <filenum>-th file contained in <encseq>, as
+   stored in the header of the encoded sequence. */
+GtUint64 gt_encseq_filelength(const GtEncseq *encseq, GtUword filenum);
+
 /* The following type stores a two bit encoding in <tbe> with information
   about the number of two bit units which do not store a special
   character in <unitsnotspecial>. To allow the comparison of these
@@ -103,6 +107,25 @@ void gt_encseq_extract_encoded_with_reader(GtEncseqReader *esr,
                                GtUword frompos,
                                GtUword topos);
 
+/* Stores the next <len> encoded characters delivered by <esr> in <buffer>,
+   which must be large enough to hold them. The result and the state of <esr>
+   afterwards are the same as for <len> calls of
+   <gt_encseq_reader_next_encoded_char>. For forward and complement reading
+   on an encoded sequence with a two bit encoding and stop position support
+   or bit access, the characters are decoded from the two bit encoding a
+   unit at a time and the special characters are patched in afterwards. */
+void gt_encseq_reader_next_encoded_chars(GtEncseqReader *esr,
+                                         GtUchar *buffer,
+                                         GtUword len);
+
+/* Stores the next <len> decoded characters delivered by <esr> in <buffer>,
+   like <len> calls of <gt_encseq_reader_next_decoded_char>. Unless the
+   encoded sequence has lossless support, this uses
+   <gt_encseq_reader_next_encoded_chars>. */
+void gt_encseq_reader_next_decoded_chars(GtEncseqReader *esr,
+                                         char *buffer,
+                                         GtUword len);
+
 /* The following type stores the result of comparing a pair of twobit
   encodings. <common> stores the number of units which are common
   (either from the beginning or from the end. common is in the range 0 to
@@ -23,6 +23,7 @@
 #include "core/alphabet_api.h"
 #include "core/logger_api.h"
 #include "core/timer_api.h"
+#include "core/range_api.h"
 #include "core/readmode_api.h"
 #include "core/str_api.h"
 #include "core/str_array_api.h"
@@ -64,6 +65,15 @@ typedef struct GtEncseqBuilder GtEncseqBuilder;
    sequential scan of a <GtEncseq> region as an iterator. */
 typedef struct GtEncseqReader GtEncseqReader;
 
+/* The <GtEncseqAccessPattern> describes how the tables of a <GtEncseq> mapped
+   from secondary storage are expected to be accessed, see
+   <gt_encseq_set_access_pattern()>. */
+typedef enum {
+  GT_ENCSEQ_ACCESS_NORMAL,
+  GT_ENCSEQ_ACCESS_SEQUENTIAL,
+  GT_ENCSEQ_ACCESS_RANDOM
+} GtEncseqAccessPattern;
+
 /* The file suffix used for encoded sequence files. */
 #define GT_ENCSEQFILESUFFIX ".esq"
 /* The file suffix used for encoded sequence separator position tables. */
@@ -201,6 +211,27 @@ bool              gt_encseq_is_mirrored(const GtEncseq *encseq);
 GtUword           gt_encseq_version(const GtEncseq *encseq);
 /* Returns TRUE if <encseq> was created on a 64-bit system. */
 bool              gt_encseq_is_64_bit(const GtEncseq *encseq);
+/* Advises the operating system that the tables of <encseq> mapped from
+   secondary storage are accessed according to <pattern>. For
+   <GT_ENCSEQ_ACCESS_SEQUENTIAL> the tables are read ahead aggressively, for
+   <GT_ENCSEQ_ACCESS_RANDOM> read-ahead is disabled, such that every page
+   fault only reads the page needed. Has no effect if <encseq> was not
+   mapped or the advice is not supported. */
+void              gt_encseq_set_access_pattern(const GtEncseq *encseq,
+                                               GtEncseqAccessPattern pattern);
+/* Initiates reading the parts of the mapped tables of <encseq> required to
+   access the positions in the <numofranges> ranges in <ranges> and the
+   descriptions of the sequences overlapping them, such that the subsequent
+   accesses do not wait for the secondary storage. The reading is done in the
+   background, this function returns immediately. */
+void              gt_encseq_prefetch(const GtEncseq *encseq,
+                                     const GtRange *ranges,
+                                     GtUword numofranges);
+/* Locks the mapped sequence separator table and description separator table
+   of <encseq>, which are accessed for almost every sequence and description
+   lookup, into memory. Returns 0 on success, otherwise -1 and <err> is set
+   accordingly (for example, if the limit of locked memory is exceeded). */
+int               gt_encseq_lock_tables(const GtEncseq *encseq, GtError *err);
 /* Deletes <encseq> and frees all associated space. */
 void              gt_encseq_delete(GtEncseq *encseq);
 
@@ -348,6 +379,19 @@ int               gt_encseq_encoder_encode(GtEncseqEncoder *ee,
                                           GtStrArray *seqfiles,
                                           const char *indexname,
                                           GtError *err);
+/* Appends the sequences in the sequence files given in <seqfiles> to the
+   encoded sequence with index name <indexname>, replacing its index tables.
+   The alphabet and the set of tables (descriptions, MD5 fingerprints,
+   lossless support etc.) of the existing encoded sequence are kept; the
+   corresponding settings in <ee> are ignored. The access type is chosen as
+   for <gt_encseq_encoder_encode()>. The existing sequences are read from the
+   index tables, so the original sequence files are not needed. Returns 0 on
+   success, or a negative value on error (<err> is set accordingly); in this
+   case the index tables are left unchanged. */
+int               gt_encseq_encoder_append(GtEncseqEncoder *ee,
+                                           GtStrArray *seqfiles,
+                                           const char *indexname,
+                                           GtError *err);
 /* Deletes <ee>. */
 void              gt_encseq_encoder_delete(GtEncseqEncoder *ee);
 
@@ -687,6 +687,74 @@ void gt_fa_xmunmap(void *addr)
   gt_mutex_unlock(fa->mmap_mutex);
 }
 
+static size_t fa_map_length(const void *map)
+{
+  FAMapInfo *mapinfo;
+  size_t len;
+  gt_assert(fa && map);
+  gt_mutex_lock(fa->mmap_mutex);
+  mapinfo = gt_hashmap_get(fa->memory_maps, map);
+  gt_assert(mapinfo);
+  len = mapinfo->len;
+  gt_mutex_unlock(fa->mmap_mutex);
+  return len;
+}
+
+void gt_fa_madvise(GT_UNUSED const void *map, GT_UNUSED size_t offset,
+                   GT_UNUSED size_t len, GT_UNUSED GtFaAdvice advice)
+{
+#if !defined (_WIN32) && defined (POSIX_MADV_NORMAL)
+  size_t maplen, pagesize = (size_t) sysconf(_SC_PAGESIZE);
+  int posixadvice;
+
+  if (!map) return;
+  maplen = fa_map_length(map);
+  if (offset >= maplen)
+    return;
+  if (len == 0 || len > maplen - offset)
+    len = maplen - offset;
+  /* the address must be aligned to a page boundary, the start of the map
+     already is */
+  len += offset % pagesize;
+  offset -= offset % pagesize;
+  switch (advice) {
+    case GT_FA_ADVICE_SEQUENTIAL:
+      posixadvice = POSIX_MADV_SEQUENTIAL;
+      break;
+    case GT_FA_ADVICE_RANDOM:
+      posixadvice = POSIX_MADV_RANDOM;
+      break;
+    case GT_FA_ADVICE_WILLNEED:
+      posixadvice = POSIX_MADV_WILLNEED;
+      break;
+    default:
+      posixadvice = POSIX_MADV_NORMAL;
+  }
+  /* failure is not an error, the advice is only a hint */
+  (void) posix_madvise((char *) map + offset, len, posixadvice);
+#endif
+}
+
+int gt_fa_mlock(const void *map, GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(map);
+#ifndef _WIN32
+  if (mlock(map, fa_map_length(map)) != 0) {
+    gt_error_set(err, "cannot lock memory map into memory: %s",
+                 strerror(errno));
+    return -1;
+  }
+#else
+  if (!VirtualLock((LPVOID) map, fa_map_length(map))) {
+    gt_error_set(err, "cannot VirtualLock memory map: 0x%08x",
+                 (unsigned int) GetLastError());
+    return -1;
+  }
+#endif
+  return 0;
+}
+
 void* gt_fa_mmap_read_with_suffix_func(const char *path, const char *suffix,
                                        size_t *len, const char *src_file,
                                        int src_line, GtError *err)
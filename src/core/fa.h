@@ -146,6 +146,26 @@ void*   gt_fa_xmmap_write_func_range(const char *path, size_t len,
 
 void    gt_fa_xmunmap(void *addr);
 
+/* the expected accesses to a memory map, see <gt_fa_madvise()> */
+typedef enum {
+  GT_FA_ADVICE_NORMAL,
+  GT_FA_ADVICE_SEQUENTIAL,
+  GT_FA_ADVICE_RANDOM,
+  GT_FA_ADVICE_WILLNEED
+} GtFaAdvice;
+
+/* Advise the operating system that the <len> bytes at offset <offset> of the
+   memory map starting at <map> will be accessed as given by <advice>;
+   <GT_FA_ADVICE_WILLNEED> initiates reading the range in advance. The range
+   is restricted to the memory map, a <len> of 0 extends it to the end of the
+   map. This is only a hint, which is ignored if not supported. */
+void    gt_fa_madvise(const void *map, size_t offset, size_t len,
+                      GtFaAdvice advice);
+/* Lock the memory map starting at <map> into memory, such that accessing it
+   does not cause page faults. The lock is released when <map> is unmapped.
+   Returns 0 on success; otherwise -1 and <err> is set. */
+int     gt_fa_mlock(const void *map, GtError *err);
+
 #define gt_fa_mmap_generic_fd(fd, filename_to_map, len, offset, mapwritable, \
                               hard_fail, err) \
         gt_fa_mmap_generic_fd_func(fd, filename_to_map, len, offset, \
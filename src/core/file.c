@@ -24,6 +24,9 @@
 #include "core/xbzlib.h"
 #include "core/xzlib.h"
 
+/* initial size of the buffer used for reading files opened by path */
+#define GT_FILE_READ_BUFSIZE  (1 << 17)
+
 struct GtFile {
   GtFileMode mode;
   GtUword reference_count;
@@ -34,9 +37,14 @@ struct GtFile {
   } fileptr;
   char *orig_path,
        *orig_mode,
-       unget_char;
+       unget_char,
+       *buf; /* read buffer, or line buffer for unbuffered files */
+  size_t bufsize,
+         bufstart, /* next unread character in <buf> */
+         bufend;   /* end of valid characters in <buf> */
   bool is_stdin,
-       unget_used;
+       unget_used,
+       buffered; /* the file handle is owned by <file> and read in blocks */
 };
 
 GtFileMode gt_file_mode_determine(const char *path)
@@ -134,6 +142,7 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
         break;
       default: gt_assert(0);
     }
+    file->buffered = true;
   }
   else {
     gt_assert(file_mode == GT_FILE_MODE_UNCOMPRESSED);
@@ -166,6 +175,7 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
         break;
       default: gt_assert(0);
     }
+    file->buffered = true;
   }
   else {
     gt_assert(file_mode == GT_FILE_MODE_UNCOMPRESSED);
@@ -198,6 +208,58 @@ GtFileMode gt_file_mode(const GtFile *file)
   return file->mode;
 }
 
+/* read up to <nbytes> from the file handle of <file>, bypassing the buffer */
+static size_t file_read_unbuffered(GtFile *file, void *buf, size_t nbytes)
+{
+  int rval = 0;
+  switch (file->mode) {
+    case GT_FILE_MODE_UNCOMPRESSED:
+      rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
+      break;
+    case GT_FILE_MODE_GZIP:
+      rval = gt_xgzread(file->fileptr.gzfile, buf, nbytes);
+      break;
+    case GT_FILE_MODE_BZIP2:
+      rval = gt_xbzread(file->fileptr.bzfile, buf, nbytes);
+      break;
+    default: gt_assert(0);
+  }
+  return rval > 0 ? (size_t) rval : 0;
+}
+
+/* make sure that at least <minfree> characters fit behind the valid part of
+   the buffer, plus one for a terminating '\0' */
+static void file_buffer_reserve(GtFile *file, size_t minfree)
+{
+  if (file->bufstart > 0 && file->bufend + minfree > file->bufsize) {
+    memmove(file->buf, file->buf + file->bufstart,
+            file->bufend - file->bufstart);
+    file->bufend -= file->bufstart;
+    file->bufstart = 0;
+  }
+  if (file->buf == NULL || file->bufend + minfree > file->bufsize) {
+    if (file->bufsize == 0)
+      file->bufsize = GT_FILE_READ_BUFSIZE;
+    while (file->bufend + minfree > file->bufsize)
+      file->bufsize *= 2;
+    file->buf = gt_realloc(file->buf, file->bufsize + 1);
+  }
+}
+
+/* read the next block of <file> into the buffer, returns the number of
+   characters read, 0 at the end of the file */
+static size_t file_fill_buffer(GtFile *file)
+{
+  size_t nbytes;
+  if (file->bufend == file->bufsize || file->bufsize == 0)
+    file_buffer_reserve(file, file->bufsize > 0 ? file->bufsize / 2
+                                                : GT_FILE_READ_BUFSIZE);
+  nbytes = file_read_unbuffered(file, file->buf + file->bufend,
+                                file->bufsize - file->bufend);
+  file->bufend += nbytes;
+  return nbytes;
+}
+
 int gt_file_xfgetc(GtFile *file)
 {
   int c = -1;
@@ -206,6 +268,14 @@ int gt_file_xfgetc(GtFile *file)
       c = file->unget_char;
       file->unget_used = false;
     }
+    else if (file->buffered) {
+      if (file->bufstart == file->bufend) {
+        file->bufstart = file->bufend = 0;
+        if (file_fill_buffer(file) == 0)
+          return EOF;
+      }
+      c = (unsigned char) file->buf[file->bufstart++];
+    }
     else {
       switch (file->mode) {
         case GT_FILE_MODE_UNCOMPRESSED:
@@ -226,6 +296,77 @@ int gt_file_xfgetc(GtFile *file)
   return c;
 }
 
+/* a line ends with "\n"; a '\r' pairs up with the character following it,
+   hence a run of '\r' characters before the "\n" ends with a "\r\n" line
+   terminator only if its length is odd */
+static size_t file_line_length(const char *line, size_t length)
+{
+  size_t cr = 0;
+  while (cr < length && line[length - cr - 1] == '\r')
+    cr++;
+  return (cr % 2) ? length - 1 : length;
+}
+
+int gt_file_xread_line(GtFile *file, char **line, GtUword *length)
+{
+  size_t scanpos, linelength;
+  char *newline;
+  gt_assert(file && line && length);
+  if (!file->buffered) {
+    /* collect the line character by character in the buffer */
+    int cc;
+    file->bufstart = file->bufend = 0;
+    while ((cc = gt_file_xfgetc(file)) != EOF && cc != '\n') {
+      file_buffer_reserve(file, 1);
+      file->buf[file->bufend++] = (char) cc;
+    }
+    file_buffer_reserve(file, 0);
+    linelength = cc == EOF ? file->bufend
+                           : file_line_length(file->buf, file->bufend);
+    file->buf[linelength] = '\0';
+    *line = file->buf;
+    *length = linelength;
+    return cc == EOF ? EOF : 0;
+  }
+  if (file->unget_used) {
+    /* put the character back in front of the unread part of the buffer */
+    if (file->bufstart == 0) {
+      file_buffer_reserve(file, 1);
+      memmove(file->buf + 1, file->buf, file->bufend);
+      file->bufend++;
+    }
+    else
+      file->bufstart--;
+    file->buf[file->bufstart] = file->unget_char;
+    file->unget_used = false;
+  }
+  scanpos = file->bufstart;
+  while ((newline = file->bufend > scanpos
+                    ? memchr(file->buf + scanpos, '\n',
+                             file->bufend - scanpos)
+                    : NULL) == NULL) {
+    size_t oldstart = file->bufstart;
+    scanpos = file->bufend;
+    if (file_fill_buffer(file) == 0) {
+      /* end of file without line terminator */
+      file_buffer_reserve(file, 0);
+      *line = file->buf + file->bufstart;
+      *length = file->bufend - file->bufstart;
+      (*line)[*length] = '\0';
+      file->bufstart = file->bufend;
+      return EOF;
+    }
+    /* the buffer may have been compacted */
+    scanpos -= oldstart - file->bufstart;
+  }
+  *line = file->buf + file->bufstart;
+  linelength = file_line_length(*line, newline - *line);
+  (*line)[linelength] = '\0';
+  *length = linelength;
+  file->bufstart = newline - file->buf + 1;
+  return 0;
+}
+
 void gt_file_unget_char(GtFile *file, char c)
 {
   if (file) {
@@ -364,6 +505,18 @@ void gt_file_xfputs(const char *cstr, GtFile *file)
 int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
 {
   int rval = -1;
+  if (file && file->buffered && file->bufstart < file->bufend) {
+    /* hand out the buffered characters first */
+    size_t buffered = file->bufend - file->bufstart;
+    if (buffered > nbytes)
+      buffered = nbytes;
+    memcpy(buf, file->buf + file->bufstart, buffered);
+    file->bufstart += buffered;
+    if (buffered == nbytes)
+      return (int) buffered;
+    return (int) (buffered + file_read_unbuffered(file, (char*) buf + buffered,
+                                                  nbytes - buffered));
+  }
   if (file) {
     switch (file->mode) {
       case GT_FILE_MODE_UNCOMPRESSED:
@@ -406,6 +559,8 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
 void gt_file_xrewind(GtFile *file)
 {
   gt_assert(file);
+  file->bufstart = file->bufend = 0;
+  file->unget_used = false;
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       rewind(file->fileptr.file);
@@ -425,6 +580,7 @@ void gt_file_delete_without_handle(GtFile *file)
   if (!file) return;
   gt_free(file->orig_path);
   gt_free(file->orig_mode);
+  gt_free(file->buf);
   gt_free(file);
 }
 
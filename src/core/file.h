@@ -20,6 +20,7 @@
 
 #include <stdlib.h>
 #include "core/file_api.h"
+#include "core/types_api.h"
 
 typedef enum {
   GT_FILE_MODE_UNCOMPRESSED,
@@ -63,4 +64,14 @@ GtFileMode  gt_file_mode(const GtFile *file);
    Can only be used once at a time. */
 void        gt_file_unget_char(GtFile *file, char c);
 
+/* Read the next line from <file> (which cannot be <NULL>). A line ends with
+   "\n" or "\r\n", the line terminator is not part of the line. Files opened
+   by path are read in large blocks and the line is searched in the buffer,
+   so <line> points into this buffer. The line is '\0'-terminated, may be
+   modified by the caller and stays valid until the next read operation on
+   <file>. Its length is stored in <length>. Returns 0 if a line was read and
+   <EOF> if the end of <file> was reached before a line terminator, in which
+   case <line> holds the remaining characters (if any). */
+int         gt_file_xread_line(GtFile *file, char **line, GtUword *length);
+
 #endif
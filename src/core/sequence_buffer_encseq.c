@@ -0,0 +1,246 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/chardef.h"
+#include "core/desc_buffer.h"
+#include "core/encseq.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/sequence_buffer_encseq.h"
+#include "core/sequence_buffer_plain.h"
+#include "core/sequence_buffer_rep.h"
+#include "core/sequence_buffer_inline.h"
+
+struct GtSequenceBufferEncseq {
+  const GtSequenceBuffer parent_instance;
+  const GtEncseq *encseq;
+  GtEncseqReader *esr;
+  GtStrArray *nextfilenametab;
+  GtSequenceBuffer *next;
+  GtDescBuffer *nextdescqueue;
+  GtUword currentpos,
+          seqnum;
+  char decoded[OUTBUFSIZE];
+  bool started,
+       nextstarted;
+};
+
+#define gt_sequence_buffer_encseq_cast(SB)\
+        gt_sequence_buffer_cast(gt_sequence_buffer_encseq_class(), SB)
+
+static void gt_sequence_buffer_encseq_add_desc(GtSequenceBufferEncseq *sbe,
+                                               const char *desc,
+                                               GtUword desclen)
+{
+  GtDescBuffer *descptr = ((GtSequenceBuffer *) sbe)->pvt->descptr;
+  GtUword idx;
+
+  for (idx = 0; idx < desclen; idx++)
+    gt_desc_buffer_append_char(descptr, desc[idx]);
+  gt_desc_buffer_finish(descptr);
+}
+
+static void gt_sequence_buffer_encseq_add_encseq_desc(
+                                                   GtSequenceBufferEncseq *sbe)
+{
+  GtUword desclen = 0;
+  const char *desc = NULL;
+
+  if (gt_encseq_has_description_support(sbe->encseq))
+    desc = gt_encseq_description(sbe->encseq, &desclen, sbe->seqnum);
+  gt_sequence_buffer_encseq_add_desc(sbe, desc, desclen);
+}
+
+static void gt_sequence_buffer_encseq_add_next_desc(
+                                                   GtSequenceBufferEncseq *sbe)
+{
+  const char *desc = gt_desc_buffer_get_next(sbe->nextdescqueue);
+
+  gt_sequence_buffer_encseq_add_desc(sbe, desc, (GtUword) strlen(desc));
+}
+
+static void gt_sequence_buffer_encseq_start(GtSequenceBufferEncseq *sbe)
+{
+  GtSequenceBufferMembers *pvt = ((GtSequenceBuffer *) sbe)->pvt;
+  GtUword filenum, numoffiles = gt_encseq_num_of_files(sbe->encseq);
+
+  sbe->esr = gt_encseq_create_reader_with_readmode(sbe->encseq,
+                                                   GT_READMODE_FORWARD, 0);
+  if (pvt->filelengthtab != NULL) {
+    for (filenum = 0; filenum < numoffiles; filenum++) {
+      pvt->filelengthtab[filenum].length
+        = gt_encseq_filelength(sbe->encseq, filenum);
+      pvt->filelengthtab[filenum].effectivelength
+        = gt_encseq_effective_filelength(sbe->encseq, filenum);
+    }
+  }
+  if (pvt->descptr != NULL)
+    gt_sequence_buffer_encseq_add_encseq_desc(sbe);
+  if (sbe->next != NULL) {
+    /* the sequences of the following files are processed by <sbe->next>,
+       which collects their descriptions in a buffer of its own, as the
+       descriptions must be delivered in the order of the separators */
+    gt_sequence_buffer_set_symbolmap(sbe->next, pvt->symbolmap);
+    if (pvt->chardisttab != NULL)
+      gt_sequence_buffer_set_chardisttab(sbe->next, pvt->chardisttab);
+    if (pvt->filelengthtab != NULL)
+      gt_sequence_buffer_set_filelengthtab(sbe->next,
+                                           pvt->filelengthtab + numoffiles);
+    if (pvt->descptr != NULL) {
+      sbe->nextdescqueue = gt_desc_buffer_new();
+      gt_sequence_buffer_set_desc_buffer(sbe->next, sbe->nextdescqueue);
+    }
+  }
+  sbe->started = true;
+}
+
+static int gt_sequence_buffer_encseq_advance(GtSequenceBuffer *sb,
+                                             GtError *err)
+{
+  GtSequenceBufferEncseq *sbe = gt_sequence_buffer_encseq_cast(sb);
+  GtSequenceBufferMembers *pvt = sb->pvt;
+  GtUword currentoutpos = 0,
+          totallength = gt_encseq_total_length(sbe->encseq);
+  int ret;
+
+  gt_error_check(err);
+  if (!sbe->started)
+    gt_sequence_buffer_encseq_start(sbe);
+  while (currentoutpos < (GtUword) OUTBUFSIZE) {
+    if (sbe->currentpos < totallength) {
+      GtUword idx, len = MIN((GtUword) OUTBUFSIZE - currentoutpos,
+                             totallength - sbe->currentpos);
+
+      gt_encseq_reader_next_decoded_chars(sbe->esr, sbe->decoded, len);
+      for (idx = 0; idx < len; idx++) {
+        unsigned char cc = (unsigned char) sbe->decoded[idx];
+
+        if (cc == (unsigned char) SEPARATOR) {
+          pvt->outbuf[currentoutpos++] = (unsigned char) SEPARATOR;
+          pvt->lastspeciallength++;
+          sbe->seqnum++;
+          if (pvt->descptr != NULL)
+            gt_sequence_buffer_encseq_add_encseq_desc(sbe);
+        } else {
+          if ((ret = process_char(sb, currentoutpos, cc, err)) != 0)
+            return ret;
+          currentoutpos++;
+        }
+      }
+      sbe->currentpos += len;
+    } else if (sbe->next != NULL && !sbe->nextstarted) {
+      /* separator between the encoded sequence and the following files */
+      pvt->outbuf[currentoutpos++] = (unsigned char) SEPARATOR;
+      pvt->lastspeciallength++;
+      sbe->nextstarted = true;
+    } else if (sbe->next != NULL) {
+      GtUchar charcode;
+      char cc;
+
+      ret = gt_sequence_buffer_next_with_original(sbe->next, &charcode, &cc,
+                                                  err);
+      if (ret < 0)
+        return ret;
+      if (ret == 0) {
+        if (pvt->descptr != NULL)
+          gt_sequence_buffer_encseq_add_next_desc(sbe);
+        pvt->complete = true;
+        break;
+      }
+      if (ISSPECIAL(charcode)) {
+        pvt->lastspeciallength++;
+        if (charcode == (GtUchar) SEPARATOR && pvt->descptr != NULL)
+          gt_sequence_buffer_encseq_add_next_desc(sbe);
+      } else
+        pvt->lastspeciallength = 0;
+      pvt->outbuf[currentoutpos] = charcode;
+      pvt->outbuforig[currentoutpos] = (unsigned char) cc;
+      pvt->counter++;
+      currentoutpos++;
+    } else {
+      pvt->complete = true;
+      break;
+    }
+  }
+  pvt->nextfree = currentoutpos;
+  return 0;
+}
+
+static GtUword gt_sequence_buffer_encseq_get_file_index(GtSequenceBuffer *sb)
+{
+  GtSequenceBufferEncseq *sbe = gt_sequence_buffer_encseq_cast(sb);
+  GtUword numoffiles = gt_encseq_num_of_files(sbe->encseq);
+
+  if (sbe->nextstarted)
+    return numoffiles + gt_sequence_buffer_get_file_index(sbe->next);
+  return numoffiles - 1;
+}
+
+static void gt_sequence_buffer_encseq_free(GtSequenceBuffer *sb)
+{
+  GtSequenceBufferEncseq *sbe = gt_sequence_buffer_encseq_cast(sb);
+
+  gt_encseq_reader_delete(sbe->esr);
+  gt_sequence_buffer_delete(sbe->next);
+  gt_desc_buffer_delete(sbe->nextdescqueue);
+  gt_str_array_delete(sbe->nextfilenametab);
+}
+
+const GtSequenceBufferClass* gt_sequence_buffer_encseq_class(void)
+{
+  static const GtSequenceBufferClass sbc = {
+                                      sizeof (GtSequenceBufferEncseq),
+                                      gt_sequence_buffer_encseq_advance,
+                                      gt_sequence_buffer_encseq_get_file_index,
+                                      gt_sequence_buffer_encseq_free };
+  return &sbc;
+}
+
+GtSequenceBuffer* gt_sequence_buffer_encseq_new(const GtEncseq *encseq,
+                                                const GtStrArray *filenametab,
+                                                bool plainformat,
+                                                GtError *err)
+{
+  GtSequenceBuffer *sb;
+  GtSequenceBufferEncseq *sbe;
+  GtUword filenum, numoffiles = gt_encseq_num_of_files(encseq);
+
+  gt_error_check(err);
+  gt_assert(encseq && filenametab
+              && gt_str_array_size(filenametab) >= numoffiles);
+  sb = gt_sequence_buffer_create(gt_sequence_buffer_encseq_class());
+  sbe = gt_sequence_buffer_encseq_cast(sb);
+  sb->pvt->filenametab = filenametab;
+  sbe->encseq = encseq;
+  if (gt_str_array_size(filenametab) > numoffiles) {
+    sbe->nextfilenametab = gt_str_array_new();
+    for (filenum = numoffiles; filenum < gt_str_array_size(filenametab);
+         filenum++) {
+      gt_str_array_add_cstr(sbe->nextfilenametab,
+                            gt_str_array_get(filenametab, filenum));
+    }
+    if (plainformat)
+      sbe->next = gt_sequence_buffer_plain_new(sbe->nextfilenametab);
+    else
+      sbe->next = gt_sequence_buffer_new_guess_type(sbe->nextfilenametab,
+                                                    err);
+    if (sbe->next == NULL) {
+      gt_sequence_buffer_delete(sb);
+      return NULL;
+    }
+  }
+  return sb;
+}
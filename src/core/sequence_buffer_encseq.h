@@ -0,0 +1,44 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEQUENCE_BUFFER_ENCSEQ_H
+#define SEQUENCE_BUFFER_ENCSEQ_H
+
+#include "core/encseq_api.h"
+#include "core/sequence_buffer.h"
+#include "core/str_array_api.h"
+
+/* implements the ``sequence buffer'' interface for the sequences of an
+   encoded sequence, followed by the sequences of further sequence files */
+typedef struct GtSequenceBufferEncseq GtSequenceBufferEncseq;
+
+const GtSequenceBufferClass* gt_sequence_buffer_encseq_class(void);
+
+/* Returns a sequence buffer delivering the decoded sequences of <encseq>
+   followed by the sequences in the files of <filenametab>, whose first
+   entries are the names of the files of <encseq>. The remaining files are
+   read in the format of the first of them, or as plain files if
+   <plainformat> is true. The descriptions of <encseq> are delivered if
+   <encseq> has description support. Returns NULL and sets <err> if the
+   format of the sequence files cannot be determined. */
+GtSequenceBuffer*            gt_sequence_buffer_encseq_new(
+                                                   const GtEncseq *encseq,
+                                                   const GtStrArray
+                                                     *filenametab,
+                                                   bool plainformat,
+                                                   GtError *err);
+
+#endif
@@ -21,6 +21,7 @@
 #include "core/cstr_api.h"
 #include "core/dynalloc.h"
 #include "core/ensure.h"
+#include "core/file.h"
 #include "core/ma.h"
 #include "core/str.h"
 #include "core/unused_api.h"
@@ -312,60 +313,16 @@ int gt_str_read_next_line(GtStr *s, FILE *fpin)
 
 int gt_str_read_next_line_generic(GtStr *s, GtFile *fpin)
 {
-  int cc;
-  char c;
+  GtUword length;
+  char *line;
+  int rval;
   gt_assert(s);
-  for (;;) {
-    cc = gt_file_xfgetc(fpin);
-    if (cc == EOF)
-      return EOF;
-    if (cc == '\n') {
-      if ((s->length+1) * sizeof (char) > s->allocated) {
-        s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                              (s->length+1) * sizeof (char));
-      }
-      s->cstr[s->length] = '\0';
-      return 0;
-    }
-    else if (cc == '\r') {
-      /* check if we have a Windows newline "\r\n" */
-      int ncc;
-      char nc;
-      ncc = gt_file_xfgetc(fpin);
-      if (ncc == EOF) {
-        c = cc;
-        if ((s->length+2) * sizeof (char) > s->allocated) {
-          s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                                (s->length+2) * sizeof (char));
-        }
-        s->cstr[s->length++] = c;
-        return EOF;
-      }
-      if (ncc == '\n') {
-        if ((s->length+1) * sizeof (char) > s->allocated) {
-          s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                                (s->length+1) * sizeof (char));
-        }
-        s->cstr[s->length] = '\0';
-        return 0;
-      }
-      c = cc;
-      nc = ncc;
-      if ((s->length+3) * sizeof (char) > s->allocated) {
-        s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                              (s->length+3) * sizeof (char));
-      }
-      s->cstr[s->length++] = c;
-      s->cstr[s->length++] = nc;
-      continue;
-    }
-    c = cc;
-    if ((s->length+2) * sizeof (char) > s->allocated) {
-      s->cstr = gt_dynalloc(s->cstr, &s->allocated,
-                            (s->length+2) * sizeof (char));
-    }
-    s->cstr[s->length++] = c;
-  }
+  if (!fpin)
+    return gt_str_read_next_line(s, stdin);
+  rval = gt_file_xread_line(fpin, &line, &length);
+  if (length > 0)
+    gt_str_append_cstr_nt(s, line, length);
+  return rval;
 }
 
 int gt_str_unit_test(GtError *err)
@@ -16,41 +16,131 @@
 */
 
 #include <string.h>
-#include "core/cstr_table.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/hashtable.h"
+#include "core/ma.h"
 #include "core/mathsupport.h"
 #include "core/multithread_api.h"
+#include "core/str_api.h"
 #include "core/symbol.h"
 #include "core/unused_api.h"
 
-static GtCstrTable *symbols = NULL;
-static GtMutex *symbol_mutex = NULL;
+/* The symbols are distributed over several independently locked tables,
+   selected by the high bits of the string hash. Each table is an open
+   addressing hash set indexed by the low bits of the same hash, which is
+   stored with the symbol to skip most string comparisons. The rwlock of a
+   table is the only lock taken: looking up an existing symbol only takes it
+   for reading, hence threads do not block each other unless a new symbol is
+   added to the same table. */
+#define SYMBOL_SHARD_BITS  6
+#define SYMBOL_NUM_SHARDS  (1U << SYMBOL_SHARD_BITS)
+#define SYMBOL_START_SIZE  16
+
+typedef struct {
+  uint32_t hash;
+  char *symbol; /* NULL for an empty slot */
+} GtSymbolEntry;
+
+typedef struct {
+  GtSymbolEntry *entries;
+  GtUword size, /* always a power of two */
+          fill;
+  GtRWLock *lock;
+} GtSymbolShard;
+
+static GtSymbolShard *symbol_shards = NULL;
 
 void gt_symbol_init(void)
 {
-  if (!symbols)
-    symbols = gt_cstr_table_new();
-  if (!symbol_mutex)
-    symbol_mutex = gt_mutex_new();
+  unsigned int i;
+  if (symbol_shards)
+    return;
+  symbol_shards = gt_malloc(SYMBOL_NUM_SHARDS * sizeof *symbol_shards);
+  for (i = 0; i < SYMBOL_NUM_SHARDS; i++) {
+    symbol_shards[i].entries = gt_calloc(SYMBOL_START_SIZE,
+                                         sizeof (GtSymbolEntry));
+    symbol_shards[i].size = SYMBOL_START_SIZE;
+    symbol_shards[i].fill = 0;
+    symbol_shards[i].lock = gt_rwlock_new();
+  }
+}
+
+/* Return the slot of <cstr> in <shard>, or the empty slot where it belongs. */
+static GtSymbolEntry* symbol_shard_find(const GtSymbolShard *shard,
+                                        const char *cstr, uint32_t hash)
+{
+  GtUword mask = shard->size - 1, idx = hash & mask;
+  for (;;) {
+    GtSymbolEntry *entry = shard->entries + idx;
+    if (!entry->symbol
+        || (entry->hash == hash && !strcmp(entry->symbol, cstr)))
+      return entry;
+    idx = (idx + 1) & mask;
+  }
+}
+
+static void symbol_shard_grow(GtSymbolShard *shard)
+{
+  GtSymbolEntry *old = shard->entries;
+  GtUword i, oldsize = shard->size, mask;
+  shard->size *= 2;
+  mask = shard->size - 1;
+  shard->entries = gt_calloc(shard->size, sizeof (GtSymbolEntry));
+  for (i = 0; i < oldsize; i++) {
+    if (old[i].symbol) {
+      GtUword idx = old[i].hash & mask;
+      while (shard->entries[idx].symbol)
+        idx = (idx + 1) & mask;
+      shard->entries[idx] = old[i];
+    }
+  }
+  gt_free(old);
 }
 
 const char* gt_symbol(const char *cstr)
 {
+  GtSymbolShard *shard;
+  GtSymbolEntry *entry;
   const char *symbol;
+  uint32_t hash;
   if (!cstr)
     return NULL;
-  gt_mutex_lock(symbol_mutex);
-  if (!(symbol = gt_cstr_table_get(symbols, cstr))) {
-    gt_cstr_table_add(symbols, cstr);
-    symbol = gt_cstr_table_get(symbols, cstr);
+  hash = gt_ht_cstr_elem_hash(&cstr);
+  shard = symbol_shards + (hash >> (32 - SYMBOL_SHARD_BITS));
+  gt_rwlock_rdlock(shard->lock);
+  symbol = symbol_shard_find(shard, cstr, hash)->symbol;
+  gt_rwlock_unlock(shard->lock);
+  if (symbol)
+    return symbol;
+  gt_rwlock_wrlock(shard->lock);
+  /* another thread could have added <cstr> in the meantime */
+  entry = symbol_shard_find(shard, cstr, hash);
+  if (!(symbol = entry->symbol)) {
+    entry->hash = hash;
+    symbol = entry->symbol = gt_cstr_dup(cstr);
+    /* keep the table at most three quarters full */
+    if (++shard->fill > shard->size / 4 * 3)
+      symbol_shard_grow(shard);
   }
-  gt_mutex_unlock(symbol_mutex);
+  gt_rwlock_unlock(shard->lock);
   return symbol;
 }
 
 void gt_symbol_clean(void)
 {
-  gt_cstr_table_delete(symbols);
-  gt_mutex_delete(symbol_mutex);
+  unsigned int i;
+  GtUword j;
+  if (!symbol_shards)
+    return;
+  for (i = 0; i < SYMBOL_NUM_SHARDS; i++) {
+    for (j = 0; j < symbol_shards[i].size; j++)
+      gt_free(symbol_shards[i].entries[j].symbol);
+    gt_free(symbol_shards[i].entries);
+    gt_rwlock_delete(symbol_shards[i].lock);
+  }
+  gt_free(symbol_shards);
+  symbol_shards = NULL;
 }
 
 /* we use randomly generated numbers to test the symbol mechanism */
@@ -60,13 +150,15 @@ void gt_symbol_clean(void)
 static void* test_symbol(GT_UNUSED void *data)
 {
   GtStr *symbol;
+  const char *sym;
   GtUword i;
   symbol = gt_str_new();
   for (i = 0; i < NUMBER_OF_SYMBOLS; i++) {
     gt_str_reset(symbol);
     gt_str_append_uword(symbol, gt_rand_max(MAX_SYMBOL));
-    gt_symbol(gt_str_get(symbol));
-    gt_assert(!strcmp(gt_symbol(gt_str_get(symbol)), gt_str_get(symbol)));
+    sym = gt_symbol(gt_str_get(symbol));
+    gt_assert(!strcmp(sym, gt_str_get(symbol)));
+    gt_assert(gt_symbol(gt_str_get(symbol)) == sym);
   }
   gt_str_delete(symbol);
   return NULL;
@@ -74,6 +166,16 @@ static void* test_symbol(GT_UNUSED void *data)
 
 int gt_symbol_unit_test(GtError *err)
 {
+  char foo[] = "foo";
+  const char *sym;
+  int had_err = 0;
   gt_error_check(err);
-  return gt_multithread(test_symbol, NULL, err);
+  sym = gt_symbol(foo);
+  gt_ensure(sym != foo && !strcmp(sym, "foo"));
+  gt_ensure(gt_symbol("foo") == sym);
+  gt_ensure(gt_symbol("bar") != sym);
+  gt_ensure(gt_symbol(NULL) == NULL);
+  if (!had_err)
+    had_err = gt_multithread(test_symbol, NULL, err);
+  return had_err;
 }
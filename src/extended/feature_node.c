@@ -21,6 +21,7 @@
 #include "core/class_alloc_lock.h"
 #include "core/cstr_api.h"
 #include "core/ensure.h"
+#include "core/hashmap.h"
 #include "core/hashtable.h"
 #include "core/ma.h"
 #include "core/queue_api.h"
@@ -52,6 +53,8 @@
 #define PSEUDO_FEATURE_MASK             0x1
 #define DFS_STATUS_OFFSET               16
 #define DFS_STATUS_MASK                 0x3
+#define ARENA_ATTRIBUTES_OFFSET         18
+#define ARENA_ATTRIBUTES_MASK           0x1
 
 typedef enum {
   NO_PARENT,
@@ -81,12 +84,28 @@ typedef struct {
   GtUword number;
 } GtTypeTraverseInfo;
 
+static bool attributes_in_arena(const GtFeatureNode *fn)
+{
+  return (fn->bit_field >> ARENA_ATTRIBUTES_OFFSET) & ARENA_ATTRIBUTES_MASK;
+}
+
+/* Replace attributes allocated in the arena of <fn> by a copy on the heap,
+   before they are changed in a way the arena does not support. */
+static void move_attributes_from_arena(GtFeatureNode *fn)
+{
+  if (attributes_in_arena(fn)) {
+    fn->attributes = gt_tag_value_map_clone(fn->attributes);
+    fn->bit_field &= ~(ARENA_ATTRIBUTES_MASK << ARENA_ATTRIBUTES_OFFSET);
+  }
+}
+
 static void feature_node_free(GtGenomeNode *gn)
 {
   GtFeatureNode *fn = gt_feature_node_cast(gn);
   gt_str_delete(fn->seqid);
   gt_str_delete(fn->source);
-  gt_tag_value_map_delete(fn->attributes);
+  if (!attributes_in_arena(fn))
+    gt_tag_value_map_delete(fn->attributes);
   if (fn->children) {
     GtDlistelem *dlistelem;
     for (dlistelem = gt_dlist_first(fn->children);
@@ -231,16 +250,10 @@ static void set_tree_status(unsigned int *bit_field, TreeStatus tree_status)
   *bit_field |= tree_status << TREE_STATUS_OFFSET;
 }
 
-GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
-                                  GtUword start, GtUword end,
-                                  GtStrand strand)
+static void feature_node_init(GtFeatureNode *fn, GtStr *seqid,
+                              const char *type, GtUword start, GtUword end,
+                              GtStrand strand)
 {
-  GtGenomeNode *gn;
-  GtFeatureNode *fn;
-  gt_assert(seqid && type);
-  gt_assert(start <= end);
-  gn = gt_genome_node_create(gt_feature_node_class());
-  fn = gt_feature_node_cast(gn);
   fn->seqid       = gt_str_ref(seqid);
   fn->source      = NULL;
   fn->type        = gt_symbol(type);
@@ -258,6 +271,29 @@ GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
   set_tree_status(&fn->bit_field, IS_TREE);
   /* the DFS status is set to DFS_WHITE already */
   fn->representative = NULL;
+}
+
+GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
+                                  GtUword start, GtUword end,
+                                  GtStrand strand)
+{
+  GtGenomeNode *gn;
+  gt_assert(seqid && type);
+  gt_assert(start <= end);
+  gn = gt_genome_node_create(gt_feature_node_class());
+  feature_node_init(gt_feature_node_cast(gn), seqid, type, start, end, strand);
+  return gn;
+}
+
+GtGenomeNode* gt_feature_node_new_in_arena(GtArena *arena, GtStr *seqid,
+                                           const char *type, GtUword start,
+                                           GtUword end, GtStrand strand)
+{
+  GtGenomeNode *gn;
+  gt_assert(arena && seqid && type);
+  gt_assert(start <= end);
+  gn = gt_genome_node_create_in_arena(gt_feature_node_class(), arena);
+  feature_node_init(gt_feature_node_cast(gn), seqid, type, start, end, strand);
   return gn;
 }
 
@@ -375,6 +411,225 @@ GtFeatureNode* gt_feature_node_clone(const GtFeatureNode *template)
   return fn;
 }
 
+static void serialize_uword(GtStr *buffer, GtUword value)
+{
+  gt_str_append_cstr_nt(buffer, (const char*) &value, sizeof value);
+}
+
+static GtUword deserialize_uword(const char **data)
+{
+  GtUword value;
+  memcpy(&value, *data, sizeof value);
+  *data += sizeof value;
+  return value;
+}
+
+/* strings are stored with their terminator, such that they can be used
+   directly from the serialized data, <NULL> is stored as <GT_UNDEF_UWORD> */
+static void serialize_cstr(GtStr *buffer, const char *cstr)
+{
+  if (cstr) {
+    GtUword length = strlen(cstr);
+    serialize_uword(buffer, length);
+    gt_str_append_cstr_nt(buffer, cstr, length + 1);
+  }
+  else
+    serialize_uword(buffer, GT_UNDEF_UWORD);
+}
+
+static const char* deserialize_cstr(const char **data)
+{
+  const char *cstr;
+  GtUword length = deserialize_uword(data);
+  if (length == GT_UNDEF_UWORD)
+    return NULL;
+  cstr = *data;
+  *data += length + 1;
+  return cstr;
+}
+
+/* Return a <GtStr> with content <cstr>, reusing <*last> if possible. */
+static GtStr* deserialize_shared_str(GtStr **last, const char *cstr)
+{
+  if (!cstr)
+    return NULL;
+  if (!*last || strcmp(gt_str_get(*last), cstr)) {
+    gt_str_delete(*last);
+    *last = gt_str_new_cstr(cstr);
+  }
+  return *last;
+}
+
+bool gt_feature_node_serialize(GtFeatureNode *fn, GtStr *buffer)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *node;
+  GtHashmap *indices;
+  GtArray *nodes;
+  GtUword i, nof_nodes;
+  bool serializable = true;
+  gt_assert(fn && buffer);
+  /* number the nodes in depth first order, nodes with several parents are
+     numbered when they are reached for the first time. The root comes first,
+     also if it is a pseudo-feature, which the iterator skips. */
+  nodes = gt_array_new(sizeof (GtFeatureNode*));
+  indices = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  gt_array_add(nodes, fn);
+  gt_hashmap_add(indices, fn, (void*) gt_array_size(nodes));
+  fni = gt_feature_node_iterator_new(fn);
+  while ((node = gt_feature_node_iterator_next(fni))) {
+    if (!gt_hashmap_get(indices, node)) {
+      gt_array_add(nodes, node);
+      gt_hashmap_add(indices, node, (void*) gt_array_size(nodes));
+    }
+  }
+  gt_feature_node_iterator_delete(fni);
+  nof_nodes = gt_array_size(nodes);
+  /* the representatives of multi-features must be part of the tree */
+  for (i = 0; serializable && i < nof_nodes; i++) {
+    node = *(GtFeatureNode**) gt_array_get(nodes, i);
+    if (node->representative && !gt_hashmap_get(indices, node->representative))
+      serializable = false;
+  }
+  if (serializable) {
+    serialize_cstr(buffer, gt_str_get(fn->seqid));
+    serialize_uword(buffer, nof_nodes);
+    for (i = 0; i < nof_nodes; i++) {
+      GtGenomeNode *gn;
+      unsigned int bit_field;
+      node = *(GtFeatureNode**) gt_array_get(nodes, i);
+      gn = (GtGenomeNode*) node;
+      serialize_cstr(buffer, gn->filename ? gt_str_get(gn->filename) : NULL);
+      serialize_uword(buffer, gn->line_number);
+      serialize_cstr(buffer, node->type);
+      serialize_cstr(buffer, node->source ? gt_str_get(node->source) : NULL);
+      serialize_uword(buffer, node->range.start);
+      serialize_uword(buffer, node->range.end);
+      gt_str_append_cstr_nt(buffer, (const char*) &node->score,
+                            sizeof node->score);
+      bit_field = node->bit_field
+                  & ~(ARENA_ATTRIBUTES_MASK << ARENA_ATTRIBUTES_OFFSET);
+      gt_str_append_cstr_nt(buffer, (const char*) &bit_field,
+                            sizeof bit_field);
+      if (node->attributes) {
+        GtUword length = gt_tag_value_map_length(node->attributes);
+        serialize_uword(buffer, length);
+        gt_str_append_cstr_nt(buffer, node->attributes, length);
+      }
+      else
+        serialize_uword(buffer, 0);
+      serialize_uword(buffer, node->representative
+                              ? (GtUword) gt_hashmap_get(indices,
+                                                         node->representative)
+                                - 1
+                              : GT_UNDEF_UWORD);
+    }
+    /* the children are stored after all nodes, because a node with several
+       parents may be numbered before some of its parents */
+    for (i = 0; i < nof_nodes; i++) {
+      GtDlistelem *dlistelem;
+      node = *(GtFeatureNode**) gt_array_get(nodes, i);
+      serialize_uword(buffer, node->children
+                              ? gt_dlist_size(node->children) : 0);
+      if (node->children) {
+        for (dlistelem = gt_dlist_first(node->children); dlistelem != NULL;
+             dlistelem = gt_dlistelem_next(dlistelem)) {
+          serialize_uword(buffer,
+                          (GtUword) gt_hashmap_get(indices,
+                                              gt_dlistelem_get_data(dlistelem))
+                          - 1);
+        }
+      }
+    }
+  }
+  gt_hashmap_delete(indices);
+  gt_array_delete(nodes);
+  return serializable;
+}
+
+GtGenomeNode* gt_feature_node_deserialize(const char **data)
+{
+  GtFeatureNode **nodes;
+  GtStr *seqid, *filename = NULL, *source = NULL;
+  GtUword i, j, nof_nodes, *representatives;
+  unsigned int *bit_fields;
+  bool *is_child;
+  GtGenomeNode *root;
+  gt_assert(data && *data);
+  seqid = gt_str_new_cstr(deserialize_cstr(data));
+  nof_nodes = deserialize_uword(data);
+  gt_assert(nof_nodes > 0);
+  nodes = gt_malloc(sizeof *nodes * nof_nodes);
+  representatives = gt_malloc(sizeof *representatives * nof_nodes);
+  bit_fields = gt_malloc(sizeof *bit_fields * nof_nodes);
+  is_child = gt_calloc(nof_nodes, sizeof *is_child);
+  for (i = 0; i < nof_nodes; i++) {
+    const char *filename_cstr, *type, *source_cstr;
+    GtUword line_number, start, end, attributes_length;
+    GtFeatureNode *fn;
+    filename_cstr = deserialize_cstr(data);
+    line_number = deserialize_uword(data);
+    type = deserialize_cstr(data);
+    source_cstr = deserialize_cstr(data);
+    start = deserialize_uword(data);
+    end = deserialize_uword(data);
+    if (type) {
+      fn = (GtFeatureNode*) gt_feature_node_new(seqid, type, start, end,
+                                                GT_STRAND_UNKNOWN);
+    }
+    else {
+      fn = (GtFeatureNode*) gt_feature_node_new_pseudo(seqid, start, end,
+                                                       GT_STRAND_UNKNOWN);
+    }
+    if (filename_cstr) {
+      gt_genome_node_set_origin((GtGenomeNode*) fn,
+                                deserialize_shared_str(&filename,
+                                                       filename_cstr),
+                                line_number);
+    }
+    if (source_cstr)
+      fn->source = gt_str_ref(deserialize_shared_str(&source, source_cstr));
+    memcpy(&fn->score, *data, sizeof fn->score);
+    *data += sizeof fn->score;
+    memcpy(bit_fields + i, *data, sizeof *bit_fields);
+    *data += sizeof *bit_fields;
+    attributes_length = deserialize_uword(data);
+    if (attributes_length) {
+      fn->attributes = gt_tag_value_map_clone((const GtTagValueMap) *data);
+      *data += attributes_length;
+    }
+    representatives[i] = deserialize_uword(data);
+    nodes[i] = fn;
+  }
+  for (i = 0; i < nof_nodes; i++) {
+    GtUword nof_children = deserialize_uword(data);
+    for (j = 0; j < nof_children; j++) {
+      GtUword child = deserialize_uword(data);
+      gt_assert(child < nof_nodes);
+      /* a node with several parents is referenced once for each parent */
+      if (is_child[child])
+        (void) gt_genome_node_ref((GtGenomeNode*) nodes[child]);
+      is_child[child] = true;
+      gt_feature_node_add_child(nodes[i], nodes[child]);
+    }
+  }
+  /* the status bits changed by adding the children are restored as well */
+  for (i = 0; i < nof_nodes; i++) {
+    nodes[i]->bit_field = bit_fields[i];
+    if (representatives[i] != GT_UNDEF_UWORD)
+      nodes[i]->representative = nodes[representatives[i]];
+  }
+  root = (GtGenomeNode*) nodes[0];
+  gt_free(is_child);
+  gt_free(bit_fields);
+  gt_free(representatives);
+  gt_free(nodes);
+  gt_str_delete(source);
+  gt_str_delete(filename);
+  gt_str_delete(seqid);
+  return root;
+}
+
 const char* gt_feature_node_get_source(const GtFeatureNode *fn)
 {
   gt_assert(fn);
@@ -667,10 +922,24 @@ void gt_feature_node_add_attribute(GtFeatureNode *fn,
                                    const char *attr_name,
                                    const char *attr_value)
 {
+  GtArena *arena;
   gt_assert(fn && attr_name && attr_value);
   gt_assert(strlen(attr_name)); /* attribute name cannot be empty */
   gt_assert(strlen(attr_value)); /* attribute value cannot be empty */
-  if (!fn->attributes)
+  arena = ((GtGenomeNode*) fn)->arena;
+  if (arena && (!fn->attributes || attributes_in_arena(fn))) {
+    /* keep the attributes of a node allocated in an arena in the same arena */
+    if (!fn->attributes) {
+      fn->attributes = gt_tag_value_map_new_in_arena(arena, attr_name,
+                                                     attr_value);
+      fn->bit_field |= ARENA_ATTRIBUTES_MASK << ARENA_ATTRIBUTES_OFFSET;
+    }
+    else {
+      gt_tag_value_map_add_in_arena(&fn->attributes, arena, attr_name,
+                                    attr_value);
+    }
+  }
+  else if (!fn->attributes)
     fn->attributes = gt_tag_value_map_new(attr_name, attr_value);
   else
     gt_tag_value_map_add(&fn->attributes, attr_name, attr_value);
@@ -687,6 +956,7 @@ void gt_feature_node_set_attribute(GtFeatureNode *fn,
   gt_assert(fn && attr_name && attr_value);
   gt_assert(strlen(attr_name)); /* attribute name cannot be empty */
   gt_assert(strlen(attr_value)); /* attribute value cannot be empty */
+  move_attributes_from_arena(fn);
   if (!fn->attributes)
     fn->attributes = gt_tag_value_map_new(attr_name, attr_value);
   else
@@ -703,6 +973,7 @@ void gt_feature_node_remove_attribute(GtFeatureNode *fn,
   gt_assert(fn && attr_name);
   gt_assert(strlen(attr_name)); /* attribute name cannot be empty */
   gt_assert(fn->attributes); /* attribute list must exist already */
+  move_attributes_from_arena(fn);
   if (gt_tag_value_map_size(fn->attributes) == 1) {
     gt_tag_value_map_delete(fn->attributes);
     fn->attributes = NULL;
@@ -826,6 +1097,75 @@ int gt_feature_node_unit_test(GtError *err)
   gt_genome_node_delete(fn);
   gt_str_delete(seqid);
 
+  /* serialization round trip of a tree with a node with two parents */
+  if (!had_err) {
+    GtFeatureNodeIterator *fni_a, *fni_b;
+    GtFeatureNode *a, *b, *exon;
+    GtGenomeNode *copy;
+    GtStr *buffer = gt_str_new();
+    const char *data;
+    fn = gt_feature_node_new_standard_gene();
+    gt_feature_node_add_attribute((GtFeatureNode*) fn, "ID", "gene1");
+    /* skip the TF binding site, take the first two mRNAs */
+    fni_a = gt_feature_node_iterator_new_direct((GtFeatureNode*) fn);
+    (void) gt_feature_node_iterator_next(fni_a);
+    a = gt_feature_node_iterator_next(fni_a);
+    b = gt_feature_node_iterator_next(fni_a);
+    gt_feature_node_iterator_delete(fni_a);
+    gt_feature_node_set_score(a, 0.5);
+    /* the first exon of the first mRNA also becomes part of the second one */
+    fni_a = gt_feature_node_iterator_new_direct(a);
+    exon = gt_feature_node_iterator_next(fni_a);
+    gt_feature_node_iterator_delete(fni_a);
+    gt_feature_node_add_child(b, (GtFeatureNode*)
+                              gt_genome_node_ref((GtGenomeNode*) exon));
+    gt_ensure(gt_feature_node_serialize((GtFeatureNode*) fn, buffer));
+    data = gt_str_get(buffer);
+    copy = gt_feature_node_deserialize(&data);
+    gt_ensure(data == gt_str_get(buffer) + gt_str_length(buffer));
+    /* the exon is shared in the copy as well */
+    fni_a = gt_feature_node_iterator_new_direct((GtFeatureNode*) copy);
+    (void) gt_feature_node_iterator_next(fni_a);
+    a = gt_feature_node_iterator_next(fni_a);
+    b = gt_feature_node_iterator_next(fni_a);
+    gt_feature_node_iterator_delete(fni_a);
+    fni_a = gt_feature_node_iterator_new_direct(a);
+    exon = gt_feature_node_iterator_next(fni_a);
+    gt_feature_node_iterator_delete(fni_a);
+    fni_b = gt_feature_node_iterator_new_direct(b);
+    while ((b = gt_feature_node_iterator_next(fni_b)) && b != exon);
+    gt_feature_node_iterator_delete(fni_b);
+    gt_ensure(b == exon);
+    fni_a = gt_feature_node_iterator_new((GtFeatureNode*) fn);
+    fni_b = gt_feature_node_iterator_new((GtFeatureNode*) copy);
+    while (!had_err && (a = gt_feature_node_iterator_next(fni_a))) {
+      GtRange range_a, range_b;
+      b = gt_feature_node_iterator_next(fni_b);
+      gt_ensure(b != NULL && a != b);
+      if (!had_err) {
+        range_a = gt_genome_node_get_range((GtGenomeNode*) a);
+        range_b = gt_genome_node_get_range((GtGenomeNode*) b);
+        gt_ensure(!gt_range_compare(&range_a, &range_b));
+        gt_ensure(!strcmp(gt_feature_node_get_type(a),
+                          gt_feature_node_get_type(b)));
+        gt_ensure(gt_feature_node_get_strand(a)
+                  == gt_feature_node_get_strand(b));
+        gt_ensure(gt_feature_node_score_is_defined(a)
+                  == gt_feature_node_score_is_defined(b));
+        gt_ensure(gt_feature_node_number_of_children(a)
+                  == gt_feature_node_number_of_children(b));
+      }
+    }
+    gt_ensure(!gt_feature_node_iterator_next(fni_b));
+    gt_ensure(!strcmp(gt_feature_node_get_attribute((GtFeatureNode*) copy,
+                                                    "ID"), "gene1"));
+    gt_feature_node_iterator_delete(fni_b);
+    gt_feature_node_iterator_delete(fni_a);
+    gt_genome_node_delete(copy);
+    gt_genome_node_delete(fn);
+    gt_str_delete(buffer);
+  }
+
   return had_err;
 }
 
@@ -1100,8 +1440,15 @@ void gt_feature_node_add_child(GtFeatureNode *parent, GtFeatureNode *child)
   /* pseudo-features have to be top-level */
   gt_assert(!gt_feature_node_is_pseudo((GtFeatureNode*) child));
   /* create children list on demand */
-  if (!parent->children)
-    parent->children = gt_dlist_new((GtCompare) gt_genome_node_cmp);
+  if (!parent->children) {
+    GtArena *arena = ((GtGenomeNode*) parent)->arena;
+    if (arena) {
+      parent->children = gt_dlist_new_in_arena((GtCompare) gt_genome_node_cmp,
+                                               arena);
+    }
+    else
+      parent->children = gt_dlist_new((GtCompare) gt_genome_node_cmp);
+  }
   gt_dlist_add(parent->children, child); /* XXX: check for cycles */
   /* update tree status of <parent> */
   set_tree_status(&parent->bit_field, TREE_STATUS_UNDETERMINED);
@@ -18,6 +18,7 @@
 #ifndef FEATURE_NODE_H
 #define FEATURE_NODE_H
 
+#include "core/arena.h"
 #include "core/bittab.h"
 #include "core/range.h"
 #include "core/strand_api.h"
@@ -32,7 +33,21 @@ typedef int (*GtFeatureNodeTraverseFunc)(GtFeatureNode*, void*, GtError*);
 
 const GtGenomeNodeClass* gt_feature_node_class(void);
 
+/* Like <gt_feature_node_new()>, but the new node, its attributes and its list
+   of children are allocated in <arena>. The node holds a reference to
+   <arena>. */
+GtGenomeNode*  gt_feature_node_new_in_arena(GtArena *arena, GtStr *seqid,
+                                            const char *type, GtUword start,
+                                            GtUword end, GtStrand strand);
 GtFeatureNode* gt_feature_node_clone(const GtFeatureNode*);
+/* Append a binary representation of the feature tree rooted at <fn> to
+   <buffer>, which can be read back with <gt_feature_node_deserialize()> by the
+   same program. Observers and user data are not stored. Return <false> and
+   leave <buffer> unchanged if a multi-feature in the tree has a representative
+   outside of it. */
+bool           gt_feature_node_serialize(GtFeatureNode *fn, GtStr *buffer);
+/* Return the feature tree stored at <*data> and move <*data> behind it. */
+GtGenomeNode*  gt_feature_node_deserialize(const char **data);
 void           gt_feature_node_get_exons(GtFeatureNode*,
                                          GtArray *exon_features);
 void           gt_feature_node_determine_transcripttypes(GtFeatureNode*);
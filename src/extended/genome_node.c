@@ -212,11 +212,8 @@ static int compare_genome_nodes_with_delta(GtGenomeNode *gn_a,
   return gt_range_compare_with_delta(&range_a, &range_b, delta);
 }
 
-GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
+static void genome_node_init(GtGenomeNode *gn, const GtGenomeNodeClass *gnc)
 {
-  GtGenomeNode *gn;
-  gt_assert(gnc && gnc->size);
-  gn                     = gt_malloc(gnc->size);
   gn->c_class            = gnc;
   gn->filename           = NULL; /* means the node is generated */
   gn->line_number        = 0;
@@ -226,6 +223,26 @@ GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
 #ifdef GT_THREADS_ENABLED
   gn->lock              = gt_rwlock_new();
 #endif
+}
+
+GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
+{
+  GtGenomeNode *gn;
+  gt_assert(gnc && gnc->size);
+  gn = gt_malloc(gnc->size);
+  genome_node_init(gn, gnc);
+  gn->arena = NULL;
+  return gn;
+}
+
+GtGenomeNode* gt_genome_node_create_in_arena(const GtGenomeNodeClass *gnc,
+                                             GtArena *arena)
+{
+  GtGenomeNode *gn;
+  gt_assert(gnc && gnc->size && arena);
+  gn = gt_arena_alloc(arena, gnc->size);
+  genome_node_init(gn, gnc);
+  gn->arena = gt_arena_ref(arena);
   return gn;
 }
 
@@ -539,5 +556,8 @@ void gt_genome_node_delete(GtGenomeNode *gn)
 #ifdef GT_THREADS_ENABLED
   gt_rwlock_delete(gn->lock);
 #endif
-  gt_free(gn);
+  if (gn->arena)
+    gt_arena_delete(gn->arena);
+  else
+    gt_free(gn);
 }
@@ -19,6 +19,7 @@
 #define GENOME_NODE_REP_H
 
 #include <stdio.h>
+#include "core/arena.h"
 #include "core/dlist.h"
 #include "core/hashmap.h"
 #include "core/thread_api.h"
@@ -50,6 +51,7 @@ struct GtGenomeNodeClass
 struct GtGenomeNode
 {
   const GtGenomeNodeClass *c_class;
+  GtArena *arena; /* the node is allocated in <arena> if not NULL */
   GtStr *filename;
   GtHashmap *userdata; /* created on demand */
   /* GtGenomeNodes are very space critical, therefore we can justify a bit
@@ -71,5 +73,9 @@ const GtGenomeNodeClass* gt_genome_node_class_new(size_t size,
                                        GtGenomeNodeChangeSeqidFunc change_seqid,
                                        GtGenomeNodeAcceptFunc accept);
 GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass*);
+/* Like <gt_genome_node_create()>, but the node is allocated in <arena>, which
+   is kept alive until the node is deleted. */
+GtGenomeNode* gt_genome_node_create_in_arena(const GtGenomeNodeClass*,
+                                             GtArena *arena);
 
 #endif
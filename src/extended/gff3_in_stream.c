@@ -138,6 +138,13 @@ void gt_gff3_in_stream_enable_strict_mode(GtGFF3InStream *is)
   gt_gff3_in_stream_plain_enable_strict_mode(is->gff3_in_stream_plain);
 }
 
+void gt_gff3_in_stream_enable_arena_allocation(GtNodeStream *ns)
+{
+  GtGFF3InStream *is = gff3_in_stream_cast(ns);
+  gt_assert(is);
+  gt_gff3_in_stream_plain_enable_arena_allocation(is->gff3_in_stream_plain);
+}
+
 void gt_gff3_in_stream_enable_tidy_mode(GtGFF3InStream *is)
 {
   gt_assert(is);
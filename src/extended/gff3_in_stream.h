@@ -31,6 +31,10 @@ void                     gt_gff3_in_stream_set_offset(GtNodeStream*, GtWord);
 int                      gt_gff3_in_stream_set_offsetfile(GtNodeStream*, GtStr*,
                                                           GtError*);
 void                     gt_gff3_in_stream_disable_add_ids(GtNodeStream*);
+/* Allocate the parsed feature nodes in arenas, see
+   <gt_gff3_parser_enable_arena_allocation()>. */
+void                     gt_gff3_in_stream_enable_arena_allocation(
+                                                                 GtNodeStream*);
 void                     gt_gff3_in_stream_fix_region_boundaries(
                                                                GtGFF3InStream*);
 
@@ -23,6 +23,7 @@
 #include "core/queue.h"
 #include "core/progressbar.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_in_stream_plain.h"
 #include "extended/gff3_parser.h"
@@ -232,6 +233,8 @@ static GtNodeStream* gff3_in_stream_plain_new(GtStrArray *files,
   gff3_in_stream_plain->genome_node_buffer  = gt_queue_new();
   gff3_in_stream_plain->gff3_parser         = gt_gff3_parser_new(NULL);
   gff3_in_stream_plain->used_types          = gt_cstr_table_new();
+  if (gt_jobs > 1)
+    gt_gff3_parser_enable_parallel_mode(gff3_in_stream_plain->gff3_parser);
   return ns;
 }
 
@@ -305,6 +308,13 @@ void gt_gff3_in_stream_plain_enable_strict_mode(GtNodeStream *ns)
   gt_gff3_parser_enable_strict_mode(is->gff3_parser);
 }
 
+void gt_gff3_in_stream_plain_enable_arena_allocation(GtNodeStream *ns)
+{
+  GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
+  gt_assert(is);
+  gt_gff3_parser_enable_arena_allocation(is->gff3_parser);
+}
+
 void gt_gff3_in_stream_plain_enable_tidy_mode(GtNodeStream *ns)
 {
   GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
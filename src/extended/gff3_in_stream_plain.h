@@ -39,6 +39,7 @@ void          gt_gff3_in_stream_plain_do_not_check_region_boundaries(
                                                           GtGFF3InStreamPlain*);
 void          gt_gff3_in_stream_plain_enable_tidy_mode(GtNodeStream*);
 void          gt_gff3_in_stream_plain_enable_strict_mode(GtNodeStream*);
+void          gt_gff3_in_stream_plain_enable_arena_allocation(GtNodeStream*);
 void          gt_gff3_in_stream_plain_show_progress_bar(GtGFF3InStreamPlain*);
 void          gt_gff3_in_stream_plain_set_type_checker(GtNodeStream*,
                                                        GtTypeChecker*);
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "core/arena.h"
 #include "core/array.h"
 #include "core/assert_api.h"
 #include "core/compat.h"
@@ -26,9 +27,11 @@
 #include "core/hashmap.h"
 #include "core/ma.h"
 #include "core/md5_seqid.h"
+#include "core/multithread_api.h"
 #include "core/parseutils.h"
 #include "core/queue.h"
 #include "core/splitter.h"
+#include "core/str.h"
 #include "core/symbol_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -48,6 +51,45 @@
 #include "extended/region_node.h"
 #include "extended/xrf_checker_api.h"
 
+/* In parallel mode the input is read in batches of at most <GFF3_BATCH_LINES>
+   lines or about <GFF3_BATCH_SIZE> bytes. The feature lines of a batch are
+   tokenized in parallel, each thread takes <GFF3_TOKENIZE_STEP> lines at a
+   time. */
+#define GFF3_BATCH_LINES    16384
+#define GFF3_BATCH_SIZE     (1 << 22)
+#define GFF3_TOKENIZE_STEP  512
+
+/* If arena allocation is enabled, feature nodes are allocated in an arena
+   which is replaced by a new one after <GFF3_ARENA_SIZE> bytes. */
+#define GFF3_ARENA_SIZE     (1 << 18)
+
+/* A line of a batch. If <tokenized> is true, the line is a feature line whose
+   columns have been split and checked, such that parsing them in serial order
+   cannot produce a warning. The attribute column has then been rewritten as
+   <nof_attributes> pairs of '\0'-terminated tags and values. */
+typedef struct {
+  GtUword offset,
+          length,
+          nof_attributes;
+  char *seqid,
+       *source,
+       *type,
+       *attributes;
+  GtRange range;
+  float score_value;
+  GtStrand strand_value;
+  GtPhase phase_value;
+  bool tokenized,
+       score_is_defined;
+} GFF3BatchLine;
+
+typedef struct {
+  GtStr *buffer, /* the '\0'-terminated lines of the batch */
+        *line;
+  GtArray *lines;
+  GtUword next_line;
+} GFF3LineBatch;
+
 struct GtGFF3Parser {
   GtFeatureInfo *feature_info;
   GtHashmap *seqid_to_ssr_mapping, /* maps seqids to simple sequence regions */
@@ -66,6 +108,8 @@ struct GtGFF3Parser {
   GtOrphanage *orphanage;
   GtTypeChecker *type_checker;
   GtXRFChecker *xrf_checker;
+  GFF3LineBatch *batch; /* not NULL in parallel mode */
+  GtArena *arena; /* not NULL if arena allocation is enabled */
   unsigned int last_terminator; /* line number of the last terminator */
 };
 
@@ -96,6 +140,34 @@ static void simple_sequence_region_delete(SimpleSequenceRegion *ssr)
   gt_free(ssr);
 }
 
+static GFF3LineBatch* gff3_line_batch_new(void)
+{
+  GFF3LineBatch *batch = gt_malloc(sizeof *batch);
+  batch->buffer = gt_str_new();
+  batch->line = gt_str_new();
+  batch->lines = gt_array_new(sizeof (GFF3BatchLine));
+  batch->next_line = 0;
+  return batch;
+}
+
+static void gff3_line_batch_reset(GFF3LineBatch *batch)
+{
+  gt_assert(batch);
+  gt_str_reset(batch->buffer);
+  gt_str_reset(batch->line);
+  gt_array_reset(batch->lines);
+  batch->next_line = 0;
+}
+
+static void gff3_line_batch_delete(GFF3LineBatch *batch)
+{
+  if (!batch) return;
+  gt_array_delete(batch->lines);
+  gt_str_delete(batch->line);
+  gt_str_delete(batch->buffer);
+  gt_free(batch);
+}
+
 GtGFF3Parser* gt_gff3_parser_new(GtTypeChecker *type_checker)
 {
   GtGFF3Parser *parser;
@@ -173,6 +245,20 @@ void gt_gff3_parser_enable_strict_mode(GtGFF3Parser *parser)
   parser->strict = true;
 }
 
+void gt_gff3_parser_enable_parallel_mode(GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  if (!parser->batch)
+    parser->batch = gff3_line_batch_new();
+}
+
+void gt_gff3_parser_enable_arena_allocation(GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  if (!parser->arena)
+    parser->arena = gt_arena_new();
+}
+
 void gt_gff3_parser_enable_tidy_mode(GtGFF3Parser *parser)
 {
   gt_assert(parser && !parser->strict);
@@ -1187,6 +1273,182 @@ static bool invalid_uppercase_gvf_attribute(const char *attr_tag)
           strcmp(attr_tag, GT_GVF_ZYGOSITY));
 }
 
+/* Add the attribute <attr_tag>=<attr_value> to <feature_node> and check the
+   attributes which require special care. The values of the ID and Parent
+   attributes are stored in <id_value> and <parent_value> to be processed
+   after all attributes have been added. */
+static int add_attribute(GtGenomeNode *feature_node, char *attr_tag,
+                         char *attr_value, char **id_value,
+                         char **parent_value, GtGFF3Parser *parser,
+                         const char *seqid, const char *filename,
+                         unsigned int line_number, GtError *err)
+{
+  const char *old_value;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* save all attributes, although the Parent and ID attributes are newly
+     created in GFF3 output */
+  if ((old_value = gt_feature_node_get_attribute((GtFeatureNode*)
+                                                 feature_node, attr_tag))) {
+    /* handle duplicate attribute */
+    if (parser->tidy) {
+      GtStr *combined_value;
+      gt_warning("more than one %s attribute on line %u in file \"%s\"; "
+                 "join them", attr_tag, line_number, filename);
+      combined_value = gt_str_new_cstr(old_value);
+      gt_str_append_char(combined_value, ',');
+      gt_str_append_cstr(combined_value, attr_value);
+      gt_feature_node_set_attribute((GtFeatureNode*) feature_node,
+                                    attr_tag, gt_str_get(combined_value));
+      gt_str_delete(combined_value);
+    }
+    else {
+      gt_error_set(err, "more than one %s attribute on line %u in file "
+                        "\"%s\"", attr_tag, line_number, filename);
+      had_err = -1;
+    }
+  }
+  else {
+    gt_feature_node_add_attribute((GtFeatureNode*) feature_node, attr_tag,
+                                  attr_value);
+  }
+  /* some attributes require special care */
+  if (!had_err) {
+    if (!strcmp(attr_tag, GT_GFF_ID))
+      *id_value = attr_value; /* process later */
+    else if (!strcmp(attr_tag, GT_GFF_PARENT))
+      *parent_value = attr_value; /* process later */
+    else if (!strcmp(attr_tag, GT_GFF_IS_CIRCULAR)) {
+      SimpleSequenceRegion *ssr;
+      if (strcmp(attr_value, "true")) {
+        gt_error_set(err, "value \"%s\" of %s attribute on line %u in file "
+                     "\"%s\" does not equal \"true\"", attr_value,
+                     GT_GFF_IS_CIRCULAR, line_number, filename);
+        had_err = -1;
+      }
+      ssr = gt_hashmap_get(parser->seqid_to_ssr_mapping, seqid);
+      gt_assert(ssr); /* XXX */
+      gt_assert(!ssr->is_circular); /* XXX */
+      ssr->is_circular = true;
+    }
+    else if (!strcmp(attr_tag, GT_GFF_TARGET)) {
+      /* the value of ``Target'' attributes have a special syntax which is
+         checked here */
+      had_err = gt_gff3_parser_parse_target_attributes(attr_value, NULL, NULL,
+                                                       NULL, NULL, filename,
+                                                       line_number, err);
+      if (had_err && parser->tidy) {
+        GtStrArray *target_ids;
+        GtArray *target_ranges, *target_strands;
+        /* try to tidy up the ``Target'' attributes */
+        gt_error_unset(err);
+        target_ids = gt_str_array_new();
+        target_ranges = gt_array_new(sizeof (GtRange));
+        target_strands = gt_array_new(sizeof (GtStrand));
+        had_err = gt_gff3_parser_parse_all_target_attributes(attr_value, true,
+                                                             target_ids,
+                                                             target_ranges,
+                                                             target_strands,
+                                                             filename,
+                                                             line_number,
+                                                             err);
+        if (!had_err) {
+          GtStr *new_target = gt_str_new();
+          gt_gff3_parser_build_target_str(new_target, target_ids,
+                                          target_ranges, target_strands);
+          gt_feature_node_set_attribute((GtFeatureNode*) feature_node,
+                                        GT_GFF_TARGET,
+                                        gt_str_get(new_target));
+          gt_str_delete(new_target);
+        }
+        gt_array_delete(target_strands);
+        gt_array_delete(target_ranges);
+        gt_str_array_delete(target_ids);
+      }
+    }
+    else if (!strcmp(attr_tag, GT_GFF_DBXREF)
+               || !strcmp(attr_tag, GT_GFF_ONTOLOGY_TERM)) {
+      if (parser->xrf_checker) {
+        if (!gt_xrf_checker_is_valid(parser->xrf_checker, attr_value, err)) {
+          had_err = -1;
+        }
+      }
+    }
+    else if (parser->type_checker && !strcmp(attr_tag, GT_GFF_GAP)) {
+      GtGapStr *gs = NULL;
+      GtRange rng = gt_genome_node_get_range(feature_node);
+      if (gt_type_checker_is_a(parser->type_checker,
+                               gt_symbol("protein_match"),
+                               gt_feature_node_get_type((GtFeatureNode*)
+                                                        feature_node))) {
+        gs = gt_gap_str_new_protein(attr_value, err);
+      } else {
+        gs = gt_gap_str_new_nucleotide(attr_value, err);
+      }
+      if (!gs) {
+        gt_assert(gt_error_is_set(err));
+        had_err = -1;
+      }
+      if (!had_err) {
+        if (gt_range_length(&rng) != gt_gap_str_length_reference(gs)) {
+          gt_error_set(err, "length of aligned reference in %s attribute on "
+                            "line %u in file \"%s\" (" GT_WU ") does not "
+                            "match the length of its %s feature (" GT_WU ")",
+                       GT_GFF_GAP, line_number, filename,
+                       gt_gap_str_length_reference(gs),
+                       gt_feature_node_get_type((GtFeatureNode*)
+                                                feature_node),
+                       gt_range_length(&rng));
+          had_err = -1;
+        }
+      }
+      gt_gap_str_delete(gs);
+    }
+  }
+  return had_err;
+}
+
+static int process_id_and_parent_attr(GtGenomeNode *feature_node,
+                                      char *id_value, char *parent_value,
+                                      bool *is_child, GtGFF3Parser *parser,
+                                      GtQueue *genome_nodes,
+                                      const char *filename,
+                                      unsigned int line_number, GtError *err)
+{
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* process ID attribute */
+  if (id_value) {
+    had_err = process_id_attr(id_value, (GtFeatureNode*) feature_node, is_child,
+                              parser, genome_nodes, filename, line_number, err);
+  }
+
+  /* we check multi-feature contrains before we process the Parent attribute,
+     because that prevents problems with multi-features with different parents
+     and allows to process multi-features with orphaned parents at the same
+     time. */
+  if (!had_err && gt_feature_node_is_multi((GtFeatureNode*) feature_node)) {
+    had_err =
+      check_multi_feature_constrains(feature_node, (GtGenomeNode*)
+                    gt_feature_node_get_multi_representative((GtFeatureNode*)
+                                                             feature_node),
+                    gt_feature_node_get_attribute((GtFeatureNode*) feature_node,
+                                                  GT_GFF_ID),
+                                     parser, filename, line_number, err);
+  }
+
+  /* finally, process Parent attribute */
+  if (!had_err && parent_value) {
+    had_err = process_parent_attr(parent_value, feature_node, id_value,
+                                  is_child, parser, genome_nodes, filename,
+                                  line_number, err);
+  }
+
+  return had_err;
+}
+
 static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
                             bool *is_child, GtGFF3Parser *parser,
                             const char *seqid, GtQueue *genome_nodes,
@@ -1207,7 +1469,6 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
   gt_splitter_split(attribute_splitter, attributes, strlen(attributes), ';');
 
   for (i = 0; !had_err && i < gt_splitter_size(attribute_splitter); i++) {
-    const char *old_value;
     bool attr_valid = true;
     char *attr_tag = NULL,
          *attr_value = NULL,
@@ -1303,154 +1564,17 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
         }
       }
     }
-    /* save all attributes, although the Parent and ID attributes are newly
-       created in GFF3 output */
     if (!had_err && attr_valid) {
-      if ((old_value = gt_feature_node_get_attribute((GtFeatureNode*)
-                                                     feature_node, attr_tag))) {
-        /* handle duplicate attribute */
-        if (parser->tidy) {
-          GtStr *combined_value;
-          gt_warning("more than one %s attribute on line %u in file \"%s\"; "
-                     "join them", attr_tag, line_number, filename);
-          combined_value = gt_str_new_cstr(old_value);
-          gt_str_append_char(combined_value, ',');
-          gt_str_append_cstr(combined_value, attr_value);
-          gt_feature_node_set_attribute((GtFeatureNode*) feature_node,
-                                        attr_tag, gt_str_get(combined_value));
-          gt_str_delete(combined_value);
-        }
-        else {
-          gt_error_set(err, "more than one %s attribute on line %u in file "
-                            "\"%s\"", attr_tag, line_number, filename);
-          had_err = -1;
-        }
-      }
-      else {
-        gt_feature_node_add_attribute((GtFeatureNode*) feature_node, attr_tag,
-                                      attr_value);
-      }
+      had_err = add_attribute(feature_node, attr_tag, attr_value, &id_value,
+                              &parent_value, parser, seqid, filename,
+                              line_number, err);
     }
-    /* some attributes require special care */
-    if (!had_err && attr_valid) {
-      if (!strcmp(attr_tag, GT_GFF_ID))
-        id_value = attr_value; /* process later */
-      else if (!strcmp(attr_tag, GT_GFF_PARENT))
-        parent_value = attr_value; /* process later */
-      else if (!strcmp(attr_tag, GT_GFF_IS_CIRCULAR)) {
-        SimpleSequenceRegion *ssr;
-        if (strcmp(attr_value, "true")) {
-          gt_error_set(err, "value \"%s\" of %s attribute on line %u in file "
-                       "\"%s\" does not equal \"true\"", attr_value,
-                       GT_GFF_IS_CIRCULAR, line_number, filename);
-          had_err = -1;
-        }
-        ssr = gt_hashmap_get(parser->seqid_to_ssr_mapping, seqid);
-        gt_assert(ssr); /* XXX */
-        gt_assert(!ssr->is_circular); /* XXX */
-        ssr->is_circular = true;
-      }
-      else if (!strcmp(attr_tag, GT_GFF_TARGET)) {
-        /* the value of ``Target'' attributes have a special syntax which is
-           checked here */
-        had_err = gt_gff3_parser_parse_target_attributes(attr_value, NULL, NULL,
-                                                         NULL, NULL, filename,
-                                                         line_number, err);
-        if (had_err && parser->tidy) {
-          GtStrArray *target_ids;
-          GtArray *target_ranges, *target_strands;
-          /* try to tidy up the ``Target'' attributes */
-          gt_error_unset(err);
-          target_ids = gt_str_array_new();
-          target_ranges = gt_array_new(sizeof (GtRange));
-          target_strands = gt_array_new(sizeof (GtStrand));
-          had_err = gt_gff3_parser_parse_all_target_attributes(attr_value, true,
-                                                               target_ids,
-                                                               target_ranges,
-                                                               target_strands,
-                                                               filename,
-                                                               line_number,
-                                                               err);
-          if (!had_err) {
-            GtStr *new_target = gt_str_new();
-            gt_gff3_parser_build_target_str(new_target, target_ids,
-                                            target_ranges, target_strands);
-            gt_feature_node_set_attribute((GtFeatureNode*) feature_node,
-                                          GT_GFF_TARGET,
-                                          gt_str_get(new_target));
-            gt_str_delete(new_target);
-          }
-          gt_array_delete(target_strands);
-          gt_array_delete(target_ranges);
-          gt_str_array_delete(target_ids);
-        }
-      }
-      else if (!strcmp(attr_tag, GT_GFF_DBXREF)
-                 || !strcmp(attr_tag, GT_GFF_ONTOLOGY_TERM)) {
-        if (parser->xrf_checker) {
-          if (!gt_xrf_checker_is_valid(parser->xrf_checker, attr_value, err)) {
-            had_err = -1;
-          }
-        }
-      }
-      else if (parser->type_checker && !strcmp(attr_tag, GT_GFF_GAP)) {
-        GtGapStr *gs = NULL;
-        GtRange rng = gt_genome_node_get_range(feature_node);
-        if (gt_type_checker_is_a(parser->type_checker,
-                                 gt_symbol("protein_match"),
-                                 gt_feature_node_get_type((GtFeatureNode*)
-                                                          feature_node))) {
-          gs = gt_gap_str_new_protein(attr_value, err);
-        } else {
-          gs = gt_gap_str_new_nucleotide(attr_value, err);
-        }
-        if (!gs) {
-          gt_assert(gt_error_is_set(err));
-          had_err = -1;
-        }
-        if (!had_err) {
-          if (gt_range_length(&rng) != gt_gap_str_length_reference(gs)) {
-            gt_error_set(err, "length of aligned reference in %s attribute on "
-                              "line %u in file \"%s\" (" GT_WU ") does not "
-                              "match the length of its %s feature (" GT_WU ")",
-                         GT_GFF_GAP, line_number, filename,
-                         gt_gap_str_length_reference(gs),
-                         gt_feature_node_get_type((GtFeatureNode*)
-                                                  feature_node),
-                         gt_range_length(&rng));
-            had_err = -1;
-          }
-        }
-        gt_gap_str_delete(gs);
-      }
-    }
-  }
-
-  /* process ID attribute */
-  if (!had_err && id_value) {
-    had_err = process_id_attr(id_value, (GtFeatureNode*) feature_node, is_child,
-                              parser, genome_nodes, filename, line_number, err);
-  }
-
-  /* we check multi-feature contrains before we process the Parent attribute,
-     because that prevents problems with multi-features with different parents
-     and allows to process multi-features with orphaned parents at the same
-     time. */
-  if (!had_err && gt_feature_node_is_multi((GtFeatureNode*) feature_node)) {
-    had_err =
-      check_multi_feature_constrains(feature_node, (GtGenomeNode*)
-                    gt_feature_node_get_multi_representative((GtFeatureNode*)
-                                                             feature_node),
-                    gt_feature_node_get_attribute((GtFeatureNode*) feature_node,
-                                                  GT_GFF_ID),
-                                     parser, filename, line_number, err);
   }
 
-  /* finally, process Parent attribute */
-  if (!had_err && parent_value) {
-    had_err = process_parent_attr(parent_value, feature_node, id_value,
-                                  is_child, parser, genome_nodes, filename,
-                                  line_number, err);
+  if (!had_err) {
+    had_err = process_id_and_parent_attr(feature_node, id_value, parent_value,
+                                         is_child, parser, genome_nodes,
+                                         filename, line_number, err);
   }
 
   gt_splitter_delete(parent_splitter);
@@ -1460,6 +1584,35 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
   return had_err;
 }
 
+static int parse_tokenized_attributes(char *attributes,
+                                      GtUword nof_attributes,
+                                      GtGenomeNode *feature_node,
+                                      bool *is_child, GtGFF3Parser *parser,
+                                      const char *seqid, GtQueue *genome_nodes,
+                                      const char *filename,
+                                      unsigned int line_number, GtError *err)
+{
+  char *attr_tag = attributes, *attr_value,
+       *id_value = NULL, *parent_value = NULL;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  for (i = 0; !had_err && i < nof_attributes; i++) {
+    attr_value = attr_tag + strlen(attr_tag) + 1;
+    had_err = add_attribute(feature_node, attr_tag, attr_value, &id_value,
+                            &parent_value, parser, seqid, filename,
+                            line_number, err);
+    attr_tag = attr_value + strlen(attr_value) + 1;
+  }
+  if (!had_err) {
+    had_err = process_id_and_parent_attr(feature_node, id_value, parent_value,
+                                         is_child, parser, genome_nodes,
+                                         filename, line_number, err);
+  }
+  return had_err;
+}
+
 static void set_source(GtFeatureNode *feature_node, const char *source,
                        GtHashmap *source_to_str_mapping)
 {
@@ -1491,11 +1644,13 @@ void chomp_seqid(char *seqid, const char *filename, unsigned int line_number)
 static int parse_gff3_feature_line(GtGFF3Parser *parser,
                                    GtQueue *genome_nodes,
                                    GtCstrTable *used_types, char *line,
-                                   size_t line_length, GtStr *filenamestr,
+                                   size_t line_length,
+                                   const GFF3BatchLine *tokens,
+                                   GtStr *filenamestr,
                                    unsigned int line_number, GtError *err)
 {
   GtGenomeNode *gn = NULL, *feature_node = NULL;
-  GtSplitter *splitter;
+  GtSplitter *splitter = NULL;
   GtStr *seqid_str = NULL;
   GtStrand gt_strand_value;
   float score_value;
@@ -1503,7 +1658,7 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
   GtRange range;
   char *seqid = NULL, *source = NULL, *type = NULL, *start = NULL,
        *end = NULL, *score = NULL, *strand = NULL, *phase = NULL,
-       *attributes = NULL, **tokens;
+       *attributes = NULL, **fields;
   const char *filename;
   bool score_is_defined, is_child = false;
   int had_err = 0;
@@ -1512,12 +1667,25 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   filename = gt_str_get(filenamestr);
 
-  /* create splitter */
-  splitter = gt_splitter_new();
-
-  /* parse */
-  gt_splitter_split(splitter, line, line_length, '\t');
-  if (gt_splitter_size(splitter) != 9) {
+  if (tokens) {
+    /* the line has been split and checked by the batch tokenizer */
+    seqid      = tokens->seqid;
+    source     = tokens->source;
+    type       = tokens->type;
+    attributes = tokens->attributes;
+    range = tokens->range;
+    score_is_defined = tokens->score_is_defined;
+    score_value = tokens->score_value;
+    gt_strand_value = tokens->strand_value;
+    phase_value = tokens->phase_value;
+  }
+  else {
+    /* create splitter */
+    splitter = gt_splitter_new();
+    /* parse */
+    gt_splitter_split(splitter, line, line_length, '\t');
+  }
+  if (!tokens && gt_splitter_size(splitter) != 9) {
     if (parser->tidy && gt_splitter_size(splitter) == 10) {
       gt_warning("line %u in file \"%s\" does not contain 9 tab (\\t) "
                  "separated fields, dropping 10th field",
@@ -1529,20 +1697,21 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
       had_err = -1;
     }
   }
-  if (!had_err) {
-    tokens = gt_splitter_get_tokens(splitter);
-    seqid      = tokens[0];
-    source     = tokens[1];
-    type       = tokens[2];
-    start      = tokens[3];
-    end        = tokens[4];
-    score      = tokens[5];
-    strand     = tokens[6];
-    phase      = tokens[7];
-    attributes = tokens[8];
-  }
-
-  if (!had_err && parser->tidy && (start[0] == '.' || end[0] == '.')) {
+  if (!had_err && !tokens) {
+    fields = gt_splitter_get_tokens(splitter);
+    seqid      = fields[0];
+    source     = fields[1];
+    type       = fields[2];
+    start      = fields[3];
+    end        = fields[4];
+    score      = fields[5];
+    strand     = fields[6];
+    phase      = fields[7];
+    attributes = fields[8];
+  }
+
+  if (!had_err && !tokens && parser->tidy &&
+      (start[0] == '.' || end[0] == '.')) {
     gt_warning("feature \"%s\" on line %u in file \"%s\" has undefined "
                "range, discarding feature", type, line_number, filename);
     gt_splitter_delete(splitter);
@@ -1562,7 +1731,7 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
   }
 
   /* parse the range */
-  if (!had_err) {
+  if (!had_err && !tokens) {
     if (parser->strict)
       had_err = gt_parse_range(&range, start, end, line_number, filename, err);
     else if (parser->tidy) {
@@ -1585,22 +1754,22 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
   }
 
   /* parse the score */
-  if (!had_err) {
+  if (!had_err && !tokens) {
     had_err = gt_parse_score(&score_is_defined, &score_value, score,
                              line_number, filename, err);
   }
 
   /* parse the strand */
-  if (!had_err) {
+  if (!had_err && !tokens) {
     had_err = gt_parse_strand(&gt_strand_value, strand, line_number, filename,
                               err);
   }
 
   /* parse the phase */
-  if (!had_err)
+  if (!had_err && !tokens)
     had_err = gt_parse_phase(&phase_value, phase, line_number, filename, err);
 
-  if (!had_err)
+  if (!had_err && !tokens)
     chomp_seqid(seqid, filename, line_number);
 
   /* get seqid */
@@ -1614,8 +1783,20 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   /* create the feature */
   if (!had_err) {
-    feature_node = gt_feature_node_new(seqid_str, type, range.start, range.end,
-                                       gt_strand_value);
+    if (parser->arena) {
+      if (gt_arena_size(parser->arena) >= GFF3_ARENA_SIZE) {
+        /* the nodes in the full arena keep it alive as long as necessary */
+        gt_arena_delete(parser->arena);
+        parser->arena = gt_arena_new();
+      }
+      feature_node = gt_feature_node_new_in_arena(parser->arena, seqid_str,
+                                                  type, range.start, range.end,
+                                                  gt_strand_value);
+    }
+    else {
+      feature_node = gt_feature_node_new(seqid_str, type, range.start,
+                                         range.end, gt_strand_value);
+    }
     gt_genome_node_set_origin(feature_node, filenamestr, line_number);
   }
 
@@ -1626,7 +1807,13 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
   }
 
   /* parse the attributes */
-  if (!had_err) {
+  if (!had_err && tokens) {
+    had_err = parse_tokenized_attributes(attributes, tokens->nof_attributes,
+                                         feature_node, &is_child, parser,
+                                         seqid, genome_nodes, filename,
+                                         line_number, err);
+  }
+  else if (!had_err) {
     had_err = parse_attributes(attributes, feature_node, &is_child, parser,
                                seqid, genome_nodes, filename, line_number, err);
   }
@@ -2102,6 +2289,231 @@ static int parse_meta_gff3_line(GtGFF3Parser *parser, GtQueue *genome_nodes,
   return had_err;
 }
 
+/* Parse the coordinate <str> if it consists of digits only and is short
+   enough to fit into a <GtWord>. */
+static bool gff3_line_batch_parse_coordinate(GtUword *value, const char *str)
+{
+  const GtUword maxdigits = sizeof (GtWord) == (size_t) 8 ? 18UL : 9UL;
+  GtUword i, val = 0;
+  for (i = 0; isdigit((unsigned char) str[i]); i++) {
+    if (i == maxdigits)
+      return false;
+    val = val * 10 + (str[i] - '0');
+  }
+  if (i == 0 || str[i] != '\0')
+    return false;
+  *value = val;
+  return true;
+}
+
+/* Split the attribute column <attributes> into tag/value pairs stored in
+   <pairs>, the same way <parse_attributes()> does. Returns false if this
+   would produce a warning or an error. */
+static bool gff3_line_batch_split_attributes(GtStr *pairs,
+                                             GtUword *nof_attributes,
+                                             const char *attributes)
+{
+  const char *token = attributes, *end, *equal, *tag;
+  GtUword i, tagoffset;
+
+  gt_str_reset(pairs);
+  *nof_attributes = 0;
+  if (attributes[0] == '.' && !strchr(attributes, ';'))
+    return true; /* no attributes to parse */
+  for (;;) {
+    if (!(end = strchr(token, ';')))
+      end = token + strlen(token);
+    if (token[0] == '.')
+      return false;
+    for (tag = token; tag < end && *tag == ' '; tag++)
+      /* Nothing */;
+    if (tag < end) {
+      if (!(equal = memchr(token, '=', end - token))
+          || memchr(equal + 1, '=', end - equal - 1)
+          || tag == equal || equal + 1 == end) {
+        return false;
+      }
+      tagoffset = gt_str_length(pairs);
+      gt_str_append_cstr_nt(pairs, tag, equal - tag);
+      gt_str_append_char(pairs, '\0');
+      if (isupper((unsigned char) tag[0])
+          && invalid_uppercase_gff3_attribute(gt_str_get(pairs) + tagoffset)) {
+        return false;
+      }
+      gt_str_append_cstr_nt(pairs, equal + 1, end - equal - 1);
+      gt_str_append_char(pairs, '\0');
+      (*nof_attributes)++;
+    }
+    if (*end == '\0')
+      break;
+    token = end + 1;
+  }
+  /* a duplicate attribute is reported or joined in serial order */
+  tag = gt_str_get(pairs);
+  for (i = 0; i < *nof_attributes; i++) {
+    const char *other = tag + strlen(tag) + 1;
+    GtUword j;
+    other += strlen(other) + 1;
+    for (j = i + 1; j < *nof_attributes; j++) {
+      if (!strcmp(tag, other))
+        return false;
+      other += strlen(other) + 1;
+      other += strlen(other) + 1;
+    }
+    tag += strlen(tag) + 1;
+    tag += strlen(tag) + 1;
+  }
+  return true;
+}
+
+/* Tokenize the batch line <bl> stored in <line>. The line is only marked as
+   tokenized (and modified) if parsing it would not produce any warning, so
+   that all messages are still produced in the order of the input. */
+static void gff3_line_batch_tokenize_line(GFF3BatchLine *bl, char *line,
+                                          GtStr *pairs)
+{
+  char *fields[9];
+  GtUword i, nof_fields = 1, start, end;
+  bool ok;
+
+  bl->tokenized = false;
+  if (bl->length == 0 || line[0] == '#' || line[0] == '>')
+    return;
+  fields[0] = line;
+  for (i = 0; i < bl->length; i++) {
+    if (line[i] == '\t') {
+      if (nof_fields == 9)
+        return;
+      fields[nof_fields++] = line + i + 1;
+    }
+    else if (line[i] == '\0')
+      return;
+  }
+  if (nof_fields != 9)
+    return;
+  for (i = 1; i < 9; i++)
+    fields[i][-1] = '\0';
+
+  ok = gff3_line_batch_parse_coordinate(&start, fields[3])
+       && gff3_line_batch_parse_coordinate(&end, fields[4])
+       && start > 0 && start <= end;
+  if (ok && fields[0][0] != '\0')
+    ok = fields[0][strlen(fields[0]) - 1] != ' '; /* see chomp_seqid() */
+  if (ok) {
+    if (!strcmp(fields[5], "."))
+      bl->score_is_defined = false;
+    else if (sscanf(fields[5], "%f", &bl->score_value) == 1)
+      bl->score_is_defined = true;
+    else
+      ok = false;
+  }
+  ok = ok && strlen(fields[6]) == 1
+          && strspn(fields[6], GT_STRAND_CHARS) == 1
+          && strlen(fields[7]) == 1
+          && strspn(fields[7], GT_PHASE_CHARS) == 1
+          && gff3_line_batch_split_attributes(pairs, &bl->nof_attributes,
+                                              fields[8]);
+  if (!ok) {
+    /* leave the line to the serial parser */
+    for (i = 1; i < 9; i++)
+      fields[i][-1] = '\t';
+    return;
+  }
+  gt_assert(gt_str_length(pairs) <= strlen(fields[8]) + 1);
+  memcpy(fields[8], gt_str_get(pairs), gt_str_length(pairs));
+  bl->seqid = fields[0];
+  bl->source = fields[1];
+  bl->type = fields[2];
+  bl->attributes = fields[8];
+  bl->range.start = start;
+  bl->range.end = end;
+  bl->strand_value = gt_strand_get(fields[6][0]);
+  bl->phase_value = gt_phase_get(fields[7][0]);
+  bl->tokenized = true;
+}
+
+typedef struct {
+  GFF3LineBatch *batch;
+  GtMutex *mutex;
+  GtUword next_line;
+} GFF3TokenizeInfo;
+
+static void* gff3_line_batch_tokenize_thread(void *data)
+{
+  GFF3TokenizeInfo *info = data;
+  GtUword nof_lines = gt_array_size(info->batch->lines), idx, start;
+  char *buffer = gt_str_get(info->batch->buffer);
+  GtStr *pairs = gt_str_new();
+
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    start = info->next_line;
+    info->next_line += GFF3_TOKENIZE_STEP;
+    gt_mutex_unlock(info->mutex);
+    if (start >= nof_lines)
+      break;
+    for (idx = start; idx < nof_lines && idx < start + GFF3_TOKENIZE_STEP;
+         idx++) {
+      GFF3BatchLine *bl = gt_array_get(info->batch->lines, idx);
+      gff3_line_batch_tokenize_line(bl, buffer + bl->offset, pairs);
+    }
+  }
+  gt_str_delete(pairs);
+  return NULL;
+}
+
+/* Read the next batch of lines from <fpin> and tokenize them in parallel. A
+   batch ends after a line which starts the FASTA section or a FASTA entry,
+   because the sequences are read directly from <fpin>. The first line of a
+   file (<first_line> is true) is left to <parse_first_gff3_line()>. */
+static int gff3_line_batch_fill(GFF3LineBatch *batch, GtFile *fpin,
+                                bool fasta_parsing, bool first_line,
+                                GtError *err)
+{
+  GFF3TokenizeInfo info;
+  int had_err = 0;
+  gt_error_check(err);
+
+  gff3_line_batch_reset(batch);
+  while (gt_array_size(batch->lines) < GFF3_BATCH_LINES
+         && gt_str_length(batch->buffer) < GFF3_BATCH_SIZE
+         && gt_str_read_next_line_generic(batch->line, fpin) != EOF) {
+    GFF3BatchLine bl;
+    const char *line = gt_str_get(batch->line);
+    bool last = fasta_parsing || line[0] == '>'
+                || !strcmp(line, GT_GFF_FASTA_DIRECTIVE);
+    bl.offset = gt_str_length(batch->buffer);
+    bl.length = gt_str_length(batch->line);
+    bl.tokenized = false;
+    gt_str_append_str(batch->buffer, batch->line);
+    gt_str_append_char(batch->buffer, '\0');
+    gt_array_add(batch->lines, bl);
+    gt_str_reset(batch->line);
+    if (last)
+      break;
+  }
+
+  info.batch = batch;
+  info.next_line = first_line ? 1 : 0;
+  if (gt_array_size(batch->lines) < info.next_line + GFF3_TOKENIZE_STEP) {
+    /* not worth starting threads */
+    GtStr *pairs = gt_str_new();
+    GtUword idx;
+    for (idx = info.next_line; idx < gt_array_size(batch->lines); idx++) {
+      GFF3BatchLine *bl = gt_array_get(batch->lines, idx);
+      gff3_line_batch_tokenize_line(bl, gt_str_get(batch->buffer) + bl->offset,
+                                    pairs);
+    }
+    gt_str_delete(pairs);
+  }
+  else {
+    info.mutex = gt_mutex_new();
+    had_err = gt_multithread(gff3_line_batch_tokenize_thread, &info, err);
+    gt_mutex_delete(info.mutex);
+  }
+  return had_err;
+}
+
 int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
                                       GtQueue *genome_nodes,
                                       GtCstrTable *used_types,
@@ -2113,7 +2525,7 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   GtStr *line_buffer;
   char *line;
   const char *filename;
-  int rval, had_err = 0;
+  int rval = 0, had_err = 0;
 
   gt_error_check(err);
   gt_assert(status_code && genome_nodes && used_types);
@@ -2123,9 +2535,30 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   /* init */
   line_buffer = gt_str_new();
 
-  while ((rval = gt_str_read_next_line_generic(line_buffer, fpin)) != EOF) {
-    line = gt_str_get(line_buffer);
-    line_length = gt_str_length(line_buffer);
+  for (;;) {
+    GFF3BatchLine *bl = NULL;
+    if (parser->batch) {
+      GFF3LineBatch *batch = parser->batch;
+      if (batch->next_line == gt_array_size(batch->lines)) {
+        had_err = gff3_line_batch_fill(batch, fpin, parser->fasta_parsing,
+                                       *line_number == 0, err);
+        if (had_err)
+          break;
+        if (gt_array_size(batch->lines) == 0) {
+          rval = EOF;
+          break;
+        }
+      }
+      bl = gt_array_get(batch->lines, batch->next_line++);
+      line = gt_str_get(batch->buffer) + bl->offset;
+      line_length = bl->length;
+    }
+    else {
+      if ((rval = gt_str_read_next_line_generic(line_buffer, fpin)) == EOF)
+        break;
+      line = gt_str_get(line_buffer);
+      line_length = gt_str_length(line_buffer);
+    }
     (*line_number)++;
 
     if (*line_number == 1) {
@@ -2161,8 +2594,9 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
     }
     else {
       had_err = parse_gff3_feature_line(parser, genome_nodes, used_types, line,
-                                        line_length, filenamestr, *line_number,
-                                        err);
+                                        line_length,
+                                        bl && bl->tokenized ? bl : NULL,
+                                        filenamestr, *line_number, err);
       if (had_err || (!parser->incomplete_node && gt_queue_size(genome_nodes)))
         break;
     }
@@ -2212,6 +2646,8 @@ void gt_gff3_parser_reset(GtGFF3Parser *parser)
   gt_hashmap_reset(parser->seqid_to_ssr_mapping);
   gt_hashmap_reset(parser->source_to_str_mapping);
   gt_orphanage_reset(parser->orphanage);
+  if (parser->batch)
+    gff3_line_batch_reset(parser->batch);
   parser->last_terminator = 0;
 }
 
@@ -2225,5 +2661,7 @@ void gt_gff3_parser_delete(GtGFF3Parser *parser)
   gt_orphanage_delete(parser->orphanage);
   gt_type_checker_delete(parser->type_checker);
   gt_xrf_checker_delete(parser->xrf_checker);
+  gff3_line_batch_delete(parser->batch);
+  gt_arena_delete(parser->arena);
   gt_free(parser);
 }
@@ -21,6 +21,16 @@
 #include "extended/gff3_parser_api.h"
 
 void gt_gff3_parser_enable_strict_mode(GtGFF3Parser*);
+/* Read the input in batches of lines and tokenize the feature lines of a batch
+   on <gt_jobs> threads. The nodes are still built in the order of the input.
+   The input must not be read otherwise between two calls of
+   <gt_gff3_parser_parse_genome_nodes()>. */
+void gt_gff3_parser_enable_parallel_mode(GtGFF3Parser*);
+/* Allocate the feature nodes together with their attributes and lists of
+   children in arenas of a few hundred kilobytes, instead of allocating each of
+   them separately. An arena is freed when all nodes allocated in it have been
+   deleted. */
+void gt_gff3_parser_enable_arena_allocation(GtGFF3Parser*);
 int  gt_gff3_parser_set_offsetfile(GtGFF3Parser*, GtStr*, GtError*);
 int  gt_gff3_parser_parse_target_attributes(const char *values,
                                             GtUword *num_of_targets,
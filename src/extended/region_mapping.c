@@ -309,8 +309,12 @@ int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
       }
       if (!had_err) {
         GtUword seqstartpos;
+        GtRange extractrange;
         *seq = gt_calloc(end - start + 1, sizeof (char));
         seqstartpos = gt_encseq_seqstartpos(rm->encseq, seqno);
+        extractrange.start = seqstartpos + start - 1;
+        extractrange.end = seqstartpos + end - 1;
+        gt_encseq_prefetch(rm->encseq, &extractrange, 1UL);
         gt_encseq_extract_decoded(rm->encseq, *seq, seqstartpos + start - 1,
                                   seqstartpos + end - 1);
       }
@@ -219,6 +219,10 @@ GtRegionMapping* gt_seqid2file_region_mapping_new(GtSeqid2FileInfo *s2fi,
     if (!encseq)
       rm = NULL;
     else {
+      /* the encoded sequence is only used by the region mapping, which
+         extracts features in the order of the annotation, hence reading
+         ahead beyond the extracted ranges is useless */
+      gt_encseq_set_access_pattern(encseq, GT_ENCSEQ_ACCESS_RANDOM);
       rm = gt_region_mapping_new_encseq(encseq, s2fi->matchdesc,
                                         s2fi->usedesc);
       gt_encseq_delete(encseq);
@@ -15,25 +15,426 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/array.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/queue_api.h"
+#include "core/undef_api.h"
+#include "core/xansi_api.h"
+#include "extended/comment_node_api.h"
 #include "extended/eof_node_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
+#include "extended/genome_node_rep.h"
+#include "extended/meta_node_api.h"
 #include "extended/node_stream_api.h"
+#include "extended/priority_queue.h"
+#include "extended/region_node_api.h"
+#include "extended/sequence_node_api.h"
 #include "extended/sort_stream.h"
 
+/* The estimated memory consumption of a single node, without its attributes
+   and sequence. */
+#define SORT_STREAM_NODE_SIZE  256
+
+/* Whenever this many run files of the same generation exist, they are merged
+   into a single run of the next generation. Hence every node is rewritten only
+   a logarithmic number of times and the number of open files stays small. */
+#define SORT_STREAM_MERGE_RUNS 32
+
+/* Kinds of records in a run file. A node which cannot be serialized stays in
+   memory, its place in the run is marked by a <SORT_STREAM_RESIDENT> record. */
+typedef enum {
+  SORT_STREAM_FEATURE,
+  SORT_STREAM_REGION,
+  SORT_STREAM_COMMENT,
+  SORT_STREAM_META,
+  SORT_STREAM_SEQUENCE,
+  SORT_STREAM_RESIDENT
+} SortStreamRecordKind;
+
+/* A sorted run of nodes. Runs are kept in the order of the input, during a
+   merge the <number> of a run decides between equal nodes from different
+   runs. The generation of a run is the number of merges its nodes went
+   through. */
+typedef struct {
+  FILE *fp; /* <NULL> for the last run, which is kept in <nodes> */
+  GtQueue *resident;
+  GtGenomeNode *gn; /* the current node of the run */
+  GtUword number,
+          generation;
+} SortStreamRun;
+
 struct GtSortStream {
   const GtNodeStream parent_instance;
   GtNodeStream *in_stream;
-  GtUword idx;
-  GtArray *nodes;
+  GtUword idx,
+          memlimit, /* 0 if all nodes are sorted in memory */
+          memused,
+          record_size;
+  GtArray *nodes,
+          *runs; /* not empty if nodes have been written to run files */
+  GtPriorityQueue *pq;
+  GtGenomeNode *next_node; /* read ahead while joining region nodes */
+  GtStr *buffer;
+  char *record;
   bool sorted;
 };
 
 #define gt_sort_stream_cast(GS)\
         gt_node_stream_cast(gt_sort_stream_class(), GS);
 
+static void add_attribute_size(const char *tag, const char *value, void *data)
+{
+  GtUword *size = data;
+  *size += strlen(tag) + strlen(value) + 2;
+}
+
+static GtUword sort_stream_node_size(GtGenomeNode *gn)
+{
+  GtFeatureNode *fn;
+  GtSequenceNode *sn;
+  GtUword size = 0;
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    GtFeatureNodeIterator *fni = gt_feature_node_iterator_new(fn);
+    while ((fn = gt_feature_node_iterator_next(fni))) {
+      size += SORT_STREAM_NODE_SIZE;
+      gt_feature_node_foreach_attribute(fn, add_attribute_size, &size);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn))) {
+    size = SORT_STREAM_NODE_SIZE + gt_sequence_node_get_sequence_length(sn)
+           + strlen(gt_sequence_node_get_description(sn));
+  }
+  else
+    size = SORT_STREAM_NODE_SIZE;
+  return size;
+}
+
+static void sort_stream_write_uword(GtStr *buffer, GtUword value)
+{
+  gt_str_append_cstr_nt(buffer, (const char*) &value, sizeof value);
+}
+
+static GtUword sort_stream_read_uword(const char **data)
+{
+  GtUword value;
+  memcpy(&value, *data, sizeof value);
+  *data += sizeof value;
+  return value;
+}
+
+/* strings are stored with their terminator, <NULL> as <GT_UNDEF_UWORD> */
+static void sort_stream_write_cstr(GtStr *buffer, const char *cstr)
+{
+  if (cstr) {
+    GtUword length = strlen(cstr);
+    sort_stream_write_uword(buffer, length);
+    gt_str_append_cstr_nt(buffer, cstr, length + 1);
+  }
+  else
+    sort_stream_write_uword(buffer, GT_UNDEF_UWORD);
+}
+
+static const char* sort_stream_read_cstr(const char **data)
+{
+  const char *cstr;
+  GtUword length = sort_stream_read_uword(data);
+  if (length == GT_UNDEF_UWORD)
+    return NULL;
+  cstr = *data;
+  *data += length + 1;
+  return cstr;
+}
+
+/* Append the record for <gn> to <buffer>. Return <false> if <gn> has to be
+   kept in memory. */
+static bool sort_stream_serialize(GtGenomeNode *gn, GtStr *buffer)
+{
+  GtFeatureNode *fn;
+  GtCommentNode *cn;
+  GtMetaNode *mn;
+  GtSequenceNode *sn;
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    gt_str_append_char(buffer, SORT_STREAM_FEATURE);
+    if (gt_feature_node_serialize(fn, buffer))
+      return true;
+    gt_str_reset(buffer);
+    return false;
+  }
+  if (gt_region_node_try_cast(gn)) {
+    GtRange range = gt_genome_node_get_range(gn);
+    gt_str_append_char(buffer, SORT_STREAM_REGION);
+    sort_stream_write_cstr(buffer, gt_str_get(gt_genome_node_get_seqid(gn)));
+    sort_stream_write_uword(buffer, range.start);
+    sort_stream_write_uword(buffer, range.end);
+  }
+  else if ((cn = gt_comment_node_try_cast(gn))) {
+    gt_str_append_char(buffer, SORT_STREAM_COMMENT);
+    sort_stream_write_cstr(buffer, gt_comment_node_get_comment(cn));
+  }
+  else if ((mn = gt_meta_node_try_cast(gn))) {
+    gt_str_append_char(buffer, SORT_STREAM_META);
+    sort_stream_write_cstr(buffer, gt_meta_node_get_directive(mn));
+    sort_stream_write_cstr(buffer, gt_meta_node_get_data(mn));
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn))) {
+    gt_str_append_char(buffer, SORT_STREAM_SEQUENCE);
+    sort_stream_write_cstr(buffer, gt_sequence_node_get_description(sn));
+    sort_stream_write_cstr(buffer, gt_sequence_node_get_sequence(sn));
+  }
+  else
+    return false;
+  sort_stream_write_cstr(buffer, gn->filename ? gt_str_get(gn->filename)
+                                              : NULL);
+  sort_stream_write_uword(buffer, gn->line_number);
+  return true;
+}
+
+static GtGenomeNode* sort_stream_deserialize(const char *data)
+{
+  GtGenomeNode *gn;
+  const char *filename;
+  GtUword line_number;
+  switch (*data++) {
+    case SORT_STREAM_FEATURE:
+      return gt_feature_node_deserialize(&data);
+    case SORT_STREAM_REGION: {
+      GtStr *seqid = gt_str_new_cstr(sort_stream_read_cstr(&data));
+      GtUword start = sort_stream_read_uword(&data);
+      gn = gt_region_node_new(seqid, start, sort_stream_read_uword(&data));
+      gt_str_delete(seqid);
+      break;
+    }
+    case SORT_STREAM_COMMENT:
+      gn = gt_comment_node_new(sort_stream_read_cstr(&data));
+      break;
+    case SORT_STREAM_META: {
+      const char *directive = sort_stream_read_cstr(&data);
+      gn = gt_meta_node_new(directive, sort_stream_read_cstr(&data));
+      break;
+    }
+    case SORT_STREAM_SEQUENCE: {
+      const char *description = sort_stream_read_cstr(&data);
+      GtStr *sequence = gt_str_new_cstr(sort_stream_read_cstr(&data));
+      gn = gt_sequence_node_new(description, sequence);
+      gt_str_delete(sequence);
+      break;
+    }
+    default:
+      gt_assert(false);
+      return NULL;
+  }
+  filename = sort_stream_read_cstr(&data);
+  line_number = sort_stream_read_uword(&data);
+  if (filename) {
+    GtStr *filenamestr = gt_str_new_cstr(filename);
+    gt_genome_node_set_origin(gn, filenamestr, line_number);
+    gt_str_delete(filenamestr);
+  }
+  return gn;
+}
+
+static void sort_stream_run_init(SortStreamRun *run, GtUword generation)
+{
+  run->fp = gt_xtmpfp_generic(NULL, TMPFP_AUTOREMOVE | TMPFP_OPENBINARY);
+  run->resident = gt_queue_new();
+  run->gn = NULL;
+  run->number = 0;
+  run->generation = generation;
+}
+
+/* Append <gn> to <run>. <gn> is deleted unless it has to be kept in memory. */
+static void sort_stream_run_write(GtSortStream *sort_stream,
+                                  SortStreamRun *run, GtGenomeNode *gn)
+{
+  GtUword length;
+  gt_str_reset(sort_stream->buffer);
+  if (sort_stream_serialize(gn, sort_stream->buffer))
+    gt_genome_node_delete(gn);
+  else {
+    gt_str_append_char(sort_stream->buffer, SORT_STREAM_RESIDENT);
+    gt_queue_add(run->resident, gn);
+  }
+  length = gt_str_length(sort_stream->buffer);
+  gt_xfwrite_one(&length, run->fp);
+  gt_xfwrite(gt_str_get(sort_stream->buffer), 1, length, run->fp);
+}
+
+static void sort_stream_run_rewind(SortStreamRun *run)
+{
+  gt_xfflush(run->fp);
+  gt_xfseek(run->fp, 0, SEEK_SET);
+}
+
+static void sort_stream_run_delete(SortStreamRun *run)
+{
+  gt_genome_node_delete(run->gn);
+  if (run->fp) {
+    while (gt_queue_size(run->resident))
+      gt_genome_node_delete(gt_queue_get(run->resident));
+    gt_queue_delete(run->resident);
+    gt_fa_xfclose(run->fp);
+  }
+}
+
+/* Set the current node of <run> to its next node, or to <NULL> at its end. */
+static void sort_stream_run_advance(GtSortStream *sort_stream,
+                                    SortStreamRun *run)
+{
+  GtUword length;
+  run->gn = NULL;
+  if (!run->fp) {
+    if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
+      run->gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
+                                               sort_stream->idx);
+      sort_stream->idx++;
+    }
+  }
+  else if (fread(&length, sizeof length, 1, run->fp) == 1) {
+    if (length > sort_stream->record_size) {
+      sort_stream->record = gt_realloc(sort_stream->record, length);
+      sort_stream->record_size = length;
+    }
+    gt_xfread(sort_stream->record, 1, length, run->fp);
+    if (*sort_stream->record == SORT_STREAM_RESIDENT)
+      run->gn = gt_queue_get(run->resident);
+    else
+      run->gn = sort_stream_deserialize(sort_stream->record);
+  }
+}
+
+static int sort_stream_run_compare(const void *a, const void *b)
+{
+  const SortStreamRun *run_a = a, *run_b = b;
+  int rval = gt_genome_node_cmp(run_a->gn, run_b->gn);
+  if (!rval) {
+    /* keep equal nodes in the order of the input */
+    rval = run_a->number < run_b->number ? -1 : 1;
+  }
+  return rval;
+}
+
+/* Merge the runs from index <first> on, starting with their current nodes. */
+static void sort_stream_start_merge(GtSortStream *sort_stream, GtUword first)
+{
+  GtUword i, nof_runs = gt_array_size(sort_stream->runs);
+  sort_stream->pq = gt_priority_queue_new(sort_stream_run_compare,
+                                          nof_runs - first);
+  for (i = first; i < nof_runs; i++) {
+    SortStreamRun *run = gt_array_get(sort_stream->runs, i);
+    run->number = i;
+    sort_stream_run_advance(sort_stream, run);
+    if (run->gn)
+      gt_priority_queue_add(sort_stream->pq, run);
+  }
+}
+
+static GtUword sort_stream_run_generation(const GtSortStream *sort_stream,
+                                         GtUword idx)
+{
+  return ((SortStreamRun*) gt_array_get(sort_stream->runs, idx))->generation;
+}
+
+/* Replace the run files from index <first> on by a single one of the next
+   generation. */
+static void sort_stream_merge_runs(GtSortStream *sort_stream, GtUword first)
+{
+  SortStreamRun merged;
+  GtUword i;
+  sort_stream_run_init(&merged,
+                       sort_stream_run_generation(sort_stream, first) + 1);
+  sort_stream_start_merge(sort_stream, first);
+  while (!gt_priority_queue_is_empty(sort_stream->pq)) {
+    SortStreamRun *run = gt_priority_queue_extract_min(sort_stream->pq);
+    sort_stream_run_write(sort_stream, &merged, run->gn);
+    sort_stream_run_advance(sort_stream, run);
+    if (run->gn)
+      gt_priority_queue_add(sort_stream->pq, run);
+  }
+  gt_priority_queue_delete(sort_stream->pq);
+  sort_stream->pq = NULL;
+  for (i = first; i < gt_array_size(sort_stream->runs); i++)
+    sort_stream_run_delete(gt_array_get(sort_stream->runs, i));
+  gt_array_set_size(sort_stream->runs, first);
+  sort_stream_run_rewind(&merged);
+  gt_array_add(sort_stream->runs, merged);
+}
+
+/* Sort the nodes read so far and write them to a new run file. */
+static void sort_stream_write_run(GtSortStream *sort_stream)
+{
+  SortStreamRun run;
+  GtUword i, nof_runs;
+  sort_stream_run_init(&run, 0);
+  gt_genome_nodes_sort_stable(sort_stream->nodes);
+  for (i = 0; i < gt_array_size(sort_stream->nodes); i++) {
+    sort_stream_run_write(sort_stream, &run,
+                          *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
+                                                         i));
+  }
+  sort_stream_run_rewind(&run);
+  gt_array_add(sort_stream->runs, run);
+  gt_array_reset(sort_stream->nodes);
+  sort_stream->memused = 0;
+  /* merge the last runs while they are of the same generation, the
+     generations do not increase from one run to the next */
+  while ((nof_runs = gt_array_size(sort_stream->runs))
+           >= SORT_STREAM_MERGE_RUNS
+         && sort_stream_run_generation(sort_stream,
+                                       nof_runs - SORT_STREAM_MERGE_RUNS)
+            == sort_stream_run_generation(sort_stream, nof_runs - 1)) {
+    sort_stream_merge_runs(sort_stream, nof_runs - SORT_STREAM_MERGE_RUNS);
+  }
+}
+
+/* Sort the remaining nodes and prepare the merge, if there are run files. */
+static void sort_stream_finish_input(GtSortStream *sort_stream)
+{
+  gt_genome_nodes_sort_stable(sort_stream->nodes);
+  if (!gt_array_size(sort_stream->runs))
+    return;
+  if (gt_array_size(sort_stream->nodes)) {
+    SortStreamRun run;
+    run.fp = NULL;
+    run.resident = NULL;
+    run.gn = NULL;
+    run.generation = 0;
+    gt_array_add(sort_stream->runs, run);
+  }
+  sort_stream_start_merge(sort_stream, 0);
+}
+
+/* Return the next node in sorted order, or <NULL>. */
+static GtGenomeNode* sort_stream_next_sorted(GtSortStream *sort_stream)
+{
+  GtGenomeNode *gn = NULL;
+  if (sort_stream->next_node) {
+    gn = sort_stream->next_node;
+    sort_stream->next_node = NULL;
+  }
+  else if (!sort_stream->pq) {
+    if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
+      gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
+                                          sort_stream->idx);
+      sort_stream->idx++;
+    }
+  }
+  else if (!gt_priority_queue_is_empty(sort_stream->pq)) {
+    SortStreamRun *run = gt_priority_queue_extract_min(sort_stream->pq);
+    gn = run->gn;
+    sort_stream_run_advance(sort_stream, run);
+    if (run->gn)
+      gt_priority_queue_add(sort_stream->pq, run);
+  }
+  return gn;
+}
+
 static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                GtError *err)
 {
@@ -49,31 +450,33 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                            err)) && node) {
       if ((eofn = gt_eof_node_try_cast(node)))
         gt_genome_node_delete(node); /* get rid of EOF nodes */
-      else
+      else {
         gt_array_add(sort_stream->nodes, node);
+        if (sort_stream->memlimit) {
+          sort_stream->memused += sort_stream_node_size(node);
+          if (sort_stream->memused >= sort_stream->memlimit)
+            sort_stream_write_run(sort_stream);
+        }
+      }
     }
     if (!had_err) {
-      gt_genome_nodes_sort_stable(sort_stream->nodes);
+      sort_stream_finish_input(sort_stream);
       sort_stream->sorted = true;
     }
   }
 
   if (!had_err) {
     gt_assert(sort_stream->sorted);
-    if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-      *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                           sort_stream->idx);
-      sort_stream->idx++;
+    if ((*gn = sort_stream_next_sorted(sort_stream))) {
       /* join region nodes with the same sequence ID */
       if (gt_region_node_try_cast(*gn)) {
         GtRange range_a, range_b;
-        while (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-          node = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                                sort_stream->idx);
+        while ((node = sort_stream_next_sorted(sort_stream))) {
           if (!gt_region_node_try_cast(node) ||
               gt_str_cmp(gt_genome_node_get_seqid(*gn),
                          gt_genome_node_get_seqid(node))) {
             /* the next node is not a region node with the same ID */
+            sort_stream->next_node = node;
             break;
           }
           range_a = gt_genome_node_get_range(*gn);
@@ -81,7 +484,6 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
           range_a = gt_range_join(&range_a, &range_b);
           gt_genome_node_set_range(*gn, &range_a);
           gt_genome_node_delete(node);
-          sort_stream->idx++;
         }
       }
       return 0;
@@ -100,11 +502,18 @@ static void gt_sort_stream_free(GtNodeStream *ns)
 {
   GtUword i;
   GtSortStream *sort_stream = gt_sort_stream_cast(ns);
+  for (i = 0; i < gt_array_size(sort_stream->runs); i++)
+    sort_stream_run_delete(gt_array_get(sort_stream->runs, i));
   for (i = sort_stream->idx; i < gt_array_size(sort_stream->nodes); i++) {
     gt_genome_node_delete(*(GtGenomeNode**)
                           gt_array_get(sort_stream->nodes, i));
   }
+  gt_genome_node_delete(sort_stream->next_node);
+  gt_array_delete(sort_stream->runs);
   gt_array_delete(sort_stream->nodes);
+  gt_priority_queue_delete(sort_stream->pq);
+  gt_str_delete(sort_stream->buffer);
+  gt_free(sort_stream->record);
   gt_node_stream_delete(sort_stream->in_stream);
 }
 
@@ -129,6 +538,20 @@ GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream)
   sort_stream->in_stream = gt_node_stream_ref(in_stream);
   sort_stream->sorted = false;
   sort_stream->idx = 0;
+  sort_stream->memlimit = 0;
+  sort_stream->memused = 0;
   sort_stream->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  sort_stream->runs = gt_array_new(sizeof (SortStreamRun));
+  sort_stream->pq = NULL;
+  sort_stream->next_node = NULL;
+  sort_stream->buffer = gt_str_new();
+  sort_stream->record = NULL;
+  sort_stream->record_size = 0;
   return ns;
 }
+
+void gt_sort_stream_set_memlimit(GtSortStream *sort_stream, GtUword memlimit)
+{
+  gt_assert(sort_stream && !sort_stream->sorted);
+  sort_stream->memlimit = memlimit;
+}
@@ -21,5 +21,10 @@
 #include "extended/sort_stream_api.h"
 
 const GtNodeStreamClass* gt_sort_stream_class(void);
+/* Keep at most about <memlimit> bytes of nodes in memory. The nodes beyond are
+   sorted in runs which are written to temporary files and merged afterwards.
+   The order of the nodes is the same as without a limit. */
+void                     gt_sort_stream_set_memlimit(GtSortStream*,
+                                                     GtUword memlimit);
 
 #endif
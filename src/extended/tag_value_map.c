@@ -135,6 +135,59 @@ void gt_tag_value_map_add(GtTagValueMap *map, const char *tag,
   (*map)[map_len + tag_len + 1 + value_len + 1] = '\0';
 }
 
+GtTagValueMap gt_tag_value_map_new_in_arena(GtArena *arena, const char *tag,
+                                            const char *value)
+{
+  GtTagValueMap map;
+  size_t tag_len, value_len;
+  gt_assert(arena && tag && value);
+  tag_len = strlen(tag);
+  value_len = strlen(value);
+  gt_assert(tag_len && value_len);
+  map = gt_arena_alloc(arena, tag_len + 1 + value_len + 1 + 1);
+  memcpy(map, tag, tag_len + 1);
+  memcpy(map + tag_len + 1, value, value_len + 1);
+  map[tag_len + 1 + value_len + 1] = '\0';
+  return map;
+}
+
+void gt_tag_value_map_add_in_arena(GtTagValueMap *map, GtArena *arena,
+                                   const char *tag, const char *value)
+{
+  size_t tag_len, value_len, map_len = 0;
+  GT_UNUSED const char *tag_already_used;
+  gt_assert(map && *map && arena && tag && value);
+  tag_len = strlen(tag);
+  value_len = strlen(value);
+  gt_assert(tag_len && value_len);
+  tag_already_used = get_value(*map, tag, &map_len);
+  gt_assert(!tag_already_used);
+  /* while the attributes of a new node are added, the map is usually the
+     last allocation in <arena> and grows in place */
+  *map = gt_arena_grow(arena, *map, map_len + 1,
+                       map_len + tag_len + 1 + value_len + 1 + 1);
+  memcpy(*map + map_len, tag, tag_len + 1);
+  memcpy(*map + map_len + tag_len + 1, value, value_len + 1);
+  (*map)[map_len + tag_len + 1 + value_len + 1] = '\0';
+}
+
+GtTagValueMap gt_tag_value_map_clone(const GtTagValueMap map)
+{
+  GtTagValueMap clone;
+  size_t map_len;
+  gt_assert(map);
+  map_len = get_map_len(map);
+  clone = gt_malloc(map_len + 1);
+  memcpy(clone, map, map_len + 1);
+  return clone;
+}
+
+size_t gt_tag_value_map_length(const GtTagValueMap map)
+{
+  gt_assert(map);
+  return get_map_len(map) + 1;
+}
+
 void gt_tag_value_map_remove(GtTagValueMap *map, const char *tag)
 {
   size_t tag_len, value_len, map_len;
@@ -400,6 +453,25 @@ int gt_tag_value_map_unit_test(GtError *err)
     gt_tag_value_map_delete(map);
   }
 
+  /* test maps allocated in an arena */
+  if (!had_err) {
+    GtArena *arena = gt_arena_new();
+    GtTagValueMap map = gt_tag_value_map_new_in_arena(arena, "tag 1", "foo"),
+                  clone;
+    gt_tag_value_map_add_in_arena(&map, arena, "tag 2", "bar");
+    (void) gt_arena_alloc(arena, 1);
+    gt_tag_value_map_add_in_arena(&map, arena, "tag 3", "baz");
+    gt_ensure(gt_tag_value_map_size(map) == 3);
+    gt_ensure(!strcmp(gt_tag_value_map_get(map, "tag 1"), "foo"));
+    gt_ensure(!strcmp(gt_tag_value_map_get(map, "tag 3"), "baz"));
+    clone = gt_tag_value_map_clone(map);
+    gt_tag_value_map_remove(&clone, "tag 2");
+    gt_ensure(gt_tag_value_map_size(clone) == 2);
+    gt_ensure(!strcmp(gt_tag_value_map_get(map, "tag 2"), "bar"));
+    gt_tag_value_map_delete(clone);
+    gt_arena_delete(arena);
+  }
+
   return had_err;
 }
 
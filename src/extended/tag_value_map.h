@@ -18,8 +18,23 @@
 #ifndef TAG_VALUE_MAP_H
 #define TAG_VALUE_MAP_H
 
+#include "core/arena.h"
 #include "extended/tag_value_map_api.h"
 
+/* Like <gt_tag_value_map_new()> and <gt_tag_value_map_add()>, but the map is
+   allocated in <arena>. Such a map must not be deleted with
+   <gt_tag_value_map_delete()> and must be copied with
+   <gt_tag_value_map_clone()> before it is passed to a function which changes
+   its size. */
+GtTagValueMap gt_tag_value_map_new_in_arena(GtArena *arena, const char *tag,
+                                            const char *value);
+void          gt_tag_value_map_add_in_arena(GtTagValueMap *map, GtArena *arena,
+                                            const char *tag,
+                                            const char *value);
+/* Return a copy of <map> allocated with <gt_malloc()>. */
+GtTagValueMap gt_tag_value_map_clone(const GtTagValueMap map);
+/* Return the number of bytes occupied by <map>, including its terminator. */
+size_t        gt_tag_value_map_length(const GtTagValueMap map);
 void          gt_tag_value_map_show(const GtTagValueMap);
 int           gt_tag_value_map_unit_test(GtError*);
 
@@ -17,6 +17,7 @@
 
 #include "gtt.h"
 #include "core/alphabet.h"
+#include "core/arena.h"
 #include "core/array.h"
 #include "core/array2dim_api.h"
 #include "core/array2dim_sparse.h"
@@ -87,6 +88,8 @@
 #include "ltr/gt_ltrdigest.h"
 #include "ltr/gt_ltrharvest.h"
 #include "ltr/ltrdigest_pbs_visitor.h"
+#include "match/diagbandseed.h"
+#include "match/diagbandseed-score.h"
 #include "match/evalue.h"
 #include "match/karlin_altschul_stat.h"
 #include "match/rdj-spmlist.h"
@@ -283,6 +286,7 @@ GtHashmap* gtt_unit_tests(void)
 
   gt_hashmap_add(unit_tests, "alphabet class", gt_alphabet_unit_test);
   gt_hashmap_add(unit_tests, "alignment class", gt_alignment_unit_test);
+  gt_hashmap_add(unit_tests, "arena class", gt_arena_unit_test);
   gt_hashmap_add(unit_tests, "array class", gt_array_unit_test);
   gt_hashmap_add(unit_tests, "array example", gt_array_example);
   gt_hashmap_add(unit_tests, "array2dim example", gt_array2dim_example);
@@ -311,6 +315,10 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "cstr table class", gt_cstr_table_unit_test);
   gt_hashmap_add(unit_tests, "description buffer class",
                                                       gt_desc_buffer_unit_test);
+  gt_hashmap_add(unit_tests, "diagbandseed engine class",
+                                              gt_diagbandseed_engine_unit_test);
+  gt_hashmap_add(unit_tests, "diagbandseed score module",
+                                               gt_diagbandseed_score_unit_test);
   gt_hashmap_add(unit_tests, "disc distri class", gt_disc_distri_unit_test);
   gt_hashmap_add(unit_tests, "dlist class", gt_dlist_unit_test);
   gt_hashmap_add(unit_tests, "dlist example", gt_dlist_example);
@@ -205,7 +205,7 @@ int gt_matchspacedseed(bool withesa,
   if (!haserr)
   {
     genericindex = genericindex_new(inputindex,withesa,
-                                    withesa && docompare,false,false,
+                                    withesa && docompare,false,false,false,
                                     0,logger,err);
     if (genericindex == NULL)
     {
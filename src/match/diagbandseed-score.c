@@ -0,0 +1,492 @@
+/*
+  Copyright (c) 2015-2016 Joerg Winkler <j.winkler@posteo.de>
+  Copyright (c) 2015-2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/ensure.h"
+#include "core/ma_api.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "match/diagbandseed-score.h"
+
+/* The vectorized kernels are compiled for the target instruction sets with
+   function attributes and selected at runtime, so the binary still runs on
+   CPUs without SSE4.1 or AVX2. */
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__)) && \
+    (defined (__clang__) || __GNUC__ > 4 || \
+     (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define GT_DIAGBANDSEED_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+GtDiagbandseedKernel gt_diagbandseed_kernel_best(void)
+{
+  if (gt_diagbandseed_kernel_supported(GT_DIAGBANDSEED_KERNEL_AVX2)) {
+    return GT_DIAGBANDSEED_KERNEL_AVX2;
+  }
+  if (gt_diagbandseed_kernel_supported(GT_DIAGBANDSEED_KERNEL_SSE41)) {
+    return GT_DIAGBANDSEED_KERNEL_SSE41;
+  }
+  return GT_DIAGBANDSEED_KERNEL_SCALAR;
+}
+
+bool gt_diagbandseed_kernel_supported(GtDiagbandseedKernel kernel)
+{
+  switch (kernel) {
+    case GT_DIAGBANDSEED_KERNEL_SCALAR:
+      return true;
+#ifdef GT_DIAGBANDSEED_X86_KERNELS
+    case GT_DIAGBANDSEED_KERNEL_SSE41:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("sse4.1") ? true : false;
+    case GT_DIAGBANDSEED_KERNEL_AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") ? true : false;
+#endif
+    default:
+      return false;
+  }
+}
+
+const char *gt_diagbandseed_kernel_name(GtDiagbandseedKernel kernel)
+{
+  switch (kernel) {
+    case GT_DIAGBANDSEED_KERNEL_SSE41:
+      return "sse4.1";
+    case GT_DIAGBANDSEED_KERNEL_AVX2:
+      return "avx2";
+    default:
+      return "scalar";
+  }
+}
+
+bool gt_diagbandseed_score_batchable(GtUword amaxlen, GtUword bmaxlen)
+{
+  /* the gather instructions use signed 32 bit indices */
+  return amaxlen <= (GtUword) INT32_MAX && bmaxlen <= (GtUword) INT32_MAX &&
+         amaxlen + bmaxlen <= (GtUword) INT32_MAX;
+}
+
+void gt_diagbandseed_score_segment_seedwise(uint8_t *pass,
+                                            GtDiagbandseedScore *score,
+                                            GtDiagbandseedPosition *lastp,
+                                            const GtDiagbandseedSeedPair
+                                              *segment,
+                                            GtUword len,
+                                            GtUword amaxlen,
+                                            GtUword logdiagbandwidth,
+                                            unsigned int seedlength,
+                                            GtUword mincoverage)
+{
+  const GtDiagbandseedSeedPair *seed_pair;
+  GtUword diag;
+
+  /* calculate diagonal band scores */
+  for (seed_pair = segment; seed_pair < segment + len; seed_pair++) {
+    gt_assert(seed_pair->apos <= amaxlen);
+    diag = (amaxlen + (GtUword) seed_pair->bpos - (GtUword) seed_pair->apos)
+            >> logdiagbandwidth;
+    if (seed_pair->bpos >= seedlength + lastp[diag]) {
+      /* no overlap: add seedlength */
+      score[diag + 1] += seedlength;
+    } else {
+      /* overlap: add difference below overlap */
+      gt_assert(lastp[diag] <= seed_pair->bpos); /* if fail: sort by bpos */
+      score[diag + 1] += seed_pair->bpos - lastp[diag];
+    }
+    lastp[diag] = seed_pair->bpos;
+  }
+
+  /* test for mincoverage */
+  for (seed_pair = segment; seed_pair < segment + len; seed_pair++) {
+    diag = (amaxlen + (GtUword) seed_pair->bpos - (GtUword) seed_pair->apos)
+           >> logdiagbandwidth;
+    pass[seed_pair - segment]
+      = (GtUword) MAX(score[diag + 2], score[diag]) + (GtUword) score[diag + 1]
+        >= mincoverage ? 1 : 0;
+  }
+
+  /* reset diagonal band scores */
+  for (seed_pair = segment; seed_pair < segment + len; seed_pair++) {
+    diag = (amaxlen + (GtUword) seed_pair->bpos - (GtUword) seed_pair->apos)
+           >> logdiagbandwidth;
+    score[diag + 1] = 0;
+    lastp[diag] = 0;
+  }
+}
+
+static void gt_diagbandseed_diagonals_scalar(uint32_t *diags,
+                                             const GtDiagbandseedSeedPair
+                                               *segment,
+                                             GtUword from,
+                                             GtUword len,
+                                             GtUword amaxlen,
+                                             GtUword logdiagbandwidth)
+{
+  GtUword idx;
+
+  for (idx = from; idx < len; idx++) {
+    gt_assert(segment[idx].apos <= amaxlen);
+    diags[idx] = (uint32_t) ((amaxlen + (GtUword) segment[idx].bpos
+                              - (GtUword) segment[idx].apos)
+                             >> logdiagbandwidth);
+  }
+}
+
+static void gt_diagbandseed_coverage_scalar(uint8_t *pass,
+                                            const uint32_t *diags,
+                                            const GtDiagbandseedScore *score,
+                                            GtUword from,
+                                            GtUword len,
+                                            GtUword mincoverage)
+{
+  GtUword idx;
+
+  for (idx = from; idx < len; idx++) {
+    const uint32_t diag = diags[idx];
+    pass[idx] = (GtUword) MAX(score[diag + 2], score[diag])
+                + (GtUword) score[diag + 1] >= mincoverage ? 1 : 0;
+  }
+}
+
+#ifdef GT_DIAGBANDSEED_X86_KERNELS
+/* Store the diagonal bands of four consecutive seed pairs in DIAGS. */
+#define GT_DIAGBANDSEED_SSE_DIAGONALS(DIAGS, SEEDPAIRS, AMAXLEN, SHIFT)        \
+        {                                                                      \
+          const __m128i sp0 = _mm_loadu_si128((const __m128i *) (SEEDPAIRS)),  \
+                        sp1 = _mm_loadu_si128((const __m128i *)                \
+                                              ((SEEDPAIRS) + 1)),              \
+                        sp2 = _mm_loadu_si128((const __m128i *)                \
+                                              ((SEEDPAIRS) + 2)),              \
+                        sp3 = _mm_loadu_si128((const __m128i *)                \
+                                              ((SEEDPAIRS) + 3)),              \
+                        /* apos0 apos1 bpos0 bpos1 */                          \
+                        t01 = _mm_unpackhi_epi32(sp0, sp1),                    \
+                        t23 = _mm_unpackhi_epi32(sp2, sp3),                    \
+                        apos = _mm_unpacklo_epi64(t01, t23),                   \
+                        bpos = _mm_unpackhi_epi64(t01, t23);                   \
+          _mm_storeu_si128((__m128i *) (DIAGS),                                \
+                           _mm_srl_epi32(_mm_sub_epi32(_mm_add_epi32(bpos,     \
+                                                                     AMAXLEN), \
+                                                       apos), SHIFT));         \
+        }
+
+__attribute__ ((target ("sse4.1")))
+static void gt_diagbandseed_diagonals_sse41(uint32_t *diags,
+                                            const GtDiagbandseedSeedPair
+                                              *segment,
+                                            GtUword len,
+                                            GtUword amaxlen,
+                                            GtUword logdiagbandwidth)
+{
+  const __m128i vamaxlen = _mm_set1_epi32((int) amaxlen),
+                vshift = _mm_cvtsi32_si128((int) MIN(logdiagbandwidth, 32));
+  GtUword idx;
+
+  for (idx = 0; idx + 4 <= len; idx += 4) {
+    GT_DIAGBANDSEED_SSE_DIAGONALS(diags + idx, segment + idx, vamaxlen,
+                                  vshift);
+  }
+  gt_diagbandseed_diagonals_scalar(diags, segment, idx, len, amaxlen,
+                                   logdiagbandwidth);
+}
+
+/* Set the lanes of the result to all ones if the sum of the better neighbour
+   score and the own score reaches the minimum coverage. If the 32 bit sum
+   overflows, the real sum exceeds any 32 bit <mincoverage>. */
+#define GT_DIAGBANDSEED_COVERAGE(PREFIX, SUFFIX, SUM, BEST, MINCOV)             \
+        PREFIX##_or_##SUFFIX(                                                  \
+          PREFIX##_cmpeq_epi32(PREFIX##_max_epu32(SUM, MINCOV), SUM),          \
+          PREFIX##_andnot_##SUFFIX(                                            \
+            PREFIX##_cmpeq_epi32(PREFIX##_max_epu32(SUM, BEST), SUM),          \
+            PREFIX##_cmpeq_epi32(SUM, SUM)))
+
+__attribute__ ((target ("sse4.1")))
+static void gt_diagbandseed_coverage_sse41(uint8_t *pass,
+                                           const uint32_t *diags,
+                                           const GtDiagbandseedScore *score,
+                                           GtUword len,
+                                           GtUword mincoverage)
+{
+  const __m128i vmincov = _mm_set1_epi32((int) mincoverage);
+  GtUword idx;
+
+  gt_assert(mincoverage <= (GtUword) UINT32_MAX);
+  for (idx = 0; idx + 4 <= len; idx += 4) {
+    const uint32_t *d = diags + idx;
+    const __m128i left = _mm_setr_epi32((int) score[d[0]], (int) score[d[1]],
+                                        (int) score[d[2]], (int) score[d[3]]),
+                  own = _mm_setr_epi32((int) score[d[0] + 1],
+                                       (int) score[d[1] + 1],
+                                       (int) score[d[2] + 1],
+                                       (int) score[d[3] + 1]),
+                  right = _mm_setr_epi32((int) score[d[0] + 2],
+                                         (int) score[d[1] + 2],
+                                         (int) score[d[2] + 2],
+                                         (int) score[d[3] + 2]),
+                  best = _mm_max_epu32(left, right),
+                  sum = _mm_add_epi32(best, own);
+    const int mask
+      = _mm_movemask_ps(_mm_castsi128_ps(GT_DIAGBANDSEED_COVERAGE(_mm, si128,
+                                                                  sum, best,
+                                                                  vmincov)));
+    pass[idx] = (uint8_t) (mask & 1);
+    pass[idx + 1] = (uint8_t) ((mask >> 1) & 1);
+    pass[idx + 2] = (uint8_t) ((mask >> 2) & 1);
+    pass[idx + 3] = (uint8_t) ((mask >> 3) & 1);
+  }
+  gt_diagbandseed_coverage_scalar(pass, diags, score, idx, len, mincoverage);
+}
+
+__attribute__ ((target ("avx2")))
+static void gt_diagbandseed_diagonals_avx2(uint32_t *diags,
+                                           const GtDiagbandseedSeedPair
+                                             *segment,
+                                           GtUword len,
+                                           GtUword amaxlen,
+                                           GtUword logdiagbandwidth)
+{
+  const __m256i vamaxlen = _mm256_set1_epi32((int) amaxlen),
+                /* undo the lane interleaving of the unpack instructions */
+                vorder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  const __m128i vshift = _mm_cvtsi32_si128((int) MIN(logdiagbandwidth, 32));
+  GtUword idx;
+
+  for (idx = 0; idx + 8 <= len; idx += 8) {
+    const __m256i *sp = (const __m256i *) (segment + idx),
+                  sp01 = _mm256_loadu_si256(sp),
+                  sp23 = _mm256_loadu_si256(sp + 1),
+                  sp45 = _mm256_loadu_si256(sp + 2),
+                  sp67 = _mm256_loadu_si256(sp + 3),
+                  /* lane 0: apos0 apos2 bpos0 bpos2,
+                     lane 1: apos1 apos3 bpos1 bpos3 */
+                  t0 = _mm256_unpackhi_epi32(sp01, sp23),
+                  t1 = _mm256_unpackhi_epi32(sp45, sp67),
+                  apos = _mm256_unpacklo_epi64(t0, t1),
+                  bpos = _mm256_unpackhi_epi64(t0, t1),
+                  diag = _mm256_srl_epi32(_mm256_sub_epi32(
+                                            _mm256_add_epi32(bpos, vamaxlen),
+                                            apos), vshift);
+    _mm256_storeu_si256((__m256i *) (diags + idx),
+                        _mm256_permutevar8x32_epi32(diag, vorder));
+  }
+  if (idx + 4 <= len) {
+    const __m128i vamaxlen128 = _mm_set1_epi32((int) amaxlen);
+    GT_DIAGBANDSEED_SSE_DIAGONALS(diags + idx, segment + idx, vamaxlen128,
+                                  vshift);
+    idx += 4;
+  }
+  gt_diagbandseed_diagonals_scalar(diags, segment, idx, len, amaxlen,
+                                   logdiagbandwidth);
+}
+
+__attribute__ ((target ("avx2")))
+static void gt_diagbandseed_coverage_avx2(uint8_t *pass,
+                                          const uint32_t *diags,
+                                          const GtDiagbandseedScore *score,
+                                          GtUword len,
+                                          GtUword mincoverage)
+{
+  const __m256i vmincov = _mm256_set1_epi32((int) mincoverage);
+  const int *iscore = (const int *) score;
+  GtUword idx, j;
+
+  gt_assert(mincoverage <= (GtUword) UINT32_MAX);
+  for (idx = 0; idx + 8 <= len; idx += 8) {
+    const __m256i d = _mm256_loadu_si256((const __m256i *) (diags + idx)),
+                  left = _mm256_i32gather_epi32(iscore, d, 4),
+                  own = _mm256_i32gather_epi32(iscore + 1, d, 4),
+                  right = _mm256_i32gather_epi32(iscore + 2, d, 4),
+                  best = _mm256_max_epu32(left, right),
+                  sum = _mm256_add_epi32(best, own);
+    const int mask
+      = _mm256_movemask_ps(_mm256_castsi256_ps(
+                             GT_DIAGBANDSEED_COVERAGE(_mm256, si256, sum, best,
+                                                      vmincov)));
+    for (j = 0; j < 8; j++) {
+      pass[idx + j] = (uint8_t) ((mask >> j) & 1);
+    }
+  }
+  gt_diagbandseed_coverage_scalar(pass, diags, score, idx, len, mincoverage);
+}
+#endif
+
+void gt_diagbandseed_score_segment(GtDiagbandseedKernel kernel,
+                                   uint8_t *pass,
+                                   uint32_t *diags,
+                                   GtDiagbandseedScore *score,
+                                   GtDiagbandseedPosition *lastp,
+                                   const GtDiagbandseedSeedPair *segment,
+                                   GtUword len,
+                                   GtUword amaxlen,
+                                   GtUword logdiagbandwidth,
+                                   unsigned int seedlength,
+                                   GtUword mincoverage)
+{
+  GtUword idx;
+
+  gt_assert(amaxlen <= (GtUword) INT32_MAX);
+  /* a 32 bit sum never reaches a larger mincoverage */
+  if (mincoverage > (GtUword) UINT32_MAX) {
+    kernel = GT_DIAGBANDSEED_KERNEL_SCALAR;
+  }
+
+  /* calculate diagonal bands */
+  switch (kernel) {
+#ifdef GT_DIAGBANDSEED_X86_KERNELS
+    case GT_DIAGBANDSEED_KERNEL_AVX2:
+      gt_diagbandseed_diagonals_avx2(diags, segment, len, amaxlen,
+                                     logdiagbandwidth);
+      break;
+    case GT_DIAGBANDSEED_KERNEL_SSE41:
+      gt_diagbandseed_diagonals_sse41(diags, segment, len, amaxlen,
+                                      logdiagbandwidth);
+      break;
+#endif
+    default:
+      gt_diagbandseed_diagonals_scalar(diags, segment, 0, len, amaxlen,
+                                       logdiagbandwidth);
+  }
+
+  /* calculate diagonal band scores. The seed pairs of one band depend on each
+     other, hence this is done one seed pair at a time, but without branches:
+     a seed pair adds its length minus the overlap with the previous seed pair
+     in the same band. */
+  for (idx = 0; idx < len; idx++) {
+    const uint32_t diag = diags[idx];
+    const GtDiagbandseedPosition bpos = segment[idx].bpos;
+
+    gt_assert(lastp[diag] <= bpos); /* if fail: sort by bpos */
+    score[diag + 1] += MIN(bpos - lastp[diag], seedlength);
+    lastp[diag] = bpos;
+  }
+
+  /* test for mincoverage */
+  switch (kernel) {
+#ifdef GT_DIAGBANDSEED_X86_KERNELS
+    case GT_DIAGBANDSEED_KERNEL_AVX2:
+      gt_diagbandseed_coverage_avx2(pass, diags, score, len, mincoverage);
+      break;
+    case GT_DIAGBANDSEED_KERNEL_SSE41:
+      gt_diagbandseed_coverage_sse41(pass, diags, score, len, mincoverage);
+      break;
+#endif
+    default:
+      gt_diagbandseed_coverage_scalar(pass, diags, score, 0, len,
+                                      mincoverage);
+  }
+
+  /* reset diagonal band scores */
+  for (idx = 0; idx < len; idx++) {
+    score[diags[idx] + 1] = 0;
+    lastp[diags[idx]] = 0;
+  }
+}
+
+static int gt_diagbandseed_seedpair_compare(const void *a, const void *b)
+{
+  const GtDiagbandseedSeedPair *sa = (const GtDiagbandseedSeedPair *) a,
+                               *sb = (const GtDiagbandseedSeedPair *) b;
+
+  if (sa->bpos != sb->bpos) {
+    return sa->bpos < sb->bpos ? -1 : 1;
+  }
+  if (sa->apos != sb->apos) {
+    return sa->apos < sb->apos ? -1 : 1;
+  }
+  return 0;
+}
+
+#define GT_DIAGBANDSEED_TEST_SEGMENTLEN 300
+
+int gt_diagbandseed_score_unit_test(GtError *err)
+{
+  GtDiagbandseedSeedPair segment[GT_DIAGBANDSEED_TEST_SEGMENTLEN];
+  uint8_t refpass[GT_DIAGBANDSEED_TEST_SEGMENTLEN],
+          pass[GT_DIAGBANDSEED_TEST_SEGMENTLEN];
+  uint32_t diags[GT_DIAGBANDSEED_TEST_SEGMENTLEN];
+  GtDiagbandseedKernel kernel;
+  int trial, had_err = 0;
+
+  gt_error_check(err);
+  for (trial = 0; !had_err && trial < 500; trial++) {
+    const unsigned int seedlength = 2U + (unsigned int) gt_rand_max(30);
+    const GtUword amaxlen = seedlength + gt_rand_max(3000),
+                  bmaxlen = seedlength + gt_rand_max(3000),
+                  logdiagbandwidth = gt_rand_max(7),
+                  ndiags = (amaxlen >> logdiagbandwidth) +
+                           (bmaxlen >> logdiagbandwidth) + 2,
+                  len = 1 + gt_rand_max(GT_DIAGBANDSEED_TEST_SEGMENTLEN - 1),
+                  /* sometimes no seed pair can pass */
+                  mincoverage = trial % 50 == 0
+                                ? (GtUword) UINT32_MAX + 1
+                                : seedlength + gt_rand_max(6 * seedlength);
+    const GtUword offset = gt_rand_max(MIN(amaxlen, bmaxlen));
+    GtDiagbandseedScore *score = gt_calloc(ndiags + 2, sizeof *score);
+    GtDiagbandseedPosition *lastp = gt_calloc(ndiags, sizeof *lastp);
+    GtUword idx;
+
+    /* half of the seed pairs cluster around one diagonal, so that some of
+       them reach the mincoverage */
+    for (idx = 0; idx < len; idx++) {
+      GtDiagbandseedSeedPair *sp = segment + idx;
+      sp->aseqnum = sp->bseqnum = 0;
+      sp->bpos = (GtDiagbandseedPosition) (seedlength - 1 +
+                                           gt_rand_max(bmaxlen - seedlength
+                                                       + 1));
+      if (gt_rand_max(1) == 0) {
+        sp->apos = (GtDiagbandseedPosition) (seedlength - 1 +
+                                             gt_rand_max(amaxlen - seedlength
+                                                         + 1));
+      } else {
+        GtUword apos = (GtUword) sp->bpos + offset + gt_rand_max(4);
+        sp->apos = (GtDiagbandseedPosition) (apos > amaxlen ? amaxlen : apos);
+        if (sp->apos < seedlength - 1) {
+          sp->apos = seedlength - 1;
+        }
+      }
+    }
+    qsort(segment, (size_t) len, sizeof *segment,
+          gt_diagbandseed_seedpair_compare);
+
+    gt_diagbandseed_score_segment_seedwise(refpass, score, lastp, segment, len,
+                                           amaxlen, logdiagbandwidth,
+                                           seedlength, mincoverage);
+    for (kernel = GT_DIAGBANDSEED_KERNEL_SCALAR;
+         !had_err && kernel <= GT_DIAGBANDSEED_KERNEL_AVX2; kernel++) {
+      if (!gt_diagbandseed_kernel_supported(kernel)) {
+        continue;
+      }
+      gt_ensure(gt_diagbandseed_score_batchable(amaxlen, bmaxlen));
+      memset(pass, 2, sizeof pass);
+      gt_diagbandseed_score_segment(kernel, pass, diags, score, lastp, segment,
+                                    len, amaxlen, logdiagbandwidth, seedlength,
+                                    mincoverage);
+      gt_ensure(memcmp(pass, refpass, (size_t) len) == 0);
+      for (idx = 0; !had_err && idx < ndiags; idx++) {
+        gt_ensure(score[idx + 1] == 0 && lastp[idx] == 0);
+      }
+    }
+    gt_free(score);
+    gt_free(lastp);
+  }
+  gt_ensure(gt_diagbandseed_kernel_supported(gt_diagbandseed_kernel_best()));
+  gt_ensure(!gt_diagbandseed_score_batchable((GtUword) INT32_MAX, 1));
+  return had_err;
+}
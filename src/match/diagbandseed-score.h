@@ -0,0 +1,96 @@
+/*
+  Copyright (c) 2015-2016 Joerg Winkler <j.winkler@posteo.de>
+  Copyright (c) 2015-2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef DIAGBANDSEED_SCORE_H
+#define DIAGBANDSEED_SCORE_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+typedef uint32_t GtDiagbandseedPosition;
+typedef uint32_t GtDiagbandseedSeqnum;
+typedef uint32_t GtDiagbandseedScore;
+
+typedef struct {
+  GtDiagbandseedSeqnum bseqnum; /*  2nd important sort criterion */
+  GtDiagbandseedSeqnum aseqnum; /* most important sort criterion */
+  GtDiagbandseedPosition apos;
+  GtDiagbandseedPosition bpos;  /*  3rd important sort criterion */
+} GtDiagbandseedSeedPair;
+
+/* The implementations of the diagonal band scoring. */
+typedef enum {
+  GT_DIAGBANDSEED_KERNEL_SCALAR,
+  GT_DIAGBANDSEED_KERNEL_SSE41,
+  GT_DIAGBANDSEED_KERNEL_AVX2
+} GtDiagbandseedKernel;
+
+/* Return the fastest kernel supported by the CPU the program runs on. */
+GtDiagbandseedKernel gt_diagbandseed_kernel_best(void);
+
+/* Return true if <kernel> can be used on the CPU the program runs on. */
+bool                 gt_diagbandseed_kernel_supported(GtDiagbandseedKernel
+                                                        kernel);
+
+/* Return the name of <kernel>. */
+const char*          gt_diagbandseed_kernel_name(GtDiagbandseedKernel kernel);
+
+/* Return true if the diagonal band scores of seed pairs from sequences of
+   length at most <amaxlen> and <bmaxlen> can be computed by
+   gt_diagbandseed_score_segment(), i.e. if all intermediate values fit into
+   32 bits. */
+bool gt_diagbandseed_score_batchable(GtUword amaxlen, GtUword bmaxlen);
+
+/* Decide for each of the <len> seed pairs of the <segment> (i.e. all seed
+   pairs have the same aseqnum and bseqnum and are sorted by bpos) whether the
+   diagonal band of the seed pair together with the better of its two
+   neighbouring bands covers at least <mincoverage> positions. The decision for
+   the i-th seed pair is stored in <pass>[i]. <score> (with ndiags + 2 entries)
+   and <lastp> (with ndiags entries) must be zero, they are zero again on
+   return. The seed pairs are processed one at a time. */
+void gt_diagbandseed_score_segment_seedwise(uint8_t *pass,
+                                            GtDiagbandseedScore *score,
+                                            GtDiagbandseedPosition *lastp,
+                                            const GtDiagbandseedSeedPair
+                                              *segment,
+                                            GtUword len,
+                                            GtUword amaxlen,
+                                            GtUword logdiagbandwidth,
+                                            unsigned int seedlength,
+                                            GtUword mincoverage);
+
+/* Same as gt_diagbandseed_score_segment_seedwise(), but the diagonal bands
+   and the coverage decisions of the segment are computed in batches using
+   <kernel>. <diags> must provide space for <len> entries. The results are the
+   same as those of gt_diagbandseed_score_segment_seedwise(). Requires
+   gt_diagbandseed_score_batchable() to be true. */
+void gt_diagbandseed_score_segment(GtDiagbandseedKernel kernel,
+                                   uint8_t *pass,
+                                   uint32_t *diags,
+                                   GtDiagbandseedScore *score,
+                                   GtDiagbandseedPosition *lastp,
+                                   const GtDiagbandseedSeedPair *segment,
+                                   GtUword len,
+                                   GtUword amaxlen,
+                                   GtUword logdiagbandwidth,
+                                   unsigned int seedlength,
+                                   GtUword mincoverage);
+
+int gt_diagbandseed_score_unit_test(GtError *err);
+
+#endif
@@ -0,0 +1,226 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <time.h>
+#include "core/assert_api.h"
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
+#include "core/xposix.h"
+#include "match/diagbandseed-stats.h"
+
+typedef struct {
+  double wall,
+         cpu;
+  GtUword calls,
+          allocated,
+          peakgrowth,
+          items_in,
+          items_out;
+} GtDiagbandseedStageStats;
+
+struct GtDiagbandseedStats {
+  GtDiagbandseedStageStats stage[GT_DIAGBANDSEED_NUM_STAGES];
+  double start,
+         *busy;
+  GtUword numofbusy;
+  GtMutex *mutex;
+};
+
+static const char *gt_diagbandseed_stage_names[] = {
+  "kmers", "sort", "seedpairs", "filter", "extend", "output"
+};
+
+GtDiagbandseedStats *gt_diagbandseed_stats_new(void)
+{
+  GtDiagbandseedStats *stats = gt_calloc((size_t) 1, sizeof *stats);
+  stats->start = gt_diagbandseed_stats_wall();
+  stats->mutex = gt_mutex_new();
+  return stats;
+}
+
+void gt_diagbandseed_stats_delete(GtDiagbandseedStats *stats)
+{
+  if (stats != NULL) {
+    gt_mutex_delete(stats->mutex);
+    gt_free(stats->busy);
+    gt_free(stats);
+  }
+}
+
+const char *gt_diagbandseed_stats_stage_name(GtDiagbandseedStage stage)
+{
+  gt_assert(stage < GT_DIAGBANDSEED_NUM_STAGES);
+  return gt_diagbandseed_stage_names[stage];
+}
+
+double gt_diagbandseed_stats_wall(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double) tv.tv_sec + (double) tv.tv_usec / 1e6;
+}
+
+double gt_diagbandseed_stats_cpu(void)
+{
+#ifdef CLOCK_PROCESS_CPUTIME_ID
+  struct timespec ts;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) == 0) {
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+  }
+#endif
+  {
+    struct rusage ru;
+    gt_xgetrusage(RUSAGE_SELF, &ru);
+    return (double) ru.ru_utime.tv_sec + (double) ru.ru_utime.tv_usec / 1e6 +
+           (double) ru.ru_stime.tv_sec + (double) ru.ru_stime.tv_usec / 1e6;
+  }
+}
+
+void gt_diagbandseed_stats_clock_start(GtDiagbandseedStatsClock *clock)
+{
+  gt_assert(clock != NULL);
+  clock->wall = gt_diagbandseed_stats_wall();
+  clock->cpu = gt_diagbandseed_stats_cpu();
+  clock->space = gt_ma_get_space_current();
+  clock->spacepeak = gt_ma_get_space_peak();
+}
+
+static void gt_diagbandseed_stats_add_space(GtDiagbandseedStats *stats,
+                                            GtDiagbandseedStage stage,
+                                            GtUword allocated,
+                                            GtUword peakgrowth,
+                                            double wall,
+                                            double cpu,
+                                            GtUword items_in,
+                                            GtUword items_out)
+{
+  GtDiagbandseedStageStats *sst;
+
+  gt_assert(stats != NULL && stage < GT_DIAGBANDSEED_NUM_STAGES);
+  gt_mutex_lock(stats->mutex);
+  sst = stats->stage + stage;
+  sst->calls++;
+  sst->wall += wall;
+  sst->cpu += cpu;
+  sst->allocated += allocated;
+  sst->peakgrowth = MAX(sst->peakgrowth, peakgrowth);
+  sst->items_in += items_in;
+  sst->items_out += items_out;
+  gt_mutex_unlock(stats->mutex);
+}
+
+void gt_diagbandseed_stats_add_clock(GtDiagbandseedStats *stats,
+                                     GtDiagbandseedStage stage,
+                                     const GtDiagbandseedStatsClock *clock,
+                                     GtUword items_in,
+                                     GtUword items_out)
+{
+  const GtUword space = gt_ma_get_space_current(),
+                spacepeak = gt_ma_get_space_peak();
+  GtUword allocated, peakgrowth;
+
+  gt_assert(clock != NULL);
+  allocated = space > clock->space ? space - clock->space : 0;
+  /* a raised process-wide peak was reached during the stage */
+  peakgrowth = spacepeak > clock->spacepeak ? spacepeak - clock->space
+                                            : allocated;
+  gt_diagbandseed_stats_add_space(stats, stage, allocated, peakgrowth,
+                                  gt_diagbandseed_stats_wall() - clock->wall,
+                                  gt_diagbandseed_stats_cpu() - clock->cpu,
+                                  items_in, items_out);
+}
+
+void gt_diagbandseed_stats_add(GtDiagbandseedStats *stats,
+                               GtDiagbandseedStage stage,
+                               double wall,
+                               double cpu,
+                               GtUword items_in,
+                               GtUword items_out)
+{
+  gt_diagbandseed_stats_add_space(stats, stage, 0, 0, wall, cpu, items_in,
+                                  items_out);
+}
+
+void gt_diagbandseed_stats_add_thread(GtDiagbandseedStats *stats,
+                                      GtUword threadnum,
+                                      double busy)
+{
+  gt_assert(stats != NULL);
+  gt_mutex_lock(stats->mutex);
+  if (threadnum >= stats->numofbusy) {
+    GtUword idx;
+    stats->busy = gt_realloc(stats->busy, (threadnum + 1) * sizeof
+                                          *stats->busy);
+    for (idx = stats->numofbusy; idx <= threadnum; idx++) {
+      stats->busy[idx] = 0.0;
+    }
+    stats->numofbusy = threadnum + 1;
+  }
+  stats->busy[threadnum] += busy;
+  gt_mutex_unlock(stats->mutex);
+}
+
+int gt_diagbandseed_stats_write_json(const GtDiagbandseedStats *stats,
+                                     const char *path,
+                                     unsigned int numthreads,
+                                     GtError *err)
+{
+  FILE *fp;
+  GtUword idx;
+  double busy_sum = 0.0, busy_max = 0.0;
+  int stage;
+
+  gt_error_check(err);
+  gt_assert(stats != NULL && path != NULL);
+  fp = gt_fa_fopen(path, "w", err);
+  if (fp == NULL) {
+    return -1;
+  }
+  fprintf(fp, "{\n  \"tool\": \"seed_extend\",\n  \"threads\": %u,\n",
+          numthreads);
+  fprintf(fp, "  \"memory_tracking\": %s,\n",
+          gt_ma_bookkeeping_enabled() ? "true" : "false");
+  fprintf(fp, "  \"wall_seconds\": %.6f,\n",
+          gt_diagbandseed_stats_wall() - stats->start);
+  fprintf(fp, "  \"stages\": [\n");
+  for (stage = 0; stage < (int) GT_DIAGBANDSEED_NUM_STAGES; stage++) {
+    const GtDiagbandseedStageStats *sst = stats->stage + stage;
+    fprintf(fp, "    {\"name\": \"%s\", \"calls\": " GT_WU ", "
+                "\"wall_seconds\": %.6f, \"cpu_seconds\": %.6f, "
+                "\"allocated_bytes\": " GT_WU ", \"peak_growth_bytes\": "
+                GT_WU ", \"items_in\": " GT_WU ", \"items_out\": " GT_WU
+                "}%s\n",
+            gt_diagbandseed_stats_stage_name((GtDiagbandseedStage) stage),
+            sst->calls, sst->wall, sst->cpu, sst->allocated, sst->peakgrowth,
+            sst->items_in, sst->items_out,
+            stage + 1 < (int) GT_DIAGBANDSEED_NUM_STAGES ? "," : "");
+  }
+  fprintf(fp, "  ],\n  \"extension_threads\": {\"busy_seconds\": [");
+  for (idx = 0; idx < stats->numofbusy; idx++) {
+    fprintf(fp, "%s%.6f", idx > 0 ? ", " : "", stats->busy[idx]);
+    busy_sum += stats->busy[idx];
+    busy_max = MAX(busy_max, stats->busy[idx]);
+  }
+  /* ratio of the longest busy time to the mean busy time, 1 is perfect */
+  fprintf(fp, "], \"imbalance\": %.4f}\n}\n",
+          busy_sum > 0.0 ? busy_max * stats->numofbusy / busy_sum : 1.0);
+  gt_fa_xfclose(fp);
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef DIAGBANDSEED_STATS_H
+#define DIAGBANDSEED_STATS_H
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* The class <GtDiagbandseedStats> collects the resources used by the stages
+   of the seed and extend algorithm: wall time, CPU time of the process
+   during the stage, allocated bytes, the number of items going in and out of
+   the stage and the busy time of each extension thread. All functions
+   adding to the statistics may be called by several threads at once. */
+typedef struct GtDiagbandseedStats GtDiagbandseedStats;
+
+typedef enum {
+  GT_DIAGBANDSEED_STAGE_KMERS,     /* k-mers of sequences -> k-mer list */
+  GT_DIAGBANDSEED_STAGE_SORT,      /* sorting of k-mer and seed pair lists */
+  GT_DIAGBANDSEED_STAGE_SEEDPAIRS, /* k-mers of both lists -> seed pairs */
+  GT_DIAGBANDSEED_STAGE_FILTER,    /* seed pairs -> seeds in good bands */
+  GT_DIAGBANDSEED_STAGE_EXTEND,    /* extended seeds -> matches */
+  GT_DIAGBANDSEED_STAGE_OUTPUT,    /* matches written */
+  GT_DIAGBANDSEED_NUM_STAGES
+} GtDiagbandseedStage;
+
+/* The state of the clocks at the start of a stage: the times, the space in
+   use and the process-wide space peak. */
+typedef struct {
+  double wall,
+         cpu;
+  GtUword space,
+          spacepeak;
+} GtDiagbandseedStatsClock;
+
+GtDiagbandseedStats *gt_diagbandseed_stats_new(void);
+
+void gt_diagbandseed_stats_delete(GtDiagbandseedStats *stats);
+
+/* Return the name of <stage> as used in the report. */
+const char *gt_diagbandseed_stats_stage_name(GtDiagbandseedStage stage);
+
+/* Return the wall clock time in seconds. */
+double gt_diagbandseed_stats_wall(void);
+
+/* Return the CPU time in seconds used by all threads of the process. As the
+   stages do not overlap, the difference of two calls from the thread running
+   the stages includes the work of its helper threads. */
+double gt_diagbandseed_stats_cpu(void);
+
+/* Store the current wall time, CPU time of the process, allocated space and
+   space peak in <clock>. */
+void gt_diagbandseed_stats_clock_start(GtDiagbandseedStatsClock *clock);
+
+/* Add the time and space used since <clock> was started to <stage>, together
+   with <items_in> and <items_out>. The space is recorded as the growth of the
+   space in use at the end and as the peak growth during the stage. The latter
+   is exact if the process-wide space peak was raised during the stage;
+   otherwise only the growth at the end is known. */
+void gt_diagbandseed_stats_add_clock(GtDiagbandseedStats *stats,
+                                     GtDiagbandseedStage stage,
+                                     const GtDiagbandseedStatsClock *clock,
+                                     GtUword items_in,
+                                     GtUword items_out);
+
+/* Add <wall> and <cpu> seconds, <items_in> and <items_out> to <stage>. */
+void gt_diagbandseed_stats_add(GtDiagbandseedStats *stats,
+                               GtDiagbandseedStage stage,
+                               double wall,
+                               double cpu,
+                               GtUword items_in,
+                               GtUword items_out);
+
+/* Add <busy> seconds to the busy time of extension thread <threadnum>. */
+void gt_diagbandseed_stats_add_thread(GtDiagbandseedStats *stats,
+                                      GtUword threadnum,
+                                      double busy);
+
+/* Write the statistics as JSON object to the file <path>. <numthreads> is
+   the number of threads the program was run with. For each stage,
+   "wall_seconds" is the elapsed time and "cpu_seconds" the CPU time (user and
+   system) of all threads of the process while the stage ran, so with several
+   threads it may exceed the elapsed time. Filtering, extension and output
+   are interleaved, so their times are split in proportion to the measured
+   busy times. Returns 0 on success; otherwise -1 and <err> is set. */
+int gt_diagbandseed_stats_write_json(const GtDiagbandseedStats *stats,
+                                     const char *path,
+                                     unsigned int numthreads,
+                                     GtError *err);
+#endif
@@ -24,9 +24,11 @@
 #include "core/complement.h"
 #include "core/cstr_api.h"
 #include "core/encseq.h"
+#include "core/ensure.h"
 #include "core/fa.h"
 #include "core/fileutils_api.h"
 #include "core/ma_api.h"
+#include "core/mathsupport.h"
 #include "core/minmax.h"
 #include "core/radix_sort.h"
 #include "core/timer_api.h"
@@ -34,6 +36,8 @@
 #include "core/xansi_api.h"
 #include "match/declare-readfunc.h"
 #include "match/diagbandseed.h"
+#include "match/diagbandseed-score.h"
+#include "match/diagbandseed-stats.h"
 #include "match/kmercodes.h"
 #include "match/querymatch.h"
 #include "match/querymatch-align.h"
@@ -49,10 +53,8 @@
 #define GT_DIAGBANDSEED_FMT          "in " GT_WD ".%06ld seconds.\n"
 /* #define GT_DIAGBANDSEED_SEEDHISTOGRAM 100 */
 
-typedef uint32_t GtDiagbandseedPosition;
-typedef uint32_t GtDiagbandseedSeqnum;
-typedef uint32_t GtDiagbandseedScore;
 typedef struct GtDiagbandseedProcKmerInfo GtDiagbandseedProcKmerInfo;
+typedef struct GtDiagbandseedMinimizerWindow GtDiagbandseedMinimizerWindow;
 
 typedef struct {
   GtCodetype code;              /* only sort criterion */
@@ -64,13 +66,6 @@ GT_DECLAREARRAYSTRUCT(GtDiagbandseedKmerPos);
 DECLAREBufferedfiletype(GtDiagbandseedKmerPos);
 DECLAREREADFUNCTION(GtDiagbandseedKmerPos);
 
-typedef struct {
-  GtDiagbandseedSeqnum bseqnum; /*  2nd important sort criterion */
-  GtDiagbandseedSeqnum aseqnum; /* most important sort criterion */
-  GtDiagbandseedPosition apos;
-  GtDiagbandseedPosition bpos;  /*  3rd important sort criterion */
-} GtDiagbandseedSeedPair;
-
 GT_DECLAREARRAYSTRUCT(GtDiagbandseedSeedPair);
 
 struct GtDiagbandseedInfo {
@@ -78,10 +73,13 @@ struct GtDiagbandseedInfo {
   const GtEncseq *bencseq;
   GtUword maxfreq;
   GtUword memlimit;
+  GtUword spblocksize;
   GtRange *seedpairdistance;
   const GtDiagbandseedExtendParams *extp;
   GtUword anumseqranges;
   GtUword bnumseqranges;
+  GtUword samplingparam;
+  GtDiagbandseedSampling sampling;
   unsigned int seedlength;
   bool norev;
   bool nofwd;
@@ -90,6 +88,8 @@ struct GtDiagbandseedInfo {
   bool debug_kmer;
   bool debug_seedpair;
   bool use_kmerfile;
+  bool use_kpos;
+  GtDiagbandseedStats *stats;
 };
 
 struct GtDiagbandseedExtendParams {
@@ -113,6 +113,7 @@ struct GtDiagbandseedExtendParams {
   bool benchmark;
   bool always_polished_ends;
   bool verify_alignment;
+  bool binary;
 };
 
 struct GtDiagbandseedProcKmerInfo {
@@ -127,6 +128,11 @@ struct GtDiagbandseedProcKmerInfo {
   GtRange *specialrange;
   unsigned int seedlength;
   GtReadmode readmode;
+  /* k-mer sampling */
+  GtDiagbandseedSampling sampling;
+  GtUword samplingparam;
+  GtUword numofkmers; /* number of k-mers before sampling */
+  GtDiagbandseedMinimizerWindow *window;
 };
 
 /* * * * * CONSTRUCTORS AND DESTRUCTORS * * * * */
@@ -135,7 +141,10 @@ GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
                                              const GtEncseq *bencseq,
                                              GtUword maxfreq,
                                              GtUword memlimit,
+                                             GtUword spblockmem,
                                              unsigned int seedlength,
+                                             GtDiagbandseedSampling sampling,
+                                             GtUword samplingparam,
                                              bool norev,
                                              bool nofwd,
                                              GtRange *seedpairdistance,
@@ -144,6 +153,7 @@ GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
                                              bool debug_kmer,
                                              bool debug_seedpair,
                                              bool use_kmerfile,
+                                             bool use_kpos,
                                              const GtDiagbandseedExtendParams
                                                *extp,
                                              GtUword anumseqranges,
@@ -154,7 +164,15 @@ GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
   info->bencseq = bencseq;
   info->maxfreq = maxfreq;
   info->memlimit = memlimit;
+  /* number of seed pairs fitting into one block */
+  if (spblockmem == GT_UWORD_MAX) {
+    info->spblocksize = GT_UWORD_MAX;
+  } else {
+    info->spblocksize = MAX(spblockmem / sizeof (GtDiagbandseedSeedPair), 1);
+  }
   info->seedlength = seedlength;
+  info->sampling = sampling;
+  info->samplingparam = samplingparam;
   info->norev = norev;
   info->nofwd = nofwd;
   info->seedpairdistance = seedpairdistance;
@@ -163,12 +181,21 @@ GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
   info->debug_kmer = debug_kmer;
   info->debug_seedpair = debug_seedpair;
   info->use_kmerfile = use_kmerfile;
+  info->use_kpos = use_kpos;
   info->extp = extp;
   info->anumseqranges = anumseqranges;
   info->bnumseqranges = bnumseqranges;
+  info->stats = NULL;
   return info;
 }
 
+void gt_diagbandseed_info_stats_set(GtDiagbandseedInfo *info,
+                                    GtDiagbandseedStats *stats)
+{
+  gt_assert(info != NULL);
+  info->stats = stats;
+}
+
 void gt_diagbandseed_info_delete(GtDiagbandseedInfo *info)
 {
   if (info != NULL) {
@@ -196,7 +223,8 @@ GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
                                 bool benchmark,
                                 GtUword alignmentwidth,
                                 bool always_polished_ends,
-                                bool verify_alignment)
+                                bool verify_alignment,
+                                bool binary)
 {
   GtDiagbandseedExtendParams *extp = gt_malloc(sizeof *extp);
   extp->errorpercentage = errorpercentage;
@@ -219,6 +247,7 @@ GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
   extp->alignmentwidth = alignmentwidth;
   extp->always_polished_ends = always_polished_ends;
   extp->verify_alignment = verify_alignment;
+  extp->binary = binary;
   return extp;
 }
 
@@ -274,23 +303,194 @@ static GtUword gt_diagbandseed_update_separatorpos(GtRange *specialrange,
   return gt_encseq_total_length(encseq);
 }
 
+/* * * * * K-MER SAMPLING * * * * */
+
+/* An invertible mixing function (the finalizer of MurmurHash3), so that the
+   order of the hash values of k-mers is not biased to their lexicographic
+   order and different k-mers have different hash values. */
+static inline uint64_t gt_diagbandseed_hash(uint64_t code)
+{
+  code ^= code >> 33;
+  code *= (uint64_t) 0xff51afd7ed558ccdULL;
+  code ^= code >> 33;
+  code *= (uint64_t) 0xc4ceb9fe1a85ec53ULL;
+  code ^= code >> 33;
+  return code;
+}
+
+/* Return true if the first s-mer of the k-mer with the given <code> has the
+   smallest hash value of its s-mers. */
+static bool gt_diagbandseed_is_syncmer(GtCodetype code,
+                                       unsigned int seedlength,
+                                       unsigned int smerlength)
+{
+  const unsigned int lastshift = 2 * (seedlength - smerlength);
+  const GtCodetype smermask = (((GtCodetype) 1) << (2 * smerlength)) - 1;
+  const uint64_t firsthash = gt_diagbandseed_hash((code >> lastshift) &
+                                                  smermask);
+  unsigned int shift;
+
+  for (shift = 0; shift < lastshift; shift += 2) {
+    if (gt_diagbandseed_hash((code >> shift) & smermask) < firsthash) {
+      return false;
+    }
+  }
+  return true;
+}
+
+typedef struct {
+  GtDiagbandseedKmerPos kmerpos;
+  uint64_t hash;
+  GtUword index;
+  bool selected;
+} GtDiagbandseedMinimizerCandidate;
+
+/* The candidates of the current window are kept in a ring buffer in the
+   order of their index. Their hash values do not decrease, so the minimizers
+   of the window are at the front. */
+struct GtDiagbandseedMinimizerWindow {
+  GtDiagbandseedMinimizerCandidate *candidates;
+  GtUword windowsize, allocated, first, size, numofkmers;
+};
+
+static GtDiagbandseedMinimizerWindow *gt_diagbandseed_minimizer_window_new(
+                                                            GtUword windowsize)
+{
+  GtDiagbandseedMinimizerWindow *window = gt_malloc(sizeof *window);
+  gt_assert(windowsize > 0);
+  window->windowsize = windowsize;
+  window->allocated = windowsize + 1;
+  window->candidates = gt_malloc(window->allocated *
+                                 sizeof *window->candidates);
+  window->first = window->size = window->numofkmers = 0;
+  return window;
+}
+
+static void gt_diagbandseed_minimizer_window_delete(
+                                         GtDiagbandseedMinimizerWindow *window)
+{
+  if (window != NULL) {
+    gt_free(window->candidates);
+    gt_free(window);
+  }
+}
+
+static void gt_diagbandseed_kmer_add(GtArrayGtDiagbandseedKmerPos *list,
+                                     const GtDiagbandseedKmerPos *kmerpos)
+{
+  const GtUword array_incr = 256;
+  GtDiagbandseedKmerPos *kmerposptr = NULL;
+
+  GT_GETNEXTFREEINARRAY(kmerposptr,
+                        list,
+                        GtDiagbandseedKmerPos,
+                        array_incr + 0.2 * list->allocatedGtDiagbandseedKmerPos);
+  *kmerposptr = *kmerpos;
+}
+
+/* Add the minimizers of the current window to <list>, unless they were
+   already added for a previous window. */
+static void gt_diagbandseed_minimizer_select(
+                                         GtDiagbandseedMinimizerWindow *window,
+                                         GtArrayGtDiagbandseedKmerPos *list)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < window->size; idx++) {
+    GtDiagbandseedMinimizerCandidate *candidate
+      = window->candidates + (window->first + idx) % window->allocated;
+
+    if (candidate->hash != window->candidates[window->first].hash) {
+      break;
+    }
+    if (!candidate->selected) {
+      candidate->selected = true;
+      gt_diagbandseed_kmer_add(list, &candidate->kmerpos);
+    }
+  }
+}
+
+/* Finish the current range of consecutive k-mers: if it is shorter than a
+   window, its minimizers are used. */
+static void gt_diagbandseed_minimizer_flush(
+                                         GtDiagbandseedMinimizerWindow *window,
+                                         GtArrayGtDiagbandseedKmerPos *list)
+{
+  if (window->numofkmers > 0 && window->numofkmers < window->windowsize) {
+    gt_diagbandseed_minimizer_select(window, list);
+  }
+  window->first = window->size = window->numofkmers = 0;
+}
+
+static void gt_diagbandseed_minimizer_next(
+                                         GtDiagbandseedMinimizerWindow *window,
+                                         GtArrayGtDiagbandseedKmerPos *list,
+                                         const GtDiagbandseedKmerPos *kmerpos)
+{
+  const uint64_t hash = gt_diagbandseed_hash(kmerpos->code);
+  const GtUword index = window->numofkmers++;
+  GtDiagbandseedMinimizerCandidate *candidate;
+
+  /* remove candidates which can no longer be minimizers */
+  while (window->size > 0 &&
+         window->candidates[(window->first + window->size - 1) %
+                            window->allocated].hash > hash) {
+    window->size--;
+  }
+  candidate = window->candidates + (window->first + window->size) %
+                                   window->allocated;
+  candidate->kmerpos = *kmerpos;
+  candidate->hash = hash;
+  candidate->index = index;
+  candidate->selected = false;
+  window->size++;
+  /* remove candidates which left the window */
+  while (window->candidates[window->first].index + window->windowsize
+         <= index) {
+    window->first = (window->first + 1) % window->allocated;
+    window->size--;
+  }
+  if (window->numofkmers >= window->windowsize) {
+    gt_diagbandseed_minimizer_select(window, list);
+  }
+}
+
+/* Add the k-mer to the list of <pkinfo>, if it is selected by the sampling.
+   <firstinrange> is true if the k-mer does not overlap the previous one. */
+static void gt_diagbandseed_kmer_sample(GtDiagbandseedProcKmerInfo *pkinfo,
+                                        bool firstinrange,
+                                        const GtDiagbandseedKmerPos *kmerpos)
+{
+  pkinfo->numofkmers++;
+  switch (pkinfo->sampling) {
+    case GT_DIAGBANDSEED_SAMPLE_MINIMIZER:
+      if (firstinrange) {
+        gt_diagbandseed_minimizer_flush(pkinfo->window, pkinfo->list);
+      }
+      gt_diagbandseed_minimizer_next(pkinfo->window, pkinfo->list, kmerpos);
+      break;
+    case GT_DIAGBANDSEED_SAMPLE_SYNCMER:
+      if (gt_diagbandseed_is_syncmer(kmerpos->code, pkinfo->seedlength,
+                                     (unsigned int) pkinfo->samplingparam)) {
+        gt_diagbandseed_kmer_add(pkinfo->list, kmerpos);
+      }
+      break;
+    default:
+      gt_diagbandseed_kmer_add(pkinfo->list, kmerpos);
+  }
+}
+
 /* Add given code and its seqnum and position to a kmer list. */
 static void gt_diagbandseed_processkmercode(void *prockmerinfo,
                                             bool firstinrange,
                                             GtUword startpos,
                                             GtCodetype code)
 {
-  const GtUword array_incr = 256;
   GtDiagbandseedProcKmerInfo *pkinfo;
-  GtDiagbandseedKmerPos *kmerposptr = NULL;
+  GtDiagbandseedKmerPos kmerpos;
 
   gt_assert(prockmerinfo != NULL);
   pkinfo = (GtDiagbandseedProcKmerInfo *) prockmerinfo;
-  GT_GETNEXTFREEINARRAY(kmerposptr,
-                        pkinfo->list,
-                        GtDiagbandseedKmerPos,
-                        array_incr + 0.2 *
-                        pkinfo->list->allocatedGtDiagbandseedKmerPos);
 
   /* check separator positions and determine next seqnum and endpos */
   if (firstinrange) {
@@ -317,14 +517,15 @@ static void gt_diagbandseed_processkmercode(void *prockmerinfo,
   }
 
   /* save k-mer code */
-  kmerposptr->code = (pkinfo->readmode == GT_READMODE_FORWARD
-                      ? code : gt_kmercode_reverse(code, pkinfo->seedlength));
+  kmerpos.code = (pkinfo->readmode == GT_READMODE_FORWARD
+                  ? code : gt_kmercode_reverse(code, pkinfo->seedlength));
   /* save endpos and seqnum */
   gt_assert(pkinfo->endpos != UINT_MAX);
-  kmerposptr->endpos = pkinfo->endpos;
+  kmerpos.endpos = pkinfo->endpos;
   pkinfo->endpos = (pkinfo->readmode == GT_READMODE_FORWARD
                     ? pkinfo->endpos + 1 : pkinfo->endpos - 1);
-  kmerposptr->seqnum = pkinfo->seqnum;
+  kmerpos.seqnum = pkinfo->seqnum;
+  gt_diagbandseed_kmer_sample(pkinfo, firstinrange, &kmerpos);
 }
 
 /* Uses GtKmercodeiterator for fetching the kmers. */
@@ -363,49 +564,50 @@ static void gt_diagbandseed_get_kmers_kciter(GtDiagbandseedProcKmerInfo *pkinfo)
   gt_kmercodeiterator_delete(kc_iter);
 }
 
-/* Return a sorted list of k-mers of given seedlength from specified encseq.
- * Only sequences in seqrange will be taken into account.
- * The caller is responsible for freeing the result. */
-GtArrayGtDiagbandseedKmerPos gt_diagbandseed_get_kmers(const GtEncseq *encseq,
-                                                       unsigned int seedlength,
-                                                       GtReadmode readmode,
-                                                       const GtRange *seqrange,
-                                                       bool debug_kmer,
-                                                       bool verbose,
-                                                       GtUword known_size,
-                                                       FILE *stream)
+/* Expected number of (sampled) k-mers of the sequences in <seqrange>. */
+static GtUword gt_diagbandseed_expected_kmers(const GtEncseq *encseq,
+                                              unsigned int seedlength,
+                                              GtDiagbandseedSampling sampling,
+                                              GtUword samplingparam,
+                                              const GtRange *seqrange)
 {
-  GtArrayGtDiagbandseedKmerPos list;
-  GtDiagbandseedProcKmerInfo pkinfo;
-  GtRadixsortinfo *rdxinfo;
-  GtRange specialrange;
-  GtTimer *timer = NULL;
-  GtUword listlen = known_size;
-
-  gt_assert(encseq != NULL);
-  gt_assert(seqrange->start <= seqrange->end);
-  gt_assert(seqrange->end < gt_encseq_num_of_sequences(encseq));
-
-  if (known_size == 0) {
-    listlen = gt_seed_extend_numofkmers(encseq, seedlength, seqrange);
-  }
+  GtUword listlen = gt_seed_extend_numofkmers(encseq, seedlength, seqrange);
 
-  if (verbose) {
-    timer = gt_timer_new();
-    fprintf(stream, "# Start fetching %u-mers (expect " GT_WU ")...\n",
-            seedlength, listlen);
-    gt_timer_start(timer);
+  if (sampling == GT_DIAGBANDSEED_SAMPLE_MINIMIZER) {
+    listlen = 2 * listlen / (samplingparam + 1) + 1;
+  } else if (sampling == GT_DIAGBANDSEED_SAMPLE_SYNCMER) {
+    gt_assert(samplingparam < (GtUword) seedlength);
+    listlen = listlen / (seedlength - samplingparam + 1) + 1;
   }
+  return listlen;
+}
 
-  GT_INITARRAY(&list, GtDiagbandseedKmerPos);
-  GT_CHECKARRAYSPACEMULTI(&list, GtDiagbandseedKmerPos, listlen);
+/* Append the (sampled) k-mers of the sequences in <seqrange> to <list> in the
+   order of their positions. Returns the number of k-mers before sampling. */
+static GtUword gt_diagbandseed_kmers_collect(GtArrayGtDiagbandseedKmerPos
+                                               *list,
+                                             const GtEncseq *encseq,
+                                             unsigned int seedlength,
+                                             GtDiagbandseedSampling sampling,
+                                             GtUword samplingparam,
+                                             GtReadmode readmode,
+                                             const GtRange *seqrange)
+{
+  GtDiagbandseedProcKmerInfo pkinfo;
+  GtRange specialrange;
 
-  pkinfo.list = &list;
+  pkinfo.list = list;
   pkinfo.seqnum = seqrange->start;
   pkinfo.endpos = 0;
   pkinfo.encseq = encseq;
   pkinfo.seedlength = seedlength;
   pkinfo.readmode = readmode;
+  pkinfo.sampling = sampling;
+  pkinfo.samplingparam = samplingparam;
+  pkinfo.numofkmers = 0;
+  pkinfo.window = sampling == GT_DIAGBANDSEED_SAMPLE_MINIMIZER
+                    ? gt_diagbandseed_minimizer_window_new(samplingparam)
+                    : NULL;
   if (seqrange->end + 1 == gt_encseq_num_of_sequences(encseq)) {
     pkinfo.totallength = gt_encseq_total_length(encseq);
   } else {
@@ -453,7 +655,240 @@ GtArrayGtDiagbandseedKmerPos gt_diagbandseed_get_kmers(const GtEncseq *encseq,
   if (gt_encseq_has_specialranges(encseq)) {
     gt_specialrangeiterator_delete(pkinfo.sri);
   }
+  if (pkinfo.window != NULL) {
+    gt_diagbandseed_minimizer_flush(pkinfo.window, list);
+    gt_diagbandseed_minimizer_window_delete(pkinfo.window);
+  }
+  return pkinfo.numofkmers;
+}
+
+#ifdef GT_THREADS_ENABLED
+typedef struct {
+  GtArrayGtDiagbandseedKmerPos list;
+  const GtEncseq *encseq;
+  unsigned int seedlength;
+  GtDiagbandseedSampling sampling;
+  GtUword samplingparam;
+  GtReadmode readmode;
+  GtRange seqrange;
+  GtUword numofkmers;
+} GtDiagbandseedKmerThreadInfo;
+
+static void *gt_diagbandseed_kmers_thread(void *thread_info)
+{
+  GtDiagbandseedKmerThreadInfo *ti = (GtDiagbandseedKmerThreadInfo *)
+                                     thread_info;
+
+  ti->numofkmers = gt_diagbandseed_kmers_collect(&ti->list,
+                                                 ti->encseq,
+                                                 ti->seedlength,
+                                                 ti->sampling,
+                                                 ti->samplingparam,
+                                                 ti->readmode,
+                                                 &ti->seqrange);
+  return NULL;
+}
+
+/* Divide <seqrange> into at most <numthreads> ranges of consecutive sequences
+   of about the same total length and collect their k-mers in parallel. The
+   lists of the ranges are concatenated in the order of the sequences, so that
+   <list> is the same as that of gt_diagbandseed_kmers_collect. */
+static GtUword gt_diagbandseed_kmers_collect_threaded(
+                                       GtArrayGtDiagbandseedKmerPos *list,
+                                       const GtEncseq *encseq,
+                                       unsigned int seedlength,
+                                       GtDiagbandseedSampling sampling,
+                                       GtUword samplingparam,
+                                       GtReadmode readmode,
+                                       const GtRange *seqrange,
+                                       unsigned int numthreads)
+{
+  GtDiagbandseedKmerThreadInfo *tinfo;
+  GtArray *threads = gt_array_new(sizeof (GtThread *));
+  GtError *thread_err = gt_error_new();
+  GtUword firstpos, lastpos, nextseqnum = seqrange->start, numofkmers = 0,
+          listlen, idx;
+  unsigned int tidx, numranges = 0;
+  bool *started;
+
+  firstpos = gt_encseq_seqstartpos(encseq, seqrange->start);
+  lastpos = gt_encseq_seqstartpos(encseq, seqrange->end) +
+            gt_encseq_seqlength(encseq, seqrange->end);
+  tinfo = gt_malloc(numthreads * sizeof *tinfo);
+  started = gt_calloc(numthreads, sizeof *started);
+  for (tidx = 0; tidx < numthreads && nextseqnum <= seqrange->end; tidx++) {
+    GtDiagbandseedKmerThreadInfo *ti = tinfo + numranges;
+    GtUword lastseqnum = seqrange->end;
+
+    if (tidx + 1 < numthreads) {
+      /* last sequence starting at or before the split position; binary
+         search, as the split position may be a separator */
+      const GtUword splitpos = firstpos + (lastpos - firstpos) *
+                               (tidx + 1) / numthreads;
+      GtUword left = nextseqnum, right = seqrange->end;
+
+      while (left < right) {
+        const GtUword mid = left + (right - left + 1) / 2;
+        if (gt_encseq_seqstartpos(encseq, mid) <= splitpos) {
+          left = mid;
+        } else {
+          right = mid - 1;
+        }
+      }
+      lastseqnum = left;
+    }
+    ti->encseq = encseq;
+    ti->seedlength = seedlength;
+    ti->sampling = sampling;
+    ti->samplingparam = samplingparam;
+    ti->readmode = readmode;
+    ti->seqrange.start = nextseqnum;
+    ti->seqrange.end = lastseqnum;
+    ti->numofkmers = 0;
+    GT_INITARRAY(&ti->list, GtDiagbandseedKmerPos);
+    numranges++;
+    nextseqnum = lastseqnum + 1;
+  }
+
+  /* the first range is processed by the calling thread; if a thread cannot
+     be started, its range is processed by the calling thread afterwards */
+  for (tidx = 1; tidx < numranges; tidx++) {
+    GtDiagbandseedKmerThreadInfo *ti = tinfo + tidx;
+    GtThread *thread;
+
+    listlen = gt_diagbandseed_expected_kmers(encseq, seedlength, sampling,
+                                             samplingparam, &ti->seqrange);
+    GT_CHECKARRAYSPACEMULTI(&ti->list, GtDiagbandseedKmerPos, listlen);
+    thread = gt_thread_new(gt_diagbandseed_kmers_thread, ti, thread_err);
+    if (thread != NULL) {
+      gt_array_add(threads, thread);
+      started[tidx] = true;
+    } else {
+      gt_warning("%s; its k-mers are collected by the calling thread",
+                 gt_error_get(thread_err));
+      gt_error_unset(thread_err);
+    }
+  }
+  tinfo[0].list = *list;
+  gt_diagbandseed_kmers_thread(tinfo);
+  for (tidx = 1; tidx < numranges; tidx++) {
+    if (!started[tidx]) {
+      gt_diagbandseed_kmers_thread(tinfo + tidx);
+    }
+  }
+  for (idx = 0; idx < gt_array_size(threads); idx++) {
+    GtThread *thread = *(GtThread **) gt_array_get(threads, idx);
+    gt_thread_join(thread);
+    gt_thread_delete(thread);
+  }
+
+  /* concatenate the lists in the order of the ranges */
+  *list = tinfo[0].list;
+  numofkmers = tinfo[0].numofkmers;
+  listlen = list->nextfreeGtDiagbandseedKmerPos;
+  for (tidx = 1; tidx < numranges; tidx++) {
+    listlen += tinfo[tidx].list.nextfreeGtDiagbandseedKmerPos;
+  }
+  if (listlen > list->allocatedGtDiagbandseedKmerPos) {
+    list->spaceGtDiagbandseedKmerPos
+      = gt_realloc(list->spaceGtDiagbandseedKmerPos,
+                   listlen * sizeof *list->spaceGtDiagbandseedKmerPos);
+    list->allocatedGtDiagbandseedKmerPos = listlen;
+  }
+  for (tidx = 1; tidx < numranges; tidx++) {
+    GtArrayGtDiagbandseedKmerPos *tlist = &tinfo[tidx].list;
+
+    if (tlist->nextfreeGtDiagbandseedKmerPos > 0) {
+      memcpy(list->spaceGtDiagbandseedKmerPos +
+             list->nextfreeGtDiagbandseedKmerPos,
+             tlist->spaceGtDiagbandseedKmerPos,
+             tlist->nextfreeGtDiagbandseedKmerPos *
+             sizeof *tlist->spaceGtDiagbandseedKmerPos);
+      list->nextfreeGtDiagbandseedKmerPos
+        += tlist->nextfreeGtDiagbandseedKmerPos;
+    }
+    numofkmers += tinfo[tidx].numofkmers;
+    GT_FREEARRAY(tlist, GtDiagbandseedKmerPos);
+  }
+  gt_free(started);
+  gt_free(tinfo);
+  gt_error_delete(thread_err);
+  gt_array_delete(threads);
+  return numofkmers;
+}
+#endif
+
+/* Return a sorted list of k-mers of given seedlength from specified encseq.
+ * Only sequences in seqrange will be taken into account and only the k-mers
+ * selected by <sampling> are kept.
+ * The caller is responsible for freeing the result. */
+GtArrayGtDiagbandseedKmerPos gt_diagbandseed_get_kmers(const GtEncseq *encseq,
+                                                       unsigned int seedlength,
+                                                       GtDiagbandseedSampling
+                                                         sampling,
+                                                       GtUword samplingparam,
+                                                       GtReadmode readmode,
+                                                       const GtRange *seqrange,
+                                                       bool debug_kmer,
+                                                       bool verbose,
+                                                       GtUword known_size,
+                                                       GtDiagbandseedStats
+                                                         *stats,
+                                                       FILE *stream)
+{
+  GtArrayGtDiagbandseedKmerPos list;
+  GtTimer *timer = NULL;
+  GtDiagbandseedStatsClock clock;
+  GtUword listlen = known_size, numofkmers;
+
+  gt_assert(encseq != NULL);
+  gt_assert(seqrange->start <= seqrange->end);
+  gt_assert(seqrange->end < gt_encseq_num_of_sequences(encseq));
+
+  if (known_size == 0) {
+    listlen = gt_diagbandseed_expected_kmers(encseq, seedlength, sampling,
+                                             samplingparam, seqrange);
+  }
+
+  if (verbose) {
+    timer = gt_timer_new();
+    fprintf(stream, "# Start fetching %u-mers (expect " GT_WU ")...\n",
+            seedlength, listlen);
+    gt_timer_start(timer);
+  }
+  if (stats != NULL) {
+    gt_diagbandseed_stats_clock_start(&clock);
+  }
+
+  GT_INITARRAY(&list, GtDiagbandseedKmerPos);
+  GT_CHECKARRAYSPACEMULTI(&list, GtDiagbandseedKmerPos, listlen);
+
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1 && seqrange->start < seqrange->end) {
+    numofkmers = gt_diagbandseed_kmers_collect_threaded(&list,
+                                                        encseq,
+                                                        seedlength,
+                                                        sampling,
+                                                        samplingparam,
+                                                        readmode,
+                                                        seqrange,
+                                                        gt_jobs);
+  } else
+#endif
+  {
+    numofkmers = gt_diagbandseed_kmers_collect(&list,
+                                               encseq,
+                                               seedlength,
+                                               sampling,
+                                               samplingparam,
+                                               readmode,
+                                               seqrange);
+  }
   listlen = list.nextfreeGtDiagbandseedKmerPos;
+  if (stats != NULL) {
+    gt_diagbandseed_stats_add_clock(stats, GT_DIAGBANDSEED_STAGE_KMERS, &clock,
+                                    numofkmers, listlen);
+  }
 
   /* reduce size of array to number of entries */
   /* list.allocatedGtDiagbandseedKmerPos = listlen;
@@ -471,17 +906,28 @@ GtArrayGtDiagbandseedKmerPos gt_diagbandseed_get_kmers(const GtEncseq *encseq,
   }
 
   if (verbose) {
-    fprintf(stream, "# ...found " GT_WU " %u-mers ", listlen, seedlength);
+    if (sampling != GT_DIAGBANDSEED_SAMPLE_ALL) {
+      fprintf(stream, "# ...sampled " GT_WU " of " GT_WU " %u-mers (%.1f%%) ",
+              listlen, numofkmers, seedlength,
+              numofkmers > 0 ? 100.0 * listlen / numofkmers : 0.0);
+    } else {
+      fprintf(stream, "# ...found " GT_WU " %u-mers ", listlen, seedlength);
+    }
     gt_timer_show_formatted(timer, GT_DIAGBANDSEED_FMT, stream);
     gt_timer_start(timer);
   }
 
-  /* sort list */
-  rdxinfo = gt_radixsort_new_ulongpair(listlen);
+  /* sort list, using gt_jobs threads */
+  if (stats != NULL) {
+    gt_diagbandseed_stats_clock_start(&clock);
+  }
   gt_radixsort_inplace_GtUwordPair((GtUwordPair *)
                                    list.spaceGtDiagbandseedKmerPos,
                                    listlen);
-  gt_radixsort_delete(rdxinfo);
+  if (stats != NULL) {
+    gt_diagbandseed_stats_add_clock(stats, GT_DIAGBANDSEED_STAGE_SORT, &clock,
+                                    listlen, listlen);
+  }
 
   if (verbose) {
     fprintf(stream, "# ...sorted " GT_WU " %u-mers ", listlen, seedlength);
@@ -496,6 +942,7 @@ GtArrayGtDiagbandseedKmerPos gt_diagbandseed_get_kmers(const GtEncseq *encseq,
 
 typedef struct {
   GtArrayGtDiagbandseedKmerPos segment;
+  GtUword numofkmers; /* number of k-mers delivered since the last reset */
   bool at_end;
   /* for list based iterator */
   const GtArrayGtDiagbandseedKmerPos *origin_list;
@@ -510,6 +957,7 @@ static void gt_diagbandseed_kmer_iter_reset(GtDiagbandseedKmerIterator *ki)
 {
   gt_assert(ki != NULL);
   ki->at_end = false;
+  ki->numofkmers = 0;
   if (ki->origin_list != NULL) { /* list based */
     ki->listptr = ki->origin_list->spaceGtDiagbandseedKmerPos;
     ki->segment.spaceGtDiagbandseedKmerPos = ki->listptr;
@@ -604,6 +1052,7 @@ static const GtArrayGtDiagbandseedKmerPos *gt_diagbandseed_kmer_iter_next(
       ki->at_end = true;
     }
   }
+  ki->numofkmers += ki->segment.nextfreeGtDiagbandseedKmerPos;
   return &ki->segment;
 }
 
@@ -654,14 +1103,121 @@ static void gt_diagbandseed_processhistogram(GtUword *histogram,
   histogram[maxgram] = count;
 }
 
-/* Returns a GtDiagbandseedSeedPair list of equal kmers from the iterators. */
+/* The seed pairs of all blocks are collected in a single pass over the
+   k-mer lists. Whenever the buffer of the merge is full, it is sorted and
+   appended to a temporary file as a run, and the merge resumes where it
+   stopped. As a run is sorted by the first sequence number, the seed pairs
+   of a block form one segment of it, and as the blocks are processed in
+   order, the segments of each run are read one after the other. So for each
+   run only the position of its next segment is stored. */
+#define GT_DIAGBANDSEED_RUNCHUNK ((GtUword) 1024)
+
+typedef struct {
+  GtUword nextindex, /* file index of the first seed pair not yet read */
+          endindex, /* file index of the end of the run */
+          nextaseqnum; /* first sequence number of the seed pair at
+                          <nextindex> */
+} GtDiagbandseedSeedPairRun;
+
+typedef struct {
+  FILE *fp;
+  GtUword bufsize, /* number of seed pairs in the buffer of the merge */
+          numblocks,
+          numruns,
+          numstored, /* number of seed pairs in the file */
+          *firstseq; /* first sequence of each block */
+  GtDiagbandseedSeedPairRun *runtab;
+} GtDiagbandseedSeedPairRuns;
+
+static void gt_diagbandseed_runs_add(GtDiagbandseedSeedPairRuns *runs,
+                                     GtArrayGtDiagbandseedSeedPair *mlist)
+{
+  const GtUword mlen = mlist->nextfreeGtDiagbandseedSeedPair;
+  GtDiagbandseedSeedPair *mspace = mlist->spaceGtDiagbandseedSeedPair;
+  GtDiagbandseedSeedPairRun *run;
+
+  if (mlen == 0) {
+    return;
+  }
+  if (runs->fp == NULL) {
+    runs->fp = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  }
+  gt_radixsort_inplace_Gtuint64keyPair((Gtuint64keyPair*) mspace, mlen);
+  runs->runtab = gt_realloc(runs->runtab,
+                            (runs->numruns + 1) * sizeof *runs->runtab);
+  run = runs->runtab + runs->numruns;
+  run->nextindex = runs->numstored;
+  run->endindex = runs->numstored + mlen;
+  run->nextaseqnum = mspace[0].aseqnum;
+  gt_xfwrite(mspace, sizeof *mspace, mlen, runs->fp);
+  runs->numstored += mlen;
+  runs->numruns++;
+  mlist->nextfreeGtDiagbandseedSeedPair = 0;
+}
+
+/* Append the seed pairs of <block> from all runs to <mlist>. The blocks must
+   be read in order. Each run is read in chunks of GT_DIAGBANDSEED_RUNCHUNK
+   seed pairs directly behind the seed pairs in <mlist>, so <mlist> must
+   have space for this many seed pairs more than the block contains. */
+static void gt_diagbandseed_runs_read(GtArrayGtDiagbandseedSeedPair *mlist,
+                                      GtDiagbandseedSeedPairRuns *runs,
+                                      GtUword block)
+{
+  const GtUword endseq = block + 1 < runs->numblocks
+                           ? runs->firstseq[block + 1]
+                           : GT_UWORD_MAX;
+  GtUword idx;
+
+  gt_assert(block < runs->numblocks);
+  for (idx = 0; idx < runs->numruns; idx++) {
+    GtDiagbandseedSeedPairRun *run = runs->runtab + idx;
+
+    if (run->nextindex == run->endindex || run->nextaseqnum >= endseq) {
+      continue;
+    }
+    gt_xfseek(runs->fp, (GtWord) (run->nextindex *
+                                  sizeof (GtDiagbandseedSeedPair)),
+              SEEK_SET);
+    while (run->nextindex < run->endindex) {
+      const GtUword len = MIN(GT_DIAGBANDSEED_RUNCHUNK,
+                              run->endindex - run->nextindex);
+      GtDiagbandseedSeedPair *chunk = mlist->spaceGtDiagbandseedSeedPair +
+                                      mlist->nextfreeGtDiagbandseedSeedPair;
+      GtUword kept = 0;
+
+      gt_assert(mlist->nextfreeGtDiagbandseedSeedPair + len <=
+                mlist->allocatedGtDiagbandseedSeedPair);
+      gt_xfread(chunk, sizeof *chunk, len, runs->fp);
+      while (kept < len && chunk[kept].aseqnum < endseq) {
+        kept++;
+      }
+      mlist->nextfreeGtDiagbandseedSeedPair += kept;
+      run->nextindex += kept;
+      if (kept < len) {
+        run->nextaseqnum = chunk[kept].aseqnum;
+        break;
+      }
+    }
+  }
+}
+
+/* Returns a GtDiagbandseedSeedPair list of equal kmers from the iterators.
+   Exactly one of <mlist>, <histogram> and <seqcounts> is not NULL. In the
+   latter case, the number of seed pairs is counted for each sequence of the
+   first set, relative to <aseqwindow>->start. If <aseqwindow> is not NULL,
+   only seed pairs whose first sequence lies in this range are considered.
+   If <runs> is not NULL, <mlist> is written to it whenever it holds
+   <runs>->bufsize seed pairs. */
 static void gt_diagbandseed_merge(GtArrayGtDiagbandseedSeedPair *mlist,
+                                  GtDiagbandseedSeedPairRuns *runs,
                                   GtDiagbandseedKmerIterator *aiter,
                                   GtDiagbandseedKmerIterator *biter,
                                   GtUword *maxfreq,
                                   GtUword maxgram,
                                   GtUword memlimit,
                                   GtUword *histogram,
+                                  GtUword *seqcounts,
+                                  const GtRange *aseqwindow,
                                   const GtRange *seedpairdistance,
                                   bool selfcomp,
                                   bool alist_blist_id,
@@ -674,8 +1230,10 @@ static void gt_diagbandseed_merge(GtArrayGtDiagbandseedSeedPair *mlist,
   GtUword frequency = 0;
 
   gt_assert(aiter != NULL && biter != NULL && maxfreq != NULL);
-  gt_assert((histogram == NULL && mlist != NULL) ||
-            (histogram != NULL && mlist == NULL));
+  gt_assert((histogram == NULL && seqcounts == NULL && mlist != NULL) ||
+            (histogram != NULL && seqcounts == NULL && mlist == NULL) ||
+            (histogram == NULL && seqcounts != NULL && mlist == NULL));
+  gt_assert(seqcounts == NULL || aseqwindow != NULL);
   alist = gt_diagbandseed_kmer_iter_next(aiter);
   blist = gt_diagbandseed_kmer_iter_next(biter);
   while (alist != NULL && blist != NULL) {
@@ -698,15 +1256,31 @@ static void gt_diagbandseed_merge(GtArrayGtDiagbandseedSeedPair *mlist,
         } else {
           GtDiagbandseedKmerPos *aptr, *bptr;
           for (aptr = asegment; aptr < asegment + alen; aptr++) {
+            if (aseqwindow != NULL &&
+                (aptr->seqnum < aseqwindow->start ||
+                 aptr->seqnum > aseqwindow->end)) {
+              continue;
+            }
+            if (seqcounts != NULL && !selfcomp) {
+              seqcounts[aptr->seqnum - aseqwindow->start] += blen;
+              continue;
+            }
             for (bptr = bsegment; bptr < bsegment + blen; bptr++) {
               if (!selfcomp || aptr->seqnum < bptr->seqnum ||
                   (aptr->seqnum == bptr->seqnum &&
                    aptr->endpos + seedpairdistance->start <= bptr->endpos &&
                    aptr->endpos + seedpairdistance->end >= bptr->endpos)) {
                 /* no duplicates from the same dataset */
-                if (histogram == NULL) {
+                if (seqcounts != NULL) {
+                  /* count seed pairs per sequence of the first set */
+                  seqcounts[aptr->seqnum - aseqwindow->start]++;
+                } else if (histogram == NULL) {
                   /* save SeedPair in mlist */
                   GtDiagbandseedSeedPair *seedptr = NULL;
+                  if (runs != NULL &&
+                      mlist->nextfreeGtDiagbandseedSeedPair == runs->bufsize) {
+                    gt_diagbandseed_runs_add(runs, mlist);
+                  }
                   GT_GETNEXTFREEINARRAY(seedptr,
                                         mlist,
                                         GtDiagbandseedSeedPair,
@@ -825,12 +1399,14 @@ static int gt_diagbandseed_get_mlen_maxfreq(GtUword *mlen,
                                             bool selfcomp,
                                             bool alist_blist_id,
                                             bool verbose,
+                                            GtDiagbandseedStats *stats,
                                             FILE *stream,
                                             GtError *err)
 {
   const GtUword maxgram = MIN(*maxfreq, 8190) + 1; /* Cap on k-mer count */
   GtUword *histogram = NULL;
   GtTimer *timer = NULL;
+  GtDiagbandseedStatsClock clock;
   int had_err = 0;
 
   if (memlimit == GT_UWORD_MAX) {
@@ -844,20 +1420,30 @@ static int gt_diagbandseed_get_mlen_maxfreq(GtUword *mlen,
   }
 
   /* build histogram; histogram[maxgram] := estimation for mlen */
+  if (stats != NULL) {
+    gt_diagbandseed_stats_clock_start(&clock);
+  }
   histogram = gt_calloc(maxgram + 1, sizeof *histogram);
   gt_diagbandseed_merge(NULL, /* mlist not needed: just count */
+                        NULL,
                         aiter,
                         biter,
                         maxfreq,
                         maxgram,
                         memlimit,
                         histogram,
+                        NULL, /* seqcounts not needed */
+                        NULL, /* use all sequences */
                         seedpairdistance,
                         selfcomp,
                         alist_blist_id,
                         len_used);
   *mlen = histogram[maxgram];
   gt_free(histogram);
+  if (stats != NULL) { /* counting pass: time only */
+    gt_diagbandseed_stats_add_clock(stats, GT_DIAGBANDSEED_STAGE_SEEDPAIRS,
+                                    &clock, 0, 0);
+  }
 
   if (verbose) {
     gt_timer_show_formatted(timer,
@@ -888,6 +1474,61 @@ static int gt_diagbandseed_get_mlen_maxfreq(GtUword *mlen,
   return had_err;
 }
 
+/* Sort the seed pairs of <mlist> and show them if <debug_seedpair> is set. */
+static void gt_diagbandseed_sort_seedpairs(GtArrayGtDiagbandseedSeedPair
+                                             *mlist,
+                                           GT_UNUSED const GtEncseq *aencseq,
+                                           GT_UNUSED const GtEncseq *bencseq,
+                                           bool debug_seedpair,
+                                           bool verbose,
+                                           GtDiagbandseedStats *stats,
+                                           FILE *stream)
+{
+  const GtUword mlen = mlist->nextfreeGtDiagbandseedSeedPair;
+  GtDiagbandseedSeedPair *mspace = mlist->spaceGtDiagbandseedSeedPair;
+  GtTimer *timer = NULL;
+  GtDiagbandseedStatsClock clock;
+
+  if (mlen == 0) {
+    return;
+  }
+  if (verbose) {
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+  }
+  if (stats != NULL) {
+    gt_diagbandseed_stats_clock_start(&clock);
+  }
+
+  gt_radixsort_inplace_Gtuint64keyPair((Gtuint64keyPair*) mspace, mlen);
+  if (stats != NULL) {
+    gt_diagbandseed_stats_add_clock(stats, GT_DIAGBANDSEED_STAGE_SORT,
+                                    &clock, mlen, mlen);
+  }
+
+  if (verbose) {
+    fprintf(stream, "# ...sorted " GT_WU " seed pairs ", mlen);
+    gt_timer_show_formatted(timer, GT_DIAGBANDSEED_FMT, stream);
+    gt_timer_delete(timer);
+  }
+
+  if (debug_seedpair) {
+    const GtDiagbandseedSeedPair *curr_sp;
+#ifndef NDEBUG
+    GtUword anumofseq = gt_encseq_num_of_sequences(aencseq);
+    GtUword bnumofseq = gt_encseq_num_of_sequences(bencseq);
+#endif
+    for (curr_sp = mspace; curr_sp < mspace + mlen; curr_sp++) {
+      gt_assert(curr_sp->aseqnum < anumofseq);
+      gt_assert(curr_sp->bseqnum < bnumofseq);
+      fprintf(stream, "# SeedPair (" "%"PRIu32
+                      ",%"PRIu32",%"PRIu32",%"PRIu32")\n",
+              curr_sp->aseqnum, curr_sp->bseqnum,
+              curr_sp->apos, curr_sp->bpos);
+    }
+  }
+}
+
 /* Return a sorted list of SeedPairs from given Kmer-Iterators.
  * Parameter known_size > 0 can be given to allocate the memory beforehand.
  * The caller is responsible for freeing the result. */
@@ -898,14 +1539,16 @@ static GtArrayGtDiagbandseedSeedPair gt_diagbandseed_get_seedpairs(
                                   GtUword known_size,
                                   GtRange *seedpairdistance,
                                   bool selfcomp,
-                                  GT_UNUSED const GtEncseq *aencseq,
-                                  GT_UNUSED const GtEncseq *bencseq,
+                                  const GtEncseq *aencseq,
+                                  const GtEncseq *bencseq,
                                   bool debug_seedpair,
                                   bool verbose,
+                                  GtDiagbandseedStats *stats,
                                   FILE *stream)
 {
   GtArrayGtDiagbandseedSeedPair mlist;
   GtTimer *timer = NULL;
+  GtDiagbandseedStatsClock clock;
   GtUword mlen;
 
   if (verbose) {
@@ -920,6 +1563,9 @@ static GtArrayGtDiagbandseedSeedPair gt_diagbandseed_get_seedpairs(
   }
 
   /* allocate mlist space according to seed pair count */
+  if (stats != NULL) {
+    gt_diagbandseed_stats_clock_start(&clock);
+  }
   GT_INITARRAY(&mlist, GtDiagbandseedSeedPair);
   if (known_size > 0) {
     GT_CHECKARRAYSPACEMULTI(&mlist, GtDiagbandseedSeedPair, known_size);
@@ -927,171 +1573,338 @@ static GtArrayGtDiagbandseedSeedPair gt_diagbandseed_get_seedpairs(
 
   /* create mlist */
   gt_diagbandseed_merge(&mlist,
+                        NULL, /* keep all seed pairs in memory */
                         aiter,
                         biter,
                         &maxfreq,
                         GT_UWORD_MAX, /* maxgram not needed */
                         GT_UWORD_MAX, /* memlimit not needed */
                         NULL, /* histogram not needed: save seed pairs */
+                        NULL, /* seqcounts not needed */
+                        NULL, /* use all sequences */
                         seedpairdistance,
                         selfcomp,
                         false, /* not needed */
                         0); /* len_used not needed */
   mlen = mlist.nextfreeGtDiagbandseedSeedPair;
+  if (stats != NULL) {
+    gt_diagbandseed_stats_add_clock(stats, GT_DIAGBANDSEED_STAGE_SEEDPAIRS,
+                                    &clock,
+                                    aiter->numofkmers + biter->numofkmers,
+                                    mlen);
+  }
 
   if (verbose) {
     fprintf(stream, "# ...collected " GT_WU " seed pairs ", mlen);
     gt_timer_show_formatted(timer, GT_DIAGBANDSEED_FMT, stream);
+    gt_timer_delete(timer);
   }
 
   /* sort mlist */
-  if (mlen > 0) {
-    GtDiagbandseedSeedPair *mspace = mlist.spaceGtDiagbandseedSeedPair;
-    GtRadixsortinfo *rdxinfo;
-
-    if (verbose) {
-      gt_timer_start(timer);
-    }
-
-    rdxinfo = gt_radixsort_new_uint64keypair(mlen);
-    gt_radixsort_inplace_Gtuint64keyPair((Gtuint64keyPair*) mspace, mlen);
-    gt_radixsort_delete(rdxinfo);
-
-    if (verbose) {
-      fprintf(stream, "# ...sorted " GT_WU " seed pairs ", mlen);
-      gt_timer_show_formatted(timer, GT_DIAGBANDSEED_FMT, stream);
-    }
-
-    if (debug_seedpair) {
-      const GtDiagbandseedSeedPair *curr_sp;
-#ifndef NDEBUG
-      GtUword anumofseq = gt_encseq_num_of_sequences(aencseq);
-      GtUword bnumofseq = gt_encseq_num_of_sequences(bencseq);
-#endif
-      for (curr_sp = mspace; curr_sp < mspace + mlen; curr_sp++) {
-        gt_assert(curr_sp->aseqnum < anumofseq);
-        gt_assert(curr_sp->bseqnum < bnumofseq);
-        fprintf(stream, "# SeedPair (" "%"PRIu32
-                        ",%"PRIu32",%"PRIu32",%"PRIu32")\n",
-                curr_sp->aseqnum, curr_sp->bseqnum,
-                curr_sp->apos, curr_sp->bpos);
-      }
-    }
-  }
-
-  if (verbose) {
-    gt_timer_delete(timer);
-  }
+  gt_diagbandseed_sort_seedpairs(&mlist, aencseq, bencseq, debug_seedpair,
+                                 verbose, stats, stream);
   return mlist;
 }
 
 /* * * * * SEED EXTENSION * * * * */
 
-/* start seed extension for seed pairs in mlist */
-static void gt_diagbandseed_process_seeds(GtArrayGtDiagbandseedSeedPair *mlist,
-                                          const GtDiagbandseedExtendParams *arg,
-                                          void *processinfo,
-                                          GtQuerymatchoutoptions *querymoutopt,
-                                          const GtEncseq *aencseq,
-                                          const GtEncseq *bencseq,
-                                          unsigned int seedlength,
-                                          bool reverse,
-                                          bool verbose,
-                                          FILE *stream)
+typedef struct {
+  void *processinfo;
+  Polishing_info *pol_info;
+  GtQuerymatchoutoptions *querymoutopt;
+} GtDiagbandseedExtendResources;
+
+/* Create the extension info objects according to the extension parameters. */
+static GtDiagbandseedExtendResources *gt_diagbandseed_extend_resources_new(
+                                      const GtDiagbandseedExtendParams *extp)
 {
-  GtDiagbandseedScore *score = NULL;
-  GtDiagbandseedPosition *lastp = NULL;
-  GtExtendSelfmatchRelativeFunc extend_selfmatch_relative_function = NULL;
-  GtExtendQuerymatchRelativeFunc extend_querymatch_relative_function = NULL;
-  GtProcessinfo_and_querymatchspaceptr info_querymatch;
-  const GtUword amaxlen = gt_encseq_max_seq_length(aencseq),
-                bmaxlen = gt_encseq_max_seq_length(bencseq);
-  const GtDiagbandseedSeedPair *lm = NULL, *maxsegm, *nextsegm, *seed_pair;
-  const GtUword ndiags = (amaxlen >> arg->logdiagbandwidth) +
-                         (bmaxlen >> arg->logdiagbandwidth) + 2;
-  const GtUword minsegmentlen = (arg->mincoverage - 1) / seedlength + 1;
-  GtUword mlen = 0, diag = 0;
-  bool firstinrange = true;
-  GtUword count_extensions = 0;
-  const GtReadmode query_readmode = ((arg->extendgreedy || arg->extendxdrop)
-                                     && reverse
-                                     ? GT_READMODE_REVCOMPL
-                                     : GT_READMODE_FORWARD);
-  GtTimer *timer = NULL;
-#ifdef GT_DIAGBANDSEED_SEEDHISTOGRAM
-  GtUword *seedhistogram = NULL;
-  GtUword seedcount = 0;
-#endif
-
-  /* select extension method */
-  info_querymatch.processinfo = processinfo;
-  gt_assert(mlist != NULL);
-  mlen = mlist->nextfreeGtDiagbandseedSeedPair; /* mlist length  */
-  lm = mlist->spaceGtDiagbandseedSeedPair;      /* mlist pointer */
+  GtDiagbandseedExtendResources *extres = gt_malloc(sizeof *extres);
 
-  if (mlen < minsegmentlen || mlen == 0) {
-    return;
-  }
+  gt_assert(extp != NULL);
+  extres->processinfo = NULL;
+  extres->pol_info = NULL;
+  extres->querymoutopt = NULL;
+  if (extp->extendgreedy) {
+    GtGreedyextendmatchinfo *grextinfo = NULL;
+    const double weak_errorperc = (double)(extp->weakends
+                                           ? MAX(extp->errorpercentage, 20)
+                                           : extp->errorpercentage);
 
-  if (arg->extendgreedy) {
-    extend_selfmatch_relative_function = gt_greedy_extend_selfmatch_relative;
-    extend_querymatch_relative_function = gt_greedy_extend_querymatch_relative;
-  } else if (arg->extendxdrop) {
-    extend_selfmatch_relative_function = gt_xdrop_extend_selfmatch_relative;
-    extend_querymatch_relative_function = gt_xdrop_extend_querymatch_relative;
-  } else { /* no seed extension */
-    return;
+    extres->pol_info = polishing_info_new_with_bias(weak_errorperc,
+                                                    extp->matchscore_bias,
+                                                    extp->history_size);
+    grextinfo = gt_greedy_extend_matchinfo_new(extp->errorpercentage,
+                                               extp->maxalignedlendifference,
+                                               extp->history_size,
+                                               extp->perc_mat_history,
+                                               extp->userdefinedleastlength,
+                                               extp->extend_char_access,
+                                               extp->sensitivity,
+                                               extres->pol_info);
+    if (extp->benchmark) {
+      gt_greedy_extend_matchinfo_silent_set(grextinfo);
+    }
+    extres->processinfo = (void *)grextinfo;
+  } else if (extp->extendxdrop) {
+    GtXdropmatchinfo *xdropinfo = NULL;
+    gt_assert(extp->extendgreedy == false);
+    xdropinfo = gt_xdrop_matchinfo_new(extp->userdefinedleastlength,
+                                       extp->errorpercentage,
+                                       extp->xdropbelowscore,
+                                       extp->sensitivity);
+    if (extp->benchmark) {
+      gt_xdrop_matchinfo_silent_set(xdropinfo);
+    }
+    extres->processinfo = (void *)xdropinfo;
   }
-
-  if (verbose) {
-    GtStr *add_column_header;
-    timer = gt_timer_new();
-    if (arg->extendgreedy) {
-      fprintf(stream, "# Start greedy seed pair extension...\n");
-    } else {
-      fprintf(stream, "# Start xdrop seed pair extension...\n");
+  if (extp->extendxdrop || extp->alignmentwidth > 0 ||
+      extp->verify_alignment) {
+    extres->querymoutopt = gt_querymatchoutoptions_new(true,
+                                                       false,
+                                                       extp->alignmentwidth);
+    if (extp->extendxdrop || extp->extendgreedy) {
+      const GtUword sensitivity = extp->extendxdrop ? 100UL : extp->sensitivity;
+      gt_querymatchoutoptions_extend(extres->querymoutopt,
+                                     extp->errorpercentage,
+                                     extp->maxalignedlendifference,
+                                     extp->history_size,
+                                     extp->perc_mat_history,
+                                     extp->extend_char_access,
+                                     extp->weakends,
+                                     sensitivity,
+                                     extp->matchscore_bias,
+                                     extp->always_polished_ends,
+                                     extp->display_flag);
     }
-    fprintf(stream, "# Columns: alen aseq astartpos strand blen bseq bstartpos "
-            "score editdist identity");
-    add_column_header = gt_querymatch_column_header(arg->display_flag);
-    if (gt_str_length(add_column_header) > 0)
-    {
-      fputs(gt_str_get(add_column_header),stream);
+  }
+  return extres;
+}
+
+static void gt_diagbandseed_extend_resources_delete(
+                                      GtDiagbandseedExtendResources *extres,
+                                      const GtDiagbandseedExtendParams *extp)
+{
+  if (extres != NULL) {
+    if (extp->extendgreedy) {
+      polishing_info_delete(extres->pol_info);
+      gt_greedy_extend_matchinfo_delete((GtGreedyextendmatchinfo *)
+                                        extres->processinfo);
+    } else if (extp->extendxdrop) {
+      gt_xdrop_matchinfo_delete((GtXdropmatchinfo *)extres->processinfo);
     }
-    fputc('\n',stream);
-    gt_str_delete(add_column_header);
-    gt_timer_start(timer);
+    gt_querymatchoutoptions_delete(extres->querymoutopt);
+    gt_free(extres);
   }
+}
 
-  info_querymatch.querymatchspaceptr = gt_querymatch_new();
-  info_querymatch.karlin_altschul_stat = gt_karlin_altschul_stat_new_gapped();
-  gt_karlin_altschul_stat_add_keyvalues(info_querymatch.karlin_altschul_stat,
-                                        gt_encseq_total_length(aencseq),
-                                        gt_encseq_num_of_sequences(aencseq));
-  if (arg->verify_alignment)
+/* The values which are the same for all segments of a seed pair list. */
+typedef struct {
+  const GtDiagbandseedExtendParams *arg;
+  GtExtendSelfmatchRelativeFunc extend_selfmatch_relative_function;
+  GtExtendQuerymatchRelativeFunc extend_querymatch_relative_function;
+  const GtEncseq *aencseq;
+  const GtEncseq *bencseq;
+  GtUword amaxlen;
+  GtUword bmaxlen;
+  GtUword ndiags;
+  GtUword minsegmentlen;
+  unsigned int seedlength;
+  GtReadmode query_readmode;
+  bool batchable;
+  GtDiagbandseedKernel kernel;
+  GtDiagbandseedStats *stats; /* if not NULL, the work is measured */
+} GtDiagbandseedSegmentInfo;
+
+/* The work done on seed pair lists by one or more workspaces. The diagonal
+   band filter, the extension and the output of the matches alternate for each
+   segment, so only the filter and output times are measured directly. */
+typedef struct {
+  double elapsed,  /* wall time of processing the segments */
+         busy,     /* sum of the wall times of all threads */
+         cpu,      /* CPU time of the process meanwhile */
+         filter,   /* wall time of the diagonal band filter */
+         output;   /* wall time of the match output */
+  GtUword seedpairs,
+          passed,  /* seed pairs passing the filter */
+          extensions,
+          matches;
+} GtDiagbandseedExtendTally;
+
+/* The space needed to process the segments of a seed pair list. Each thread
+   uses its own workspace. */
+typedef struct {
+  GtProcessinfo_and_querymatchspaceptr info_querymatch;
+  GtDiagbandseedScore *score;
+  GtDiagbandseedPosition *lastp;
+  uint8_t *pass;  /* coverage decisions of the seed pairs of a segment */
+  uint32_t *diags; /* diagonal bands of the seed pairs of a segment */
+  GtUword allocatedsegment;
+  GtUword allocateddiags;
+  GtUword count_extensions;
+  GtDiagbandseedExtendTally tally;
+  bool timed; /* measure the time of the filter and of the output */
+  GtDiagbandseedMatchFunc matchfunc; /* if NULL, matches are printed */
+  void *matchdata;
+#ifdef GT_THREADS_ENABLED
+  GtMutex *matchmutex; /* if not NULL, serializes the calls of matchfunc */
+#endif
+#ifdef GT_DIAGBANDSEED_SEEDHISTOGRAM
+  GtUword *seedhistogram;
+#endif
+} GtDiagbandseedWorkspace;
+
+static void gt_diagbandseed_workspace_init(GtDiagbandseedWorkspace *ws,
+                                           const GtDiagbandseedSegmentInfo *si,
+                                           void *processinfo,
+                                           GtQuerymatchoutoptions
+                                             *querymoutopt,
+                                           FILE *stream)
+{
+  ws->info_querymatch.processinfo = processinfo;
+  ws->info_querymatch.querymatchspaceptr = gt_querymatch_new();
+  ws->info_querymatch.karlin_altschul_stat
+    = gt_karlin_altschul_stat_new_gapped();
+  gt_karlin_altschul_stat_add_keyvalues(ws->info_querymatch.
+                                          karlin_altschul_stat,
+                                        gt_encseq_total_length(si->aencseq),
+                                        gt_encseq_num_of_sequences(si->
+                                                                   aencseq));
+  if (si->arg->verify_alignment)
   {
-    gt_querymatch_verify_alignment_set(info_querymatch.querymatchspaceptr);
+    gt_querymatch_verify_alignment_set(ws->info_querymatch.querymatchspaceptr);
   }
-  gt_querymatch_display_set(info_querymatch.querymatchspaceptr,
-                            arg->display_flag);
+  if (si->arg->binary)
+  {
+    gt_querymatch_binary_set(ws->info_querymatch.querymatchspaceptr);
+  }
+  gt_querymatch_display_set(ws->info_querymatch.querymatchspaceptr,
+                            si->arg->display_flag);
   if (querymoutopt != NULL) {
-    gt_querymatch_outoptions_set(info_querymatch.querymatchspaceptr,
+    gt_querymatch_outoptions_set(ws->info_querymatch.querymatchspaceptr,
                                  querymoutopt);
   }
-  gt_querymatch_query_readmode_set(info_querymatch.querymatchspaceptr,
-                                   query_readmode);
-  gt_querymatch_file_set(info_querymatch.querymatchspaceptr, stream);
+  gt_querymatch_query_readmode_set(ws->info_querymatch.querymatchspaceptr,
+                                   si->query_readmode);
+  gt_querymatch_file_set(ws->info_querymatch.querymatchspaceptr, stream);
 
   /* score[0] and score[ndiags+1] remain zero as boundaries */
-  score = gt_calloc(ndiags + 2, sizeof *score);
-  lastp = gt_calloc(ndiags, sizeof *lastp);
-  maxsegm = lm + mlen - minsegmentlen;
-  nextsegm = lm;
+  ws->score = gt_calloc(si->ndiags + 2, sizeof *ws->score);
+  ws->lastp = gt_calloc(si->ndiags, sizeof *ws->lastp);
+  ws->pass = NULL;
+  ws->diags = NULL;
+  ws->allocatedsegment = 0;
+  ws->allocateddiags = si->ndiags;
+  ws->count_extensions = 0;
+  memset(&ws->tally, 0, sizeof ws->tally);
+  ws->timed = si->stats != NULL ? true : false;
+  ws->matchfunc = NULL;
+  ws->matchdata = NULL;
+#ifdef GT_THREADS_ENABLED
+  ws->matchmutex = NULL;
+#endif
+#ifdef GT_DIAGBANDSEED_SEEDHISTOGRAM
+  ws->seedhistogram = (GtUword *)gt_calloc(GT_DIAGBANDSEED_SEEDHISTOGRAM,
+                                           sizeof *ws->seedhistogram);
+#endif
+}
+
+/* Reuse the workspace <ws> for another seed pair list with segment info
+   <si>. The score arrays are zero after each segment, so they only need to
+   be enlarged if <si> has more diagonal bands. */
+static void gt_diagbandseed_workspace_prepare(GtDiagbandseedWorkspace *ws,
+                                              const GtDiagbandseedSegmentInfo
+                                                *si)
+{
+  gt_querymatch_query_readmode_set(ws->info_querymatch.querymatchspaceptr,
+                                   si->query_readmode);
+  if (si->ndiags > ws->allocateddiags) {
+    gt_free(ws->score);
+    gt_free(ws->lastp);
+    ws->score = gt_calloc(si->ndiags + 2, sizeof *ws->score);
+    ws->lastp = gt_calloc(si->ndiags, sizeof *ws->lastp);
+    ws->allocateddiags = si->ndiags;
+  }
+  ws->count_extensions = 0;
+}
 
+/* Print <querymatch> or pass it to the match function of <ws>. */
+static void gt_diagbandseed_report_match(GtDiagbandseedWorkspace *ws,
+                                         const GtQuerymatch *querymatch)
+{
+  ws->tally.matches++;
+  if (ws->matchfunc == NULL) {
+    if (ws->timed) {
+      const double start = gt_diagbandseed_stats_wall();
+      gt_querymatch_prettyprint(querymatch);
+      ws->tally.output += gt_diagbandseed_stats_wall() - start;
+    } else {
+      gt_querymatch_prettyprint(querymatch);
+    }
+    return;
+  }
+#ifdef GT_THREADS_ENABLED
+  if (ws->matchmutex != NULL) {
+    gt_mutex_lock(ws->matchmutex);
+    ws->matchfunc(querymatch, ws->matchdata);
+    gt_mutex_unlock(ws->matchmutex);
+    return;
+  }
+#endif
+  ws->matchfunc(querymatch, ws->matchdata);
+}
+
+/* Add the work done with workspace <ws> to <tally>. */
+static void gt_diagbandseed_tally_add(GtDiagbandseedExtendTally *tally,
+                                      const GtDiagbandseedWorkspace *ws)
+{
+  tally->busy += ws->tally.busy;
+  tally->cpu += ws->tally.cpu;
+  tally->filter += ws->tally.filter;
+  tally->output += ws->tally.output;
+  tally->seedpairs += ws->tally.seedpairs;
+  tally->passed += ws->tally.passed;
+  tally->extensions += ws->count_extensions;
+  tally->matches += ws->tally.matches;
+}
+
+static void gt_diagbandseed_workspace_wrap(GtDiagbandseedWorkspace *ws)
+{
+  gt_querymatch_delete(ws->info_querymatch.querymatchspaceptr);
+  gt_karlin_altschul_stat_delete(ws->info_querymatch.karlin_altschul_stat);
+  gt_free(ws->score);
+  gt_free(ws->lastp);
+  gt_free(ws->pass);
+  gt_free(ws->diags);
 #ifdef GT_DIAGBANDSEED_SEEDHISTOGRAM
-  seedhistogram = (GtUword *)gt_calloc(GT_DIAGBANDSEED_SEEDHISTOGRAM,
-                                       sizeof *seedhistogram);
+  gt_free(ws->seedhistogram);
 #endif
+}
+
+/* Filter and extend the seed pairs from lm to lm + mlen - 1. The seed pairs of
+   one segment (i.e. equal aseqnum and bseqnum) must not be split. */
+static void gt_diagbandseed_process_segments(GtDiagbandseedWorkspace *ws,
+                                             const GtDiagbandseedSegmentInfo
+                                               *si,
+                                             const GtDiagbandseedSeedPair *lm,
+                                             GtUword mlen)
+{
+  const GtDiagbandseedExtendParams *arg = si->arg;
+  const GtDiagbandseedSeedPair *maxsegm, *nextsegm, *seed_pair;
+  const GtUword amaxlen = si->amaxlen, minsegmentlen = si->minsegmentlen;
+  const unsigned int seedlength = si->seedlength;
+  GtUword segmlen;
+  double filterstart = 0.0;
+  bool firstinrange = true;
+#ifdef GT_DIAGBANDSEED_SEEDHISTOGRAM
+  GtUword seedcount = 0;
+#endif
+
+  ws->tally.seedpairs += mlen;
+  if (mlen < minsegmentlen || mlen == 0) {
+    return;
+  }
+  maxsegm = lm + mlen - minsegmentlen;
+  nextsegm = lm;
 
   /* iterate through segments of equal k-mers */
   while (nextsegm <= maxsegm) {
@@ -1108,34 +1921,45 @@ static void gt_diagbandseed_process_seeds(GtArrayGtDiagbandseedSeedPair *mlist,
       continue;
     }
 
-    /* calculate diagonal band scores */
     do {
-      gt_assert(nextsegm->bpos <= bmaxlen && nextsegm->apos <= amaxlen);
-      diag = (amaxlen + (GtUword)nextsegm->bpos - (GtUword)nextsegm->apos)
-              >> arg->logdiagbandwidth;
-      if (nextsegm->bpos >= seedlength + lastp[diag]) {
-        /* no overlap: add seedlength */
-        score[diag + 1] += seedlength;
-      } else {
-        /* overlap: add difference below overlap */
-        gt_assert(lastp[diag] <= nextsegm->bpos); /* if fail: sort by bpos */
-        score[diag + 1] += nextsegm->bpos - lastp[diag];
-      }
-      lastp[diag] = nextsegm->bpos;
       nextsegm++;
     } while (nextsegm < lm + mlen &&
              nextsegm->aseqnum == currsegm->aseqnum &&
              nextsegm->bseqnum == currsegm->bseqnum);
+    segmlen = (GtUword) (nextsegm - currsegm);
+    if (segmlen > ws->allocatedsegment) {
+      ws->allocatedsegment = MAX(segmlen, 2 * ws->allocatedsegment);
+      ws->pass = gt_realloc(ws->pass,
+                            sizeof *ws->pass * ws->allocatedsegment);
+      ws->diags = gt_realloc(ws->diags,
+                             sizeof *ws->diags * ws->allocatedsegment);
+    }
+
+    /* calculate diagonal band scores and test for mincoverage */
+    if (ws->timed) {
+      filterstart = gt_diagbandseed_stats_wall();
+    }
+    if (si->batchable) {
+      gt_diagbandseed_score_segment(si->kernel, ws->pass, ws->diags,
+                                    ws->score, ws->lastp, currsegm, segmlen,
+                                    amaxlen, arg->logdiagbandwidth,
+                                    seedlength, arg->mincoverage);
+    } else {
+      gt_diagbandseed_score_segment_seedwise(ws->pass, ws->score, ws->lastp,
+                                             currsegm, segmlen, amaxlen,
+                                             arg->logdiagbandwidth,
+                                             seedlength, arg->mincoverage);
+    }
+    if (ws->timed) {
+      ws->tally.filter += gt_diagbandseed_stats_wall() - filterstart;
+    }
 
-    /* test for mincoverage and overlap to previous extension */
+    /* extend the seed pairs if they do not overlap a previous extension */
     firstinrange = true;
     for (seed_pair = currsegm; seed_pair < nextsegm; seed_pair++) {
       gt_assert(seed_pair->apos <= amaxlen);
-      gt_assert(seed_pair->bseqnum < gt_encseq_num_of_sequences(bencseq));
-      diag = (amaxlen + (GtUword) seed_pair->bpos - (GtUword) seed_pair->apos)
-             >> arg->logdiagbandwidth;
-      if ((GtUword)MAX(score[diag + 2], score[diag]) + (GtUword)score[diag + 1]
-          >= arg->mincoverage)
+      gt_assert(seed_pair->bseqnum < gt_encseq_num_of_sequences(si->bencseq));
+      if (ws->pass[seed_pair - currsegm])
       {
         /* relative seed start position in A and B */
         const GtUword bstart = (GtUword) (seed_pair->bpos + 1 - seedlength);
@@ -1143,81 +1967,456 @@ static void gt_diagbandseed_process_seeds(GtArrayGtDiagbandseedSeedPair *mlist,
 #ifdef GT_DIAGBANDSEED_SEEDHISTOGRAM
         seedcount++;
 #endif
+        ws->tally.passed++;
 
         if (firstinrange ||
-            !gt_querymatch_overlap(info_querymatch.querymatchspaceptr,
+            !gt_querymatch_overlap(ws->info_querymatch.querymatchspaceptr,
                                    seed_pair->apos, seed_pair->bpos,
                                    arg->use_apos))
         {
           /* extend seed */
           const GtQuerymatch *querymatch = NULL;
 
-          if (aencseq == bencseq) {
-            querymatch = extend_selfmatch_relative_function(&info_querymatch,
-                                                            aencseq,
-                                                            seed_pair->aseqnum,
-                                                            astart,
-                                                            seed_pair->bseqnum,
-                                                            bstart,
-                                                            seedlength,
-                                                            query_readmode);
+          if (si->aencseq == si->bencseq) {
+            querymatch = si->extend_selfmatch_relative_function(
+                                                       &ws->info_querymatch,
+                                                       si->aencseq,
+                                                       seed_pair->aseqnum,
+                                                       astart,
+                                                       seed_pair->bseqnum,
+                                                       bstart,
+                                                       seedlength,
+                                                       si->query_readmode);
           } else {
-            querymatch = extend_querymatch_relative_function(&info_querymatch,
-                                                             aencseq,
-                                                             seed_pair->aseqnum,
-                                                             astart,
-                                                             bencseq,
-                                                             seed_pair->bseqnum,
-                                                             bstart,
-                                                             seedlength,
-                                                             query_readmode);
+            querymatch = si->extend_querymatch_relative_function(
+                                                       &ws->info_querymatch,
+                                                       si->aencseq,
+                                                       seed_pair->aseqnum,
+                                                       astart,
+                                                       si->bencseq,
+                                                       seed_pair->bseqnum,
+                                                       bstart,
+                                                       seedlength,
+                                                       si->query_readmode);
           }
-          count_extensions++;
+          ws->count_extensions++;
           if (querymatch != NULL) {
             firstinrange = false;
             /* show extension results */
             if (gt_querymatch_check_final(querymatch, arg->errorpercentage,
                                           arg->userdefinedleastlength))
             {
-              gt_querymatch_prettyprint(querymatch);
+              gt_diagbandseed_report_match(ws, querymatch);
             }
           }
         }
       }
     }
 
-    /* reset diagonal band scores */
-    for (seed_pair = currsegm; seed_pair < nextsegm; seed_pair++) {
-      diag = (amaxlen + (GtUword) seed_pair->bpos - (GtUword) seed_pair->apos)
-             >> arg->logdiagbandwidth;
-      score[diag + 1] = 0;
-      lastp[diag] = 0;
-    }
-
 #ifdef GT_DIAGBANDSEED_SEEDHISTOGRAM
-    seedhistogram[MIN(GT_DIAGBANDSEED_SEEDHISTOGRAM - 1, seedcount)]++;
+    ws->seedhistogram[MIN(GT_DIAGBANDSEED_SEEDHISTOGRAM - 1, seedcount)]++;
     seedcount = 0;
 #endif
   }
-  gt_querymatch_delete(info_querymatch.querymatchspaceptr);
-  gt_karlin_altschul_stat_delete(info_querymatch.karlin_altschul_stat);
-  gt_free(score);
-  gt_free(lastp);
+}
 
-#ifdef GT_DIAGBANDSEED_SEEDHISTOGRAM
-  fprintf(stream, "# seed histogram:");
-  for (seedcount = 0; seedcount < GT_DIAGBANDSEED_SEEDHISTOGRAM; seedcount++) {
-    if (seedcount % 10 == 0) {
-      fprintf(stream, "\n#\t");
+#ifdef GT_THREADS_ENABLED
+/* Number of tasks per thread the seed pair list is divided into. The more
+   tasks, the better the load balance, as idle threads take the next task. */
+#define GT_DIAGBANDSEED_TASKS_PER_THREAD 16
+
+/* The output of one task is written to the temporary file of the thread which
+   processed the task. */
+typedef struct {
+  GtUword threadnum;
+  GtUword outstart;
+  GtUword outend;
+} GtDiagbandseedTaskOutput;
+
+typedef struct {
+  const GtDiagbandseedSegmentInfo *si;
+  const GtDiagbandseedSeedPair *mspace;
+  const GtUword *taskbounds;
+  GtUword numtasks;
+  GtUword *nexttask;
+  GtMutex *mutex;
+  GtDiagbandseedTaskOutput *taskoutput;
+  GtDiagbandseedExtendResources *extres;
+  GtDiagbandseedWorkspace *ws;
+  GtUword threadnum;
+  FILE *stream;
+} GtDiagbandseedExtendThreadInfo;
+
+/* Process tasks from the common task pool until it is empty. */
+static void *gt_diagbandseed_extend_thread(void *thread_info)
+{
+  GtDiagbandseedExtendThreadInfo *ti
+    = (GtDiagbandseedExtendThreadInfo *) thread_info;
+  double wall = 0.0;
+
+  if (ti->ws->timed) {
+    wall = gt_diagbandseed_stats_wall();
+  }
+  while (true) {
+    GtUword task;
+
+    gt_mutex_lock(ti->mutex);
+    task = (*ti->nexttask)++;
+    gt_mutex_unlock(ti->mutex);
+    if (task >= ti->numtasks) {
+      break;
+    }
+    if (ti->taskoutput != NULL) {
+      ti->taskoutput[task].threadnum = ti->threadnum;
+      ti->taskoutput[task].outstart = (GtUword) ftell(ti->stream);
+    }
+    gt_diagbandseed_process_segments(ti->ws,
+                                     ti->si,
+                                     ti->mspace + ti->taskbounds[task],
+                                     ti->taskbounds[task + 1] -
+                                     ti->taskbounds[task]);
+    if (ti->taskoutput != NULL) {
+      ti->taskoutput[task].outend = (GtUword) ftell(ti->stream);
+    }
+  }
+  if (ti->ws->timed) {
+    ti->ws->tally.busy += gt_diagbandseed_stats_wall() - wall;
+  }
+  return NULL;
+}
+
+/* Divide the seed pair list into tasks of about the same size, not splitting
+   segments. Returns the <*numtasks> + 1 task boundaries. */
+static GtUword *gt_diagbandseed_taskbounds(const GtDiagbandseedSeedPair *mspace,
+                                           GtUword mlen,
+                                           unsigned int numthreads,
+                                           GtUword *numtasks)
+{
+  const GtUword tasklen = MAX(mlen / (numthreads *
+                                      GT_DIAGBANDSEED_TASKS_PER_THREAD), 1);
+  GtUword *taskbounds, idx = 0;
+
+  taskbounds = gt_malloc((mlen / tasklen + 2) * sizeof *taskbounds);
+  taskbounds[0] = 0;
+  *numtasks = 0;
+  while (idx < mlen) {
+    idx = MIN(idx + tasklen, mlen);
+    while (idx < mlen && mspace[idx].aseqnum == mspace[idx - 1].aseqnum &&
+           mspace[idx].bseqnum == mspace[idx - 1].bseqnum) {
+      idx++;
+    }
+    taskbounds[++(*numtasks)] = idx;
+  }
+  return taskbounds;
+}
+
+/* Let the calling thread and <numthreads> - 1 additional threads process
+   the tasks. If a thread cannot be started, its share of the tasks is taken
+   over by the other threads. */
+static void gt_diagbandseed_extend_threads_run(GtDiagbandseedExtendThreadInfo
+                                                 *tinfo,
+                                               unsigned int numthreads)
+{
+  GtArray *threads = gt_array_new(sizeof (GtThread *));
+  GtError *thread_err = gt_error_new();
+  GtUword idx;
+  unsigned int tidx;
+
+  for (tidx = 1; tidx < numthreads; tidx++) {
+    GtThread *thread = gt_thread_new(gt_diagbandseed_extend_thread,
+                                     tinfo + tidx, thread_err);
+    if (thread != NULL) {
+      gt_array_add(threads, thread);
+    } else {
+      gt_warning("%s; its seed pairs are extended by the other threads",
+                 gt_error_get(thread_err));
+      gt_error_unset(thread_err);
+    }
+  }
+  gt_diagbandseed_extend_thread(tinfo);
+  for (idx = 0; idx < gt_array_size(threads); idx++) {
+    GtThread *thread = *(GtThread **) gt_array_get(threads, idx);
+    gt_thread_join(thread);
+    gt_thread_delete(thread);
+  }
+  gt_error_delete(thread_err);
+  gt_array_delete(threads);
+}
+
+/* Divide the seed pair list into tasks and let <numthreads> threads process
+   them. Afterwards the output of the tasks is copied to <stream> in the order
+   of the seed pair list. The work of the threads is added to <tally>. */
+static void gt_diagbandseed_process_segments_threaded(
+                                     const GtDiagbandseedSegmentInfo *si,
+                                     const GtDiagbandseedSeedPair *mspace,
+                                     GtUword mlen,
+                                     unsigned int numthreads,
+                                     GtDiagbandseedExtendTally *tally,
+                                     FILE *stream)
+{
+  GtUword *taskbounds, numtasks, idx, nexttask = 0;
+  GtDiagbandseedExtendThreadInfo *tinfo;
+  GtDiagbandseedTaskOutput *taskoutput;
+  GtDiagbandseedWorkspace *ws;
+  GtDiagbandseedStatsClock clock;
+  GtMutex *mutex = gt_mutex_new();
+  unsigned int tidx;
+  double start = 0.0, cpustart = 0.0;
+  char *buffer;
+
+  taskbounds = gt_diagbandseed_taskbounds(mspace, mlen, numthreads, &numtasks);
+  taskoutput = gt_malloc(numtasks * sizeof *taskoutput);
+
+  /* each thread has its own extension objects, workspace and output */
+  tinfo = gt_malloc(numthreads * sizeof *tinfo);
+  ws = gt_malloc(numthreads * sizeof *ws);
+  for (tidx = 0; tidx < numthreads; tidx++) {
+    tinfo[tidx].si = si;
+    tinfo[tidx].mspace = mspace;
+    tinfo[tidx].taskbounds = taskbounds;
+    tinfo[tidx].numtasks = numtasks;
+    tinfo[tidx].nexttask = &nexttask;
+    tinfo[tidx].mutex = mutex;
+    tinfo[tidx].taskoutput = taskoutput;
+    tinfo[tidx].threadnum = (GtUword) tidx;
+    tinfo[tidx].stream = gt_xtmpfp_generic(NULL,
+                                           TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+    tinfo[tidx].extres = gt_diagbandseed_extend_resources_new(si->arg);
+    tinfo[tidx].ws = ws + tidx;
+    gt_diagbandseed_workspace_init(tinfo[tidx].ws,
+                                   si,
+                                   tinfo[tidx].extres->processinfo,
+                                   tinfo[tidx].extres->querymoutopt,
+                                   tinfo[tidx].stream);
+  }
+  if (si->stats != NULL) {
+    start = gt_diagbandseed_stats_wall();
+    cpustart = gt_diagbandseed_stats_cpu();
+  }
+  gt_diagbandseed_extend_threads_run(tinfo, numthreads);
+  if (si->stats != NULL) {
+    /* the process CPU time covers all extension threads */
+    tally->elapsed += gt_diagbandseed_stats_wall() - start;
+    tally->cpu += gt_diagbandseed_stats_cpu() - cpustart;
+    gt_diagbandseed_stats_clock_start(&clock);
+  }
+
+  /* restore output order */
+  buffer = gt_malloc(BUFSIZ * sizeof *buffer);
+  for (idx = 0; idx < numtasks; idx++) {
+    FILE *fp = tinfo[taskoutput[idx].threadnum].stream;
+    GtUword remaining = taskoutput[idx].outend - taskoutput[idx].outstart;
+
+    if (remaining > 0) {
+      gt_xfseek(fp, (GtWord) taskoutput[idx].outstart, SEEK_SET);
+      while (remaining > 0) {
+        const size_t len = (size_t) MIN(remaining, (GtUword) BUFSIZ);
+        gt_xfread(buffer, sizeof *buffer, len, fp);
+        gt_xfwrite(buffer, sizeof *buffer, len, stream);
+        remaining -= (GtUword) len;
+      }
+    }
+  }
+  gt_free(buffer);
+  if (si->stats != NULL) {
+    gt_diagbandseed_stats_add_clock(si->stats, GT_DIAGBANDSEED_STAGE_OUTPUT,
+                                    &clock, 0, 0);
+  }
+
+  for (tidx = 0; tidx < numthreads; tidx++) {
+    if (si->stats != NULL) {
+      gt_diagbandseed_stats_add_thread(si->stats, (GtUword) tidx,
+                                       tinfo[tidx].ws->tally.busy);
     }
-    fprintf(stream, GT_WU "\t", seedhistogram[seedcount]);
+    gt_diagbandseed_tally_add(tally, tinfo[tidx].ws);
+    gt_diagbandseed_workspace_wrap(tinfo[tidx].ws);
+    gt_diagbandseed_extend_resources_delete(tinfo[tidx].extres, si->arg);
+    gt_fa_xfclose(tinfo[tidx].stream);
   }
-  fprintf(stream, "\n");
-  gt_free(seedhistogram);
+  gt_free(ws);
+  gt_free(tinfo);
+  gt_free(taskoutput);
+  gt_free(taskbounds);
+  gt_mutex_delete(mutex);
+}
 #endif
+
+/* Set the segment info <si> for the seed pairs of <aencseq> and <bencseq> and
+   select the extension method. Returns false if no extension is required. */
+static bool gt_diagbandseed_segment_info_set(GtDiagbandseedSegmentInfo *si,
+                                             const GtDiagbandseedExtendParams
+                                               *arg,
+                                             const GtEncseq *aencseq,
+                                             const GtEncseq *bencseq,
+                                             unsigned int seedlength,
+                                             bool reverse)
+{
+  si->arg = arg;
+  si->aencseq = aencseq;
+  si->bencseq = bencseq;
+  si->seedlength = seedlength;
+  si->amaxlen = gt_encseq_max_seq_length(aencseq);
+  si->bmaxlen = gt_encseq_max_seq_length(bencseq);
+  si->ndiags = (si->amaxlen >> arg->logdiagbandwidth) +
+               (si->bmaxlen >> arg->logdiagbandwidth) + 2;
+  si->minsegmentlen = (arg->mincoverage - 1) / seedlength + 1;
+  si->batchable = gt_diagbandseed_score_batchable(si->amaxlen, si->bmaxlen);
+  si->kernel = gt_diagbandseed_kernel_best();
+  si->stats = NULL;
+  si->query_readmode = ((arg->extendgreedy || arg->extendxdrop) && reverse
+                        ? GT_READMODE_REVCOMPL
+                        : GT_READMODE_FORWARD);
+
+  /* select extension method */
+  if (arg->extendgreedy) {
+    si->extend_selfmatch_relative_function
+      = gt_greedy_extend_selfmatch_relative;
+    si->extend_querymatch_relative_function
+      = gt_greedy_extend_querymatch_relative;
+  } else if (arg->extendxdrop) {
+    si->extend_selfmatch_relative_function
+      = gt_xdrop_extend_selfmatch_relative;
+    si->extend_querymatch_relative_function
+      = gt_xdrop_extend_querymatch_relative;
+  } else { /* no seed extension */
+    return false;
+  }
+  return true;
+}
+
+/* Add the extension work in <tally> to the filter, extend and output stages
+   of <stats>. Filtering, extending and printing are interleaved per segment,
+   so the elapsed and CPU time is split in the proportion of the busy time
+   measured for filtering and printing. */
+static void gt_diagbandseed_tally_report(GtDiagbandseedStats *stats,
+                                         const GtDiagbandseedExtendTally *tally)
+{
+  double filtershare = 0.0, outputshare = 0.0, extendshare;
+
+  if (tally->busy > 0.0) {
+    filtershare = MIN(tally->filter / tally->busy, 1.0);
+    outputshare = MIN(tally->output / tally->busy, 1.0 - filtershare);
+  }
+  extendshare = 1.0 - filtershare - outputshare;
+  gt_diagbandseed_stats_add(stats, GT_DIAGBANDSEED_STAGE_FILTER,
+                            tally->elapsed * filtershare,
+                            tally->cpu * filtershare,
+                            tally->seedpairs, tally->passed);
+  gt_diagbandseed_stats_add(stats, GT_DIAGBANDSEED_STAGE_EXTEND,
+                            tally->elapsed * extendshare,
+                            tally->cpu * extendshare,
+                            tally->extensions, tally->matches);
+  gt_diagbandseed_stats_add(stats, GT_DIAGBANDSEED_STAGE_OUTPUT,
+                            tally->elapsed * outputshare,
+                            tally->cpu * outputshare,
+                            tally->matches, tally->matches);
+}
+
+/* start seed extension for seed pairs in mlist, using <numthreads> threads */
+static void gt_diagbandseed_process_seeds(GtArrayGtDiagbandseedSeedPair *mlist,
+                                          const GtDiagbandseedExtendParams *arg,
+                                          void *processinfo,
+                                          GtQuerymatchoutoptions *querymoutopt,
+                                          const GtEncseq *aencseq,
+                                          const GtEncseq *bencseq,
+                                          unsigned int seedlength,
+                                          bool reverse,
+                                          GT_UNUSED unsigned int numthreads,
+                                          bool verbose,
+                                          GtDiagbandseedStats *stats,
+                                          FILE *stream)
+{
+  GtDiagbandseedSegmentInfo si;
+  GtDiagbandseedExtendTally tally;
+  GtUword mlen = 0;
+  GtTimer *timer = NULL;
+
+  gt_assert(mlist != NULL);
+  mlen = mlist->nextfreeGtDiagbandseedSeedPair; /* mlist length  */
+  if (!gt_diagbandseed_segment_info_set(&si, arg, aencseq, bencseq,
+                                        seedlength, reverse) ||
+      mlen < si.minsegmentlen || mlen == 0) {
+    return;
+  }
+  si.stats = stats;
+  memset(&tally, 0, sizeof tally);
+
+  if (verbose) {
+    GtStr *add_column_header;
+    timer = gt_timer_new();
+    if (arg->extendgreedy) {
+      fprintf(stream, "# Start greedy seed pair extension...\n");
+    } else {
+      fprintf(stream, "# Start xdrop seed pair extension...\n");
+    }
+    fprintf(stream, "# Columns: alen aseq astartpos strand blen bseq bstartpos "
+            "score editdist identity");
+    add_column_header = gt_querymatch_column_header(arg->display_flag);
+    if (gt_str_length(add_column_header) > 0)
+    {
+      fputs(gt_str_get(add_column_header),stream);
+    }
+    fputc('\n',stream);
+    gt_str_delete(add_column_header);
+    gt_timer_start(timer);
+  }
+
+#if defined (GT_THREADS_ENABLED) && !defined (GT_DIAGBANDSEED_SEEDHISTOGRAM)
+  if (numthreads > 1) {
+    fflush(stream);
+    gt_diagbandseed_process_segments_threaded(&si,
+                                              mlist->
+                                                spaceGtDiagbandseedSeedPair,
+                                              mlen,
+                                              numthreads,
+                                              &tally,
+                                              stream);
+  } else
+#endif
+  {
+    GtDiagbandseedWorkspace ws;
+    double wall = 0.0, cpu = 0.0;
+
+    gt_diagbandseed_workspace_init(&ws, &si, processinfo, querymoutopt,
+                                   stream);
+    if (stats != NULL) {
+      wall = gt_diagbandseed_stats_wall();
+      cpu = gt_diagbandseed_stats_cpu();
+    }
+    gt_diagbandseed_process_segments(&ws,
+                                     &si,
+                                     mlist->spaceGtDiagbandseedSeedPair,
+                                     mlen);
+    if (stats != NULL) {
+      ws.tally.busy = gt_diagbandseed_stats_wall() - wall;
+      ws.tally.cpu = gt_diagbandseed_stats_cpu() - cpu;
+      tally.elapsed = ws.tally.busy;
+      gt_diagbandseed_stats_add_thread(stats, 0, ws.tally.busy);
+    }
+    gt_diagbandseed_tally_add(&tally, &ws);
+#ifdef GT_DIAGBANDSEED_SEEDHISTOGRAM
+    {
+      GtUword seedcount;
+      fprintf(stream, "# seed histogram:");
+      for (seedcount = 0; seedcount < GT_DIAGBANDSEED_SEEDHISTOGRAM;
+           seedcount++) {
+        if (seedcount % 10 == 0) {
+          fprintf(stream, "\n#\t");
+        }
+        fprintf(stream, GT_WU "\t", ws.seedhistogram[seedcount]);
+      }
+      fprintf(stream, "\n");
+    }
+#endif
+    gt_diagbandseed_workspace_wrap(&ws);
+  }
+  if (stats != NULL) {
+    gt_diagbandseed_tally_report(stats, &tally);
+  }
+
   if (verbose) {
     fprintf(stream, "# ...finished " GT_WU " seed pair extension%s ",
-            count_extensions, count_extensions > 1 ? "s" : "");
+            tally.extensions, tally.extensions > 1 ? "s" : "");
     gt_timer_show_formatted(timer, GT_DIAGBANDSEED_FMT, stream);
     gt_timer_delete(timer);
   }
@@ -1225,8 +2424,8 @@ static void gt_diagbandseed_process_seeds(GtArrayGtDiagbandseedSeedPair *mlist,
 
 /* * * * * ALGORITHM STEPS * * * * */
 
-static char *gt_diagbandseed_kmer_filename(const GtEncseq *encseq,
-                                           unsigned int seedlength,
+static char *gt_diagbandseed_kmer_filename(const GtDiagbandseedInfo *arg,
+                                           const GtEncseq *encseq,
                                            bool forward,
                                            unsigned int numparts,
                                            unsigned int partindex)
@@ -1234,38 +2433,266 @@ static char *gt_diagbandseed_kmer_filename(const GtEncseq *encseq,
   char *filename;
   GtStr *str = gt_str_new_cstr(gt_encseq_indexname(encseq));
   gt_str_append_char(str, '.');
-  gt_str_append_uint(str, seedlength);
+  gt_str_append_uint(str, arg->seedlength);
   gt_str_append_char(str, forward ? 'f' : 'r');
   gt_str_append_uint(str, numparts);
   gt_str_append_char(str, '-');
   gt_str_append_uint(str, partindex + 1);
+  if (arg->sampling != GT_DIAGBANDSEED_SAMPLE_ALL) {
+    gt_str_append_char(str, '.');
+    gt_str_append_char(str, arg->sampling == GT_DIAGBANDSEED_SAMPLE_MINIMIZER
+                              ? 'm' : 's');
+    gt_str_append_uword(str, arg->samplingparam);
+  }
   gt_str_append_cstr(str, ".kmer");
   filename = gt_cstr_dup(gt_str_get(str));
   gt_str_delete(str);
   return filename;
 }
 
-/* Go through the different steps of the seed and extend algorithm. */
+/* Return in <spblocksize> the number of seed pairs of a block. If a memory
+   limit is given, the k-mer lists of <len_used> elements take their share of
+   it first. */
+static int gt_diagbandseed_spblocksize(GtUword *spblocksize,
+                                       const GtDiagbandseedInfo *arg,
+                                       GtUword len_used,
+                                       GtError *err)
+{
+  const GtUword kmermem = len_used * sizeof (GtDiagbandseedKmerPos);
+
+  if (arg->memlimit < kmermem + sizeof (GtDiagbandseedSeedPair)) {
+    gt_error_set(err,
+                 "option -memlimit too strict: need at least " GT_WU "MB",
+                 (kmermem >> 20) + 1);
+    return -1;
+  }
+  *spblocksize = MIN(arg->spblocksize,
+                     (arg->memlimit - kmermem) /
+                     sizeof (GtDiagbandseedSeedPair));
+  return 0;
+}
+
+/* Generate, sort and extend the seed pairs of the given k-mer iterators block
+   by block. First the seed pairs are counted for each sequence of the first
+   set. Then consecutive sequences are combined to blocks of at most
+   <spblocksize> seed pairs. A single sequence with more seed pairs forms a
+   block of its own, which exceeds this size, as the seed pairs of a sequence
+   are extended together. All seed pairs are then collected in one pass over
+   the k-mer lists, using a buffer of <spblocksize> seed pairs which is
+   written to a temporary file whenever it is full. Finally, the seed pairs
+   of each block are read, sorted and extended. As the seed pairs are sorted
+   by the first sequence number, processing the blocks in order gives the
+   same result as processing the complete list at once. */
+static int gt_diagbandseed_process_blocks(const GtDiagbandseedInfo *arg,
+                                          GtDiagbandseedKmerIterator *aiter,
+                                          GtDiagbandseedKmerIterator *biter,
+                                          const GtDiagbandseedExtendResources
+                                            *extres,
+                                          const GtRange *aseqrange,
+                                          GtRange *seedpairdistance,
+                                          GtUword spblocksize,
+                                          bool selfcomp,
+                                          bool reverse,
+                                          unsigned int numthreads,
+                                          FILE *stream,
+                                          GtError *err)
+{
+  const GtUword numaseqs = gt_range_length(aseqrange);
+  GtUword *seqcounts, *blocklen, maxfreq = arg->maxfreq, idx, block,
+          numseedpairs = 0, maxseqlen = 0;
+  GtDiagbandseedSeedPairRuns runs;
+  GtArrayGtDiagbandseedSeedPair mlist;
+  GtTimer *timer = NULL;
+  GtDiagbandseedStatsClock clock;
+  int had_err = 0;
+
+  gt_assert(spblocksize > 0 && spblocksize < GT_UWORD_MAX);
+  if (arg->verbose) {
+    timer = gt_timer_new();
+    fprintf(stream, "# Start counting seed pairs per sequence...\n");
+    gt_timer_start(timer);
+  }
+
+  /* count seed pairs for each sequence of the first set */
+  seqcounts = gt_calloc(numaseqs, sizeof *seqcounts);
+  gt_diagbandseed_kmer_iter_reset(aiter);
+  gt_diagbandseed_kmer_iter_reset(biter);
+  gt_diagbandseed_merge(NULL, /* mlist not needed: just count */
+                        NULL,
+                        aiter,
+                        biter,
+                        &maxfreq,
+                        GT_UWORD_MAX, /* maxgram not needed */
+                        GT_UWORD_MAX, /* memlimit not needed */
+                        NULL, /* histogram not needed */
+                        seqcounts,
+                        aseqrange,
+                        seedpairdistance,
+                        selfcomp,
+                        false, /* not needed */
+                        0); /* len_used not needed */
+
+  /* combine consecutive sequences to blocks */
+  runs.fp = NULL;
+  runs.bufsize = spblocksize;
+  runs.numblocks = runs.numruns = runs.numstored = 0;
+  runs.runtab = NULL;
+  runs.firstseq = gt_malloc(numaseqs * sizeof *runs.firstseq);
+  blocklen = gt_malloc(numaseqs * sizeof *blocklen);
+  idx = 0;
+  while (idx < numaseqs) {
+    runs.firstseq[runs.numblocks] = aseqrange->start + idx;
+    blocklen[runs.numblocks] = seqcounts[idx];
+    maxseqlen = MAX(maxseqlen, seqcounts[idx]);
+    for (idx++; idx < numaseqs &&
+                blocklen[runs.numblocks] + seqcounts[idx] <= spblocksize;
+         idx++) {
+      blocklen[runs.numblocks] += seqcounts[idx];
+      maxseqlen = MAX(maxseqlen, seqcounts[idx]);
+    }
+    numseedpairs += blocklen[runs.numblocks];
+    runs.numblocks++;
+  }
+  gt_free(seqcounts);
+  if (arg->verbose) {
+    fprintf(stream, "# ...counted " GT_WU " seed pairs, at most " GT_WU
+            " for one sequence, block size is " GT_WU " ", numseedpairs,
+            maxseqlen, spblocksize);
+    gt_timer_show_formatted(timer, GT_DIAGBANDSEED_FMT, stream);
+    fprintf(stream, "# Start collecting seed pairs in runs of at most " GT_WU
+            "...\n", spblocksize);
+    gt_timer_start(timer);
+  }
+
+  /* collect the seed pairs of all blocks in one pass */
+  if (arg->stats != NULL) {
+    gt_diagbandseed_stats_clock_start(&clock);
+  }
+  GT_INITARRAY(&mlist, GtDiagbandseedSeedPair);
+  GT_CHECKARRAYSPACEMULTI(&mlist, GtDiagbandseedSeedPair,
+                          MIN(numseedpairs, spblocksize));
+  gt_diagbandseed_kmer_iter_reset(aiter);
+  gt_diagbandseed_kmer_iter_reset(biter);
+  gt_diagbandseed_merge(&mlist,
+                        &runs,
+                        aiter,
+                        biter,
+                        &maxfreq,
+                        GT_UWORD_MAX, /* maxgram not needed */
+                        GT_UWORD_MAX, /* memlimit not needed */
+                        NULL, /* histogram not needed: save seed pairs */
+                        NULL, /* seqcounts not needed */
+                        NULL, /* use all sequences */
+                        seedpairdistance,
+                        selfcomp,
+                        false, /* not needed */
+                        0); /* len_used not needed */
+  if (runs.numruns > 0) {
+    /* the seed pairs of the buffer join the others in the file */
+    gt_diagbandseed_runs_add(&runs, &mlist);
+    GT_FREEARRAY(&mlist, GtDiagbandseedSeedPair);
+  }
+  if (arg->stats != NULL) {
+    gt_diagbandseed_stats_add_clock(arg->stats,
+                                    GT_DIAGBANDSEED_STAGE_SEEDPAIRS, &clock,
+                                    aiter->numofkmers + biter->numofkmers,
+                                    numseedpairs);
+  }
+  if (arg->verbose) {
+    fprintf(stream, "# ...collected " GT_WU " seed pairs in " GT_WU
+            " run%s ", numseedpairs, MAX(runs.numruns, 1),
+            runs.numruns > 1 ? "s" : "");
+    gt_timer_show_formatted(timer, GT_DIAGBANDSEED_FMT, stream);
+    gt_timer_delete(timer);
+  }
+
+  /* sort and extend the seed pairs of each block */
+  for (block = 0, idx = 0; !had_err && block < runs.numblocks; block++) {
+    GtArrayGtDiagbandseedSeedPair blocklist;
+
+    if (blocklen[block] == 0) {
+      continue;
+    }
+    if (arg->verbose) {
+      fprintf(stream, "# Process block " GT_WU " (sequences " GT_WU "..." GT_WU
+              ")\n", ++idx, runs.firstseq[block],
+              block + 1 < runs.numblocks ? runs.firstseq[block + 1] - 1
+                                         : aseqrange->end);
+    }
+    if (runs.numruns > 0) {
+      GT_INITARRAY(&blocklist, GtDiagbandseedSeedPair);
+      GT_CHECKARRAYSPACEMULTI(&blocklist, GtDiagbandseedSeedPair,
+                              blocklen[block] + GT_DIAGBANDSEED_RUNCHUNK);
+      gt_diagbandseed_runs_read(&blocklist, &runs, block);
+    } else {
+      /* all seed pairs fit into the buffer, so they form a single block */
+      gt_assert(runs.numblocks == 1);
+      blocklist = mlist;
+    }
+    gt_assert(blocklist.nextfreeGtDiagbandseedSeedPair == blocklen[block]);
+    gt_diagbandseed_sort_seedpairs(&blocklist, arg->aencseq, arg->bencseq,
+                                   arg->debug_seedpair, arg->verbose,
+                                   arg->stats, stream);
+    if (arg->verify) {
+      had_err = gt_diagbandseed_verify(arg->aencseq,
+                                       arg->bencseq,
+                                       &blocklist,
+                                       arg->seedlength,
+                                       reverse,
+                                       arg->verbose,
+                                       stream,
+                                       err);
+    }
+    if (!had_err) {
+      gt_diagbandseed_process_seeds(&blocklist,
+                                    arg->extp,
+                                    extres->processinfo,
+                                    extres->querymoutopt,
+                                    arg->aencseq,
+                                    arg->bencseq,
+                                    arg->seedlength,
+                                    reverse,
+                                    numthreads,
+                                    arg->verbose,
+                                    arg->stats,
+                                    stream);
+    }
+    if (runs.numruns > 0) {
+      GT_FREEARRAY(&blocklist, GtDiagbandseedSeedPair);
+    }
+  }
+  if (runs.numruns == 0) {
+    GT_FREEARRAY(&mlist, GtDiagbandseedSeedPair);
+  }
+  gt_fa_xfclose(runs.fp);
+  gt_free(runs.runtab);
+  gt_free(runs.firstseq);
+  gt_free(blocklen);
+  return had_err;
+}
+
+/* Go through the different steps of the seed and extend algorithm. The seed
+   extension is performed by <numthreads> threads. */
 static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                                      const GtArrayGtDiagbandseedKmerPos *alist,
                                      FILE *stream,
                                      const GtRange *aseqrange,
                                      const GtRange *bseqrange,
                                      GtUwordPair partindex,
+                                     unsigned int numthreads,
                                      GtError *err)
 {
   GtArrayGtDiagbandseedKmerPos blist;
   GtArrayGtDiagbandseedSeedPair mlist, mrevlist;
   GtDiagbandseedKmerIterator *aiter = NULL, *biter = NULL;
-  GtUword alen = 0, blen = 0, mlen = 0, mrevlen = 0, maxfreq, len_used;
+  GtUword alen = 0, blen = 0, mlen = 0, mrevlen = 0, maxfreq, len_used,
+          spblocksize = 0;
   GtRange seedpairdistance = *arg->seedpairdistance;
   char *blist_file = NULL;
   int had_err = 0;
   bool alist_blist_id, both_strands, selfcomp, equalranges, use_blist = false;
-  const GtDiagbandseedExtendParams *extp = NULL;
-  Polishing_info *pol_info = NULL;
-  void *processinfo = NULL;
-  GtQuerymatchoutoptions *querymoutopt = NULL;
+  const bool use_blocks = arg->spblocksize < GT_UWORD_MAX ? true : false;
+  GtDiagbandseedExtendResources *extres = NULL;
 
   gt_assert(arg != NULL && aseqrange != NULL && bseqrange != NULL);
 
@@ -1290,7 +2717,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
   /* Create k-mer iterator for alist */
   if (alist == NULL) {
     char *alist_file;
-    alist_file = gt_diagbandseed_kmer_filename(arg->aencseq, arg->seedlength,
+    alist_file = gt_diagbandseed_kmer_filename(arg, arg->aencseq,
                                                true, arg->anumseqranges,
                                                partindex.a);
     FILE *alist_fp = gt_fa_fopen(alist_file, "rb", err);
@@ -1312,7 +2739,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
     biter = gt_diagbandseed_kmer_iter_new_list(alist);
     blen = alen;
   } else if (arg->use_kmerfile) {
-    blist_file = gt_diagbandseed_kmer_filename(arg->bencseq, arg->seedlength,
+    blist_file = gt_diagbandseed_kmer_filename(arg, arg->bencseq,
                                                !arg->nofwd, arg->bnumseqranges,
                                                partindex.b);
     if (!gt_file_exists(blist_file)) {
@@ -1338,35 +2765,60 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
     const GtUword known_size = (selfcomp && equalranges) ? alen : 0;
     blist = gt_diagbandseed_get_kmers(arg->bencseq,
                                       arg->seedlength,
+                                      arg->sampling,
+                                      arg->samplingparam,
                                       readmode,
                                       bseqrange,
                                       arg->debug_kmer,
                                       arg->verbose,
                                       known_size,
+                                      arg->stats,
                                       stream);
     blen = blist.nextfreeGtDiagbandseedKmerPos;
     biter = gt_diagbandseed_kmer_iter_new_list(&blist);
     use_blist = true;
   }
 
+  /* Create extension info objects */
+  extres = gt_diagbandseed_extend_resources_new(arg->extp);
+
   len_used = alen;
   if (!selfcomp || !arg->norev) {
     len_used += blen;
   }
-  had_err = gt_diagbandseed_get_mlen_maxfreq(&mlen,
-                                             &maxfreq,
-                                             aiter,
-                                             biter,
-                                             arg->memlimit,
-                                             &seedpairdistance,
-                                             len_used,
-                                             selfcomp,
-                                             alist_blist_id,
-                                             arg->verbose,
-                                             stream,
-                                             err);
-
-  if (!had_err) {
+  if (use_blocks) {
+    had_err = gt_diagbandseed_spblocksize(&spblocksize, arg, len_used, err);
+    if (!had_err) {
+      had_err = gt_diagbandseed_process_blocks(arg,
+                                               aiter,
+                                               biter,
+                                               extres,
+                                               aseqrange,
+                                               &seedpairdistance,
+                                               spblocksize,
+                                               selfcomp,
+                                               arg->nofwd,
+                                               numthreads,
+                                               stream,
+                                               err);
+    }
+  } else {
+    had_err = gt_diagbandseed_get_mlen_maxfreq(&mlen,
+                                               &maxfreq,
+                                               aiter,
+                                               biter,
+                                               arg->memlimit,
+                                               &seedpairdistance,
+                                               len_used,
+                                               selfcomp,
+                                               alist_blist_id,
+                                               arg->verbose,
+                                               arg->stats,
+                                               stream,
+                                               err);
+  }
+
+  if (!had_err && !use_blocks) {
     gt_diagbandseed_kmer_iter_reset(aiter);
     gt_diagbandseed_kmer_iter_reset(biter);
     mlist = gt_diagbandseed_get_seedpairs(aiter,
@@ -1379,6 +2831,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                                           arg->bencseq,
                                           arg->debug_seedpair,
                                           arg->verbose,
+                                          arg->stats,
                                           stream);
     mlen = mlist.nextfreeGtDiagbandseedSeedPair;
 
@@ -1404,77 +2857,26 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
   gt_diagbandseed_kmer_iter_delete(biter);
   if (had_err) {
     gt_diagbandseed_kmer_iter_delete(aiter);
+    gt_diagbandseed_extend_resources_delete(extres, arg->extp);
     return had_err;
   }
 
-  /* Create extension info objects */
-  extp = arg->extp;
-  if (extp->extendgreedy) {
-    GtGreedyextendmatchinfo *grextinfo = NULL;
-    const double weak_errorperc = (double)(extp->weakends
-                                           ? MAX(extp->errorpercentage, 20)
-                                           : extp->errorpercentage);
-
-    pol_info = polishing_info_new_with_bias(weak_errorperc,
-                                            extp->matchscore_bias,
-                                            extp->history_size);
-    grextinfo = gt_greedy_extend_matchinfo_new(extp->errorpercentage,
-                                               extp->maxalignedlendifference,
-                                               extp->history_size,
-                                               extp->perc_mat_history,
-                                               extp->userdefinedleastlength,
-                                               extp->extend_char_access,
-                                               extp->sensitivity,
-                                               pol_info);
-    if (extp->benchmark) {
-      gt_greedy_extend_matchinfo_silent_set(grextinfo);
-    }
-    processinfo = (void *)grextinfo;
-  } else if (extp->extendxdrop) {
-    GtXdropmatchinfo *xdropinfo = NULL;
-    gt_assert(extp->extendgreedy == false);
-    xdropinfo = gt_xdrop_matchinfo_new(extp->userdefinedleastlength,
-                                       extp->errorpercentage,
-                                       extp->xdropbelowscore,
-                                       extp->sensitivity);
-    if (extp->benchmark) {
-      gt_xdrop_matchinfo_silent_set(xdropinfo);
-    }
-    processinfo = (void *)xdropinfo;
-  }
-  if (extp->extendxdrop || extp->alignmentwidth > 0 ||
-      extp->verify_alignment) {
-    querymoutopt = gt_querymatchoutoptions_new(true,
-                                               false,
-                                               extp->alignmentwidth);
-    if (extp->extendxdrop || extp->extendgreedy) {
-      const GtUword sensitivity = extp->extendxdrop ? 100UL : extp->sensitivity;
-      gt_querymatchoutoptions_extend(querymoutopt,
-                                     extp->errorpercentage,
-                                     extp->maxalignedlendifference,
-                                     extp->history_size,
-                                     extp->perc_mat_history,
-                                     extp->extend_char_access,
-                                     extp->weakends,
-                                     sensitivity,
-                                     extp->matchscore_bias,
-                                     extp->always_polished_ends,
-                                     extp->display_flag);
-    }
-  }
-
   /* process first mlist */
-  gt_diagbandseed_process_seeds(&mlist,
-                                arg->extp,
-                                processinfo,
-                                querymoutopt,
-                                arg->aencseq,
-                                arg->bencseq,
-                                arg->seedlength,
-                                arg->nofwd,
-                                arg->verbose,
-                                stream);
-  GT_FREEARRAY(&mlist, GtDiagbandseedSeedPair);
+  if (!use_blocks) {
+    gt_diagbandseed_process_seeds(&mlist,
+                                  arg->extp,
+                                  extres->processinfo,
+                                  extres->querymoutopt,
+                                  arg->aencseq,
+                                  arg->bencseq,
+                                  arg->seedlength,
+                                  arg->nofwd,
+                                  numthreads,
+                                  arg->verbose,
+                                  arg->stats,
+                                  stream);
+    GT_FREEARRAY(&mlist, GtDiagbandseedSeedPair);
+  }
 
   /* Third (reverse) k-mer list */
   if (both_strands) {
@@ -1482,7 +2884,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
     gt_assert(blist_file == NULL && !use_blist);
     seedpairdistance.start = 0UL;
     if (arg->use_kmerfile) {
-      blist_file = gt_diagbandseed_kmer_filename(arg->bencseq, arg->seedlength,
+      blist_file = gt_diagbandseed_kmer_filename(arg, arg->bencseq,
                                                  false, arg->bnumseqranges,
                                                  partindex.b);
       if (!gt_file_exists(blist_file)) {
@@ -1501,17 +2903,33 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
     } else {
       clist = gt_diagbandseed_get_kmers(arg->bencseq,
                                         arg->seedlength,
+                                        arg->sampling,
+                                        arg->samplingparam,
                                         GT_READMODE_COMPL,
                                         bseqrange,
                                         arg->debug_kmer,
                                         arg->verbose,
                                         blen,
+                                        arg->stats,
                                         stream);
       biter = gt_diagbandseed_kmer_iter_new_list(&clist);
       use_blist = true;
     }
 
-    if (!had_err) {
+    if (!had_err && use_blocks) {
+      had_err = gt_diagbandseed_process_blocks(arg,
+                                               aiter,
+                                               biter,
+                                               extres,
+                                               aseqrange,
+                                               &seedpairdistance,
+                                               spblocksize,
+                                               selfcomp,
+                                               true,
+                                               numthreads,
+                                               stream,
+                                               err);
+    } else if (!had_err) {
       gt_diagbandseed_kmer_iter_reset(aiter);
       had_err = gt_diagbandseed_get_mlen_maxfreq(&mrevlen,
                                                  &maxfreq,
@@ -1523,11 +2941,12 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                                                  selfcomp,
                                                  alist_blist_id,
                                                  arg->verbose,
+                                                 arg->stats,
                                                  stream,
                                                  err);
     }
 
-    if (!had_err) {
+    if (!had_err && !use_blocks) {
       gt_diagbandseed_kmer_iter_reset(aiter);
       gt_diagbandseed_kmer_iter_reset(biter);
       mrevlist = gt_diagbandseed_get_seedpairs(aiter,
@@ -1540,6 +2959,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                                                arg->bencseq,
                                                arg->debug_seedpair,
                                                arg->verbose,
+                                               arg->stats,
                                                stream);
       mrevlen = mrevlist.nextfreeGtDiagbandseedSeedPair;
 
@@ -1553,7 +2973,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                                          stream,
                                          err);
         if (had_err) {
-          GT_FREEARRAY(&mlist, GtDiagbandseedSeedPair);
+          GT_FREEARRAY(&mrevlist, GtDiagbandseedSeedPair);
         }
       }
     }
@@ -1565,28 +2985,24 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
   gt_diagbandseed_kmer_iter_delete(aiter);
 
   /* Process second (reverse) mlist */
-  if (!had_err && both_strands) {
+  if (!had_err && both_strands && !use_blocks) {
     gt_diagbandseed_process_seeds(&mrevlist,
                                   arg->extp,
-                                  processinfo,
-                                  querymoutopt,
+                                  extres->processinfo,
+                                  extres->querymoutopt,
                                   arg->aencseq,
                                   arg->bencseq,
                                   arg->seedlength,
                                   true,
+                                  numthreads,
                                   arg->verbose,
+                                  arg->stats,
                                   stream);
     GT_FREEARRAY(&mrevlist, GtDiagbandseedSeedPair);
   }
 
   /* Clean up */
-  if (extp->extendgreedy) {
-    polishing_info_delete(pol_info);
-    gt_greedy_extend_matchinfo_delete((GtGreedyextendmatchinfo *)processinfo);
-  } else if (extp->extendxdrop) {
-    gt_xdrop_matchinfo_delete((GtXdropmatchinfo *)processinfo);
-  }
-  gt_querymatchoutoptions_delete(querymoutopt);
+  gt_diagbandseed_extend_resources_delete(extres, arg->extp);
   return had_err;
 }
 
@@ -1598,6 +3014,7 @@ typedef struct{
   const GtRange *aseqranges;
   const GtRange *bseqranges;
   GtArray *combinations;
+  unsigned int extthreads;
   int had_err;
   GtError *err;
 }GtDiagbandseedThreadInfo;
@@ -1610,6 +3027,7 @@ void gt_diagbandseed_thread_info_set(GtDiagbandseedThreadInfo *ti,
                                      const GtRange *aseqranges,
                                      const GtRange *bseqranges,
                                      GtArray *combinations,
+                                     unsigned int extthreads,
                                      GtError *err)
 {
   gt_assert(ti != NULL);
@@ -1619,6 +3037,7 @@ void gt_diagbandseed_thread_info_set(GtDiagbandseedThreadInfo *ti,
   ti->aseqranges = aseqranges;
   ti->bseqranges = bseqranges;
   ti->combinations = gt_array_clone(combinations);
+  ti->extthreads = extthreads;
   ti->had_err = 0;
   ti->err = err;
 }
@@ -1637,6 +3056,7 @@ static void *gt_diagbandseed_thread_algorithm(void *thread_info)
                                                 info->aseqranges + comb->a,
                                                 info->bseqranges + comb->b,
                                                 *comb,
+                                                info->extthreads,
                                                 info->err);
       if (info->had_err) break;
     }
@@ -1671,6 +3091,207 @@ static int gt_diagbandseed_write_kmers(const GtArrayGtDiagbandseedKmerPos *list,
   }
 }
 
+/* * * * * K-MER INDEX FILE * * * * */
+
+/* A k-mer index file (.kpos) consists of the following header, followed by
+   the sorted GtDiagbandseedKmerPos entries of one part of the first sequence
+   set. K-mers occurring more than <maxfreq> times are not stored, as they
+   cannot contribute seed pairs. */
+#define GT_DIAGBANDSEED_KPOS_MAGIC   "GTKPOS"
+#define GT_DIAGBANDSEED_KPOS_VERSION 2
+
+typedef struct {
+  char magic[8];
+  uint64_t version,
+           kmerpossize, /* sizeof (GtDiagbandseedKmerPos) */
+           seedlength, /* number of positions of a seed ... */
+           seedspan, /* ... and their span, equal for contiguous seeds */
+           sampling, /* GtDiagbandseedSampling */
+           samplingparam,
+           maxfreq,
+           totallength, /* of the encoded sequence ... */
+           numofsequences, /* ... to detect outdated files */
+           firstseqnum,
+           lastseqnum,
+           numofkmers;
+} GtDiagbandseedKposHeader;
+
+static char *gt_diagbandseed_kpos_filename(const GtEncseq *encseq,
+                                           GtUword numparts,
+                                           GtUword partindex)
+{
+  char *filename;
+  GtStr *str = gt_str_new_cstr(gt_encseq_indexname(encseq));
+  if (numparts > 1) {
+    gt_str_append_char(str, '.');
+    gt_str_append_uword(str, numparts);
+    gt_str_append_char(str, '-');
+    gt_str_append_uword(str, partindex + 1);
+  }
+  gt_str_append_cstr(str, ".kpos");
+  filename = gt_cstr_dup(gt_str_get(str));
+  gt_str_delete(str);
+  return filename;
+}
+
+static void gt_diagbandseed_kpos_header_set(GtDiagbandseedKposHeader *header,
+                                            const GtDiagbandseedInfo *arg,
+                                            const GtRange *seqrange,
+                                            GtUword numofkmers)
+{
+  memset(header, 0, sizeof *header);
+  strcpy(header->magic, GT_DIAGBANDSEED_KPOS_MAGIC);
+  header->version = GT_DIAGBANDSEED_KPOS_VERSION;
+  header->kmerpossize = (uint64_t) sizeof (GtDiagbandseedKmerPos);
+  header->seedlength = (uint64_t) arg->seedlength;
+  header->seedspan = (uint64_t) arg->seedlength;
+  header->sampling = (uint64_t) arg->sampling;
+  header->samplingparam = (uint64_t) arg->samplingparam;
+  header->maxfreq = (uint64_t) arg->maxfreq;
+  header->totallength = (uint64_t) gt_encseq_total_length(arg->aencseq);
+  header->numofsequences
+    = (uint64_t) gt_encseq_num_of_sequences(arg->aencseq);
+  header->firstseqnum = (uint64_t) seqrange->start;
+  header->lastseqnum = (uint64_t) seqrange->end;
+  header->numofkmers = (uint64_t) numofkmers;
+}
+
+/* Remove the k-mers occurring more than <maxfreq> times from the sorted
+   <list>. */
+static void gt_diagbandseed_kmers_filter(GtArrayGtDiagbandseedKmerPos *list,
+                                         GtUword maxfreq)
+{
+  GtDiagbandseedKmerPos *readptr = list->spaceGtDiagbandseedKmerPos,
+                        *writeptr = list->spaceGtDiagbandseedKmerPos;
+  const GtDiagbandseedKmerPos *end = readptr +
+                                     list->nextfreeGtDiagbandseedKmerPos;
+
+  if (maxfreq == GT_UWORD_MAX) {
+    return;
+  }
+  while (readptr < end) {
+    const GtDiagbandseedKmerPos *segment = readptr;
+    do {
+      readptr++;
+    } while (readptr < end && readptr->code == segment->code);
+    if ((GtUword) (readptr - segment) <= maxfreq) {
+      if (writeptr != segment) {
+        memmove(writeptr, segment, (readptr - segment) * sizeof *segment);
+      }
+      writeptr += readptr - segment;
+    }
+  }
+  list->nextfreeGtDiagbandseedKmerPos
+    = (GtUword) (writeptr - list->spaceGtDiagbandseedKmerPos);
+}
+
+static int gt_diagbandseed_kpos_write(const GtArrayGtDiagbandseedKmerPos *list,
+                                      const char *path,
+                                      const GtDiagbandseedInfo *arg,
+                                      const GtRange *seqrange,
+                                      GtError *err)
+{
+  GtDiagbandseedKposHeader header;
+  FILE *stream;
+
+  if (arg->verbose) {
+    printf("# Write " GT_WU " %u-mers to index file %s\n",
+           list->nextfreeGtDiagbandseedKmerPos, arg->seedlength, path);
+  }
+  gt_diagbandseed_kpos_header_set(&header, arg, seqrange,
+                                  list->nextfreeGtDiagbandseedKmerPos);
+  stream = gt_fa_fopen(path, "wb", err);
+  if (stream == NULL) {
+    return -1;
+  }
+  gt_xfwrite(&header, sizeof header, (size_t) 1, stream);
+  gt_xfwrite(list->spaceGtDiagbandseedKmerPos,
+             sizeof (GtDiagbandseedKmerPos),
+             (size_t) list->nextfreeGtDiagbandseedKmerPos,
+             stream);
+  gt_fa_fclose(stream);
+  return 0;
+}
+
+/* Map the k-mer index file <path> and let <list> refer to its k-mers. The
+   mapped memory is returned via <mapped> and must be unmapped with
+   gt_fa_xmunmap() instead of freeing <list>. */
+static int gt_diagbandseed_kpos_map(GtArrayGtDiagbandseedKmerPos *list,
+                                    void **mapped,
+                                    const char *path,
+                                    const GtDiagbandseedInfo *arg,
+                                    const GtRange *seqrange,
+                                    GtError *err)
+{
+  GtDiagbandseedKposHeader expected;
+  const GtDiagbandseedKposHeader *header;
+  size_t len = 0;
+  int had_err = 0;
+
+  *mapped = gt_fa_mmap_read(path, &len, err);
+  if (*mapped == NULL) {
+    return -1;
+  }
+  header = (const GtDiagbandseedKposHeader *) *mapped;
+  gt_diagbandseed_kpos_header_set(&expected, arg, seqrange, 0);
+  if (len < sizeof *header ||
+      strncmp(header->magic, expected.magic, sizeof header->magic) != 0 ||
+      header->version != expected.version ||
+      header->kmerpossize != expected.kmerpossize) {
+    gt_error_set(err, "file %s is not a k-mer index of this version and "
+                 "platform", path);
+    had_err = -1;
+  }
+  if (!had_err && (header->seedlength != expected.seedlength ||
+                   header->seedspan != expected.seedspan)) {
+    gt_error_set(err, "k-mer index %s was built for seedlength " GT_WU
+                 ", but seedlength is %u", path, (GtUword) header->seedlength,
+                 arg->seedlength);
+    had_err = -1;
+  }
+  if (!had_err && (header->sampling != expected.sampling ||
+                   header->samplingparam != expected.samplingparam)) {
+    gt_error_set(err, "k-mer index %s was built with a different k-mer "
+                 "sampling", path);
+    had_err = -1;
+  }
+  if (!had_err && header->maxfreq < expected.maxfreq) {
+    gt_error_set(err, "k-mer index %s only contains k-mers occurring at most "
+                 GT_WU " times, remove it to use a larger maxfreq", path,
+                 (GtUword) header->maxfreq);
+    had_err = -1;
+  }
+  if (!had_err && (header->totallength != expected.totallength ||
+                   header->numofsequences != expected.numofsequences ||
+                   header->firstseqnum != expected.firstseqnum ||
+                   header->lastseqnum != expected.lastseqnum)) {
+    gt_error_set(err, "k-mer index %s does not match the sequences of %s, "
+                 "remove it to rebuild it", path,
+                 gt_encseq_indexname(arg->aencseq));
+    had_err = -1;
+  }
+  if (!had_err && (uint64_t) (len - sizeof *header) !=
+                  header->numofkmers * header->kmerpossize) {
+    gt_error_set(err, "k-mer index %s is truncated", path);
+    had_err = -1;
+  }
+  if (had_err) {
+    gt_fa_xmunmap(*mapped);
+    *mapped = NULL;
+    return had_err;
+  }
+  if (arg->verbose) {
+    printf("# Map " GT_WU " %u-mers from index file %s\n",
+           (GtUword) header->numofkmers, arg->seedlength, path);
+  }
+  /* the k-mers are only read */
+  list->spaceGtDiagbandseedKmerPos
+    = (GtDiagbandseedKmerPos *) ((char *) *mapped + sizeof *header);
+  list->nextfreeGtDiagbandseedKmerPos = (GtUword) header->numofkmers;
+  list->allocatedGtDiagbandseedKmerPos = (GtUword) header->numofkmers;
+  return 0;
+}
+
 /* Run the algorithm by iterating over all combinations of sequence ranges. */
 int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                         const GtRange *aseqranges,
@@ -1709,15 +3330,17 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
         char *path;
         if (bpick && pick->b != bidx) continue;
 
-        path = gt_diagbandseed_kmer_filename(arg->bencseq, arg->seedlength, fwd,
+        path = gt_diagbandseed_kmer_filename(arg, arg->bencseq, fwd,
                                              arg->bnumseqranges, bidx);
         if (!gt_file_exists(path)) {
           GtArrayGtDiagbandseedKmerPos blist;
           GtReadmode readmode = fwd ? GT_READMODE_FORWARD : GT_READMODE_COMPL;
 
           blist = gt_diagbandseed_get_kmers(arg->bencseq, arg->seedlength,
+                                            arg->sampling, arg->samplingparam,
                                             readmode, bseqranges + bidx,
                                             arg->debug_kmer, arg->verbose, 0,
+                                            arg->stats,
                                             stdout);
           had_err = gt_diagbandseed_write_kmers(&blist, path, arg->seedlength,
                                                 arg->verbose, err);
@@ -1731,31 +3354,59 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
   for (aidx = 0; !had_err && aidx < arg->anumseqranges; aidx++) {
     /* create alist here to prevent redundant calculations */
     char *path = NULL;
+    void *mapped = NULL;
     bool use_alist = false;
     if (apick && pick->a != aidx) continue;
 
-    if (arg->use_kmerfile) {
-      path = gt_diagbandseed_kmer_filename(arg->aencseq, arg->seedlength, true,
+    if (arg->use_kpos) {
+      path = gt_diagbandseed_kpos_filename(arg->aencseq, arg->anumseqranges,
+                                           aidx);
+      if (gt_file_exists(path)) {
+        had_err = gt_diagbandseed_kpos_map(&alist, &mapped, path, arg,
+                                           aseqranges + aidx, err);
+      } else {
+        use_alist = true;
+        alist = gt_diagbandseed_get_kmers(arg->aencseq,
+                                          arg->seedlength,
+                                          arg->sampling,
+                                          arg->samplingparam,
+                                          GT_READMODE_FORWARD,
+                                          aseqranges + aidx,
+                                          arg->debug_kmer,
+                                          arg->verbose,
+                                          0,
+                                          arg->stats,
+                                          stdout);
+        gt_diagbandseed_kmers_filter(&alist, arg->maxfreq);
+        had_err = gt_diagbandseed_kpos_write(&alist, path, arg,
+                                             aseqranges + aidx, err);
+      }
+    } else if (arg->use_kmerfile) {
+      path = gt_diagbandseed_kmer_filename(arg, arg->aencseq, true,
                                            arg->anumseqranges, aidx);
     }
 
-    if (!arg->use_kmerfile || !gt_file_exists(path)) {
+    if (!arg->use_kpos && (!arg->use_kmerfile || !gt_file_exists(path))) {
       use_alist = true;
       alist = gt_diagbandseed_get_kmers(arg->aencseq,
                                         arg->seedlength,
+                                        arg->sampling,
+                                        arg->samplingparam,
                                         GT_READMODE_FORWARD,
                                         aseqranges + aidx,
                                         arg->debug_kmer,
                                         arg->verbose,
                                         0,
+                                        arg->stats,
                                         stdout);
       if (arg->use_kmerfile) {
         had_err = gt_diagbandseed_write_kmers(&alist, path, arg->seedlength,
                                               arg->verbose, err);
       }
     }
-    if (arg->use_kmerfile) {
-      gt_free(path);
+    gt_free(path);
+    if (mapped != NULL) {
+      use_alist = true;
     }
     bidx = self ? aidx : 0;
 
@@ -1772,15 +3423,18 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                                               aseqranges + aidx,
                                               bseqranges + bidx,
                                               partindex,
+                                              1U,
                                               err);
         }
         bidx++;
       }
 #ifdef GT_THREADS_ENABLED
-    } else if (!arg->use_kmerfile) {
+    } else if (!arg->use_kmerfile || arg->use_kpos) {
       const GtUword num_runs = bpick ? 1 : arg->bnumseqranges - bidx;
       const GtUword num_runs_per_thread = (num_runs - 1) / gt_jobs + 1;
       const GtUword num_threads = (num_runs - 1) / num_runs_per_thread + 1;
+      /* cores not needed for the parts are used for the seed extension */
+      const unsigned int extthreads = gt_jobs / (unsigned int) num_threads;
       GtArray *combinations = gt_array_new(sizeof (GtUwordPair));
       GtArray *threads = gt_array_new(sizeof (GtThread *));
 
@@ -1806,6 +3460,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                                         aseqranges,
                                         bseqranges,
                                         combinations,
+                                        extthreads,
                                         err);
         gt_array_reset(combinations);
         if ((thread = gt_thread_new(gt_diagbandseed_thread_algorithm,
@@ -1835,6 +3490,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                                         aseqranges,
                                         bseqranges,
                                         combinations,
+                                        extthreads,
                                         err);
         gt_diagbandseed_thread_algorithm(tinfo);
       }
@@ -1854,15 +3510,18 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
       gt_array_delete(combinations);
     }
 #endif
-    if (use_alist) {
+    if (mapped != NULL) {
+      gt_fa_xmunmap(mapped);
+    } else if (use_alist) {
       GT_FREEARRAY(&alist, GtDiagbandseedKmerPos);
     }
   }
 #ifdef GT_THREADS_ENABLED
-  if (gt_jobs > 1 && arg->use_kmerfile) {
+  if (gt_jobs > 1 && arg->use_kmerfile && !arg->use_kpos) {
     GtArray *combinations[gt_jobs];
     GtArray *threads = gt_array_new(sizeof (GtThread *));
     GtUword counter = 0;
+    unsigned int extthreads;
     for (tidx = 0; tidx < gt_jobs; tidx++) {
       combinations[tidx] = gt_array_new(sizeof (GtUwordPair));
     }
@@ -1875,6 +3534,8 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
         }
       }
     }
+    /* cores not needed for the parts are used for the seed extension */
+    extthreads = gt_jobs / (unsigned int) MAX(MIN(counter, gt_jobs), 1);
 
     for (tidx = 1; !had_err && tidx < gt_jobs; tidx++) {
       GtThread *thread;
@@ -1885,6 +3546,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                                       aseqranges,
                                       bseqranges,
                                       combinations[tidx],
+                                      extthreads,
                                       err);
       if ((thread = gt_thread_new(gt_diagbandseed_thread_algorithm,
                                   tinfo + tidx, err)) != NULL) {
@@ -1902,6 +3564,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                                       aseqranges,
                                       bseqranges,
                                       combinations[0],
+                                      extthreads,
                                       err);
       gt_diagbandseed_thread_algorithm(tinfo);
     }
@@ -1924,12 +3587,14 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
   }
   gt_free(tinfo);
 
-  /* print the threads' output to stdout */
+  /* print the threads' output to stdout, which may be binary */
   for (tidx = 1; tidx < gt_jobs; tidx++) {
-    char cc;
+    char buffer[BUFSIZ];
+    size_t len;
     rewind(stream[tidx]);
-    while ((cc = fgetc(stream[tidx])) != EOF) {
-      putchar(cc);
+    while ((len = fread(buffer, sizeof *buffer, sizeof buffer,
+                        stream[tidx])) > 0) {
+      gt_xfwrite(buffer, sizeof *buffer, len, stdout);
     }
     gt_fa_xfclose(stream[tidx]);
   }
@@ -1938,3 +3603,414 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
 #endif
   return had_err;
 }
+
+/* * * * * BATCH QUERIES * * * * */
+
+struct GtDiagbandseedEngine {
+  const GtDiagbandseedInfo *arg;
+  GtArrayGtDiagbandseedKmerPos alist;
+  void *mapped;
+  GtDiagbandseedExtendResources **extres;
+  GtDiagbandseedWorkspace *ws;
+  unsigned int numthreads;
+#ifdef GT_THREADS_ENABLED
+  GtMutex *mutex;
+#endif
+};
+
+GtDiagbandseedEngine *gt_diagbandseed_engine_new(const GtDiagbandseedInfo *arg,
+                                                 unsigned int numthreads,
+                                                 GtError *err)
+{
+  GtDiagbandseedEngine *engine;
+  GtDiagbandseedSegmentInfo si;
+  GtRange aseqrange;
+  unsigned int tidx;
+  int had_err = 0;
+
+  gt_assert(arg != NULL && numthreads > 0);
+  if (!gt_diagbandseed_segment_info_set(&si, arg->extp, arg->aencseq,
+                                        arg->aencseq, arg->seedlength,
+                                        false)) {
+    gt_error_set(err, "batch queries require a seed extension method");
+    return NULL;
+  }
+  engine = gt_malloc(sizeof *engine);
+  engine->arg = arg;
+  engine->mapped = NULL;
+#ifdef GT_THREADS_ENABLED
+  engine->numthreads = numthreads;
+  engine->mutex = gt_mutex_new();
+#else
+  engine->numthreads = 1U;
+#endif
+
+  /* the sorted k-mers of the first set are mapped or created once */
+  aseqrange.start = 0;
+  aseqrange.end = gt_encseq_num_of_sequences(arg->aencseq) - 1;
+  if (arg->use_kpos) {
+    char *path = gt_diagbandseed_kpos_filename(arg->aencseq, 1, 0);
+
+    if (gt_file_exists(path)) {
+      had_err = gt_diagbandseed_kpos_map(&engine->alist, &engine->mapped,
+                                         path, arg, &aseqrange, err);
+    } else {
+      engine->alist = gt_diagbandseed_get_kmers(arg->aencseq,
+                                                arg->seedlength,
+                                                arg->sampling,
+                                                arg->samplingparam,
+                                                GT_READMODE_FORWARD,
+                                                &aseqrange,
+                                                arg->debug_kmer,
+                                                arg->verbose,
+                                                0,
+                                                NULL,
+                                                stdout);
+      gt_diagbandseed_kmers_filter(&engine->alist, arg->maxfreq);
+      had_err = gt_diagbandseed_kpos_write(&engine->alist, path, arg,
+                                           &aseqrange, err);
+      if (had_err) {
+        GT_FREEARRAY(&engine->alist, GtDiagbandseedKmerPos);
+      }
+    }
+    gt_free(path);
+  } else {
+    engine->alist = gt_diagbandseed_get_kmers(arg->aencseq,
+                                              arg->seedlength,
+                                              arg->sampling,
+                                              arg->samplingparam,
+                                              GT_READMODE_FORWARD,
+                                              &aseqrange,
+                                              arg->debug_kmer,
+                                              arg->verbose,
+                                              0,
+                                              NULL,
+                                              stdout);
+  }
+  if (had_err) {
+#ifdef GT_THREADS_ENABLED
+    gt_mutex_delete(engine->mutex);
+#endif
+    gt_free(engine);
+    return NULL;
+  }
+
+  /* the workspaces are enlarged for longer queries when needed */
+  engine->extres = gt_malloc(engine->numthreads * sizeof *engine->extres);
+  engine->ws = gt_malloc(engine->numthreads * sizeof *engine->ws);
+  for (tidx = 0; tidx < engine->numthreads; tidx++) {
+    engine->extres[tidx] = gt_diagbandseed_extend_resources_new(arg->extp);
+    gt_diagbandseed_workspace_init(engine->ws + tidx,
+                                   &si,
+                                   engine->extres[tidx]->processinfo,
+                                   engine->extres[tidx]->querymoutopt,
+                                   stdout);
+  }
+  return engine;
+}
+
+/* Filter and extend the seed pairs of one strand of a query batch with the
+   workspaces of <engine>. */
+static void gt_diagbandseed_engine_extend(GtDiagbandseedEngine *engine,
+                                          const GtArrayGtDiagbandseedSeedPair
+                                            *mlist,
+                                          const GtEncseq *queries,
+                                          bool reverse,
+                                          GtDiagbandseedMatchFunc matchfunc,
+                                          void *data)
+{
+  const GtDiagbandseedInfo *arg = engine->arg;
+  const GtUword mlen = mlist->nextfreeGtDiagbandseedSeedPair;
+  GtDiagbandseedSegmentInfo si;
+  unsigned int tidx;
+
+  if (!gt_diagbandseed_segment_info_set(&si, arg->extp, arg->aencseq, queries,
+                                        arg->seedlength, reverse) ||
+      mlen < si.minsegmentlen || mlen == 0) {
+    return;
+  }
+  for (tidx = 0; tidx < engine->numthreads; tidx++) {
+    gt_diagbandseed_workspace_prepare(engine->ws + tidx, &si);
+    engine->ws[tidx].matchfunc = matchfunc;
+    engine->ws[tidx].matchdata = data;
+  }
+#ifdef GT_THREADS_ENABLED
+  if (engine->numthreads > 1) {
+    GtDiagbandseedExtendThreadInfo *tinfo;
+    GtUword *taskbounds, numtasks, nexttask = 0;
+    GtMutex *taskmutex = gt_mutex_new();
+
+    taskbounds = gt_diagbandseed_taskbounds(mlist->spaceGtDiagbandseedSeedPair,
+                                            mlen, engine->numthreads,
+                                            &numtasks);
+    tinfo = gt_malloc(engine->numthreads * sizeof *tinfo);
+    for (tidx = 0; tidx < engine->numthreads; tidx++) {
+      tinfo[tidx].si = &si;
+      tinfo[tidx].mspace = mlist->spaceGtDiagbandseedSeedPair;
+      tinfo[tidx].taskbounds = taskbounds;
+      tinfo[tidx].numtasks = numtasks;
+      tinfo[tidx].nexttask = &nexttask;
+      tinfo[tidx].mutex = taskmutex;
+      tinfo[tidx].taskoutput = NULL;
+      tinfo[tidx].extres = engine->extres[tidx];
+      tinfo[tidx].ws = engine->ws + tidx;
+      tinfo[tidx].threadnum = (GtUword) tidx;
+      tinfo[tidx].stream = NULL;
+      engine->ws[tidx].matchmutex = engine->mutex;
+    }
+    gt_diagbandseed_extend_threads_run(tinfo, engine->numthreads);
+    gt_free(tinfo);
+    gt_free(taskbounds);
+    gt_mutex_delete(taskmutex);
+  } else
+#endif
+  {
+    gt_diagbandseed_process_segments(engine->ws, &si,
+                                     mlist->spaceGtDiagbandseedSeedPair, mlen);
+  }
+}
+
+int gt_diagbandseed_engine_query(GtDiagbandseedEngine *engine,
+                                 const GtEncseq *queries,
+                                 GtDiagbandseedMatchFunc matchfunc,
+                                 void *data,
+                                 GtError *err)
+{
+  const GtDiagbandseedInfo *arg;
+  GtRange bseqrange;
+  unsigned int count;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(engine != NULL && queries != NULL && matchfunc != NULL);
+  arg = engine->arg;
+  bseqrange.start = 0;
+  bseqrange.end = gt_encseq_num_of_sequences(queries) - 1;
+
+  /* forward strand, then reverse complement of the queries */
+  for (count = 0; !had_err && count < 2; count++) {
+    const bool fwd = count == 0 ? true : false;
+    GtArrayGtDiagbandseedKmerPos blist;
+    GtDiagbandseedKmerIterator *aiter, *biter;
+    GtRange seedpairdistance = *arg->seedpairdistance;
+    GtUword mlen = 0, maxfreq = arg->maxfreq;
+
+    if ((fwd && arg->nofwd) || (!fwd && arg->norev)) {
+      continue;
+    }
+    blist = gt_diagbandseed_get_kmers(queries,
+                                      arg->seedlength,
+                                      arg->sampling,
+                                      arg->samplingparam,
+                                      fwd ? GT_READMODE_FORWARD
+                                          : GT_READMODE_COMPL,
+                                      &bseqrange,
+                                      false,
+                                      false,
+                                      0,
+                                      NULL,
+                                      stdout);
+    aiter = gt_diagbandseed_kmer_iter_new_list(&engine->alist);
+    biter = gt_diagbandseed_kmer_iter_new_list(&blist);
+    seedpairdistance.start = 0UL;
+    had_err = gt_diagbandseed_get_mlen_maxfreq(&mlen,
+                                               &maxfreq,
+                                               aiter,
+                                               biter,
+                                               arg->memlimit,
+                                               &seedpairdistance,
+                                               engine->alist.
+                                                 nextfreeGtDiagbandseedKmerPos +
+                                               blist.
+                                                 nextfreeGtDiagbandseedKmerPos,
+                                               false,
+                                               false,
+                                               false,
+                                               NULL,
+                                               stdout,
+                                               err);
+    if (!had_err) {
+      GtArrayGtDiagbandseedSeedPair mlist;
+
+      gt_diagbandseed_kmer_iter_reset(aiter);
+      gt_diagbandseed_kmer_iter_reset(biter);
+      mlist = gt_diagbandseed_get_seedpairs(aiter,
+                                            biter,
+                                            maxfreq,
+                                            mlen,
+                                            &seedpairdistance,
+                                            false,
+                                            arg->aencseq,
+                                            queries,
+                                            false,
+                                            false,
+                                            NULL,
+                                            stdout);
+      gt_diagbandseed_engine_extend(engine, &mlist, queries, !fwd, matchfunc,
+                                    data);
+      GT_FREEARRAY(&mlist, GtDiagbandseedSeedPair);
+    }
+    gt_diagbandseed_kmer_iter_delete(aiter);
+    gt_diagbandseed_kmer_iter_delete(biter);
+    GT_FREEARRAY(&blist, GtDiagbandseedKmerPos);
+  }
+  return had_err;
+}
+
+void gt_diagbandseed_engine_delete(GtDiagbandseedEngine *engine)
+{
+  unsigned int tidx;
+
+  if (engine == NULL) {
+    return;
+  }
+  for (tidx = 0; tidx < engine->numthreads; tidx++) {
+    gt_diagbandseed_workspace_wrap(engine->ws + tidx);
+    gt_diagbandseed_extend_resources_delete(engine->extres[tidx],
+                                            engine->arg->extp);
+  }
+  if (engine->mapped != NULL) {
+    gt_fa_xmunmap(engine->mapped);
+  } else {
+    GT_FREEARRAY(&engine->alist, GtDiagbandseedKmerPos);
+  }
+#ifdef GT_THREADS_ENABLED
+  gt_mutex_delete(engine->mutex);
+#endif
+  gt_free(engine->ws);
+  gt_free(engine->extres);
+  gt_free(engine);
+}
+
+#define GT_DIAGBANDSEED_TEST_NUMREFS    8
+#define GT_DIAGBANDSEED_TEST_REFLEN     3000
+#define GT_DIAGBANDSEED_TEST_NUMQUERIES 6
+#define GT_DIAGBANDSEED_TEST_QUERYLEN   600
+
+typedef struct {
+  GtUword numofmatches,
+          found[GT_DIAGBANDSEED_TEST_NUMQUERIES];
+  const GtUword *origin;
+} GtDiagbandseedTestMatches;
+
+static void gt_diagbandseed_test_match(const GtQuerymatch *querymatch,
+                                       void *data)
+{
+  GtDiagbandseedTestMatches *matches = (GtDiagbandseedTestMatches *) data;
+  const GtUword queryseqnum = (GtUword) gt_querymatch_queryseqnum(querymatch);
+
+  matches->numofmatches++;
+  /* odd queries are reverse complements */
+  if (gt_querymatch_dbseqnum(querymatch) == matches->origin[queryseqnum] &&
+      (gt_querymatch_query_readmode(querymatch) != GT_READMODE_FORWARD) ==
+      (queryseqnum % 2 == 1)) {
+    matches->found[queryseqnum]++;
+  }
+}
+
+int gt_diagbandseed_engine_unit_test(GtError *err)
+{
+  const char *nucleotides = "acgt";
+  char *refseq, *query;
+  GtUword origin[GT_DIAGBANDSEED_TEST_NUMQUERIES], idx, seqnum;
+  GtRange seedpairdistance = {1UL, GT_UWORD_MAX};
+  GtAlphabet *alphabet = gt_alphabet_new_dna();
+  GtEncseqBuilder *eb = gt_encseq_builder_new(alphabet);
+  GtEncseq *refs, *queries;
+  GtDiagbandseedExtendParams *extp;
+  GtDiagbandseedInfo *info;
+  unsigned int numthreads;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_encseq_builder_disable_description_support(eb);
+  gt_encseq_builder_create_ssp_tab(eb);
+  refseq = gt_malloc((GT_DIAGBANDSEED_TEST_REFLEN + 1) * sizeof *refseq);
+  query = gt_malloc((GT_DIAGBANDSEED_TEST_QUERYLEN + 1) * sizeof *query);
+
+  /* random references; the queries are mutated copies of parts of them */
+  for (seqnum = 0; seqnum < GT_DIAGBANDSEED_TEST_NUMREFS; seqnum++) {
+    for (idx = 0; idx < GT_DIAGBANDSEED_TEST_REFLEN; idx++) {
+      refseq[idx] = nucleotides[gt_rand_max(3)];
+    }
+    gt_encseq_builder_add_cstr(eb, refseq, GT_DIAGBANDSEED_TEST_REFLEN, NULL);
+  }
+  refs = gt_encseq_builder_build(eb, err);
+  for (seqnum = 0; refs != NULL && seqnum < GT_DIAGBANDSEED_TEST_NUMQUERIES;
+       seqnum++) {
+    const GtUword offset
+      = gt_rand_max(GT_DIAGBANDSEED_TEST_REFLEN - GT_DIAGBANDSEED_TEST_QUERYLEN);
+    GtUword startpos;
+
+    origin[seqnum] = gt_rand_max(GT_DIAGBANDSEED_TEST_NUMREFS - 1);
+    startpos = gt_encseq_seqstartpos(refs, origin[seqnum]) + offset;
+    for (idx = 0; idx < GT_DIAGBANDSEED_TEST_QUERYLEN; idx++) {
+      const GtUchar cc = gt_encseq_get_decoded_char(refs, startpos + idx,
+                                                    GT_READMODE_FORWARD);
+      query[idx] = gt_rand_max(99) == 0 ? nucleotides[gt_rand_max(3)]
+                                        : (char) cc;
+    }
+    if (seqnum % 2 == 1) {
+      for (idx = 0; idx < GT_DIAGBANDSEED_TEST_QUERYLEN / 2; idx++) {
+        const char cc = query[idx];
+        query[idx] = query[GT_DIAGBANDSEED_TEST_QUERYLEN - 1 - idx];
+        query[GT_DIAGBANDSEED_TEST_QUERYLEN - 1 - idx] = cc;
+      }
+      for (idx = 0; idx < GT_DIAGBANDSEED_TEST_QUERYLEN; idx++) {
+        query[idx] = nucleotides[3 - (strchr(nucleotides, query[idx]) -
+                                      nucleotides)];
+      }
+    }
+    gt_encseq_builder_add_cstr(eb, query, GT_DIAGBANDSEED_TEST_QUERYLEN, NULL);
+  }
+  queries = refs != NULL ? gt_encseq_builder_build(eb, err) : NULL;
+  if (refs == NULL || queries == NULL) {
+    had_err = -1;
+  }
+  gt_free(refseq);
+  gt_free(query);
+
+  extp = gt_diagbandseed_extend_params_new(10, 200, 6, 35, 0, false, 0, true,
+                                           false, 30, 60, 55,
+                                           GT_EXTEND_CHAR_ACCESS_ANY, 97, 1.0,
+                                           false, false, 0, true, false,
+                                           false);
+  info = gt_diagbandseed_info_new(refs, refs, GT_UWORD_MAX, GT_UWORD_MAX,
+                                  GT_UWORD_MAX, 14,
+                                  GT_DIAGBANDSEED_SAMPLE_ALL, 0, false, false,
+                                  &seedpairdistance, false, false, false,
+                                  false, false, false, extp, 1, 1);
+
+  /* the same batch twice with each engine gives the same matches */
+  for (numthreads = 1; !had_err && numthreads <= 3; numthreads += 2) {
+    GtDiagbandseedEngine *engine = gt_diagbandseed_engine_new(info,
+                                                              numthreads,
+                                                              err);
+    GtDiagbandseedTestMatches matches[2];
+    unsigned int run;
+
+    gt_ensure(engine != NULL);
+    for (run = 0; !had_err && run < 2; run++) {
+      memset(matches + run, 0, sizeof *matches);
+      matches[run].origin = origin;
+      had_err = gt_diagbandseed_engine_query(engine, queries,
+                                             gt_diagbandseed_test_match,
+                                             matches + run, err);
+    }
+    for (seqnum = 0; !had_err && seqnum < GT_DIAGBANDSEED_TEST_NUMQUERIES;
+         seqnum++) {
+      gt_ensure(matches[0].found[seqnum] > 0);
+      gt_ensure(matches[0].found[seqnum] == matches[1].found[seqnum]);
+    }
+    gt_ensure(matches[0].numofmatches == matches[1].numofmatches);
+    gt_diagbandseed_engine_delete(engine);
+  }
+
+  gt_diagbandseed_info_delete(info);
+  gt_diagbandseed_extend_params_delete(extp);
+  gt_encseq_delete(refs);
+  gt_encseq_delete(queries);
+  gt_encseq_builder_delete(eb);
+  gt_alphabet_delete(alphabet);
+  return had_err;
+}
@@ -22,11 +22,32 @@
 #include "core/error_api.h"
 #include "core/range_api.h"
 #include "core/types_api.h"
+#include "match/diagbandseed-stats.h"
 #include "match/ft-front-prune.h"
+#include "match/querymatch.h"
 #include "match/xdrop.h"
 
 typedef struct GtDiagbandseedInfo GtDiagbandseedInfo;
 typedef struct GtDiagbandseedExtendParams GtDiagbandseedExtendParams;
+typedef struct GtDiagbandseedEngine GtDiagbandseedEngine;
+
+/* Function called for each match found by gt_diagbandseed_engine_query().
+   <querymatch> is only valid during the call. */
+typedef void (*GtDiagbandseedMatchFunc)(const GtQuerymatch *querymatch,
+                                        void *data);
+
+/* The k-mers used as seeds. With GT_DIAGBANDSEED_SAMPLE_MINIMIZER, only the
+   k-mers with the smallest hash value among each window of <samplingparam>
+   consecutive k-mers are used. With GT_DIAGBANDSEED_SAMPLE_SYNCMER, only the
+   k-mers whose first s-mer, with s = <samplingparam>, has the smallest hash
+   value of all their s-mers (open syncmers) are used. Both selections are
+   made in the same way for both sequence sets and for both strands, so that
+   equal k-mers of matching regions are mostly selected in both. */
+typedef enum {
+  GT_DIAGBANDSEED_SAMPLE_ALL,
+  GT_DIAGBANDSEED_SAMPLE_MINIMIZER,
+  GT_DIAGBANDSEED_SAMPLE_SYNCMER
+} GtDiagbandseedSampling;
 
 /* Run the whole algorithm. */
 int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
@@ -35,12 +56,26 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                         const GtUwordPair *pick,
                         GtError *err);
 
-/* The constructor for GtDiagbandseedInfo*/
+/* The constructor for GtDiagbandseedInfo. If <spblockmem> is smaller than
+   GT_UWORD_MAX, the seed pairs are collected in sorted runs of at most
+   <spblockmem> bytes in a temporary file and then sorted and extended in
+   blocks of consecutive sequences of the first set. A block occupies at most
+   <spblockmem> bytes, unless a single sequence has more seed pairs: as these
+   are extended together, such a sequence forms a larger block of its own.
+   In addition, three words are stored for each run and a block is read with
+   a margin of 1024 seed pairs. If <use_kpos> is true, the sorted k-mers of
+   each part of <aencseq> are memory mapped from an index file
+   <indexname>.kpos (<indexname>.<parts>-<part>.kpos for more than one part),
+   which is created if it does not exist. <sampling> and <samplingparam>
+   select the k-mers to use, see GtDiagbandseedSampling. */
 GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
                                              const GtEncseq *bencseq,
                                              GtUword maxfreq,
                                              GtUword memlimit,
+                                             GtUword spblockmem,
                                              unsigned int seedlength,
+                                             GtDiagbandseedSampling sampling,
+                                             GtUword samplingparam,
                                              bool norev,
                                              bool nofwd,
                                              GtRange *seedpairdistance,
@@ -49,12 +84,19 @@ GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
                                              bool debug_kmer,
                                              bool debug_seedpair,
                                              bool use_kmerfile,
+                                             bool use_kpos,
                                              const GtDiagbandseedExtendParams
                                                *extp,
                                              GtUword anumseqranges,
                                              GtUword bnumseqranges);
 
-/* The constructor for GtDiagbandseedExtendParams*/
+/* Measure the stages of <gt_diagbandseed_run> in <stats>, which is not owned
+   by <info>. If <stats> is NULL (the default), nothing is measured. */
+void gt_diagbandseed_info_stats_set(GtDiagbandseedInfo *info,
+                                    GtDiagbandseedStats *stats);
+
+/* The constructor for GtDiagbandseedExtendParams. If <binary> is true, the
+   matches are written as GtQuerymatchRecord instead of text. */
 GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
                               GtUword errorpercentage,
                               GtUword userdefinedleastlength,
@@ -75,7 +117,33 @@ GtDiagbandseedExtendParams *gt_diagbandseed_extend_params_new(
                               bool benchmark,
                               GtUword alignmentwidth,
                               bool always_polished_ends,
-                              bool verify_alignment);
+                              bool verify_alignment,
+                              bool binary);
+
+/* Create an engine which compares query batches with the first sequence set
+   of <arg>, using <numthreads> threads for the seed extension. The sorted
+   k-mers of the first set (mapped from its .kpos index if <arg> uses one) and
+   the extension workspaces of the threads are kept by the engine and reused
+   for each batch. The second sequence set of <arg> is not used and <arg> must
+   exist as long as the engine. Returns NULL and sets <err> if <arg> does not
+   select an extension method. */
+GtDiagbandseedEngine *gt_diagbandseed_engine_new(const GtDiagbandseedInfo *arg,
+                                                 unsigned int numthreads,
+                                                 GtError *err);
+
+/* Compare all sequences of <queries> with the first sequence set of
+   <engine> and call <matchfunc> with <data> for each match. With more than
+   one thread, the calls are serialized, but their order is unspecified.
+   Returns 0 on success; otherwise -1 and <err> is set. */
+int gt_diagbandseed_engine_query(GtDiagbandseedEngine *engine,
+                                 const GtEncseq *queries,
+                                 GtDiagbandseedMatchFunc matchfunc,
+                                 void *data,
+                                 GtError *err);
+
+void gt_diagbandseed_engine_delete(GtDiagbandseedEngine *engine);
+
+int gt_diagbandseed_engine_unit_test(GtError *err);
 
 /* The destructors */
 void gt_diagbandseed_info_delete(GtDiagbandseedInfo *info);
@@ -37,6 +37,7 @@
 #include "core/fa.h"
 #include "core/log.h"
 #include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/str.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
@@ -292,6 +293,169 @@ writeOutputBuffer(struct blockCompositionSeq *newSeqIdx,
   return 1;
 }
 
+#ifdef GT_THREADS_ENABLED
+/* number of symbols read from the BWT and encoded in parallel per round */
+#define EIS_PARALLEL_ROUND_SYMBOLS (1UL << 18)
+
+/**
+ * state shared by the threads encoding the blocks of one round, every
+ * thread processes whole buckets
+ */
+struct blockEncRound
+{
+  const struct blockCompositionSeq *seqIdx;
+  const Symbol *syms;           /**< symbols of the round, mapped to
+                                 * the alphabet of the index */
+  PermCompIndex *permCompIdx;   /**< two indices per block */
+  unsigned *permIdxBits;        /**< significant bits of the
+                                 * permutation index of each block */
+  partialSymSum *bucketSums;    /**< symbol counts of each bucket */
+  AlphabetRangeSize totalAlphabetSize;
+  GtUword numBlocks, nextBucket;
+  GtMutex *mutex;
+};
+
+static void *
+blockEncRoundThread(void *data)
+{
+  struct blockEncRound *round = data;
+  const struct blockCompositionSeq *seqIdx = round->seqIdx;
+  unsigned blockSize = seqIdx->blockSize, bucketBlocks = seqIdx->bucketBlocks,
+    *compositionPreAlloc;
+  BitString permCompBSPreAlloc;
+  Symbol *block;
+  block = gt_malloc(sizeof (Symbol) * blockSize);
+  compositionPreAlloc = gt_malloc(sizeof (compositionPreAlloc[0])
+                                  * seqIdx->blockMapAlphabetSize);
+  permCompBSPreAlloc =
+    gt_malloc(bitElemsAllocSize(seqIdx->compositionTable.bitsPerCount
+                                * seqIdx->blockMapAlphabetSize
+                                + seqIdx->compositionTable.bitsPerSymbol
+                                * blockSize) * sizeof (BitElem));
+  while (1)
+  {
+    GtUword bucketNum, blockNum, endBlock;
+    gt_mutex_lock(round->mutex);
+    if ((bucketNum = round->nextBucket) * bucketBlocks < round->numBlocks)
+      round->nextBucket++;
+    gt_mutex_unlock(round->mutex);
+    if (bucketNum * bucketBlocks >= round->numBlocks)
+      break;
+    endBlock = MIN((bucketNum + 1) * bucketBlocks, round->numBlocks);
+    for (blockNum = bucketNum * bucketBlocks; blockNum < endBlock; ++blockNum)
+    {
+      memcpy(block, round->syms + blockNum * blockSize,
+             sizeof (Symbol) * blockSize);
+      addBlock2PartialSymSums(round->bucketSums
+                              + bucketNum * round->totalAlphabetSize,
+                              block, blockSize);
+      gt_MRAEncSymbolsTransform(seqIdx->blockMapAlphabet, block, blockSize);
+      gt_block2IndexPair(&seqIdx->compositionTable, blockSize,
+                         seqIdx->blockMapAlphabetSize, block,
+                         round->permCompIdx + 2 * blockNum,
+                         round->permIdxBits + blockNum,
+                         permCompBSPreAlloc, compositionPreAlloc);
+    }
+  }
+  gt_free(permCompBSPreAlloc);
+  gt_free(compositionPreAlloc);
+  gt_free(block);
+  return NULL;
+}
+
+/**
+ * Encode the first numFullBlocks blocks of the BWT with gt_jobs threads.
+ * The BWT is read in rounds of whole buckets, the composition and
+ * permutation indices and the symbol counts of the buckets of a round are
+ * computed in parallel, then the counts are summed up and the indices
+ * are appended to the output in the order of the blocks, which gives the
+ * same index as the sequential encoding.
+ * @return 0 on success, -1 on error
+ */
+static int
+encodeBlocksParallel(struct blockCompositionSeq *newSeqIdx,
+                     SeqDataReader BWTGenerator, const MRAEnc *alphabet,
+                     const int *modes, AlphabetRangeSize totalAlphabetSize,
+                     GtUword numFullBlocks, unsigned compositionIdxBits,
+                     bitInsertFunc biFunc, unsigned callBackDataOffsetBits,
+                     void *cbState, partialSymSum *buck,
+                     partialSymSum *buckLast, struct appendState *aState,
+                     GtUword *lastUpdatePos, GtError *err)
+{
+  struct blockEncRound round;
+  Symbol *syms;
+  unsigned blockSize = newSeqIdx->blockSize,
+    bucketBlocks = newSeqIdx->bucketBlocks;
+  size_t bucketLen = (size_t)bucketBlocks * blockSize;
+  GtUword roundBuckets = MAX(EIS_PARALLEL_ROUND_SYMBOLS / bucketLen, 1),
+    blockNum = 0;
+  int hadError = 0;
+  round.seqIdx = newSeqIdx;
+  round.syms = syms = gt_malloc(sizeof (Symbol) * roundBuckets * bucketLen);
+  round.permCompIdx = gt_malloc(sizeof (round.permCompIdx[0]) * 2
+                                * roundBuckets * bucketBlocks);
+  round.permIdxBits = gt_malloc(sizeof (round.permIdxBits[0])
+                                * roundBuckets * bucketBlocks);
+  round.bucketSums = gt_malloc(sizeof (round.bucketSums[0])
+                               * roundBuckets * totalAlphabetSize);
+  round.totalAlphabetSize = totalAlphabetSize;
+  round.mutex = gt_mutex_new();
+  while (!hadError && blockNum < numFullBlocks)
+  {
+    GtUword idx;
+    Symbol sym;
+    round.numBlocks = MIN(roundBuckets * bucketBlocks,
+                          numFullBlocks - blockNum);
+    round.nextBucket = 0;
+    if (SDRRead(BWTGenerator, syms, round.numBlocks * blockSize)
+        != round.numBlocks * blockSize)
+    {
+      perror("error condition while reading index data");
+      hadError = 1;
+      break;
+    }
+    gt_MRAEncSymbolsTransform(alphabet, syms, round.numBlocks * blockSize);
+    memset(round.bucketSums, 0, sizeof (round.bucketSums[0])
+           * roundBuckets * totalAlphabetSize);
+    if (gt_multithread(blockEncRoundThread, &round, err) != 0)
+    {
+      hadError = 1;
+      break;
+    }
+    for (idx = 0; idx < round.numBlocks; ++idx)
+    {
+      addRangeEncodedSyms(newSeqIdx->rangeEncs, syms + idx * blockSize,
+                          blockSize, blockNum, alphabet, REGIONS_LIST, modes);
+      append2IdxOutput(aState, round.permCompIdx + 2 * idx,
+                       compositionIdxBits, round.permIdxBits[idx]);
+      /* the counts of a bucket are needed only once it is complete */
+      if (!((idx + 1) % bucketBlocks) || idx + 1 == round.numBlocks)
+        for (sym = 0; sym < totalAlphabetSize; ++sym)
+          buck[sym] += round.bucketSums[idx / bucketBlocks
+                                        * totalAlphabetSize + sym];
+      if (!((++blockNum) % bucketBlocks))
+      {
+        if (writeOutputBuffer(newSeqIdx, aState, biFunc, *lastUpdatePos,
+                              bucketLen, callBackDataOffsetBits, cbState,
+                              buckLast) < 0)
+        {
+          hadError = 1;
+          break;
+        }
+        copyPartialSymSums(totalAlphabetSize, buckLast, buck);
+        *lastUpdatePos = blockNum * blockSize;
+      }
+    }
+  }
+  gt_mutex_delete(round.mutex);
+  gt_free(round.bucketSums);
+  gt_free(round.permIdxBits);
+  gt_free(round.permCompIdx);
+  gt_free(syms);
+  return hadError ? -1 : 0;
+}
+#endif
+
 #define newBlockEncIdxSeqLoopErr()                      \
   destructAppendState(&aState);                         \
   deletePartialSymSums(buck);                           \
@@ -534,7 +698,21 @@ gt_newGenBlockEncIdxSeq(GtUword totalLen, const char *projectName,
           struct appendState aState;
           initAppendState(&aState, newSeqIdx);
           blockNum = 0;
-          while (blockNum < numFullBlocks)
+#ifdef GT_THREADS_ENABLED
+          if (gt_jobs > 1U && numFullBlocks > 0)
+          {
+            if (encodeBlocksParallel(newSeqIdx, BWTGenerator, alphabet,
+                                     modesCopy, totalAlphabetSize,
+                                     numFullBlocks, compositionIdxBits,
+                                     biFunc, callBackDataOffsetBits, cbState,
+                                     buck, buckLast, &aState, &lastUpdatePos,
+                                     err) != 0)
+              hadGtError = 1;
+            else
+              blockNum = numFullBlocks;
+          }
+#endif
+          while (!hadGtError && blockNum < numFullBlocks)
           {
             size_t readResult;
             /* 3. for each chunk: */
@@ -1552,6 +1730,39 @@ blockCompSeqPosPairRangeRank(struct encIdxSeq *eSeqIdx, AlphabetRangeID range,
   }
 }
 
+/* size of the units in which the superblocks are prefetched */
+#define EIS_PREFETCH_STRIDE 64
+
+#ifdef __GNUC__
+#define prefetchAddr(addr) __builtin_prefetch(addr)
+#else
+#define prefetchAddr(addr) ((void) (addr))
+#endif
+
+/**
+ * Touch the constant width data of the superblock containing pos,
+ * i.e. the partial symbol sums and the composition indices, without
+ * waiting for it to arrive in the cache. Only mapped indices can be
+ * prefetched.
+ */
+static void
+blockCompSeqPrefetch(const struct encIdxSeq *eSeqIdx, GtUword pos)
+{
+  const struct blockCompositionSeq *seqIdx;
+  gt_assert(eSeqIdx && eSeqIdx->classInfo == &blockCompositionSeqClass);
+  seqIdx = constEncIdxSeq2blockCompositionSeq(eSeqIdx);
+  if (seqIdxUsesMMap(seqIdx) && pos <= seqIdx->baseClass.seqLen)
+  {
+    BitOffset bucketOffset
+      = bucketNumFromPos(seqIdx, pos) * superBlockCWBits(seqIdx);
+    const char *cwData = seqIdx->externalData.idxMMap
+      + bucketOffset / bitElemBits * sizeof (BitElem);
+    size_t offset, cwSize = superBlockCWMaxReadSize(seqIdx);
+    for (offset = 0; offset < cwSize; offset += EIS_PREFETCH_STRIDE)
+      prefetchAddr(cwData + offset);
+  }
+}
+
 static Symbol
 blockCompSeqGet(struct encIdxSeq *seq, GtUword pos, union EISHint *hint)
 {
@@ -2747,4 +2958,5 @@ static const struct encIdxSeqClass blockCompositionSeqClass =
   .seekToHeader = seekToHeader,
   .printPosDiags = printBlockEncPosDiags,
   .printExtPosDiags = displayBlockEncBlock,
+  .prefetch = blockCompSeqPrefetch,
 };
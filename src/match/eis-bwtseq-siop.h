@@ -114,6 +114,14 @@ BWTSeqPosPairOcc(const BWTSeq *bwtSeq, Symbol sym, GtUword posA,
   return BWTSeqTransformedPosPairOcc(bwtSeq, tSym, posA, posB);
 }
 
+static inline void
+BWTSeqPrefetchOcc(const BWTSeq *bwtSeq, GtUword posA, GtUword posB)
+{
+  gt_assert(bwtSeq);
+  EISPrefetch(bwtSeq->seqIdx, posA);
+  EISPrefetch(bwtSeq->seqIdx, posB);
+}
+
 static inline void
 BWTSeqRangeOcc(const BWTSeq *bwtSeq, AlphabetRangeID range, GtUword pos,
                GtUword *rangeOccs)
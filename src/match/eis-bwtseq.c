@@ -159,67 +159,156 @@ static const Mbtab *gt_prebwt_next(GtPrebwtstate *prebwt,unsigned int cc)
   return prebwt->mbtab[prebwt->depth] + prebwt->code;
 }
 
-static inline void
-getMatchBound(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
-              struct matchBound *match, bool forward)
+/* state of a backward search for a single query, the current match
+   interval is kept separately */
+struct matchState
 {
   const Symbol *qptr, *qend;
+  GtPrebwtstate prebwt;
+  bool forward;
+};
+
+static inline void
+initMatchState(const BWTSeq *bwtSeq, struct matchState *state,
+               const Symbol *query, size_t queryLen,
+               struct matchBound *match, bool forward)
+{
   unsigned int cc;
   const Mbtab *mbptr;
-  GtPrebwtstate prebwt;
 
   gt_assert(bwtSeq && query);
+  state->forward = forward;
   if (forward)
   {
-    qptr = query;
-    qend = query + queryLen;
+    state->qptr = query;
+    state->qend = query + queryLen;
   } else
   {
-    qptr = query + queryLen - 1;
-    qend = query - 1;
+    state->qptr = query + queryLen - 1;
+    state->qend = query - 1;
   }
-  gt_assert(ISNOTSPECIAL(*qptr));
-  cc = (unsigned int) *qptr;
-  prebwt.mbtab = gt_bwtseq2mbtab((const FMindex *) bwtSeq);
-  if (prebwt.mbtab != NULL)
+  gt_assert(ISNOTSPECIAL(*state->qptr));
+  cc = (unsigned int) *state->qptr;
+  state->prebwt.mbtab = gt_bwtseq2mbtab((const FMindex *) bwtSeq);
+  if (state->prebwt.mbtab != NULL)
   {
-    prebwt.numofchars = gt_bwtseq2numofchars((const FMindex *) bwtSeq);
-    prebwt.maxdepth = gt_bwtseq2maxdepth((const FMindex *) bwtSeq);
-    prebwt.code = 0;
-    prebwt.depth = 0;
-    mbptr = gt_prebwt_next(&prebwt,cc);
+    state->prebwt.numofchars = gt_bwtseq2numofchars((const FMindex *) bwtSeq);
+    state->prebwt.maxdepth = gt_bwtseq2maxdepth((const FMindex *) bwtSeq);
+    state->prebwt.code = 0;
+    state->prebwt.depth = 0;
+    mbptr = gt_prebwt_next(&state->prebwt,cc);
     match->start = mbptr->lowerbound;
     match->end = mbptr->upperbound;
   } else
   {
-    prebwt.numofchars = GT_UNDEF_UINT;
-    prebwt.maxdepth = GT_UNDEF_UINT;
-    prebwt.code = 0;
-    prebwt.depth = GT_UNDEF_UINT;
+    state->prebwt.numofchars = GT_UNDEF_UINT;
+    state->prebwt.maxdepth = GT_UNDEF_UINT;
+    state->prebwt.code = 0;
+    state->prebwt.depth = GT_UNDEF_UINT;
     match->start = bwtSeq->count[cc];
     match->end   = bwtSeq->count[cc + 1];
   }
-  qptr = forward ? (qptr+1) : (qptr-1);
-  while (match->start < match->end && qptr != qend)
+  state->qptr = forward ? (state->qptr+1) : (state->qptr-1);
+}
+
+static inline bool
+matchStateFinished(const struct matchState *state,
+                   const struct matchBound *match)
+{
+  return match->start >= match->end || state->qptr == state->qend;
+}
+
+/* true if the next symbol is matched by occurrence counts rather than by
+   a lookup in the table of precomputed bounds */
+static inline bool
+matchStateNeedsOcc(const struct matchState *state)
+{
+  return state->prebwt.mbtab == NULL
+         || state->prebwt.depth >= state->prebwt.maxdepth;
+}
+
+static inline void
+advanceMatchState(const BWTSeq *bwtSeq, struct matchState *state,
+                  struct matchBound *match)
+{
+  unsigned int cc;
+
+  gt_assert(ISNOTSPECIAL(*state->qptr));
+  cc = (unsigned int) *state->qptr;
+  if (!matchStateNeedsOcc(state))
+  {
+    const Mbtab *mbptr = gt_prebwt_next(&state->prebwt,cc);
+    match->start = mbptr->lowerbound;
+    match->end = mbptr->upperbound;
+  } else
   {
     GtUwordPair occPair;
 
-    gt_assert(ISNOTSPECIAL(*qptr));
-    cc = (unsigned int) *qptr;
-    if (prebwt.mbtab != NULL && prebwt.depth < prebwt.maxdepth)
+    occPair = BWTSeqTransformedPosPairOcc(bwtSeq, (Symbol) cc, match->start,
+                                          match->end);
+    match->start = bwtSeq->count[cc] + occPair.a;
+    match->end   = bwtSeq->count[cc] + occPair.b;
+  }
+  state->qptr = state->forward ? (state->qptr+1) : (state->qptr-1);
+}
+
+static inline void
+getMatchBound(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
+              struct matchBound *match, bool forward)
+{
+  struct matchState state;
+
+  initMatchState(bwtSeq, &state, query, queryLen, match, forward);
+  while (!matchStateFinished(&state, match))
+  {
+    advanceMatchState(bwtSeq, &state, match);
+  }
+}
+
+void
+gt_BWTSeqMatchBoundsBatch(const BWTSeq *bwtSeq, const Symbol *const *queries,
+                          const GtUword *queryLens, GtUword numQueries,
+                          struct matchBound *matches, bool forward)
+{
+  struct matchState *states;
+  GtUword *active, numActive = 0, idx;
+
+  gt_assert(bwtSeq && queries && queryLens && matches);
+  states = gt_malloc(sizeof (*states) * numQueries);
+  active = gt_malloc(sizeof (*active) * numQueries);
+  for (idx = 0; idx < numQueries; idx++)
+  {
+    initMatchState(bwtSeq, states + idx, queries[idx], (size_t) queryLens[idx],
+                   matches + idx, forward);
+    if (!matchStateFinished(states + idx, matches + idx))
     {
-      mbptr = gt_prebwt_next(&prebwt,cc);
-      match->start = mbptr->lowerbound;
-      match->end = mbptr->upperbound;
-    } else
+      if (matchStateNeedsOcc(states + idx))
+        BWTSeqPrefetchOcc(bwtSeq, matches[idx].start, matches[idx].end);
+      active[numActive++] = idx;
+    }
+  }
+  /* In each round, every unfinished query is extended by one symbol. The
+     occurrence counts needed in the next round are prefetched, so that
+     the memory accesses of all queries of a round overlap. */
+  while (numActive > 0)
+  {
+    GtUword activeidx, stillActive = 0;
+
+    for (activeidx = 0; activeidx < numActive; activeidx++)
     {
-      occPair = BWTSeqTransformedPosPairOcc(bwtSeq, (Symbol) cc, match->start,
-                                            match->end);
-      match->start = bwtSeq->count[cc] + occPair.a;
-      match->end   = bwtSeq->count[cc] + occPair.b;
+      idx = active[activeidx];
+      advanceMatchState(bwtSeq, states + idx, matches + idx);
+      if (!matchStateFinished(states + idx, matches + idx))
+      {
+        if (matchStateNeedsOcc(states + idx))
+          BWTSeqPrefetchOcc(bwtSeq, matches[idx].start, matches[idx].end);
+        active[stillActive++] = idx;
+      }
     }
-    qptr = forward ? (qptr+1) : (qptr-1);
+    numActive = stillActive;
   }
+  gt_free(active);
+  gt_free(states);
 }
 
 GtUword gt_packedindexuniqueforward(const BWTSeq *bwtSeq,
@@ -393,6 +482,24 @@ gt_initEMIterator(BWTSeqExactMatchesIterator *iter, const BWTSeq *bwtSeq,
   return true;
 }
 
+bool
+gt_initEMIteratorFromBounds(BWTSeqExactMatchesIterator *iter,
+                            const BWTSeq *bwtSeq,
+                            const struct matchBound *bounds)
+{
+  gt_assert(iter && bwtSeq && bounds);
+  if (!bwtSeq->locateSampleInterval)
+  {
+    fputs("Index does not contain locate information.\n"
+          "Localization of matches impossible!", stderr);
+    return false;
+  }
+  iter->bounds = *bounds;
+  iter->nextMatchBWTPos = iter->bounds.start;
+  initExtBitsRetrieval(&iter->extBits);
+  return true;
+}
+
 bool
 gt_initEmptyEMIterator(BWTSeqExactMatchesIterator *iter, const BWTSeq *bwtSeq)
 {
@@ -209,6 +209,17 @@ static inline GtUwordPair
 BWTSeqPosPairOcc(const BWTSeq *bwtSeq, Symbol sym,
                  GtUword posA, GtUword posB);
 
+/**
+ * \brief Announce that occurrence counts up to the given BWT positions
+ * will be queried soon, so that the part of the index needed can be
+ * fetched into the cache in the meantime.
+ * @param bwtSeq reference of object to query
+ * @param posA right bound of first BWT prefix to be queried
+ * @param posB right bound of second BWT prefix to be queried
+ */
+static inline void
+BWTSeqPrefetchOcc(const BWTSeq *bwtSeq, GtUword posA, GtUword posB);
+
 /**
  * \brief Query BWT sequence for the number of occurrences of all symbols in a
  * given alphabet range and BWT sequence prefix.
@@ -301,6 +312,25 @@ GtUword
 gt_BWTSeqMatchCount(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
                  bool forward);
 
+/**
+ * \brief Compute the match intervals of many queries at once. The
+ * queries are extended in turn by one symbol each and the occurrence
+ * counts required next are prefetched, so that the latency of the
+ * index accesses of one query is hidden by the work on the others.
+ * @param bwtSeq reference of object to query
+ * @param queries numQueries symbol strings to search matches for,
+ * none of them empty
+ * @param queryLens lengths of the query strings
+ * @param numQueries number of queries
+ * @param matches the interval of the matches of query i is stored in
+ * matches[i], it is empty if start >= end
+ * @param forward direction of processing the queries
+ */
+void
+gt_BWTSeqMatchBoundsBatch(const BWTSeq *bwtSeq, const Symbol *const *queries,
+                          const GtUword *queryLens, GtUword numQueries,
+                          struct matchBound *matches, bool forward);
+
 /**
  * \brief Given a pair of limiting positions in the suffix array and a
  * symbol, compute the interval reached by matching one symbol further.
@@ -414,6 +444,21 @@ gt_initEMIterator(BWTSeqExactMatchesIterator *iter, const BWTSeq *bwtSeq,
 bool
 gt_initEmptyEMIterator(BWTSeqExactMatchesIterator *iter, const BWTSeq *bwt);
 
+/**
+ * \brief Initializes an iterator for the matches in a given interval,
+ * for example as computed by gt_BWTSeqMatchBoundsBatch.
+ *
+ * Warning: user must manage storage of iter manually
+ * @param iter points to storage for iterator
+ * @param bwtSeq reference of bwt sequence object to use for matching
+ * @param bounds interval of the matches
+ * @return true if successfully initialized, false on error
+ */
+bool
+gt_initEMIteratorFromBounds(BWTSeqExactMatchesIterator *iter,
+                            const BWTSeq *bwtSeq,
+                            const struct matchBound *bounds);
+
 /**
  * \brief Set up iterator for new query, iter must have been
  * initialized previously. Everything else is identical to
@@ -50,6 +50,7 @@ struct encIdxSeqClass
                        EISHint hint);
   int (*printExtPosDiags)(const EISeq *seq, GtUword pos, FILE *fp,
                           EISHint hint);
+  void (*prefetch)(const EISeq *seq, GtUword pos);
 };
 
 struct encIdxSeq
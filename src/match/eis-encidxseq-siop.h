@@ -106,6 +106,13 @@ EISSymTransformedPosPairRank(EISeq *seq, Symbol tSym, GtUword posA,
   return seq->classInfo->posPairRank(seq, tSym, posA, posB, hint);
 }
 
+static inline void
+EISPrefetch(const EISeq *seq, GtUword pos)
+{
+  if (seq->classInfo->prefetch != NULL)
+    seq->classInfo->prefetch(seq, pos);
+}
+
 static inline void
 EISRetrieveExtraBits(EISeq *seq, GtUword pos, int flags,
                      struct extBitsRetrieval *retval, union EISHint *hint)
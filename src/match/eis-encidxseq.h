@@ -266,6 +266,17 @@ EISPosPairRangeRank(EISeq *seq, AlphabetRangeID range, GtUword posA,
                     GtUword posB, GtUword *rankCounts,
                     union EISHint *hint);
 
+/**
+ * \brief Announce that rank queries for position pos will follow
+ * soon. Implementations may start loading the corresponding part of
+ * the index into the cache, so that searches advancing many
+ * positions in turn do not stall on each query.
+ * @param seq sequence index object to query
+ * @param pos position of a forthcoming rank query
+ */
+static inline void
+EISPrefetch(const EISeq *seq, GtUword pos);
+
 /**
  * Presents the bits previously stored by a bitInsertFunc callback.
  * @param seq
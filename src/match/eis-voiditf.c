@@ -288,6 +288,13 @@ unsigned int gt_bwtseq2numofchars(const FMindex *fmindex)
                                           ->pckbuckettable);
 }
 
+void gt_bwtrangeprefetch(const FMindex *fmindex,
+                         GtUword lbound,
+                         GtUword ubound)
+{
+  BWTSeqPrefetchOcc((const BWTSeq *) fmindex,lbound,ubound);
+}
+
 void gt_bwtrangesplitwithoutspecial(GtArrayBoundswithchar *bwci,
                                     GtUword *rangeOccs,
                                     const FMindex *fmindex,
@@ -458,21 +465,17 @@ GtUword gt_voidpackedindexmstatsforward(const void *fmindex,
   return matchlength;
 }
 
-bool gt_pck_exactpatternmatching(const FMindex *fmindex,
-                                 const GtUchar *pattern,
-                                 GtUword patternlength,
-                                 GtUword totallength,
-                                 const GtUchar *dbsubstring,
-                                 ProcessIdxMatch processmatch,
-                                 void *processmatchinfo)
+static GtUword pck_processexactmatches(const FMindex *fmindex,
+                                       BWTSeqExactMatchesIterator *bsemi,
+                                       GtUword patternlength,
+                                       GtUword totallength,
+                                       const GtUchar *dbsubstring,
+                                       ProcessIdxMatch processmatch,
+                                       void *processmatchinfo)
 {
-  BWTSeqExactMatchesIterator *bsemi;
   GtUword dbstartpos, numofmatches;
   GtIdxMatch match;
 
-  bsemi = gt_newEMIterator((const BWTSeq *) fmindex,
-                           pattern,(size_t) patternlength, true);
-  gt_assert(bsemi != NULL);
   numofmatches = gt_EMINumMatchesTotal(bsemi);
   match.dbabsolute = true;
   match.dblen = patternlength;
@@ -487,6 +490,26 @@ bool gt_pck_exactpatternmatching(const FMindex *fmindex,
     match.dbstartpos = totallength - (dbstartpos + patternlength);
     processmatch(processmatchinfo,&match);
   }
+  return numofmatches;
+}
+
+bool gt_pck_exactpatternmatching(const FMindex *fmindex,
+                                 const GtUchar *pattern,
+                                 GtUword patternlength,
+                                 GtUword totallength,
+                                 const GtUchar *dbsubstring,
+                                 ProcessIdxMatch processmatch,
+                                 void *processmatchinfo)
+{
+  BWTSeqExactMatchesIterator *bsemi;
+  GtUword numofmatches;
+
+  bsemi = gt_newEMIterator((const BWTSeq *) fmindex,
+                           pattern,(size_t) patternlength, true);
+  gt_assert(bsemi != NULL);
+  numofmatches = pck_processexactmatches(fmindex,bsemi,patternlength,
+                                         totallength,dbsubstring,
+                                         processmatch,processmatchinfo);
   if (bsemi != NULL)
   {
     gt_deleteEMIterator(bsemi);
@@ -495,6 +518,51 @@ bool gt_pck_exactpatternmatching(const FMindex *fmindex,
   return numofmatches > 0 ? true : false;
 }
 
+void gt_pck_exactpatternbounds(const FMindex *fmindex,
+                               const GtUchar *const *patterns,
+                               const GtUword *patternlengths,
+                               GtUword numofpatterns,
+                               Mbtab *bounds)
+{
+  struct matchBound *matches;
+  GtUword idx;
+
+  matches = gt_malloc(sizeof (*matches) * numofpatterns);
+  gt_BWTSeqMatchBoundsBatch((const BWTSeq *) fmindex,patterns,patternlengths,
+                            numofpatterns,matches,true);
+  for (idx = 0; idx < numofpatterns; idx++)
+  {
+    bounds[idx].lowerbound = matches[idx].start;
+    bounds[idx].upperbound = matches[idx].end;
+  }
+  gt_free(matches);
+}
+
+bool gt_pck_exactpatternmatchingbounds(const FMindex *fmindex,
+                                       const Mbtab *bounds,
+                                       GtUword patternlength,
+                                       GtUword totallength,
+                                       const GtUchar *dbsubstring,
+                                       ProcessIdxMatch processmatch,
+                                       void *processmatchinfo)
+{
+  BWTSeqExactMatchesIterator bsemi;
+  struct matchBound matchbound;
+  GtUword numofmatches;
+  GT_UNUSED bool initialized;
+
+  matchbound.start = bounds->lowerbound;
+  matchbound.end = bounds->upperbound;
+  initialized = gt_initEMIteratorFromBounds(&bsemi,(const BWTSeq *) fmindex,
+                                            &matchbound);
+  gt_assert(initialized);
+  numofmatches = pck_processexactmatches(fmindex,&bsemi,patternlength,
+                                         totallength,dbsubstring,
+                                         processmatch,processmatchinfo);
+  gt_destructEMIterator(&bsemi);
+  return numofmatches > 0 ? true : false;
+}
+
 GtUword gt_voidpackedindex_totallength_get(const FMindex *fmindex)
 {
   GtUword bwtlen = BWTSeqLength((const BWTSeq *) fmindex);
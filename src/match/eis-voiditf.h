@@ -77,6 +77,13 @@ void gt_bwtrangesplitwithoutspecial(GtArrayBoundswithchar *bwci,
                                     GtUword lbound,
                                     GtUword ubound);
 
+/* Announce that the interval from <lbound> to <ubound> will soon be split
+   by gt_bwtrangesplitwithoutspecial, so that the parts of the index
+   required can be fetched into the cache in the meantime. */
+void gt_bwtrangeprefetch(const FMindex *fmindex,
+                         GtUword lbound,
+                         GtUword ubound);
+
 FMindex *gt_loadvoidBWTSeqForSA(const char *indexname,
                                 bool withpckbt,
                                 GtError *err);
@@ -129,6 +136,26 @@ GtUword gt_bwtrangesplitallwithoutspecial(Mbtab *mbtab,
                                                 GtUword lbound,
                                                 GtUword ubound);
 
+/* Compute the bounds of the exact matches of the <numofpatterns> patterns,
+   none of which is empty. All patterns are searched at once, so that the
+   index accesses for different patterns overlap. The bounds of the
+   matches of pattern i are stored in <bounds>[i]. */
+void gt_pck_exactpatternbounds(const FMindex *fmindex,
+                               const GtUchar *const *patterns,
+                               const GtUword *patternlengths,
+                               GtUword numofpatterns,
+                               Mbtab *bounds);
+
+/* Like gt_pck_exactpatternmatching, but for a pattern whose <bounds> were
+   computed by gt_pck_exactpatternbounds. */
+bool gt_pck_exactpatternmatchingbounds(const FMindex *fmindex,
+                                       const Mbtab *bounds,
+                                       GtUword patternlength,
+                                       GtUword totallength,
+                                       const GtUchar *dbsubstring,
+                                       ProcessIdxMatch processmatch,
+                                       void *processmatchinfo);
+
 unsigned int gt_bwtseq2maxdepth(const FMindex *fmindex);
 
 unsigned int gt_bwtseq2numofchars(const FMindex *fmindex);
@@ -0,0 +1,444 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "core/array_api.h"
+#include "core/chardef.h"
+#include "core/error_api.h"
+#include "core/fa.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/warning_api.h"
+#include "core/xansi_api.h"
+#include "esa-addlcp.h"
+#include "esa-fileend.h"
+#include "esa-map.h"
+#include "lcpoverflow.h"
+#include "sarr-def.h"
+#include "sfx-outprj.h"
+
+/* Each thread processes at least this number of entries. */
+#define GT_ADDLCP_MINENTRIESPERTHREAD ((GtUword) (1 << 16))
+#define GT_ADDLCP_UNDEFINED GT_UWORD_MAX
+
+typedef struct
+{
+  const ESASuffixptr *suftab;
+  const GtEncseq *encseq;
+  GtReadmode readmode;
+  bool cmpcharbychar;
+  GtUword totallength,
+          partwidth,
+          blockstart,
+          blockend,
+          *phitab; /* phi values of the block, overwritten by plcp values */
+  uint8_t *lcptab;
+} GtAddlcpinfo;
+
+typedef struct
+{
+  const GtAddlcpinfo *info;
+  GtUword start,
+          end,
+          maxbranchdepth;
+  double lcptabsum;
+  GtArray *largelcpvalues;
+  GtEncseqReader *esr1,
+                 *esr2;
+} GtAddlcpthreadinfo;
+
+/* Call <function> for each of the <numofthreads> elements of <threadinfo>,
+   each in its own thread. The calling thread processes the first element
+   and the elements of threads which cannot be created. */
+static void gt_addlcp_run_threads(GtThreadFunc function,
+                                  GtAddlcpthreadinfo *threadinfo,
+                                  unsigned int numofthreads)
+{
+  GtThread **threads = gt_malloc(sizeof *threads * numofthreads);
+  GtError *thread_err = gt_error_new();
+  unsigned int t;
+
+  for (t = 1U; t < numofthreads; t++)
+  {
+    threads[t] = gt_thread_new(function,threadinfo + t,thread_err);
+    if (threads[t] == NULL)
+    {
+      gt_warning("%s; its lcp values are computed by the calling thread",
+                 gt_error_get(thread_err));
+      gt_error_unset(thread_err);
+      (void) function(threadinfo + t);
+    }
+  }
+  (void) function(threadinfo);
+  for (t = 1U; t < numofthreads; t++)
+  {
+    if (threads[t] != NULL)
+    {
+      gt_thread_join(threads[t]);
+      gt_thread_delete(threads[t]);
+    }
+  }
+  gt_error_delete(thread_err);
+  gt_free(threads);
+}
+
+/* Split the range from <start> to <end> into <numofthreads> ranges of almost
+   equal size. */
+static void gt_addlcp_split(GtAddlcpthreadinfo *threadinfo,
+                            unsigned int numofthreads,
+                            GtUword start,
+                            GtUword end)
+{
+  const GtUword width = end - start;
+  unsigned int t;
+
+  for (t = 0; t < numofthreads; t++)
+  {
+    threadinfo[t].start = start + width * t/numofthreads;
+    threadinfo[t].end = start + width * (t+1)/numofthreads;
+  }
+}
+
+static void *gt_addlcp_phi_thread(void *data)
+{
+  GtAddlcpthreadinfo *ti = (GtAddlcpthreadinfo *) data;
+  const GtAddlcpinfo *info = ti->info;
+  GtUword idx;
+
+  for (idx = MAX(ti->start,1UL); idx < ti->end; idx++)
+  {
+    GtUword pos = ESASUFFIXPTRGET(info->suftab,idx);
+
+    if (pos >= info->blockstart && pos < info->blockend)
+    {
+      info->phitab[pos - info->blockstart]
+        = ESASUFFIXPTRGET(info->suftab,idx-1);
+    }
+  }
+  return NULL;
+}
+
+/* Return the length of the longest common prefix of the suffixes at <pos1>
+   and <pos2>, which is known to be at least <lcpvalue>. */
+static GtUword gt_addlcp_extend(GtAddlcpthreadinfo *ti,
+                                GtUword pos1,
+                                GtUword pos2,
+                                GtUword lcpvalue)
+{
+  const GtAddlcpinfo *info = ti->info;
+  const GtUword maxlcp = info->totallength - MAX(pos1,pos2);
+
+  if (lcpvalue >= maxlcp)
+  {
+    return maxlcp;
+  }
+  if (info->cmpcharbychar)
+  {
+    while (lcpvalue < maxlcp)
+    {
+      GtUchar cc1 = gt_encseq_get_encoded_char(info->encseq,pos1 + lcpvalue,
+                                               info->readmode),
+              cc2 = gt_encseq_get_encoded_char(info->encseq,pos2 + lcpvalue,
+                                               info->readmode);
+
+      if (cc1 != cc2 || ISSPECIAL(cc1))
+      {
+        break;
+      }
+      lcpvalue++;
+    }
+  } else
+  {
+    GtCommonunits commonunits;
+
+    (void) gt_encseq_compare_viatwobitencoding(&commonunits,
+                                               info->encseq,
+                                               info->encseq,
+                                               info->readmode,
+                                               ti->esr1,
+                                               ti->esr2,
+                                               pos1,
+                                               pos2,
+                                               lcpvalue,
+                                               0);
+    lcpvalue = commonunits.finaldepth;
+  }
+  return lcpvalue;
+}
+
+/* As the lcp value of position <pos>+1 is at least the lcp value of
+   <pos> minus 1, the lcp values are computed in the order of the positions.
+   Each thread starts with 0 at the beginning of its range. */
+static void *gt_addlcp_plcp_thread(void *data)
+{
+  GtAddlcpthreadinfo *ti = (GtAddlcpthreadinfo *) data;
+  const GtAddlcpinfo *info = ti->info;
+  GtUword pos, lcpvalue = 0;
+
+  for (pos = ti->start; pos < ti->end; pos++)
+  {
+    GtUword *phiptr = info->phitab + (pos - info->blockstart);
+
+    if (*phiptr == GT_ADDLCP_UNDEFINED)
+    {
+      *phiptr = lcpvalue = 0;
+    } else
+    {
+      lcpvalue = gt_addlcp_extend(ti,pos,*phiptr,lcpvalue);
+      *phiptr = lcpvalue;
+      if (lcpvalue > 0)
+      {
+        lcpvalue--;
+      }
+    }
+  }
+  return NULL;
+}
+
+static void *gt_addlcp_lcp_thread(void *data)
+{
+  GtAddlcpthreadinfo *ti = (GtAddlcpthreadinfo *) data;
+  const GtAddlcpinfo *info = ti->info;
+  GtUword idx;
+
+  for (idx = ti->start; idx < ti->end; idx++)
+  {
+    GtUword pos = ESASUFFIXPTRGET(info->suftab,idx);
+
+    if (pos >= info->blockstart && pos < info->blockend)
+    {
+      GtUword lcpvalue = idx == 0 ? 0 : info->phitab[pos - info->blockstart];
+
+      if (lcpvalue < (GtUword) LCPOVERFLOW)
+      {
+        info->lcptab[idx] = (uint8_t) lcpvalue;
+      } else
+      {
+        Largelcpvalue largelcpvalue;
+
+        largelcpvalue.position = idx;
+        largelcpvalue.value = lcpvalue;
+        gt_array_add(ti->largelcpvalues,largelcpvalue);
+        info->lcptab[idx] = LCPOVERFLOW;
+      }
+      if (ti->maxbranchdepth < lcpvalue)
+      {
+        ti->maxbranchdepth = lcpvalue;
+      }
+      ti->lcptabsum += (double) lcpvalue;
+    }
+  }
+  return NULL;
+}
+
+static int gt_addlcp_cmp_largelcpvalue(const void *a,const void *b)
+{
+  const Largelcpvalue *l1 = (const Largelcpvalue *) a,
+                      *l2 = (const Largelcpvalue *) b;
+
+  if (l1->position < l2->position)
+  {
+    return -1;
+  }
+  return l1->position > l2->position ? 1 : 0;
+}
+
+/* Create the .lcp file with <numofentries> bytes, all of them 0, and
+   map it. */
+static uint8_t *gt_addlcp_map_lcptab(const char *indexname,
+                                     GtUword numofentries,
+                                     GtError *err)
+{
+  FILE *fp;
+  uint8_t *lcptab = NULL;
+  GtStr *filename;
+  size_t numofbytes = 0;
+
+  fp = gt_fa_fopen_with_suffix(indexname,GT_LCPTABSUFFIX,"wb",err);
+  if (fp == NULL)
+  {
+    return NULL;
+  }
+  if (numofentries > 0)
+  {
+    const uint8_t zero = 0;
+
+    gt_xfseek(fp,(GtWord) (numofentries - 1),SEEK_SET);
+    gt_xfwrite_one(&zero,fp);
+  }
+  gt_fa_xfclose(fp);
+  if (numofentries > 0)
+  {
+    filename = gt_str_new_cstr(indexname);
+    gt_str_append_cstr(filename,GT_LCPTABSUFFIX);
+    lcptab = gt_fa_mmap_write(gt_str_get(filename),&numofbytes,err);
+    gt_str_delete(filename);
+    gt_assert(lcptab == NULL || numofbytes == (size_t) numofentries);
+  }
+  return lcptab;
+}
+
+int gt_esa_addlcp(const char *indexname,
+                  GtUword maximumspace,
+                  GtLogger *logger,
+                  GtError *err)
+{
+  Suffixarray suffixarray;
+  GtAddlcpinfo info;
+  GtAddlcpthreadinfo *threadinfo = NULL;
+  GtArray *largelcpvalues = NULL;
+  GtUword blocksize = 0, numofblocks = 0, maxbranchdepth = 0;
+  double lcptabsum = 0.0;
+  unsigned int t, numofthreads = 1U;
+  bool haserr = false;
+
+  gt_error_check(err);
+  info.lcptab = NULL;
+  if (gt_mapsuffixarray(&suffixarray,SARR_SUFTAB | SARR_ESQTAB,indexname,
+                        logger,err) != 0)
+  {
+    haserr = true;
+  }
+  if (!haserr)
+  {
+    info.suftab = suffixarray.suftab;
+    info.encseq = suffixarray.encseq;
+    info.readmode = suffixarray.readmode;
+    info.cmpcharbychar = !gt_encseq_bitwise_cmp_ok(info.encseq);
+    info.totallength = gt_encseq_total_length(info.encseq);
+    info.partwidth = MIN(info.totallength
+                         - gt_encseq_specialcharacters(info.encseq),
+                         suffixarray.numberofallsortedsuffixes);
+    info.lcptab = gt_addlcp_map_lcptab(indexname,
+                                       suffixarray.numberofallsortedsuffixes,
+                                       err);
+    if (info.lcptab == NULL && suffixarray.numberofallsortedsuffixes > 0)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr && info.partwidth > 0)
+  {
+    blocksize = info.totallength;
+    if (maximumspace > 0 &&
+        maximumspace/sizeof (*info.phitab) < (size_t) blocksize)
+    {
+      blocksize = MAX(maximumspace/sizeof (*info.phitab),1UL);
+    }
+    numofblocks = (info.totallength + blocksize - 1)/blocksize;
+    numofthreads = MAX(1U,MIN(gt_jobs,(unsigned int)
+                              (info.partwidth/GT_ADDLCP_MINENTRIESPERTHREAD)));
+    gt_logger_log(logger,"compute lcp table for "GT_WU" suffixes in "GT_WU
+                         " block(s) of "GT_WU" positions with %u thread(s)",
+                  info.partwidth,numofblocks,blocksize,numofthreads);
+    info.phitab = gt_malloc(sizeof (*info.phitab) * blocksize);
+    threadinfo = gt_malloc(sizeof (*threadinfo) * numofthreads);
+    for (t = 0; t < numofthreads; t++)
+    {
+      threadinfo[t].info = &info;
+      threadinfo[t].maxbranchdepth = 0;
+      threadinfo[t].lcptabsum = 0.0;
+      threadinfo[t].largelcpvalues = gt_array_new(sizeof (Largelcpvalue));
+      threadinfo[t].esr1 = gt_encseq_create_reader_with_readmode(info.encseq,
+                                                                info.readmode,
+                                                                0);
+      threadinfo[t].esr2 = gt_encseq_create_reader_with_readmode(info.encseq,
+                                                                info.readmode,
+                                                                0);
+    }
+    for (info.blockstart = 0; info.blockstart < info.totallength;
+         info.blockstart += blocksize)
+    {
+      GtUword pos;
+
+      info.blockend = MIN(info.blockstart + blocksize,info.totallength);
+      for (pos = 0; pos < info.blockend - info.blockstart; pos++)
+      {
+        info.phitab[pos] = GT_ADDLCP_UNDEFINED;
+      }
+      gt_addlcp_split(threadinfo,numofthreads,0,info.partwidth);
+      gt_addlcp_run_threads(gt_addlcp_phi_thread,threadinfo,numofthreads);
+      gt_addlcp_split(threadinfo,numofthreads,info.blockstart,info.blockend);
+      gt_addlcp_run_threads(gt_addlcp_plcp_thread,threadinfo,numofthreads);
+      gt_addlcp_split(threadinfo,numofthreads,0,info.partwidth);
+      gt_addlcp_run_threads(gt_addlcp_lcp_thread,threadinfo,numofthreads);
+    }
+    largelcpvalues = gt_array_new(sizeof (Largelcpvalue));
+    for (t = 0; t < numofthreads; t++)
+    {
+      gt_array_add_array(largelcpvalues,threadinfo[t].largelcpvalues);
+      gt_array_delete(threadinfo[t].largelcpvalues);
+      maxbranchdepth = MAX(maxbranchdepth,threadinfo[t].maxbranchdepth);
+      lcptabsum += threadinfo[t].lcptabsum;
+      gt_encseq_reader_delete(threadinfo[t].esr1);
+      gt_encseq_reader_delete(threadinfo[t].esr2);
+    }
+    gt_free(threadinfo);
+    gt_free(info.phitab);
+    if (numofblocks > 1UL)
+    {
+      gt_array_sort(largelcpvalues,gt_addlcp_cmp_largelcpvalue);
+    }
+  }
+  if (!haserr)
+  {
+    FILE *fpllvtab = gt_fa_fopen_with_suffix(indexname,GT_LARGELCPTABSUFFIX,
+                                             "wb",err);
+
+    if (fpllvtab == NULL)
+    {
+      haserr = true;
+    } else
+    {
+      if (largelcpvalues != NULL && gt_array_size(largelcpvalues) > 0)
+      {
+        gt_xfwrite(gt_array_get_space(largelcpvalues),sizeof (Largelcpvalue),
+                   gt_array_size(largelcpvalues),fpllvtab);
+      }
+      gt_fa_xfclose(fpllvtab);
+    }
+  }
+  if (!haserr)
+  {
+    GtUword numoflargelcpvalues
+      = largelcpvalues == NULL ? 0 : gt_array_size(largelcpvalues);
+
+    gt_logger_log(logger,"maxbranchdepth="GT_WU", largelcpvalues="GT_WU,
+                  maxbranchdepth,numoflargelcpvalues);
+    if (gt_outprjfile(indexname,
+                      suffixarray.readmode,
+                      suffixarray.encseq,
+                      suffixarray.numberofallsortedsuffixes,
+                      suffixarray.prefixlength,
+                      numoflargelcpvalues,
+                      suffixarray.numberofallsortedsuffixes > 0
+                        ? lcptabsum/suffixarray.numberofallsortedsuffixes
+                        : 0.0,
+                      maxbranchdepth,
+                      &suffixarray.longest,
+                      err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  gt_array_delete(largelcpvalues);
+  gt_fa_xmunmap(info.lcptab);
+  gt_freesuffixarray(&suffixarray);
+  return haserr ? -1 : 0;
+}
@@ -0,0 +1,41 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ESA_ADDLCP_H
+#define ESA_ADDLCP_H
+
+#include "core/error_api.h"
+#include "core/logger.h"
+#include "core/types_api.h"
+
+/* Compute the lcp table of the enhanced suffix array <indexname> from its
+   suffix array and encoded sequence and write it to the files with suffixes
+   .lcp and .llv. The values in the .prj file which depend on the lcp table
+   are updated. The lcp values are computed with the phi algorithm: for each
+   position the suffix preceding it in the suffix array is determined, then
+   the lcp values are computed in the order of the positions, the text is
+   split into as many ranges as there are threads (see <gt_jobs>).
+   If <maximumspace> is not 0, the text is processed in blocks such that the
+   table for one block occupies at most <maximumspace> bytes; the suffix
+   array is then scanned twice for each block. The .lcp file is written via a
+   memory map, so it does not need to fit into memory either. Returns 0 on
+   success; otherwise -1 and <err> is set. */
+int gt_esa_addlcp(const char *indexname,
+                  GtUword maximumspace,
+                  GtLogger *logger,
+                  GtError *err);
+
+#endif
@@ -32,6 +32,7 @@
 #include "core/encseq.h"
 #include "esa-fileend.h"
 #include "esa-scanprj.h"
+#include "esa-suftabsample.h"
 #include "sarr-def.h"
 
 #define DBFILEKEY "dbfile="
@@ -217,6 +218,7 @@ static void initsuffixarray(Suffixarray *suffixarray)
   suffixarray->llvtab = NULL;
   suffixarray->bwttab = NULL;
   suffixarray->bcktab = NULL;
+  suffixarray->suftabsample = NULL;
   suffixarray->bwttabstream.fp = NULL;
   suffixarray->bwttabstream.bufferedfilespace = NULL;
   suffixarray->suftabstream_GtUword.fp = NULL;
@@ -290,6 +292,8 @@ void gt_freesuffixarray(Suffixarray *suffixarray)
     gt_bcktab_delete(suffixarray->bcktab);
     suffixarray->bcktab = NULL;
   }
+  gt_suftabsample_delete(suffixarray->suftabsample);
+  suffixarray->suftabsample = NULL;
 }
 
 static int inputsuffixarray(bool map,
@@ -477,6 +481,12 @@ static int inputsuffixarray(bool map,
       haserr = true;
     }
   }
+  if (!haserr && (demand & SARR_SUFSAMPLE))
+  {
+    gt_assert(map && (demand & SARR_SUFTAB));
+    suffixarray->suftabsample = gt_suftabsample_new(suffixarray,indexname,
+                                                    logger);
+  }
   if (haserr)
   {
     gt_freesuffixarray(suffixarray);
@@ -21,6 +21,7 @@
 #include "sarr-def.h"
 
 #include "esa-splititv.h"
+#include "esa-suftabsample.h"
 #include "esa-minunique.h"
 
 GtUword gt_suffixarrayuniqueforward (const void *genericindex,
@@ -40,6 +41,12 @@ GtUword gt_suffixarrayuniqueforward (const void *genericindex,
   itv.left = left;
   itv.right = right;
   totallength = gt_encseq_total_length(suffixarray->encseq);
+  if (offset == 0 && suffixarray->suftabsample != NULL)
+  {
+    offset = gt_suftabsample_prefixinterval(suffixarray,&itv,qstart,qend,
+                                            2UL);
+    qstart += offset;
+  }
   for (qptr = qstart; /* Nothing */; qptr++, offset++)
   {
     if (itv.left < itv.right)
@@ -81,6 +88,12 @@ GtUword gt_suffixarraymstats (const void *genericindex,
   itv.left = left;
   itv.right = right;
   totallength = gt_encseq_total_length(suffixarray->encseq);
+  if (offset == 0 && suffixarray->suftabsample != NULL)
+  {
+    offset = gt_suftabsample_prefixinterval(suffixarray,&itv,qstart,qend,
+                                            1UL);
+    qstart += offset;
+  }
   for (qptr = qstart; /* Nothing */; qptr++, offset++)
   {
     gt_assert(itv.left <= itv.right);
@@ -121,6 +134,12 @@ GtUword gt_suffixarrayfindmums (const void *genericindex,
   itv.right = right;
   totallength = gt_encseq_total_length(suffixarray->encseq);
   *witnessposition = ULONG_MAX;
+  if (offset == 0 && suffixarray->suftabsample != NULL)
+  {
+    offset = gt_suftabsample_prefixinterval(suffixarray,&itv,qstart,qend,
+                                            1UL);
+    qstart += offset;
+  }
   for (qptr = qstart; /* Nothing */; qptr++, offset++)
   {
     gt_assert(itv.left <= itv.right);
@@ -301,6 +301,32 @@ GtMMsearchiterator *gt_mmsearchiterator_new_complete_plain(
                                  patternlength);
 }
 
+bool gt_mmsearch_plain_interval(const GtEncseq *dbencseq,
+                                const ESASuffixptr *suftab,
+                                GtReadmode readmode,
+                                Lcpinterval *lcpitv,
+                                const GtUchar *pattern,
+                                GtUword patternlength)
+{
+  GtQueryrepresentation queryrep;
+  GtQuerysubstring querysubstring;
+  GtEncseqReader *esr;
+  bool found;
+
+  queryrep.sequence = pattern;
+  queryrep.encseq = NULL;
+  queryrep.readmode = GT_READMODE_FORWARD;
+  queryrep.startpos = 0;
+  queryrep.seqlen = patternlength;
+  querysubstring.queryrep = &queryrep;
+  querysubstring.currentoffset = 0;
+  esr = gt_encseq_create_reader_with_readmode(dbencseq, readmode, 0);
+  found = gt_mmsearch(dbencseq,esr,suftab,readmode,lcpitv,&querysubstring,
+                      patternlength);
+  gt_encseq_reader_delete(esr);
+  return found;
+}
+
 GtUword gt_mmsearchiterator_count(const GtMMsearchiterator *mmsi)
 {
   gt_assert(mmsi != NULL);
@@ -21,6 +21,7 @@
 #include "core/encseq.h"
 #include "sarr-def.h"
 #include "querymatch.h"
+#include "lcpinterval.h"
 
 typedef void (*GtProcessquerymatch)(void *,const GtQuerymatch *);
 
@@ -36,6 +37,17 @@ GtMMsearchiterator *gt_mmsearchiterator_new_complete_plain(
                                     const GtUchar *pattern,
                                     GtUword patternlength);
 
+/* Restrict <lcpitv> to the interval of the suffixes having <pattern> of
+   length <patternlength> as a prefix. All suffixes in <lcpitv> must have
+   the first <lcpitv->offset> characters of <pattern> as a prefix. Returns
+   false if there is no such suffix. */
+bool gt_mmsearch_plain_interval(const GtEncseq *dbencseq,
+                                const ESASuffixptr *suftab,
+                                GtReadmode readmode,
+                                Lcpinterval *lcpitv,
+                                const GtUchar *pattern,
+                                GtUword patternlength);
+
 bool gt_mmsearchiterator_next(GtUword *dbstart,GtMMsearchiterator *mmsi);
 
 bool gt_mmsearchiterator_isempty(const GtMMsearchiterator *mmsi);
@@ -0,0 +1,575 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdint.h>
+#include "core/assert_api.h"
+#include "core/chardef.h"
+#include "core/encseq.h"
+#include "core/error_api.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "bcktab.h"
+#include "esa-fileend.h"
+#include "qgram2code.h"
+#include "esa-mmsearch.h"
+#include "esa-suftabsample.h"
+
+/* the sample consists of at most 2^16-1 suffixes, so that the keys occupy
+   at most 512 KB */
+#define GT_SUFTABSAMPLE_MAXHEIGHT 16U
+/* the minimum number of suffixes between two sampled suffixes */
+#define GT_SUFTABSAMPLE_MINSTEP   16
+
+#define GT_SUFTABSAMPLE_KEYBITS   64U
+
+typedef uint64_t GtSuftabsamplekey;
+
+struct GtSuftabsample
+{
+  const GtBcktab *bcktab;
+  GtBcktab *ownbcktab;
+  GtSuftabsamplekey *keys;      /* Eytzinger order, index 0 is not used */
+  uint8_t *regularprefix;       /* Eytzinger order, index 0 is not used */
+  unsigned int height,
+               bitspersymbol,
+               symbolsperkey;
+  GtUword numofsamples,         /* 2^height - 1 */
+          step;                 /* rank j is stored at (j+1) * step */
+};
+
+/* The sampled suffix of rank <rank> is stored at the index of the in-order
+   number <rank>+1 of a complete binary tree in breadth first order. */
+static GtUword gt_suftabsample_rank2index(const GtSuftabsample *suftabsample,
+                                          GtUword rank)
+{
+  GtUword inorder = rank + 1;
+  unsigned int trailingzeros = 0;
+
+  while ((inorder & ((GtUword) 1 << trailingzeros)) == 0)
+  {
+    trailingzeros++;
+  }
+  return ((GtUword) 1 << (suftabsample->height - 1 - trailingzeros)) +
+         (inorder >> (trailingzeros + 1));
+}
+
+static GtUword gt_suftabsample_index2rank(const GtSuftabsample *suftabsample,
+                                          GtUword idx)
+{
+  unsigned int level = 0;
+  GtUword levelstart;
+
+  while (((GtUword) 2 << level) <= idx)
+  {
+    level++;
+  }
+  levelstart = (GtUword) 1 << level;
+  return ((GtUword) 2 * (idx - levelstart) + 1)
+         * ((GtUword) 1 << (suftabsample->height - 1 - level)) - 1;
+}
+
+static GtUword gt_suftabsample_position(const GtSuftabsample *suftabsample,
+                                        GtUword rank)
+{
+  return (rank + 1) * suftabsample->step;
+}
+
+/* All characters from the first special character on are represented by
+   the largest character, so that the keys are in the order of the suffixes
+   of the sample. */
+static GtSuftabsamplekey gt_suftabsample_suffixkey(
+                                       unsigned int *regularprefix,
+                                       const GtSuftabsample *suftabsample,
+                                       const GtEncseq *encseq,
+                                       GtEncseqReader *esr,
+                                       GtReadmode readmode,
+                                       GtUword totallength,
+                                       GtUword startpos,
+                                       GtUchar largestchar)
+{
+  GtSuftabsamplekey key = 0;
+  unsigned int idx;
+  bool special = false;
+
+  if (startpos < totallength)
+  {
+    gt_encseq_reader_reinit_with_readmode(esr,encseq,readmode,startpos);
+  }
+  *regularprefix = 0;
+  for (idx = 0; idx < suftabsample->symbolsperkey; idx++)
+  {
+    GtUchar cc = largestchar;
+
+    if (!special)
+    {
+      if (startpos + idx >= totallength)
+      {
+        special = true;
+      } else
+      {
+        cc = gt_encseq_reader_next_encoded_char(esr);
+        if (ISSPECIAL(cc))
+        {
+          special = true;
+        } else
+        {
+          (*regularprefix)++;
+        }
+      }
+    }
+    if (special)
+    {
+      cc = largestchar;
+    }
+    key |= (GtSuftabsamplekey) cc << (GT_SUFTABSAMPLE_KEYBITS -
+                                      (idx + 1) * suftabsample->bitspersymbol);
+  }
+  return key;
+}
+
+/* A bucket table which does not fit to the suffix array, for example
+   because it was left over from a previous construction, is not used. */
+static GtBcktab *gt_suftabsample_mapbcktab(const Suffixarray *suffixarray,
+                                           const char *indexname,
+                                           GtLogger *logger)
+{
+  GtBcktab *bcktab = NULL;
+
+  if (suffixarray->prefixlength > 0 &&
+      gt_file_exists_with_suffix(indexname,GT_BCKTABSUFFIX))
+  {
+    GtError *err = gt_error_new();
+
+    bcktab = gt_bcktab_map(indexname,
+                           gt_encseq_alphabetnumofchars(suffixarray->encseq),
+                           suffixarray->prefixlength,
+                           gt_encseq_total_length(suffixarray->encseq) + 1,
+                           true,
+                           err);
+    if (bcktab == NULL)
+    {
+      gt_logger_log(logger,"bucket table is not used: %s",
+                    gt_error_get(err));
+    }
+    gt_error_delete(err);
+  }
+  return bcktab;
+}
+
+GtSuftabsample *gt_suftabsample_new(const Suffixarray *suffixarray,
+                                    const char *indexname,
+                                    GtLogger *logger)
+{
+  GtSuftabsample *suftabsample;
+  unsigned int numofchars;
+  GtUword rank, numofsuffixes, totallength;
+
+  gt_assert(suffixarray != NULL && suffixarray->encseq != NULL);
+  suftabsample = gt_malloc(sizeof (*suftabsample));
+  if (suffixarray->bcktab != NULL)
+  {
+    suftabsample->bcktab = suffixarray->bcktab;
+    suftabsample->ownbcktab = NULL;
+  } else
+  {
+    suftabsample->ownbcktab = gt_suftabsample_mapbcktab(suffixarray,indexname,
+                                                        logger);
+    suftabsample->bcktab = suftabsample->ownbcktab;
+  }
+  numofchars = gt_encseq_alphabetnumofchars(suffixarray->encseq);
+  suftabsample->bitspersymbol = 1U;
+  while ((1U << suftabsample->bitspersymbol) < numofchars)
+  {
+    suftabsample->bitspersymbol++;
+  }
+  suftabsample->symbolsperkey
+    = GT_SUFTABSAMPLE_KEYBITS/suftabsample->bitspersymbol;
+  numofsuffixes = suffixarray->suftab == NULL
+                    ? 0 : suffixarray->numberofallsortedsuffixes;
+  suftabsample->height = 0;
+  while (suftabsample->height < GT_SUFTABSAMPLE_MAXHEIGHT &&
+         ((GtUword) 2 << suftabsample->height) * GT_SUFTABSAMPLE_MINSTEP
+           <= numofsuffixes)
+  {
+    suftabsample->height++;
+  }
+  suftabsample->numofsamples = ((GtUword) 1 << suftabsample->height) - 1;
+  suftabsample->step = numofsuffixes/(suftabsample->numofsamples + 1);
+  suftabsample->keys = NULL;
+  suftabsample->regularprefix = NULL;
+  if (suftabsample->numofsamples > 0)
+  {
+    GtEncseqReader *esr;
+
+    suftabsample->keys = gt_malloc(sizeof (*suftabsample->keys) *
+                                   (suftabsample->numofsamples + 1));
+    suftabsample->regularprefix
+      = gt_malloc(sizeof (*suftabsample->regularprefix) *
+                  (suftabsample->numofsamples + 1));
+    totallength = gt_encseq_total_length(suffixarray->encseq);
+    esr = gt_encseq_create_reader_with_readmode(suffixarray->encseq,
+                                                suffixarray->readmode,0);
+    for (rank = 0; rank < suftabsample->numofsamples; rank++)
+    {
+      GtUword idx = gt_suftabsample_rank2index(suftabsample,rank);
+      unsigned int regularprefix;
+
+      suftabsample->keys[idx]
+        = gt_suftabsample_suffixkey(&regularprefix,
+                                    suftabsample,
+                                    suffixarray->encseq,
+                                    esr,
+                                    suffixarray->readmode,
+                                    totallength,
+                                    ESASUFFIXPTRGET(suffixarray->suftab,
+                                           gt_suftabsample_position(
+                                                           suftabsample,rank)),
+                                    (GtUchar) (numofchars - 1));
+      suftabsample->regularprefix[idx] = (uint8_t) regularprefix;
+      gt_assert(rank == 0 ||
+                suftabsample->keys[gt_suftabsample_rank2index(suftabsample,
+                                                              rank-1)]
+                <= suftabsample->keys[idx]);
+    }
+    gt_encseq_reader_delete(esr);
+  }
+  gt_logger_log(logger,"sample of suffix array: "GT_WU" suffixes with step "
+                GT_WU", %u characters per key",suftabsample->numofsamples,
+                suftabsample->step,suftabsample->symbolsperkey);
+  return suftabsample;
+}
+
+void gt_suftabsample_delete(GtSuftabsample *suftabsample)
+{
+  if (suftabsample != NULL)
+  {
+    gt_bcktab_delete(suftabsample->ownbcktab);
+    gt_free(suftabsample->keys);
+    gt_free(suftabsample->regularprefix);
+    gt_free(suftabsample);
+  }
+}
+
+static unsigned int gt_suftabsample_regularprefix(const GtUchar *pattern,
+                                                  GtUword patternlength,
+                                                  unsigned int maxlength)
+{
+  unsigned int idx;
+
+  for (idx = 0; idx < maxlength && (GtUword) idx < patternlength &&
+                !ISSPECIAL(pattern[idx]); idx++)
+    /* Nothing */ ;
+  return idx;
+}
+
+static GtSuftabsamplekey gt_suftabsample_patternkey(
+                                        const GtSuftabsample *suftabsample,
+                                        const GtUchar *pattern,
+                                        unsigned int length)
+{
+  GtSuftabsamplekey key = 0;
+  unsigned int idx;
+
+  for (idx = 0; idx < length; idx++)
+  {
+    key |= (GtSuftabsamplekey) pattern[idx]
+           << (GT_SUFTABSAMPLE_KEYBITS -
+               (idx + 1) * suftabsample->bitspersymbol);
+  }
+  return key;
+}
+
+static unsigned int gt_suftabsample_keyshift(const GtSuftabsample *suftabsample,
+                                             unsigned int length)
+{
+  gt_assert(length > 0 && length <= suftabsample->symbolsperkey);
+  return GT_SUFTABSAMPLE_KEYBITS - length * suftabsample->bitspersymbol;
+}
+
+/* Return the rank of the first sampled suffix whose first <length>
+   characters are not smaller (if <strict> is false) or larger (if <strict>
+   is true) than those of <key>, and the number of samples if there is
+   none. */
+static GtUword gt_suftabsample_bound(const GtSuftabsample *suftabsample,
+                                     GtSuftabsamplekey key,
+                                     unsigned int length,
+                                     bool strict)
+{
+  const unsigned int shift = gt_suftabsample_keyshift(suftabsample,length);
+  const GtSuftabsamplekey prefix = key >> shift;
+  GtUword idx = 1;
+
+  if (strict)
+  {
+    while (idx <= suftabsample->numofsamples)
+    {
+      idx = 2 * idx + ((suftabsample->keys[idx] >> shift) <= prefix ? 1 : 0);
+    }
+  } else
+  {
+    while (idx <= suftabsample->numofsamples)
+    {
+      idx = 2 * idx + ((suftabsample->keys[idx] >> shift) < prefix ? 1 : 0);
+    }
+  }
+  /* remove the right turns and the last left turn */
+  while (idx & 1)
+  {
+    idx >>= 1;
+  }
+  idx >>= 1;
+  return idx == 0 ? suftabsample->numofsamples
+                  : gt_suftabsample_index2rank(suftabsample,idx);
+}
+
+/* Return the length of the longest common prefix of the suffix of rank
+   <rank> and the first <length> characters of <key>, which consists of
+   regular characters only. */
+static unsigned int gt_suftabsample_lcp(const GtSuftabsample *suftabsample,
+                                        GtUword rank,
+                                        GtSuftabsamplekey key,
+                                        unsigned int length)
+{
+  GtUword idx = gt_suftabsample_rank2index(suftabsample,rank);
+  GtSuftabsamplekey diff = suftabsample->keys[idx] ^ key;
+  unsigned int lcp,
+               maxlength = MIN(length,suftabsample->regularprefix[idx]);
+
+  for (lcp = 0; lcp < maxlength; lcp++)
+  {
+    if ((diff >> gt_suftabsample_keyshift(suftabsample,lcp + 1)) != 0)
+    {
+      break;
+    }
+  }
+  return lcp;
+}
+
+/* Restrict <lcpitv> to the range of the suffix array between the sampled
+   suffixes enclosing the suffixes which have the first <length> characters
+   of <key> as a prefix. */
+static bool gt_suftabsample_enclose(const GtSuftabsample *suftabsample,
+                                    Lcpinterval *lcpitv,
+                                    GtSuftabsamplekey key,
+                                    unsigned int length)
+{
+  GtUword leftrank, rightrank, left, right, offset = 0;
+
+  leftrank = gt_suftabsample_bound(suftabsample,key,length,false);
+  rightrank = gt_suftabsample_bound(suftabsample,key,length,true);
+  left = leftrank == 0
+           ? 0 : gt_suftabsample_position(suftabsample,leftrank - 1) + 1;
+  if (rightrank < suftabsample->numofsamples)
+  {
+    right = gt_suftabsample_position(suftabsample,rightrank) - 1;
+    if (leftrank > 0)
+    {
+      /* the suffixes between two sampled suffixes have their common prefix,
+         which is also a prefix of <key> */
+      offset = (GtUword) MIN(gt_suftabsample_lcp(suftabsample,leftrank - 1,
+                                                 key,length),
+                             gt_suftabsample_lcp(suftabsample,rightrank,
+                                                 key,length));
+    }
+  } else
+  {
+    right = lcpitv->right;
+  }
+  if (left > lcpitv->left)
+  {
+    lcpitv->left = left;
+  }
+  if (right < lcpitv->right)
+  {
+    lcpitv->right = right;
+  }
+  if (offset > lcpitv->offset)
+  {
+    lcpitv->offset = offset;
+  }
+  return lcpitv->left <= lcpitv->right;
+}
+
+/* Restrict <lcpitv> to the bucket of the suffixes beginning with the first
+   <prefixlength> characters of <pattern>. */
+static bool gt_suftabsample_bucket(const GtBcktab *bcktab,
+                                   Lcpinterval *lcpitv,
+                                   const GtUchar *pattern)
+{
+  GtBucketspecification bucketspec;
+  GtCodetype code = 0;
+  unsigned int prefixlength = gt_bcktab_prefixlength(bcktab);
+
+  if (qgram2code(&code,gt_bcktab_multimappower(bcktab),prefixlength,
+                 pattern) < prefixlength)
+  {
+    return true;
+  }
+  gt_bcktab_calcboundaries(&bucketspec,bcktab,code);
+  if (bucketspec.nonspecialsinbucket == 0)
+  {
+    return false;
+  }
+  if (bucketspec.left > lcpitv->left)
+  {
+    lcpitv->left = bucketspec.left;
+  }
+  if (bucketspec.left + bucketspec.nonspecialsinbucket - 1 < lcpitv->right)
+  {
+    lcpitv->right = bucketspec.left + bucketspec.nonspecialsinbucket - 1;
+  }
+  if ((GtUword) prefixlength > lcpitv->offset)
+  {
+    lcpitv->offset = (GtUword) prefixlength;
+  }
+  return lcpitv->left <= lcpitv->right;
+}
+
+bool gt_suftabsample_narrow(const Suffixarray *suffixarray,
+                            Lcpinterval *lcpitv,
+                            const GtUchar *pattern,
+                            GtUword patternlength)
+{
+  const GtSuftabsample *suftabsample = suffixarray->suftabsample;
+
+  gt_assert(suftabsample != NULL);
+  if (suftabsample->bcktab != NULL &&
+      patternlength >= (GtUword) gt_bcktab_prefixlength(suftabsample->bcktab) &&
+      !gt_suftabsample_bucket(suftabsample->bcktab,lcpitv,pattern))
+  {
+    return false;
+  }
+  if (suftabsample->numofsamples > 0)
+  {
+    unsigned int length
+      = gt_suftabsample_regularprefix(pattern,patternlength,
+                                      suftabsample->symbolsperkey);
+
+    if (length > 0 &&
+        !gt_suftabsample_enclose(suftabsample,lcpitv,
+                                 gt_suftabsample_patternkey(suftabsample,
+                                                            pattern,length),
+                                 length))
+    {
+      return false;
+    }
+  }
+  if (lcpitv->offset > patternlength)
+  {
+    lcpitv->offset = patternlength;
+  }
+  return true;
+}
+
+GtUword gt_suftabsample_prefixinterval(const Suffixarray *suffixarray,
+                                       Simplelcpinterval *itv,
+                                       const GtUchar *qstart,
+                                       const GtUchar *qend,
+                                       GtUword minwidth)
+{
+  const GtSuftabsample *suftabsample = suffixarray->suftabsample;
+  GtSuftabsamplekey key;
+  GtUword rank, depth = 0;
+  unsigned int length;
+  Lcpinterval lcpitv, bucketitv;
+
+  gt_assert(suftabsample != NULL && qstart <= qend &&
+            (minwidth == 1UL || minwidth == 2UL));
+  bucketitv.left = 0;
+  bucketitv.right = suffixarray->numberofallsortedsuffixes - 1;
+  bucketitv.offset = 0;
+  if (suftabsample->bcktab != NULL)
+  {
+    unsigned int prefixlength = gt_bcktab_prefixlength(suftabsample->bcktab);
+
+    lcpitv = bucketitv;
+    if ((GtUword) (qend - qstart) >= (GtUword) prefixlength &&
+        gt_suftabsample_regularprefix(qstart,(GtUword) (qend - qstart),
+                                      prefixlength) == prefixlength &&
+        gt_suftabsample_bucket(suftabsample->bcktab,&lcpitv,qstart) &&
+        lcpitv.right - lcpitv.left + 1 >= minwidth)
+    {
+      /* the bucket is the lcp-interval of the first prefixlength
+         characters */
+      depth = (GtUword) prefixlength;
+      itv->left = lcpitv.left;
+      itv->right = lcpitv.right;
+      bucketitv = lcpitv;
+    }
+  }
+  if (suftabsample->numofsamples == 0)
+  {
+    return depth;
+  }
+  length = gt_suftabsample_regularprefix(qstart,(GtUword) (qend - qstart),
+                                         suftabsample->symbolsperkey);
+  if ((GtUword) length <= depth)
+  {
+    return depth;
+  }
+  key = gt_suftabsample_patternkey(suftabsample,qstart,length);
+  rank = gt_suftabsample_bound(suftabsample,key,length,false);
+  /* The sampled suffixes sharing the longest prefixes with the query are
+     next to <rank>. A prefix shared with the query by <minwidth> sampled
+     suffixes occurs at least <minwidth> times. */
+  {
+    GtUword first = rank >= minwidth ? rank - minwidth : 0,
+            last = MIN(rank + minwidth - 1,suftabsample->numofsamples - 1),
+            idx;
+    unsigned int lcpvalues[4];
+
+    gt_assert(last - first < 4UL);
+    for (idx = first; idx <= last; idx++)
+    {
+      lcpvalues[idx - first] = gt_suftabsample_lcp(suftabsample,idx,key,
+                                                    length);
+    }
+    length = 0;
+    for (idx = first; idx + minwidth - 1 <= last; idx++)
+    {
+      unsigned int lcp = lcpvalues[idx - first];
+
+      if (minwidth == 2UL && lcpvalues[idx - first + 1] < lcp)
+      {
+        lcp = lcpvalues[idx - first + 1];
+      }
+      if (lcp > length)
+      {
+        length = lcp;
+      }
+    }
+  }
+  if ((GtUword) length <= depth)
+  {
+    return depth;
+  }
+  lcpitv = bucketitv;
+  (void) gt_suftabsample_enclose(suftabsample,&lcpitv,key,length);
+  if (gt_mmsearch_plain_interval(suffixarray->encseq,
+                                 suffixarray->suftab,
+                                 suffixarray->readmode,
+                                 &lcpitv,
+                                 qstart,
+                                 (GtUword) length) &&
+      lcpitv.right - lcpitv.left + 1 >= minwidth)
+  {
+    itv->left = lcpitv.left;
+    itv->right = lcpitv.right;
+    return (GtUword) length;
+  }
+  return depth;
+}
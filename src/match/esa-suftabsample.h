@@ -0,0 +1,70 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ESA_SUFTABSAMPLE_H
+#define ESA_SUFTABSAMPLE_H
+
+#include "core/logger.h"
+#include "core/types_api.h"
+#include "lcpinterval.h"
+#include "sarr-def.h"
+#include "esa-splititv.h"
+
+/* The class <GtSuftabsample> (declared in sarr-def.h) is a small sample of
+   the suffix array held in main memory. Every suffix of the sample is
+   represented by the first characters of the suffix packed into a 64 bit
+   key and the number of these characters before the first special
+   character. The keys are stored in the order of a breadth first traversal
+   of a complete binary search tree (Eytzinger order), so that the first
+   levels of a binary search over the sample stay in the cache. A search in
+   the sample restricts the range of the suffix array to be searched and
+   delivers the length of the prefix common to all suffixes in this range,
+   so that the subsequent binary search over the mapped suffix array
+   requires fewer random accesses. If available, the bucket table of the
+   suffix array is used to further restrict the range. */
+
+/* Return a new sample of the suffix array <suffixarray> with name
+   <indexname>, whose suffix table and encoded sequence must be mapped. If
+   the bucket table of <suffixarray> is not mapped, but exists and fits to
+   the suffix array, it is mapped and used as well. */
+GtSuftabsample *gt_suftabsample_new(const Suffixarray *suffixarray,
+                                    const char *indexname,
+                                    GtLogger *logger);
+
+void gt_suftabsample_delete(GtSuftabsample *suftabsample);
+
+/* Restrict <lcpitv> such that it still contains all suffixes having the
+   first <patternlength> characters of <pattern> as a prefix. The offset of
+   <lcpitv> is set to the length of the prefix of <pattern> common to all
+   suffixes in <lcpitv>. If it is known that no suffix has <pattern> as a
+   prefix, then false is returned. */
+bool gt_suftabsample_narrow(const Suffixarray *suffixarray,
+                            Lcpinterval *lcpitv,
+                            const GtUchar *pattern,
+                            GtUword patternlength);
+
+/* Determine a length <d> greater than 0 such that the lcp-interval of the
+   suffixes having the first <d> characters of the sequence from <qstart> to
+   <qend> as a prefix contains at least <minwidth> suffixes. <minwidth> must
+   be 1 or 2. If successful, the interval is stored in <itv> and <d> is
+   returned. Otherwise 0 is returned and <itv> is not changed. */
+GtUword gt_suftabsample_prefixinterval(const Suffixarray *suffixarray,
+                                       Simplelcpinterval *itv,
+                                       const GtUchar *qstart,
+                                       const GtUchar *qend,
+                                       GtUword minwidth);
+
+#endif
@@ -29,6 +29,7 @@
 #include "absdfstrans-imp.h"
 #include "idx-limdfs.h"
 #include "esa-map.h"
+#include "esa-suftabsample.h"
 #include "idxlocalidp.h"
 #include "esa-minunique.h"
 
@@ -78,6 +79,7 @@ Genericindex *genericindex_new(const char *indexname,
                                bool withencseq,
                                bool withdestab,
                                bool withssptab,
+                               bool withsuftabsample,
                                int userdefinedmaxdepth,
                                GtLogger *logger,
                                GtError *err)
@@ -103,6 +105,10 @@ Genericindex *genericindex_new(const char *indexname,
   {
     demand |= SARR_SSPTAB;
   }
+  if (withesa && withsuftabsample)
+  {
+    demand |= SARR_SUFSAMPLE;
+  }
   genericindex->withesa = withesa;
   genericindex->suffixarray = gt_malloc(sizeof (*genericindex->suffixarray));
   if (gt_mapsuffixarray(genericindex->suffixarray,
@@ -1070,6 +1076,22 @@ static void pck_splitandprocess(Limdfsresources *limdfsresources,
                                 parent->rightbound);
     startcode = 0;
   }
+  if (parent->offset + 1 >= (GtUword) limdfsresources->genericindex->maxdepth)
+  {
+    /* the children will be split by occurrence counts, so the accesses to
+       the index for all children are started now and overlap with the
+       processing of the siblings */
+    const Boundswithchar *bwc;
+
+    for (bwc = limdfsresources->bwci.spaceBoundswithchar;
+         bwc < limdfsresources->bwci.spaceBoundswithchar +
+               limdfsresources->bwci.nextfreeBoundswithchar;
+         bwc++)
+    {
+      gt_bwtrangeprefetch(limdfsresources->genericindex->packedindex,
+                          bwc->lbound,bwc->rbound);
+    }
+  }
   for (idx = 0; idx < limdfsresources->bwci.nextfreeBoundswithchar; idx++)
   {
     Indexbounds child;
@@ -1304,6 +1326,23 @@ GtUword genericmstats(const Limdfsresources *limdfsresources,
                                       qend);
 }
 
+/* Initialize <lcpitv> with the range of the suffix array which may contain
+   suffixes beginning with <pattern>. Returns false if there is none. */
+static bool esa_initialinterval(Lcpinterval *lcpitv,
+                                const Suffixarray *suffixarray,
+                                const GtUchar *pattern,
+                                GtUword patternlength)
+{
+  lcpitv->left = 0;
+  lcpitv->right = gt_encseq_total_length(suffixarray->encseq);
+  lcpitv->offset = 0;
+  if (suffixarray->suftabsample != NULL)
+  {
+    return gt_suftabsample_narrow(suffixarray,lcpitv,pattern,patternlength);
+  }
+  return true;
+}
+
 static bool esa_exactpatternmatching(const Suffixarray *suffixarray,
                                      const GtUchar *pattern,
                                      GtUword patternlength,
@@ -1312,16 +1351,20 @@ static bool esa_exactpatternmatching(const Suffixarray *suffixarray,
                                      void *processmatchinfo)
 {
   GtMMsearchiterator *mmsi;
-  GtUword dbstartpos,
-         totallength = gt_encseq_total_length(suffixarray->encseq);
+  GtUword dbstartpos;
   bool nomatches;
   GtIdxMatch match;
+  Lcpinterval lcpitv;
 
+  if (!esa_initialinterval(&lcpitv,suffixarray,pattern,patternlength))
+  {
+    return false;
+  }
   mmsi = gt_mmsearchiterator_new_complete_plain(suffixarray->encseq,
                                            suffixarray->suftab,
-                                           0,  /* leftbound */
-                                           totallength, /* rightbound */
-                                           0, /* offset */
+                                           lcpitv.left,
+                                           lcpitv.right,
+                                           lcpitv.offset,
                                            suffixarray->readmode,
                                            pattern,
                                            patternlength);
@@ -1368,6 +1411,36 @@ bool gt_indexbasedexactpatternmatching(const Limdfsresources *limdfsresources,
   }
 }
 
+void gt_indexbasedexactpatternbounds(const Limdfsresources *limdfsresources,
+                                      const GtUchar *const *patterns,
+                                      const GtUword *patternlengths,
+                                      GtUword numofpatterns,
+                                      Mbtab *bounds)
+{
+  gt_assert(!limdfsresources->genericindex->withesa);
+  gt_pck_exactpatternbounds(limdfsresources->genericindex->packedindex,
+                            patterns,
+                            patternlengths,
+                            numofpatterns,
+                            bounds);
+}
+
+bool gt_indexbasedexactpatternmatchingbounds(
+                                      const Limdfsresources *limdfsresources,
+                                      const Mbtab *bounds,
+                                      GtUword patternlength)
+{
+  gt_assert(!limdfsresources->genericindex->withesa);
+  return gt_pck_exactpatternmatchingbounds(
+                                    limdfsresources->genericindex->packedindex,
+                                    bounds,
+                                    patternlength,
+                                    limdfsresources->genericindex->totallength,
+                                    limdfsresources->currentpathspace,
+                                    limdfsresources->processmatch,
+                                    limdfsresources->processmatchinfo);
+}
+
 GtUchar gt_limdfs_getencodedchar(const Limdfsresources *limdfsresources,
                               GtUword pos,
                               GtReadmode readmode)
@@ -1426,14 +1499,18 @@ GtUword esa_exact_pattern_count(const Suffixarray *suffixarray,
                                       const GtUchar *pattern,
                                       GtUword patternlength) {
   GtMMsearchiterator *mmsi;
-  GtUword count,
-                totallength = gt_encseq_total_length(suffixarray->encseq);
+  GtUword count;
+  Lcpinterval lcpitv;
 
+  if (!esa_initialinterval(&lcpitv,suffixarray,pattern,patternlength))
+  {
+    return 0;
+  }
   mmsi = gt_mmsearchiterator_new_complete_plain(suffixarray->encseq,
                                            suffixarray->suftab,
-                                           0,  /* leftbound */
-                                           totallength, /* rightbound */
-                                           0, /* offset */
+                                           lcpitv.left,
+                                           lcpitv.right,
+                                           lcpitv.offset,
                                            suffixarray->readmode,
                                            pattern,
                                            patternlength);
@@ -38,11 +38,15 @@ const GtEncseq *genericindex_getencseq(const Genericindex
 const Suffixarray *genericindex_getsuffixarray(const Genericindex
                                                 *genericindex);
 
+/* If <withsuftabsample> is true and <withesa> is true, a sample of the
+   suffix array and, if available, the bucket table are used to speed up
+   exact pattern matching and the computation of matching statistics. */
 Genericindex *genericindex_new(const char *indexname,
                                bool withesa,
                                bool withencseq,
                                bool withdestab,
                                bool withssptab,
+                               bool withsuftabsample,
                                int userdefinedmaxdepth,
                                GtLogger *logger,
                                GtError *err);
@@ -100,6 +104,22 @@ bool gt_indexbasedexactpatternmatching(const Limdfsresources *limdfsresources,
                                     const GtUchar *pattern,
                                     GtUword patternlength);
 
+/* For a packed index, compute the bounds of the exact matches of all
+   <numofpatterns> non-empty patterns at once, see
+   gt_pck_exactpatternbounds. */
+void gt_indexbasedexactpatternbounds(const Limdfsresources *limdfsresources,
+                                      const GtUchar *const *patterns,
+                                      const GtUword *patternlengths,
+                                      GtUword numofpatterns,
+                                      Mbtab *bounds);
+
+/* Report the exact matches of a pattern of length <patternlength> whose
+   <bounds> were computed by gt_indexbasedexactpatternbounds. */
+bool gt_indexbasedexactpatternmatchingbounds(
+                                      const Limdfsresources *limdfsresources,
+                                      const Mbtab *bounds,
+                                      GtUword patternlength);
+
 GtUchar gt_limdfs_getencodedchar(const Limdfsresources *limdfsresources,
                               GtUword pos,
                               GtReadmode readmode);
@@ -182,6 +182,7 @@ int gt_runidxlocali(const IdxlocaliOptions *idxlocalioptions,GtError *err)
                                     idxlocalioptions->docompare,
                                     false,
                                     true,
+                                    false,
                                     0,
                                     logger,
                                     err);
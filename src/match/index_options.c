@@ -339,6 +339,7 @@ gt_index_options_register_generic_output(GtOptionParser *op,
     idxo->optionoutsuftab
       = idxo->optionoutlcptab = idxo->optionoutbwttab = NULL;
     idxo->sfxstrategy.spmopt_minlength = 0;
+    idxo->sfxstrategy.spillparts = false;
 #ifndef S_SPLINT_S
     gt_registerPackedIndexOptions(op,
                                   &idxo->bwtIdxParams,
@@ -456,6 +457,17 @@ static GtIndexOptions* gt_index_options_register_generic_create(
                            idxo->memlimit, NULL);
     gt_option_parser_add_option(op, idxo->optionmemlimit);
     gt_option_exclude(idxo->optionmemlimit, idxo->optionparts);
+    idxo->option = gt_option_new_bool("spillparts",
+                                      "if the index is constructed in "
+                                      "several parts, scan the sequence only "
+                                      "once and read the suffixes of each "
+                                      "part from a temporary file",
+                                      &idxo->sfxstrategy.spillparts,
+                                      false);
+    gt_option_parser_add_option(op, idxo->option);
+    gt_option_imply_either_2(idxo->option, idxo->optionmemlimit,
+                             idxo->optionparts);
+    gt_option_exclude(idxo->option, idxo->optionspmopt);
   }
 
   idxo->option = gt_option_new_bool("iterscan",
@@ -16,7 +16,10 @@
 */
 
 #include <float.h>
+#include <string.h>
+#include "core/fa.h"
 #include "core/ma_api.h"
+#include "core/xansi_api.h"
 #include "core/types_api.h"
 #include "core/readmode.h"
 #include "core/format64.h"
@@ -44,7 +47,7 @@ struct GtQuerymatch
   GtWord score; /* 0 for exact match */
   uint64_t queryseqnum; /* ordinal number of match in query */
   GtReadmode query_readmode; /* readmode of query sequence */
-  bool selfmatch, verify_alignment;
+  bool selfmatch, verify_alignment, binary;
   unsigned int display_flag;
   GtQuerymatchoutoptions *ref_querymatchoutoptions; /* reference to
       resources needed for alignment output */
@@ -62,6 +65,7 @@ GtQuerymatch *gt_querymatch_new(void)
   querymatch->ref_querymatchoutoptions = NULL;
   querymatch->display_flag = 0;
   querymatch->verify_alignment = false;
+  querymatch->binary = false;
   querymatch->query_readmode = GT_READMODE_FORWARD;
   querymatch->fp = stdout;
   querymatch->evalue_searchspace = 0;
@@ -167,6 +171,11 @@ bool gt_querymatch_seed_display(unsigned int display_flag)
   return gt_querymatch_display_on(display_flag,Gt_Seed_display);
 }
 
+bool gt_querymatch_seqlength_display(unsigned int display_flag)
+{
+  return gt_querymatch_display_on(display_flag,Gt_Seqlength_display);
+}
+
 int gt_querymatch_eval_display_args(unsigned int *display_flag,
                                     const GtStrArray *display_args,
                                     GtError *err)
@@ -306,6 +315,15 @@ static bool gt_querymatch_okay(const GtQuerymatch *querymatch)
   return false;
 }
 
+static double gt_querymatch_similarity(GtUword distance,GtUword alignedlen)
+{
+  if (distance == 0)
+  {
+    return 100.0;
+  }
+  return 100.0 - gt_querymatch_error_rate(distance,alignedlen);
+}
+
 void gt_querymatch_coordinates_out(const GtQuerymatch *querymatch)
 {
   const char *outflag = "FRCP";
@@ -327,19 +345,11 @@ void gt_querymatch_coordinates_out(const GtQuerymatch *querymatch)
           querymatch->querystart_fwdstrand);
   if (querymatch->score > 0)
   {
-    double similarity;
-
-    if (querymatch->distance == 0)
-    {
-      similarity = 100.0;
-    } else
-    {
-      similarity = 100.0 - gt_querymatch_error_rate(querymatch->distance,
-                                                    querymatch->dblen +
-                                                    querymatch->querylen);
-    }
     fprintf(querymatch->fp, " " GT_WD " " GT_WU " %.2f",
-            querymatch->score, querymatch->distance, similarity);
+            querymatch->score, querymatch->distance,
+            gt_querymatch_similarity(querymatch->distance,
+                                     querymatch->dblen +
+                                     querymatch->querylen));
   }
   if (gt_querymatch_display_on(querymatch->display_flag,Gt_Seqlength_display))
   {
@@ -363,6 +373,14 @@ void gt_querymatch_prettyprint(const GtQuerymatch *querymatch)
 {
   if (gt_querymatch_okay(querymatch))
   {
+    if (querymatch->binary)
+    {
+      GtQuerymatchRecord record;
+
+      gt_querymatch_record_set(&record,querymatch);
+      gt_xfwrite(&record,sizeof record,(size_t) 1,querymatch->fp);
+      return;
+    }
     gt_querymatch_coordinates_out(querymatch);
     gt_querymatchoutoptions_alignment_show(querymatch->ref_querymatchoutoptions,
                                            querymatch->distance,
@@ -788,3 +806,156 @@ GtQuerymatch *gt_querymatch_table_get(const GtArrayGtQuerymatch
   gt_assert(querymatch_table != NULL);
   return querymatch_table->spaceGtQuerymatch + idx;
 }
+
+#define GT_QUERYMATCH_BINARY_MAGIC   "GTQMATCH"
+#define GT_QUERYMATCH_BINARY_VERSION 2U
+
+typedef struct
+{
+  char magic[8];
+  uint32_t version,
+           recordsize;
+} GtQuerymatchBinaryHeader;
+
+struct GtQuerymatchBinaryReader
+{
+  void *mapped;
+  const GtQuerymatchRecord *records;
+  GtUword numofrecords;
+};
+
+void gt_querymatch_binary_set(GtQuerymatch *querymatch)
+{
+  gt_assert(querymatch != NULL);
+  querymatch->binary = true;
+}
+
+void gt_querymatch_binary_header_write(FILE *fp)
+{
+  GtQuerymatchBinaryHeader header;
+
+  memset(&header,0,sizeof header);
+  memcpy(header.magic,GT_QUERYMATCH_BINARY_MAGIC,sizeof header.magic);
+  header.version = GT_QUERYMATCH_BINARY_VERSION;
+  header.recordsize = (uint32_t) sizeof (GtQuerymatchRecord);
+  gt_xfwrite(&header,sizeof header,(size_t) 1,fp);
+}
+
+void gt_querymatch_record_set(GtQuerymatchRecord *record,
+                              const GtQuerymatch *querymatch)
+{
+  gt_assert(record != NULL && querymatch != NULL);
+  gt_assert(querymatch->dbseqnum <= UINT32_MAX &&
+            querymatch->dbseqlen <= UINT32_MAX &&
+            querymatch->queryseqnum <= UINT32_MAX &&
+            querymatch->query_totallength <= UINT32_MAX &&
+            querymatch->score >= INT32_MIN && querymatch->score <= INT32_MAX);
+  record->dbseqnum = (uint32_t) querymatch->dbseqnum;
+  record->dbstart = (uint32_t) querymatch->dbstart_relative;
+  record->dblen = (uint32_t) querymatch->dblen;
+  record->queryseqnum = (uint32_t) querymatch->queryseqnum;
+  record->querystart = (uint32_t) querymatch->querystart_fwdstrand;
+  record->querylen = (uint32_t) querymatch->querylen;
+  record->distance = (uint32_t) querymatch->distance;
+  record->score = (int32_t) querymatch->score;
+  record->query_readmode = (uint32_t) querymatch->query_readmode;
+}
+
+void gt_querymatch_record_out(const GtQuerymatchRecord *record,
+                              unsigned int display_flag,
+                              const GtEncseq *dbencseq,
+                              const GtEncseq *queryencseq,
+                              FILE *fp)
+{
+  const char *outflag = "FRCP";
+
+  gt_assert(record != NULL && record->query_readmode < 4U);
+  fprintf(fp,"%" PRIu32 " %" PRIu32 " %" PRIu32 " %c %" PRIu32 " %" PRIu32
+             " %" PRIu32,
+          record->dblen,
+          record->dbseqnum,
+          record->dbstart,
+          outflag[record->query_readmode],
+          record->querylen,
+          record->queryseqnum,
+          record->querystart);
+  if (record->score > 0)
+  {
+    fprintf(fp, " %" PRId32 " %" PRIu32 " %.2f",
+            record->score, record->distance,
+            gt_querymatch_similarity((GtUword) record->distance,
+                                     (GtUword) record->dblen +
+                                     record->querylen));
+  }
+  if (gt_querymatch_display_on(display_flag,Gt_Seqlength_display))
+  {
+    gt_assert(dbencseq != NULL && queryencseq != NULL);
+    fprintf(fp, " " GT_WU " " GT_WU,
+            gt_encseq_seqlength(dbencseq,(GtUword) record->dbseqnum),
+            gt_encseq_seqlength(queryencseq,(GtUword) record->queryseqnum));
+  }
+  fputc('\n',fp);
+}
+
+GtQuerymatchBinaryReader *gt_querymatch_binary_reader_new(const char *path,
+                                                          GtError *err)
+{
+  GtQuerymatchBinaryReader *reader;
+  const GtQuerymatchBinaryHeader *header;
+  void *mapped;
+  size_t len = 0;
+
+  gt_error_check(err);
+  mapped = gt_fa_mmap_read(path, &len, err);
+  if (mapped == NULL)
+  {
+    return NULL;
+  }
+  header = (const GtQuerymatchBinaryHeader *) mapped;
+  if (len < sizeof *header ||
+      memcmp(header->magic,GT_QUERYMATCH_BINARY_MAGIC,
+             sizeof header->magic) != 0 ||
+      header->version != GT_QUERYMATCH_BINARY_VERSION ||
+      header->recordsize != (uint32_t) sizeof (GtQuerymatchRecord))
+  {
+    gt_error_set(err,"file %s is not a binary match file of this version",
+                 path);
+    gt_fa_xmunmap(mapped);
+    return NULL;
+  }
+  if ((len - sizeof *header) % sizeof (GtQuerymatchRecord) != 0)
+  {
+    gt_error_set(err,"binary match file %s is truncated",path);
+    gt_fa_xmunmap(mapped);
+    return NULL;
+  }
+  reader = gt_malloc(sizeof *reader);
+  reader->mapped = mapped;
+  reader->records = (const GtQuerymatchRecord *) (header + 1);
+  reader->numofrecords
+    = (GtUword) ((len - sizeof *header) / sizeof (GtQuerymatchRecord));
+  return reader;
+}
+
+const GtQuerymatchRecord *gt_querymatch_binary_reader_records(
+                                 const GtQuerymatchBinaryReader *reader)
+{
+  gt_assert(reader != NULL);
+  return reader->records;
+}
+
+GtUword gt_querymatch_binary_reader_numofrecords(
+                                 const GtQuerymatchBinaryReader *reader)
+{
+  gt_assert(reader != NULL);
+  return reader->numofrecords;
+}
+
+void gt_querymatch_binary_reader_delete(GtQuerymatchBinaryReader *reader)
+{
+  if (reader != NULL)
+  {
+    gt_fa_xmunmap(reader->mapped);
+    gt_free(reader);
+  }
+}
@@ -33,6 +33,25 @@ typedef struct GtQuerymatch GtQuerymatch;
 
 GT_DECLAREARRAYSTRUCT(GtQuerymatch);
 
+/* A match as fixed width binary record. The start positions are relative to
+   the start of the sequences, the query start position refers to the forward
+   strand, as in the text output. The sequence lengths are not stored, they
+   are available from the index and the query. */
+typedef struct
+{
+  uint32_t dbseqnum,
+           dbstart,
+           dblen,
+           queryseqnum,
+           querystart,
+           querylen,
+           distance;
+  int32_t score;
+  uint32_t query_readmode;
+} GtQuerymatchRecord;
+
+typedef struct GtQuerymatchBinaryReader GtQuerymatchBinaryReader;
+
 GtQuerymatch *gt_querymatch_new(void);
 
 void gt_querymatch_file_set(GtQuerymatch *querymatch, FILE *fp);
@@ -46,6 +65,8 @@ void gt_querymatch_db_keyvalues_set(GtQuerymatch *querymatch,
 
 bool gt_querymatch_seed_display(unsigned int display_flag);
 
+bool gt_querymatch_seqlength_display(unsigned int display_flag);
+
 void gt_querymatch_outoptions_set(GtQuerymatch *querymatch,
                 GtQuerymatchoutoptions *querymatchoutoptions);
 
@@ -173,4 +194,38 @@ int gt_querymatch_eval_display_args(unsigned int *display_flag,
 const char *gt_querymatch_display_help(void);
 
 GtStr *gt_querymatch_column_header(unsigned int display_flag);
+
+/* Let gt_querymatch_prettyprint write <querymatch> as GtQuerymatchRecord
+   instead of a line of text. No alignment and no seed are shown then. */
+void gt_querymatch_binary_set(GtQuerymatch *querymatch);
+
+/* Write the header which precedes the records of a binary match file. */
+void gt_querymatch_binary_header_write(FILE *fp);
+
+void gt_querymatch_record_set(GtQuerymatchRecord *record,
+                              const GtQuerymatch *querymatch);
+
+/* Show <record> in the text format of gt_querymatch_coordinates_out. Of the
+   additional values of <display_flag>, only the sequence lengths are
+   available, they are taken from <dbencseq> and <queryencseq>, which may be
+   <NULL> if they are not displayed. */
+void gt_querymatch_record_out(const GtQuerymatchRecord *record,
+                              unsigned int display_flag,
+                              const GtEncseq *dbencseq,
+                              const GtEncseq *queryencseq,
+                              FILE *fp);
+
+/* Map the binary match file <path> and check its header. */
+GtQuerymatchBinaryReader *gt_querymatch_binary_reader_new(const char *path,
+                                                          GtError *err);
+
+/* The records of the mapped file, they are valid until the reader is
+   deleted. */
+const GtQuerymatchRecord *gt_querymatch_binary_reader_records(
+                                 const GtQuerymatchBinaryReader *reader);
+
+GtUword gt_querymatch_binary_reader_numofrecords(
+                                 const GtQuerymatchBinaryReader *reader);
+
+void gt_querymatch_binary_reader_delete(GtQuerymatchBinaryReader *reader);
 #endif
@@ -37,6 +37,9 @@
 #define SARR_SDSTAB (1U << 5)
 #define SARR_BCKTAB (1U << 6)
 #define SARR_SSPTAB (1U << 7)
+/* not a table stored on file, but a sample of the suffix table built in
+   main memory when mapping the suffix array, see esa-suftabsample.h */
+#define SARR_SUFSAMPLE (1U << 8)
 
 #define SARR_ALLTAB (SARR_ESQTAB |\
                      SARR_SUFTAB |\
@@ -61,6 +64,8 @@ DECLAREREADFUNCTION(Largelcpvalue);
 
 typedef GtUword ESASuffixptr;
 
+typedef struct GtSuftabsample GtSuftabsample;
+
 #define ESASUFFIXPTRGET(TAB,IDX)     TAB[IDX]
 
 typedef struct
@@ -80,6 +85,7 @@ typedef struct
   const GtUchar *bwttab;
   unsigned int prefixlength;
   GtBcktab *bcktab;
+  GtSuftabsample *suftabsample;
   /* or with streams */
 #if defined (_LP64) || defined (_WIN64)
   GtBufferedfile_uint32_t suftabstream_uint32_t;
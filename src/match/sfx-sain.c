@@ -16,10 +16,14 @@
 */
 
 #include <limits.h>
+#include "core/error_api.h"
+#include "core/intbits.h"
 #include "core/minmax.h"
 #include "core/unused_api.h"
+#include "core/thread_api.h"
 #include "core/timer_api.h"
 #include "core/mathsupport.h"
+#include "core/warning_api.h"
 #include "sfx-lwcheck.h"
 #include "bare-encseq.h"
 #include "sfx-sain.h"
@@ -81,6 +85,132 @@ static bool gt_sain_decideforfastmethod(GtUword maxvalue,
          ? true : false;
 }
 
+static GtUword gt_sain_rawchar(const GtSainseq *sainseq,GtUword position)
+{
+  gt_assert(position < sainseq->totallength);
+  switch (sainseq->seqtype)
+  {
+    case GT_SAIN_PLAINSEQ:
+    case GT_SAIN_BARE_ENCSEQ:
+      return (GtUword) sainseq->seq.plainseq[position];
+    case GT_SAIN_INTSEQ:
+      return (GtUword) sainseq->seq.array[position];
+    case GT_SAIN_ENCSEQ:
+      return (GtUword) gt_encseq_get_encoded_char(sainseq->seq.encseq,
+                                                  position,
+                                                  sainseq->readmode);
+  }
+  /*@ignore@*/
+  return 0;
+  /*@end@*/
+}
+
+/* Below this number of entries, all steps run in a single thread. */
+#define GT_SAIN_PARALLEL_MINENTRIES (1UL << 16)
+
+static unsigned int gt_sain_numofthreads(GT_UNUSED GtUword entries)
+{
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U && entries >= GT_SAIN_PARALLEL_MINENTRIES)
+  {
+    return gt_jobs;
+  }
+#endif
+  return 1U;
+}
+
+/* Call <function> for each of the <numofthreads> elements of size <size>
+   stored in <threadinfo>, each in its own thread. The calling thread
+   processes the first element and the elements of threads which cannot be
+   created. */
+static void gt_sain_run_threads(GtThreadFunc function,void *threadinfo,
+                                size_t size,unsigned int numofthreads)
+{
+  GtThread **threads = gt_malloc(sizeof *threads * numofthreads);
+  GtError *thread_err = gt_error_new();
+  unsigned int t;
+
+  for (t = 1U; t < numofthreads; t++)
+  {
+    threads[t] = gt_thread_new(function,(char *) threadinfo + t * size,
+                               thread_err);
+    if (threads[t] == NULL)
+    {
+      gt_warning("%s; its range is processed by the calling thread",
+                 gt_error_get(thread_err));
+      gt_error_unset(thread_err);
+      (void) function((char *) threadinfo + t * size);
+    }
+  }
+  (void) function(threadinfo);
+  for (t = 1U; t < numofthreads; t++)
+  {
+    if (threads[t] != NULL)
+    {
+      gt_thread_join(threads[t]);
+      gt_thread_delete(threads[t]);
+    }
+  }
+  gt_error_delete(thread_err);
+  gt_free(threads);
+}
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  GtUword start, end, *count;
+} GtSainCountThreadinfo;
+
+static void *gt_sain_count_thread(void *data)
+{
+  GtSainCountThreadinfo *ti = (GtSainCountThreadinfo *) data;
+  GtUword idx;
+
+  for (idx = ti->start; idx < ti->end; idx++)
+  {
+    ti->count[gt_sain_rawchar(ti->sainseq,idx)]++;
+  }
+  return NULL;
+}
+
+/* Add the number of occurrences of each character of <sainseq> to its
+   bucketsize table. Each of the <numofthreads> threads counts a section of
+   the sequence in its own table. */
+static void gt_sain_parallel_bucketsize(GtSainseq *sainseq,
+                                        unsigned int numofthreads)
+{
+  GtSainCountThreadinfo *threadinfo;
+  GtUword *count, charidx,
+          width = sainseq->totallength / numofthreads;
+  unsigned int t;
+
+  gt_assert(sainseq->seqtype == GT_SAIN_PLAINSEQ ||
+            sainseq->seqtype == GT_SAIN_INTSEQ);
+  count = gt_calloc((size_t) numofthreads * sainseq->numofchars,
+                    sizeof *count);
+  threadinfo = gt_malloc(sizeof *threadinfo * numofthreads);
+  for (t = 0; t < numofthreads; t++)
+  {
+    threadinfo[t].sainseq = sainseq;
+    threadinfo[t].start = t * width;
+    threadinfo[t].end = t + 1 < numofthreads ? (t + 1) * width
+                                              : sainseq->totallength;
+    threadinfo[t].count = count + t * sainseq->numofchars;
+  }
+  gt_sain_run_threads(gt_sain_count_thread,threadinfo,sizeof *threadinfo,
+                      numofthreads);
+  for (t = 0; t < numofthreads; t++)
+  {
+    for (charidx = 0; charidx < sainseq->numofchars; charidx++)
+    {
+      sainseq->bucketsize[charidx]
+        += (GtUsainindextype) threadinfo[t].count[charidx];
+    }
+  }
+  gt_free(threadinfo);
+  gt_free(count);
+}
+
 static void gt_sain_allocate_tmpspace(GtSainseq *sainseq,
                                       GtUword maxvalue,
                                       GtUword len)
@@ -144,6 +274,7 @@ static GtSainseq *gt_sainseq_new_from_plainseq(const GtUchar *plainseq,
                                                GtUword len)
 {
   const GtUchar *cptr;
+  unsigned int numofthreads;
   GtSainseq *sainseq = (GtSainseq *) gt_malloc(sizeof *sainseq);
 
   sainseq->seqtype = GT_SAIN_PLAINSEQ;
@@ -153,9 +284,17 @@ static GtSainseq *gt_sainseq_new_from_plainseq(const GtUchar *plainseq,
   sainseq->bare_encseq = NULL;
   sainseq->readmode = GT_READMODE_FORWARD;
   gt_sain_allocate_tmpspace(sainseq,len+1,len);
-  for (cptr = sainseq->seq.plainseq; cptr < sainseq->seq.plainseq + len; cptr++)
+  numofthreads = gt_sain_numofthreads(len);
+  if (numofthreads > 1U)
+  {
+    gt_sain_parallel_bucketsize(sainseq,numofthreads);
+  } else
   {
-    sainseq->bucketsize[*cptr]++;
+    for (cptr = sainseq->seq.plainseq; cptr < sainseq->seq.plainseq + len;
+         cptr++)
+    {
+      sainseq->bucketsize[*cptr]++;
+    }
   }
   return sainseq;
 }
@@ -201,6 +340,7 @@ static GtSainseq *gt_sainseq_new_from_array(GtUsainindextype *arr,
 {
   GtUword charidx;
   GtUsainindextype *cptr;
+  unsigned int numofthreads;
   GtSainseq *sainseq = (GtSainseq *) gt_malloc(sizeof *sainseq);
 
   sainseq->seqtype = GT_SAIN_INTSEQ;
@@ -268,10 +408,19 @@ static GtSainseq *gt_sainseq_new_from_array(GtUsainindextype *arr,
   {
     sainseq->bucketsize[charidx] = 0;
   }
-  for (cptr = arr; cptr < arr + sainseq->totallength; cptr++)
+  numofthreads = gt_sain_numofthreads(len);
+  /* only count in parallel, if the tables of the threads are small compared
+     to the sequence */
+  if (numofthreads > 1U && numofchars * numofthreads <= len / 16)
+  {
+    gt_sain_parallel_bucketsize(sainseq,numofthreads);
+  } else
   {
-    gt_assert((GtUword) *cptr < numofchars);
-    sainseq->bucketsize[*cptr]++;
+    for (cptr = arr; cptr < arr + sainseq->totallength; cptr++)
+    {
+      gt_assert((GtUword) *cptr < numofchars);
+      sainseq->bucketsize[*cptr]++;
+    }
   }
   return sainseq;
 }
@@ -666,6 +815,523 @@ static void gt_sain_induceStypes2fromspecialranges(const GtSainseq *sainseq,
 
 #include "match/sfx-sain.inc"
 
+static int gt_sain_compare_Sstarstrings(const GtSainseq *sainseq,
+                                        GtUword start1,
+                                        GtUword start2,
+                                        GtUword len)
+{
+  switch (sainseq->seqtype)
+  {
+    case GT_SAIN_PLAINSEQ:
+      return gt_sain_PLAINSEQ_compare_Sstarstrings(sainseq,
+                                                   sainseq->seq.plainseq,
+                                                   start1,start2,len);
+    case GT_SAIN_ENCSEQ:
+      return gt_sain_ENCSEQ_compare_Sstarstrings(sainseq,sainseq->seq.encseq,
+                                                 start1,start2,len);
+    case GT_SAIN_INTSEQ:
+      return gt_sain_INTSEQ_compare_Sstarstrings(sainseq,sainseq->seq.array,
+                                                 start1,start2,len);
+    case GT_SAIN_BARE_ENCSEQ:
+      return gt_sain_BARE_ENCSEQ_compare_Sstarstrings(sainseq,
+                                                      sainseq->seq.plainseq,
+                                                      start1,start2,len);
+  }
+  /*@ignore@*/
+  return 0;
+  /*@end@*/
+}
+
+/* The induction steps scan suftab and, for each suffix found, read the
+   characters left of it at random positions of the sequence. With more than
+   one thread, these characters are read in parallel for a block of entries,
+   and then the block is processed in order by the calling thread. Entries
+   written into the block after it was prefetched are recognized by their
+   changed value, and their characters are read when they are processed. So
+   the result is the same for any number of threads. */
+
+/* Number of suftab entries prefetched by each thread per block. */
+#define GT_SAIN_PREFETCH_THREADENTRIES (1UL << 15)
+
+typedef struct
+{
+  GtSsainindextype value;
+  GtUsainindextype cc, leftcc;
+} GtSainPrefetch;
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  const GtSsainindextype *suftab;
+  GtSainPrefetch *prefetch;
+  GtUword start, end;
+  bool secondpass;
+} GtSainPrefetchThreadinfo;
+
+typedef struct
+{
+  GtSainPrefetch *prefetch;
+  GtSainPrefetchThreadinfo *threadinfo;
+  GtUword blockstart, blocklen;
+  unsigned int numofthreads;
+} GtSainPrefetcher;
+
+static GtSainPrefetcher *gt_sain_prefetcher_new(unsigned int numofthreads)
+{
+  GtSainPrefetcher *pr = gt_malloc(sizeof *pr);
+
+  pr->numofthreads = numofthreads;
+  pr->blocklen = numofthreads * GT_SAIN_PREFETCH_THREADENTRIES;
+  pr->blockstart = 0;
+  pr->prefetch = gt_malloc(sizeof *pr->prefetch * pr->blocklen);
+  pr->threadinfo = gt_malloc(sizeof *pr->threadinfo * numofthreads);
+  return pr;
+}
+
+static void gt_sain_prefetcher_delete(GtSainPrefetcher *pr)
+{
+  if (pr != NULL)
+  {
+    gt_free(pr->prefetch);
+    gt_free(pr->threadinfo);
+    gt_free(pr);
+  }
+}
+
+/* In the first induction pass, a positive entry refers to the suffix at this
+   position, possibly marked by adding totallength; in the second pass it
+   refers to the suffix at the position left of it. */
+static void *gt_sain_prefetch_thread(void *data)
+{
+  GtSainPrefetchThreadinfo *ti = (GtSainPrefetchThreadinfo *) data;
+  const GtSainseq *sainseq = ti->sainseq;
+  GtSainPrefetch *pf = ti->prefetch;
+  GtUword idx;
+
+  for (idx = ti->start; idx < ti->end; idx++, pf++)
+  {
+    pf->value = ti->suftab[idx];
+    if (pf->value > 0)
+    {
+      GtUword position = (GtUword) pf->value, cc;
+
+      if (ti->secondpass)
+      {
+        position--;
+      } else
+      {
+        if (position >= sainseq->totallength)
+        {
+          position -= sainseq->totallength;
+        }
+      }
+      cc = gt_sain_rawchar(sainseq,position);
+      pf->cc = (GtUsainindextype) cc;
+      pf->leftcc = position > 0 && cc < sainseq->numofchars
+                     ? (GtUsainindextype) gt_sain_rawchar(sainseq,position-1)
+                     : 0;
+    }
+  }
+  return NULL;
+}
+
+static void gt_sain_prefetcher_run(GtSainPrefetcher *pr,
+                                   const GtSainseq *sainseq,
+                                   const GtSsainindextype *suftab,
+                                   GtUword blockstart,
+                                   GtUword blockend,
+                                   bool secondpass)
+{
+  GtUword width = (blockend - blockstart) / pr->numofthreads;
+  unsigned int t;
+
+  gt_assert(blockstart < blockend && blockend - blockstart <= pr->blocklen);
+  pr->blockstart = blockstart;
+  for (t = 0; t < pr->numofthreads; t++)
+  {
+    GtSainPrefetchThreadinfo *ti = pr->threadinfo + t;
+
+    ti->sainseq = sainseq;
+    ti->suftab = suftab;
+    ti->secondpass = secondpass;
+    ti->start = blockstart + t * width;
+    ti->end = t + 1 < pr->numofthreads ? ti->start + width : blockend;
+    ti->prefetch = pr->prefetch + (ti->start - blockstart);
+  }
+  gt_sain_run_threads(gt_sain_prefetch_thread,pr->threadinfo,
+                      sizeof *pr->threadinfo,pr->numofthreads);
+}
+
+/* Return the prefetched characters for suftab entry <idx>, if its
+   value is still <value>, and NULL otherwise. */
+static const GtSainPrefetch *gt_sain_prefetched(const GtSainPrefetcher *pr,
+                                                GtUword idx,
+                                                GtSsainindextype value)
+{
+  const GtSainPrefetch *pf = pr->prefetch + (idx - pr->blockstart);
+
+  return pf->value == value ? pf : NULL;
+}
+
+#define GT_SAIN_PREFETCHEDCHAR(PF,FIELD,POS)\
+        ((PF) != NULL ? (GtUword) (PF)->FIELD\
+                      : gt_sain_rawchar(sainseq,(GtUword) (POS)))
+
+static void gt_sain_parallel_induceLtypesuffixes1(GtSainseq *sainseq,
+                                                  GtSsainindextype *suftab,
+                                                  GtUword nonspecialentries,
+                                                  unsigned int numofthreads)
+{
+  GtUword lastupdatecc = 0, blockstart, blockend;
+  GtUsainindextype *fillptr = sainseq->bucketfillptr;
+  GtSsainindextype *suftabptr, *bucketptr = NULL;
+  GtSainPrefetcher *pr = gt_sain_prefetcher_new(numofthreads);
+  const bool fast = sainseq->roundtable != NULL ? true : false;
+
+  if (fast)
+  {
+    sainseq->currentround = 0;
+  }
+  for (blockstart = 0; blockstart < nonspecialentries; blockstart = blockend)
+  {
+    blockend = MIN(blockstart + pr->blocklen, nonspecialentries);
+    gt_sain_prefetcher_run(pr,sainseq,suftab,blockstart,blockend,false);
+    for (suftabptr = suftab + blockstart; suftabptr < suftab + blockend;
+         suftabptr++)
+    {
+      GtSsainindextype position;
+      if ((position = *suftabptr) > 0)
+      {
+        const GtSainPrefetch *pf
+          = gt_sain_prefetched(pr,(GtUword) (suftabptr - suftab),position);
+        GtUword currentcc;
+
+        if (fast && position >= (GtSsainindextype) sainseq->totallength)
+        {
+          sainseq->currentround++;
+          position -= (GtSsainindextype) sainseq->totallength;
+        }
+        currentcc = GT_SAIN_PREFETCHEDCHAR(pf,cc,position);
+        if (currentcc < sainseq->numofchars)
+        {
+          if (position > 0)
+          {
+            GtUword leftcontextcc;
+
+            position--;
+            leftcontextcc = GT_SAIN_PREFETCHEDCHAR(pf,leftcc,position);
+            if (fast)
+            {
+              GtUword t = (currentcc << 1) |
+                          (leftcontextcc < currentcc ? 1UL : 0);
+
+              gt_assert(currentcc > 0 &&
+                        sainseq->roundtable[t] <= sainseq->currentround);
+              if (sainseq->roundtable[t] < sainseq->currentround)
+              {
+                position += (GtSsainindextype) sainseq->totallength;
+                sainseq->roundtable[t] = sainseq->currentround;
+              }
+            }
+            GT_SAINUPDATEBUCKETPTR(currentcc);
+            gt_assert(suftabptr < bucketptr);
+            *bucketptr++ = (leftcontextcc < currentcc) ? ~position : position;
+            *suftabptr = 0;
+          }
+        } else
+        {
+          *suftabptr = 0;
+        }
+      } else
+      {
+        if (position < 0)
+        {
+          *suftabptr = ~position;
+        }
+      }
+    }
+  }
+  gt_sain_prefetcher_delete(pr);
+}
+
+static void gt_sain_parallel_induceStypesuffixes1(GtSainseq *sainseq,
+                                                  GtSsainindextype *suftab,
+                                                  GtUword nonspecialentries,
+                                                  unsigned int numofthreads)
+{
+  GtUword lastupdatecc = 0, blockstart, blockend;
+  GtUsainindextype *fillptr = sainseq->bucketfillptr;
+  GtSsainindextype *suftabptr, *bucketptr = NULL;
+  GtSainPrefetcher *pr = gt_sain_prefetcher_new(numofthreads);
+  const bool fast = sainseq->roundtable != NULL ? true : false;
+
+  gt_sain_special_singleSinduction1(sainseq,
+                                    suftab,
+                                    (GtSsainindextype)
+                                    (sainseq->totallength-1));
+  if (sainseq->seqtype == GT_SAIN_ENCSEQ ||
+      sainseq->seqtype == GT_SAIN_BARE_ENCSEQ)
+  {
+    gt_sain_induceStypes1fromspecialranges(sainseq,suftab);
+  }
+  for (blockend = nonspecialentries; blockend > 0; blockend = blockstart)
+  {
+    blockstart = blockend > pr->blocklen ? blockend - pr->blocklen : 0;
+    gt_sain_prefetcher_run(pr,sainseq,suftab,blockstart,blockend,false);
+    for (suftabptr = suftab + blockend; suftabptr > suftab + blockstart;
+         /* Nothing */)
+    {
+      GtSsainindextype position;
+
+      suftabptr--;
+      if ((position = *suftabptr) > 0)
+      {
+        const GtSainPrefetch *pf
+          = gt_sain_prefetched(pr,(GtUword) (suftabptr - suftab),position);
+
+        if (fast && position >= (GtSsainindextype) sainseq->totallength)
+        {
+          sainseq->currentround++;
+          position -= (GtSsainindextype) sainseq->totallength;
+        }
+        if (position > 0)
+        {
+          GtUword currentcc = GT_SAIN_PREFETCHEDCHAR(pf,cc,position);
+
+          if (currentcc < sainseq->numofchars)
+          {
+            GtUword leftcontextcc;
+            bool leftisL;
+
+            position--;
+            leftcontextcc = GT_SAIN_PREFETCHEDCHAR(pf,leftcc,position);
+            leftisL = leftcontextcc > currentcc ? true : false;
+            if (fast)
+            {
+              GtUword t = (currentcc << 1) | (leftisL ? 1UL : 0);
+
+              gt_assert(sainseq->roundtable[t] <= sainseq->currentround);
+              if (sainseq->roundtable[t] < sainseq->currentround)
+              {
+                position += (GtSsainindextype) sainseq->totallength;
+                sainseq->roundtable[t] = sainseq->currentround;
+              }
+            }
+            GT_SAINUPDATEBUCKETPTR(currentcc);
+            gt_assert(bucketptr != NULL && bucketptr - 1 < suftabptr);
+            *(--bucketptr) = leftisL ? ~(position+1) : position;
+          }
+        }
+        *suftabptr = 0;
+      }
+    }
+  }
+  gt_sain_prefetcher_delete(pr);
+}
+
+static void gt_sain_parallel_induceLtypesuffixes2(const GtSainseq *sainseq,
+                                                  GtSsainindextype *suftab,
+                                                  GtUword nonspecialentries,
+                                                  unsigned int numofthreads)
+{
+  GtUword lastupdatecc = 0, blockstart, blockend;
+  GtUsainindextype *fillptr = sainseq->bucketfillptr;
+  GtSsainindextype *suftabptr, *bucketptr = NULL;
+  GtSainPrefetcher *pr = gt_sain_prefetcher_new(numofthreads);
+
+  for (blockstart = 0; blockstart < nonspecialentries; blockstart = blockend)
+  {
+    blockend = MIN(blockstart + pr->blocklen, nonspecialentries);
+    gt_sain_prefetcher_run(pr,sainseq,suftab,blockstart,blockend,true);
+    for (suftabptr = suftab + blockstart; suftabptr < suftab + blockend;
+         suftabptr++)
+    {
+      GtSsainindextype position = *suftabptr;
+
+      *suftabptr = ~position;
+      if (position > 0)
+      {
+        const GtSainPrefetch *pf
+          = gt_sain_prefetched(pr,(GtUword) (suftabptr - suftab),position);
+        GtUword currentcc;
+
+        position--;
+        currentcc = GT_SAIN_PREFETCHEDCHAR(pf,cc,position);
+        if (currentcc < sainseq->numofchars)
+        {
+          gt_assert(currentcc > 0);
+          GT_SAINUPDATEBUCKETPTR(currentcc);
+          gt_assert(bucketptr != NULL && suftabptr < bucketptr);
+          *bucketptr++ = (position > 0 &&
+                          GT_SAIN_PREFETCHEDCHAR(pf,leftcc,position-1)
+                            < currentcc)
+                          ? ~position : position;
+        }
+      }
+    }
+  }
+  gt_sain_prefetcher_delete(pr);
+}
+
+static void gt_sain_parallel_induceStypesuffixes2(const GtSainseq *sainseq,
+                                                  GtSsainindextype *suftab,
+                                                  GtUword nonspecialentries,
+                                                  unsigned int numofthreads)
+{
+  GtUword lastupdatecc = 0, blockstart, blockend;
+  GtUsainindextype *fillptr = sainseq->bucketfillptr;
+  GtSsainindextype *suftabptr, *bucketptr = NULL;
+  GtSainPrefetcher *pr = gt_sain_prefetcher_new(numofthreads);
+
+  gt_sain_special_singleSinduction2(sainseq,
+                                    suftab,
+                                    (GtSsainindextype) sainseq->totallength,
+                                    nonspecialentries);
+  if (sainseq->seqtype == GT_SAIN_ENCSEQ ||
+      sainseq->seqtype == GT_SAIN_BARE_ENCSEQ)
+  {
+    gt_sain_induceStypes2fromspecialranges(sainseq,suftab,nonspecialentries);
+  }
+  for (blockend = nonspecialentries; blockend > 0; blockend = blockstart)
+  {
+    blockstart = blockend > pr->blocklen ? blockend - pr->blocklen : 0;
+    gt_sain_prefetcher_run(pr,sainseq,suftab,blockstart,blockend,true);
+    for (suftabptr = suftab + blockend; suftabptr > suftab + blockstart;
+         /* Nothing */)
+    {
+      GtSsainindextype position;
+
+      suftabptr--;
+      if ((position = *suftabptr) > 0)
+      {
+        const GtSainPrefetch *pf
+          = gt_sain_prefetched(pr,(GtUword) (suftabptr - suftab),position);
+        GtUword currentcc;
+
+        position--;
+        currentcc = GT_SAIN_PREFETCHEDCHAR(pf,cc,position);
+        if (currentcc < sainseq->numofchars)
+        {
+          GT_SAINUPDATEBUCKETPTR(currentcc);
+          gt_assert(bucketptr != NULL && bucketptr - 1 < suftabptr);
+          *(--bucketptr) = (position == 0 ||
+                            GT_SAIN_PREFETCHEDCHAR(pf,leftcc,position-1)
+                              > currentcc)
+                           ? ~position : position;
+        }
+      } else
+      {
+        *suftabptr = ~position;
+      }
+    }
+  }
+  gt_sain_prefetcher_delete(pr);
+}
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  GtUsainindextype *suftab, *secondhalf;
+  GtBitsequence *newname;
+  GtUword start, end, numofnewnames, firstname;
+  bool assign;
+} GtSainNamesThreadinfo;
+
+/* In the first round, mark each Sstar suffix in the range whose Sstar
+   substring differs from the one of its predecessor in suftab. In the second
+   round, store the names of the suffixes, beginning with <firstname>. */
+static void *gt_sain_names_thread(void *data)
+{
+  GtSainNamesThreadinfo *ti = (GtSainNamesThreadinfo *) data;
+  GtUword idx;
+
+  if (!ti->assign)
+  {
+    ti->numofnewnames = 0;
+    for (idx = ti->start; idx < ti->end; idx++)
+    {
+      const GtUsainindextype previouspos = ti->suftab[idx-1],
+                             position = ti->suftab[idx];
+      const GtUword currentlen = (GtUword) ti->secondhalf[GT_DIV2(position)];
+      int cmp = -1;
+
+      if ((GtUword) ti->secondhalf[GT_DIV2(previouspos)] == currentlen)
+      {
+        cmp = gt_sain_compare_Sstarstrings(ti->sainseq,(GtUword) previouspos,
+                                           (GtUword) position,currentlen);
+        gt_assert(cmp != 1);
+      }
+      if (cmp == -1)
+      {
+        GT_SETIBIT(ti->newname,idx);
+        ti->numofnewnames++;
+      }
+    }
+  } else
+  {
+    GtUword currentname = ti->firstname;
+
+    for (idx = ti->start; idx < ti->end; idx++)
+    {
+      if (GT_ISIBITSET(ti->newname,idx))
+      {
+        currentname++;
+      }
+      ti->secondhalf[GT_DIV2(ti->suftab[idx])]
+        = (GtUsainindextype) currentname;
+    }
+  }
+  return NULL;
+}
+
+/* The same as gt_sain_assignSstarnames, but the Sstar substrings are compared
+   and named by <numofthreads> threads, each for a range of suftab. */
+static GtUword gt_sain_parallel_assignSstarnames(const GtSainseq *sainseq,
+                                                 GtUword countSstartype,
+                                                 GtUsainindextype *suftab,
+                                                 unsigned int numofthreads)
+{
+  GtSainNamesThreadinfo *threadinfo;
+  GtBitsequence *newname;
+  GtUword width, currentname = 1UL;
+  unsigned int t;
+
+  gt_assert(countSstartype > 1UL);
+  GT_INITBITTAB(newname,countSstartype);
+  threadinfo = gt_malloc(sizeof *threadinfo * numofthreads);
+  /* the ranges start at multiples of the word size, so that no two threads
+     modify the same word of <newname> */
+  width = GT_DIVWORDSIZE(countSstartype / numofthreads) * GT_INTWORDSIZE;
+  gt_assert(width > 0);
+  for (t = 0; t < numofthreads; t++)
+  {
+    threadinfo[t].sainseq = sainseq;
+    threadinfo[t].suftab = suftab;
+    threadinfo[t].secondhalf = suftab + countSstartype;
+    threadinfo[t].newname = newname;
+    threadinfo[t].start = t == 0 ? 1UL : MIN(t * width, countSstartype);
+    threadinfo[t].end = t + 1 < numofthreads
+                          ? MAX(MIN((t + 1) * width, countSstartype),
+                                threadinfo[t].start)
+                          : countSstartype;
+    threadinfo[t].assign = false;
+  }
+  gt_sain_run_threads(gt_sain_names_thread,threadinfo,sizeof *threadinfo,
+                      numofthreads);
+  suftab[countSstartype + GT_DIV2(suftab[0])] = (GtUsainindextype) currentname;
+  for (t = 0; t < numofthreads; t++)
+  {
+    threadinfo[t].firstname = currentname;
+    threadinfo[t].assign = true;
+    currentname += threadinfo[t].numofnewnames;
+  }
+  gt_sain_run_threads(gt_sain_names_thread,threadinfo,sizeof *threadinfo,
+                      numofthreads);
+  gt_free(threadinfo);
+  gt_free(newname);
+  return currentname;
+}
+
 static GtUword gt_sain_insertSstarsuffixes(GtSainseq *sainseq,
                                            GtUsainindextype *suftab,
                                            GtLogger *logger)
@@ -717,6 +1383,14 @@ static void gt_sain_induceLtypesuffixes1(GtSainseq *sainseq,
                                          GtSsainindextype *suftab,
                                          GtUword nonspecialentries)
 {
+  const unsigned int numofthreads = gt_sain_numofthreads(nonspecialentries);
+
+  if (numofthreads > 1U)
+  {
+    gt_sain_parallel_induceLtypesuffixes1(sainseq,suftab,nonspecialentries,
+                                          numofthreads);
+    return;
+  }
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -772,6 +1446,14 @@ static void gt_sain_induceStypesuffixes1(GtSainseq *sainseq,
                                          GtSsainindextype *suftab,
                                          GtUword nonspecialentries)
 {
+  const unsigned int numofthreads = gt_sain_numofthreads(nonspecialentries);
+
+  if (numofthreads > 1U)
+  {
+    gt_sain_parallel_induceStypesuffixes1(sainseq,suftab,nonspecialentries,
+                                          numofthreads);
+    return;
+  }
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -932,6 +1614,14 @@ static void gt_sain_induceLtypesuffixes2(const GtSainseq *sainseq,
                                          GtSsainindextype *suftab,
                                          GtUword nonspecialentries)
 {
+  const unsigned int numofthreads = gt_sain_numofthreads(nonspecialentries);
+
+  if (numofthreads > 1U)
+  {
+    gt_sain_parallel_induceLtypesuffixes2(sainseq,suftab,nonspecialentries,
+                                          numofthreads);
+    return;
+  }
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -954,6 +1644,14 @@ static void gt_sain_induceStypesuffixes2(const GtSainseq *sainseq,
                                          GtSsainindextype *suftab,
                                          GtUword nonspecialentries)
 {
+  const unsigned int numofthreads = gt_sain_numofthreads(nonspecialentries);
+
+  if (numofthreads > 1U)
+  {
+    gt_sain_parallel_induceStypesuffixes2(sainseq,suftab,nonspecialentries,
+                                          numofthreads);
+    return;
+  }
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -1128,7 +1826,18 @@ static GtUword gt_sain_assignSstarnames(const GtSainseq *sainseq,
   GtUsainindextype *suftabptr, *secondhalf = suftab + countSstartype,
                    previouspos;
   GtUword previouslen, currentname = 1UL;
+  unsigned int numofthreads = gt_sain_numofthreads(countSstartype);
 
+  /* each thread needs a range of at least one word of marks */
+  if ((GtUword) numofthreads > GT_DIVWORDSIZE(countSstartype))
+  {
+    numofthreads = (unsigned int) GT_DIVWORDSIZE(countSstartype);
+  }
+  if (numofthreads > 1U)
+  {
+    return gt_sain_parallel_assignSstarnames(sainseq,countSstartype,suftab,
+                                             numofthreads);
+  }
   previouspos = suftab[0];
   previouslen = (GtUword) secondhalf[GT_DIV2(previouspos)];
   secondhalf[GT_DIV2(previouspos)] = (GtUsainindextype) currentname;
@@ -1142,37 +1851,8 @@ static GtUword gt_sain_assignSstarnames(const GtSainseq *sainseq,
     currentlen = (GtUword) secondhalf[GT_DIV2(position)];
     if (previouslen == currentlen)
     {
-      switch (sainseq->seqtype)
-      {
-        case GT_SAIN_PLAINSEQ:
-          cmp = gt_sain_PLAINSEQ_compare_Sstarstrings(sainseq,
-                                                      sainseq->seq.plainseq,
-                                                      (GtUword) previouspos,
-                                                      (GtUword) position,
-                                                      currentlen);
-          break;
-        case GT_SAIN_ENCSEQ:
-          cmp = gt_sain_ENCSEQ_compare_Sstarstrings(sainseq,
-                                                    sainseq->seq.encseq,
-                                                    (GtUword) previouspos,
-                                                    (GtUword) position,
-                                                    currentlen);
-          break;
-        case GT_SAIN_INTSEQ:
-          cmp = gt_sain_INTSEQ_compare_Sstarstrings(sainseq,
-                                                    sainseq->seq.array,
-                                                    (GtUword) previouspos,
-                                                    (GtUword) position,
-                                                    currentlen);
-          break;
-        case GT_SAIN_BARE_ENCSEQ:
-          cmp = gt_sain_BARE_ENCSEQ_compare_Sstarstrings(sainseq,
-                                                         sainseq->seq.plainseq,
-                                                         (GtUword) previouspos,
-                                                         (GtUword) position,
-                                                         currentlen);
-          break;
-      }
+      cmp = gt_sain_compare_Sstarstrings(sainseq,(GtUword) previouspos,
+                                         (GtUword) position,currentlen);
       gt_assert(cmp != 1);
     } else
     {
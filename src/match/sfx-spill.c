@@ -0,0 +1,305 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "core/array_api.h"
+#include "core/assert_api.h"
+#include "core/fa.h"
+#include "core/ma_api.h"
+#include "core/radix_sort.h"
+#include "core/xansi_api.h"
+#include "sfx-spill.h"
+
+#define GT_SFXSPILL_BUFSIZE ((size_t) (1 << 16))
+/* a variable length integer of 64 bit takes at most 10 bytes */
+#define GT_SFXSPILL_MAXENTRYSIZE ((size_t) 20)
+/* the buffer holds at least this many suffixes */
+#define GT_SFXSPILL_MINBUFFERED ((GtUword) 1024)
+
+/* A run is a sequence of suffixes sorted by their codes. The suffixes
+   up to <nextoffset> have been delivered, the code of the suffix at
+   <nextoffset> is <nextcode> and <previouscode> is the code of the suffix
+   before, to which the code at <nextoffset> is relative. */
+typedef struct
+{
+  GtUint64 nextoffset,
+           endoffset;
+  GtCodetype previouscode,
+             nextcode;
+} GtSfxspillrun;
+
+struct GtSfxspill
+{
+  FILE *fp;
+  GtUwordPair *buffered;
+  GtUword maxbuffered,
+          numofbuffered,
+          numofsuffixes;
+  unsigned char *iobuffer;
+  GtArray *runs;
+  GtUint64 byteswritten,
+           bytesread;
+};
+
+GtSfxspill *gt_sfxspill_new(size_t space)
+{
+  GtSfxspill *sfxspill;
+  GtRadixsortinfo *rdxinfo;
+  size_t overhead;
+
+  /* the radix sort of each run uses a workspace of this size */
+  rdxinfo = gt_radixsort_new_ulongpair(0);
+  overhead = sizeof (*sfxspill) + GT_SFXSPILL_BUFSIZE
+             + gt_radixsort_size(rdxinfo);
+  gt_radixsort_delete(rdxinfo);
+  sfxspill = gt_malloc(sizeof (*sfxspill));
+  sfxspill->maxbuffered = space > overhead
+                            ? (GtUword) ((space - overhead)
+                                         / sizeof (*sfxspill->buffered))
+                            : 0;
+  if (sfxspill->maxbuffered < GT_SFXSPILL_MINBUFFERED)
+  {
+    sfxspill->maxbuffered = GT_SFXSPILL_MINBUFFERED;
+  }
+  sfxspill->buffered = gt_malloc(sizeof (*sfxspill->buffered) *
+                                 sfxspill->maxbuffered);
+  sfxspill->fp = gt_xtmpfp_generic(NULL,TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  sfxspill->numofbuffered = 0;
+  sfxspill->numofsuffixes = 0;
+  sfxspill->iobuffer = gt_malloc(sizeof (*sfxspill->iobuffer) *
+                                 GT_SFXSPILL_BUFSIZE);
+  sfxspill->runs = gt_array_new(sizeof (GtSfxspillrun));
+  sfxspill->byteswritten = 0;
+  sfxspill->bytesread = 0;
+  return sfxspill;
+}
+
+void gt_sfxspill_delete(GtSfxspill *sfxspill)
+{
+  if (sfxspill != NULL)
+  {
+    gt_free(sfxspill->buffered);
+    gt_free(sfxspill->iobuffer);
+    gt_array_delete(sfxspill->runs);
+    gt_fa_xfclose(sfxspill->fp);
+    gt_free(sfxspill);
+  }
+}
+
+static unsigned char *gt_sfxspill_encode(unsigned char *ptr,GtUword value)
+{
+  while (value >= (GtUword) 0x80)
+  {
+    *ptr++ = (unsigned char) ((value & (GtUword) 0x7f) | (GtUword) 0x80);
+    value >>= 7;
+  }
+  *ptr++ = (unsigned char) value;
+  return ptr;
+}
+
+static const unsigned char *gt_sfxspill_decode(GtUword *value,
+                                               const unsigned char *ptr)
+{
+  unsigned int shift = 0;
+
+  *value = 0;
+  while (*ptr & 0x80)
+  {
+    *value |= ((GtUword) (*ptr++ & 0x7f)) << shift;
+    shift += 7U;
+  }
+  *value |= ((GtUword) *ptr++) << shift;
+  return ptr;
+}
+
+/* sort the buffered suffixes by their codes and append them as a run, each
+   suffix as the difference of its code to the previous code followed by its
+   position */
+static void gt_sfxspill_writerun(GtSfxspill *sfxspill)
+{
+  GtSfxspillrun run;
+  const GtUwordPair *bufptr;
+  unsigned char *ptr = sfxspill->iobuffer;
+  GtCodetype previouscode = 0;
+
+  gt_assert(sfxspill->numofbuffered > 0);
+  gt_radixsort_inplace_GtUwordPair(sfxspill->buffered,
+                                   sfxspill->numofbuffered);
+  run.nextoffset = sfxspill->byteswritten;
+  run.previouscode = 0;
+  run.nextcode = (GtCodetype) sfxspill->buffered[0].a;
+  for (bufptr = sfxspill->buffered;
+       bufptr < sfxspill->buffered + sfxspill->numofbuffered; bufptr++)
+  {
+    if (ptr + GT_SFXSPILL_MAXENTRYSIZE >
+        sfxspill->iobuffer + GT_SFXSPILL_BUFSIZE)
+    {
+      gt_xfwrite(sfxspill->iobuffer,sizeof (*sfxspill->iobuffer),
+                 (size_t) (ptr - sfxspill->iobuffer),sfxspill->fp);
+      sfxspill->byteswritten += (GtUint64) (ptr - sfxspill->iobuffer);
+      ptr = sfxspill->iobuffer;
+    }
+    ptr = gt_sfxspill_encode(ptr,bufptr->a - previouscode);
+    ptr = gt_sfxspill_encode(ptr,bufptr->b);
+    previouscode = (GtCodetype) bufptr->a;
+  }
+  gt_xfwrite(sfxspill->iobuffer,sizeof (*sfxspill->iobuffer),
+             (size_t) (ptr - sfxspill->iobuffer),sfxspill->fp);
+  sfxspill->byteswritten += (GtUint64) (ptr - sfxspill->iobuffer);
+  run.endoffset = sfxspill->byteswritten;
+  gt_array_add(sfxspill->runs,run);
+  sfxspill->numofbuffered = 0;
+}
+
+void gt_sfxspill_add(GtSfxspill *sfxspill,GtCodetype code,GtUword position)
+{
+  gt_assert(sfxspill != NULL && sfxspill->buffered != NULL);
+  if (sfxspill->numofbuffered == sfxspill->maxbuffered)
+  {
+    gt_sfxspill_writerun(sfxspill);
+  }
+  sfxspill->buffered[sfxspill->numofbuffered].a = (GtUword) code;
+  sfxspill->buffered[sfxspill->numofbuffered++].b = position;
+  sfxspill->numofsuffixes++;
+}
+
+void gt_sfxspill_finish(GtSfxspill *sfxspill)
+{
+  gt_assert(sfxspill != NULL && sfxspill->buffered != NULL);
+  if (sfxspill->numofbuffered > 0)
+  {
+    gt_sfxspill_writerun(sfxspill);
+  }
+  gt_xfflush(sfxspill->fp);
+  gt_free(sfxspill->buffered);
+  sfxspill->buffered = NULL;
+}
+
+/* deliver the suffixes of <run> up to the first suffix whose code is larger
+   than <maxcode> */
+static void gt_sfxspill_readrun(GtSfxspill *sfxspill,
+                                GtSfxspillrun *run,
+                                GtCodetype maxcode,
+                                GtSfxspillprocess process,
+                                void *processinfo)
+{
+  GtUint64 readoffset = run->nextoffset; /* file offset of <end> */
+  const unsigned char *ptr = sfxspill->iobuffer,
+                      *end = sfxspill->iobuffer;
+
+  gt_xfseek(sfxspill->fp,(GtWord) run->nextoffset,SEEK_SET);
+  while (true)
+  {
+    GtUword codedelta, position;
+    GtCodetype code;
+
+    if (ptr + GT_SFXSPILL_MAXENTRYSIZE > end && readoffset < run->endoffset)
+    {
+      size_t rest = (size_t) (end - ptr), len;
+
+      memmove(sfxspill->iobuffer,ptr,rest);
+      len = GT_SFXSPILL_BUFSIZE - rest;
+      if ((GtUint64) len > run->endoffset - readoffset)
+      {
+        len = (size_t) (run->endoffset - readoffset);
+      }
+      gt_xfread(sfxspill->iobuffer + rest,sizeof (*sfxspill->iobuffer),len,
+                sfxspill->fp);
+      readoffset += (GtUint64) len;
+      sfxspill->bytesread += (GtUint64) len;
+      ptr = sfxspill->iobuffer;
+      end = sfxspill->iobuffer + rest + len;
+    }
+    if (ptr == end)
+    {
+      break;
+    }
+    ptr = gt_sfxspill_decode(&codedelta,ptr);
+    code = run->previouscode + codedelta;
+    if (code > maxcode)
+    {
+      run->nextcode = code;
+      break;
+    }
+    ptr = gt_sfxspill_decode(&position,ptr);
+    process(processinfo,position,code);
+    run->previouscode = code;
+    run->nextoffset = readoffset - (GtUint64) (end - ptr);
+  }
+}
+
+void gt_sfxspill_readupto(GtSfxspill *sfxspill,
+                          GtCodetype maxcode,
+                          GtSfxspillprocess process,
+                          void *processinfo)
+{
+  GtUword runnum;
+
+  gt_assert(sfxspill != NULL && sfxspill->buffered == NULL);
+  for (runnum = 0; runnum < gt_array_size(sfxspill->runs); runnum++)
+  {
+    GtSfxspillrun *run = gt_array_get(sfxspill->runs,runnum);
+
+    if (run->nextoffset < run->endoffset && run->nextcode <= maxcode)
+    {
+      gt_sfxspill_readrun(sfxspill,run,maxcode,process,processinfo);
+    }
+  }
+}
+
+size_t gt_sfxspill_readspace(void)
+{
+  return sizeof (GtSfxspill) + GT_SFXSPILL_BUFSIZE;
+}
+
+size_t gt_sfxspill_size(const GtSfxspill *sfxspill)
+{
+  size_t size;
+
+  gt_assert(sfxspill != NULL);
+  size = sizeof (*sfxspill) + GT_SFXSPILL_BUFSIZE
+         + sizeof (GtSfxspillrun) * gt_array_size(sfxspill->runs);
+  if (sfxspill->buffered != NULL)
+  {
+    size += sizeof (*sfxspill->buffered) * sfxspill->maxbuffered;
+  }
+  return size;
+}
+
+GtUword gt_sfxspill_numofsuffixes(const GtSfxspill *sfxspill)
+{
+  gt_assert(sfxspill != NULL);
+  return sfxspill->numofsuffixes;
+}
+
+GtUword gt_sfxspill_numofruns(const GtSfxspill *sfxspill)
+{
+  gt_assert(sfxspill != NULL);
+  return gt_array_size(sfxspill->runs);
+}
+
+GtUint64 gt_sfxspill_byteswritten(const GtSfxspill *sfxspill)
+{
+  gt_assert(sfxspill != NULL);
+  return sfxspill->byteswritten;
+}
+
+GtUint64 gt_sfxspill_bytesread(const GtSfxspill *sfxspill)
+{
+  gt_assert(sfxspill != NULL);
+  return sfxspill->bytesread;
+}
@@ -0,0 +1,83 @@
+/*
+  Copyright (c) 2016 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SFX_SPILL_H
+#define SFX_SPILL_H
+
+#include <stdlib.h>
+#include "core/codetype.h"
+#include "core/types_api.h"
+
+/* The class <GtSfxspill> keeps the suffixes of a partitioned suffix array
+   construction in a temporary file, so that the sequence is scanned only
+   once instead of once for each part. Each suffix is added with the code of
+   its bucket. The suffixes are collected in a buffer of fixed size. When the
+   buffer is full, it is sorted by the codes and appended as a run to the
+   temporary file. The parts are then read in the order of their codes: each
+   part collects the next segment of every run, so for each run only the
+   offset of its next segment is kept. Thus the main memory required is the
+   buffer while suffixes are added and a read buffer of fixed size while a
+   part is read. */
+typedef struct GtSfxspill GtSfxspill;
+
+/* The function applied to each suffix read from the temporary file. */
+typedef void (*GtSfxspillprocess)(void *processinfo,
+                                  GtUword position,
+                                  GtCodetype code);
+
+/* Return a new <GtSfxspill> which uses at most <space> bytes while suffixes
+   are added. The buffer holds as many suffixes as fit into this space, but
+   at least 1024. */
+GtSfxspill *gt_sfxspill_new(size_t space);
+
+void        gt_sfxspill_delete(GtSfxspill *sfxspill);
+
+/* Store the suffix at <position> whose bucket has code <code>. */
+void        gt_sfxspill_add(GtSfxspill *sfxspill,GtCodetype code,
+                            GtUword position);
+
+/* Write the suffixes in the buffer as the last run and release the buffer.
+   After that, no more suffixes can be added. */
+void        gt_sfxspill_finish(GtSfxspill *sfxspill);
+
+/* Apply <process> to all suffixes of all runs whose code is at most
+   <maxcode> and which were not delivered by a previous call. Thus the parts
+   must be read in increasing order of their codes. */
+void        gt_sfxspill_readupto(GtSfxspill *sfxspill,
+                                 GtCodetype maxcode,
+                                 GtSfxspillprocess process,
+                                 void *processinfo);
+
+/* Return the number of bytes used by a <GtSfxspill> while the parts are
+   read, apart from the table of runs. */
+size_t      gt_sfxspill_readspace(void);
+
+/* Return the number of bytes currently used by <sfxspill>. */
+size_t      gt_sfxspill_size(const GtSfxspill *sfxspill);
+
+/* Return the number of suffixes added to <sfxspill>. */
+GtUword     gt_sfxspill_numofsuffixes(const GtSfxspill *sfxspill);
+
+/* Return the number of runs written to the temporary file. */
+GtUword     gt_sfxspill_numofruns(const GtSfxspill *sfxspill);
+
+/* Return the number of bytes written to the temporary file. */
+GtUint64    gt_sfxspill_byteswritten(const GtSfxspill *sfxspill);
+
+/* Return the number of bytes read from the temporary file. */
+GtUint64    gt_sfxspill_bytesread(const GtSfxspill *sfxspill);
+
+#endif
@@ -47,7 +47,9 @@ typedef struct
        noshortreadsort,
        outsuftabonfile,
        compressedoutput,
-       withradixsort;
+       withradixsort,
+       spillparts; /* scan the sequence only once and read the suffixes
+                      of each part from sorted runs in a temporary file */
 } Sfxstrategy;
 
  /*@unused@*/ static inline void defaultsfxstrategy(Sfxstrategy *sfxstrategy,
@@ -71,6 +73,7 @@ typedef struct
   sfxstrategy->noshortreadsort = false;
   sfxstrategy->compressedoutput = false;
   sfxstrategy->withradixsort = false;
+  sfxstrategy->spillparts = false;
   sfxstrategy->userdefinedsortmaxdepth = 0;
 }
 
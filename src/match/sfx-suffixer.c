@@ -58,6 +58,7 @@
 #include "sfx-bentsedg.h"
 #include "sfx-suffixgetset.h"
 #include "sfx-maprange.h"
+#include "sfx-spill.h"
 
 struct Sfxiterator
 {
@@ -91,6 +92,7 @@ struct Sfxiterator
   GtTimer *sfxprogress;
   GtSSSPbuf *sssp_buf;
   GtSpecialrangeiterator *sri; /* refers to space used in each part */
+  GtSfxspill *sfxspill; /* suffixes of all parts, sorted in runs */
 
   /* use for generating k-mer codes */
   FILE *outfpbcktab;
@@ -409,6 +411,31 @@ static void gt_insertkmerwithoutspecial(void *processinfo,
   }
 }
 
+/* With spilled parts, the sequence is scanned once before the first part and
+   all suffixes are stored with the code of their bucket. */
+#define GT_SPILLKMERWITHOUTSPECIAL(SFI,FIRSTINRANGE,POSITION,SEQNUM,RELPOS,\
+                                   SCANCODE)\
+        gt_sfxspill_add((SFI)->sfxspill,SCANCODE,POSITION)
+
+static void gt_spillkmerwithoutspecial(void *processinfo,
+                                       GtUword position,
+                                       const GtKmercode *kmercode)
+{
+  if (!kmercode->definedspecialposition)
+  {
+    GT_SPILLKMERWITHOUTSPECIAL((Sfxiterator *) processinfo, false,
+                               position, 0, 0, kmercode->code);
+  }
+}
+
+static void gt_insertspilledsuffix(void *processinfo,
+                                   GtUword position,
+                                   GtCodetype code)
+{
+  GT_INSERTKMERWITHOUTSPECIAL1((Sfxiterator *) processinfo, false,
+                               position, 0, 0, code);
+}
+
 static void gt_reversespecialcodes(Codeatposition *spaceCodeatposition,
                                    GtUword nextfreeCodeatposition)
 {
@@ -554,6 +581,17 @@ int gt_Sfxiterator_delete(Sfxiterator *sfi,GtError *err)
   }
   gt_free(sfi->spaceCodeatposition);
   sfi->spaceCodeatposition = NULL;
+  if (sfi->sfxspill != NULL)
+  {
+    gt_logger_log(sfi->logger,"spilled "GT_WU" suffixes in "GT_WU" runs: "
+                              ""GT_LLU" bytes written to and "GT_LLU" bytes "
+                              "read from temporary file",
+                  gt_sfxspill_numofsuffixes(sfi->sfxspill),
+                  gt_sfxspill_numofruns(sfi->sfxspill),
+                  gt_sfxspill_byteswritten(sfi->sfxspill),
+                  gt_sfxspill_bytesread(sfi->sfxspill));
+    gt_sfxspill_delete(sfi->sfxspill);
+  }
   gt_suffixsortspace_delete(sfi->suffixsortspace,
                             sfi->sfxstrategy.spmopt_minlength == 0
                               ? true : false);
@@ -1173,6 +1211,50 @@ typedef struct
 #undef PROCESSKMERSPECIALTYPE
 #undef PROCESSKMERCODE
 
+#define PROCESSKMERPREFIX(FUN)          spillsuffix_##FUN
+#define PROCESSKMERTYPE                 Sfxiterator
+#define PROCESSKMERSPECIALTYPE          GT_UNUSED Sfxiterator
+#define PROCESSKMERCODE                 GT_SPILLKMERWITHOUTSPECIAL
+
+#include "sfx-mapped4.gen"
+
+#undef PROCESSKMERPREFIX
+#undef PROCESSKMERTYPE
+#undef PROCESSKMERSPECIALTYPE
+#undef PROCESSKMERCODE
+
+/* Scan the sequence once and store all suffixes in runs sorted by their
+   codes. The buffer for the runs takes the space of the suffix sort space,
+   which is allocated afterwards, so that the memory limit is respected. */
+static void gt_sfxiterator_spillsuffixes(Sfxiterator *sfi)
+{
+  size_t space = (size_t) gt_suffixsortspace_requiredspace(
+                              gt_suftabparts_largest_width(sfi->suftabparts),
+                              sfi->totallength,
+                              sfi->sfxstrategy.suftabuint);
+
+  sfi->sfxspill = gt_sfxspill_new(space);
+  gt_logger_log(sfi->logger,"spill suffixes to temporary file, buffer: "
+                            "%.2f MB",
+                GT_MEGABYTES(gt_sfxspill_size(sfi->sfxspill)));
+  if (sfi->prefixlength > 1U
+      && gt_encseq_has_twobitencoding(sfi->encseq)
+      && !sfi->sfxstrategy.kmerswithencseqreader)
+  {
+    spillsuffix_getencseqkmers_twobitencoding(sfi->encseq,
+                                              sfi->readmode,
+                                              sfi->prefixlength,
+                                              sfi->prefixlength,
+                                              sfi,
+                                              NULL);
+  } else
+  {
+    getencseqkmers(sfi->encseq,sfi->readmode,sfi->prefixlength,
+                   gt_spillkmerwithoutspecial,sfi);
+  }
+  gt_sfxspill_finish(sfi->sfxspill);
+}
+
 /*
 #define SHOWCURRENTSPACE\
         printf("spacepeak at line %d: %.2f\n",__LINE__,\
@@ -1433,6 +1515,7 @@ Sfxiterator *gt_Sfxiterator_new_withadditionalvalues(
     sfi->nextfreeCodeatposition = 0;
     sfi->suffixsortspace = NULL;
     sfi->suftabparts = NULL;
+    sfi->sfxspill = NULL;
 #ifdef GT_THREADS_ENABLED
 #ifdef GT_THREADS_PARTITION
     sfi->partitions_for_threads = NULL;
@@ -1780,6 +1863,10 @@ Sfxiterator *gt_Sfxiterator_new_withadditionalvalues(
                                         : numofsuffixestosort);
     }
     estimatedspace += sizeof (uint8_t) * largestbucketsize;
+    if (sfi->sfxstrategy.spillparts)
+    {
+      estimatedspace += gt_sfxspill_readspace();
+    }
     SHOWCURRENTSPACE;
 #ifdef DEBUGSIZEESTIMATION
     if (sfi->sfxstrategy.outsuftabonfile)
@@ -1884,6 +1971,12 @@ Sfxiterator *gt_Sfxiterator_new_withadditionalvalues(
     {
       sfi->sri = NULL;
     }
+    if (sfi->sfxstrategy.spillparts &&
+        sfi->sfxstrategy.spmopt_minlength == 0 &&
+        gt_suftabparts_numofparts(sfi->suftabparts) > 1U)
+    {
+      gt_sfxiterator_spillsuffixes(sfi);
+    }
     sfi->suffixsortspace
       = gt_suffixsortspace_new(gt_suftabparts_largest_width(sfi->suftabparts),
                                sfi->totallength,
@@ -2005,33 +2098,40 @@ static void gt_sfxiterator_preparethispart(Sfxiterator *sfi)
   }
   SHOWACTUALSPACE;
   sfi->exportptr = gt_suffixsortspace_exportptr(sfi->suffixsortspace, 0);
-  if (sfi->prefixlength > 1U
-      && gt_encseq_has_twobitencoding(sfi->encseq)
-      && !sfi->sfxstrategy.kmerswithencseqreader)
+  if (sfi->sfxspill != NULL)
   {
-    insertsuffix_getencseqkmers_twobitencoding(
-                                     sfi->encseq,
-                                     sfi->readmode,
-                                     sfi->sfxstrategy.spmopt_minlength == 0
-                                       ? sfi->prefixlength
-                                       : sfi->spmopt_kmerscansize,
-                                     sfi->sfxstrategy.spmopt_minlength == 0
-                                       ? sfi->prefixlength
-                                       : sfi->sfxstrategy.spmopt_minlength,
-                                     sfi,
-                                     NULL);
+    gt_sfxspill_readupto(sfi->sfxspill,sfi->currentmaxcode,
+                         gt_insertspilledsuffix,sfi);
   } else
   {
-    if (sfi->sfxstrategy.iteratorbasedkmerscanning)
+    if (sfi->prefixlength > 1U
+        && gt_encseq_has_twobitencoding(sfi->encseq)
+        && !sfi->sfxstrategy.kmerswithencseqreader)
     {
-      getencseqkmersinsertkmerwithoutspecial(sfi->encseq,
-                                             sfi->readmode,
-                                             sfi->prefixlength,
-                                             sfi);
+      insertsuffix_getencseqkmers_twobitencoding(
+                                       sfi->encseq,
+                                       sfi->readmode,
+                                       sfi->sfxstrategy.spmopt_minlength == 0
+                                         ? sfi->prefixlength
+                                         : sfi->spmopt_kmerscansize,
+                                       sfi->sfxstrategy.spmopt_minlength == 0
+                                         ? sfi->prefixlength
+                                         : sfi->sfxstrategy.spmopt_minlength,
+                                       sfi,
+                                       NULL);
     } else
     {
-      getencseqkmers(sfi->encseq,sfi->readmode,sfi->prefixlength,
-                     gt_insertkmerwithoutspecial,sfi);
+      if (sfi->sfxstrategy.iteratorbasedkmerscanning)
+      {
+        getencseqkmersinsertkmerwithoutspecial(sfi->encseq,
+                                               sfi->readmode,
+                                               sfi->prefixlength,
+                                               sfi);
+      } else
+      {
+        getencseqkmers(sfi->encseq,sfi->readmode,sfi->prefixlength,
+                       gt_insertkmerwithoutspecial,sfi);
+      }
     }
   }
   SHOWACTUALSPACE;
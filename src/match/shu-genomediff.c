@@ -269,7 +269,7 @@ uint64_t **gt_genomediff_shulen_sum(const GtGenomediffArguments *arguments,
 
     generic_index_subject =
       genericindex_new(gt_str_array_get(arguments->filenames, 0),
-                       false, true, false, true,
+                       false, true, false, true, false,
                        arguments->user_max_depth,
                        logger, err);
     if (generic_index_subject == NULL) {
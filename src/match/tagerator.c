@@ -39,6 +39,10 @@
 
 #define MAXTAGSIZE GT_INTWORDSIZE
 
+/* number of tags read at once; for a packed index the exact matches of
+   all tags of a batch are searched simultaneously */
+#define TGR_BATCHSIZE 256
+
 #define ISRCDIR(TWL)  (((TWL)->tagptr == (TWL)->transformedtag)\
                         ? false\
                         : true)
@@ -370,7 +374,8 @@ static bool performpatternsearch(const AbstractDfstransformer *dfst,
                                  Myersonlineresources *mor,
                                  Limdfsresources *limdfsresources,
                                  const GtUchar *tagptr,
-                                 GtUword taglen)
+                                 GtUword taglen,
+                                 const Mbtab *exactbounds)
 {
   if (doonline || (!domstats && docompare))
   {
@@ -386,6 +391,11 @@ static bool performpatternsearch(const AbstractDfstransformer *dfst,
     }
     if (maxdistance == 0)
     {
+      if (exactbounds != NULL)
+      {
+        return gt_indexbasedexactpatternmatchingbounds(limdfsresources,
+                                                       exactbounds,taglen);
+      }
       return gt_indexbasedexactpatternmatching(limdfsresources,tagptr,taglen);
     } else
     {
@@ -472,7 +482,8 @@ static void searchoverstrands(const TageratorOptions *tageratoroptions,
                               Limdfsresources *limdfsresources,
                               TgrShowmatchinfo *showmatchinfo,
                               ArrayTgrSimplematch *storeonline,
-                              ArrayTgrSimplematch *storeoffline)
+                              ArrayTgrSimplematch *storeoffline,
+                              const Mbtab *const *exactbounds)
 {
   int try;
   bool domstats, matchfound;
@@ -518,7 +529,8 @@ static void searchoverstrands(const TageratorOptions *tageratoroptions,
                                  mor,
                                  limdfsresources,
                                  twl->tagptr,
-                                 twl->taglen) && !matchfound)
+                                 twl->taglen,
+                                 exactbounds[try]) && !matchfound)
         {
           matchfound = true;
         }
@@ -570,6 +582,7 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
                                     false,
                                     (tageratoroptions->outputmode &
                                      TAGOUT_DBABSPOS) ? false : true,
+                                    tageratoroptions->withsample,
                                     tageratoroptions->userdefinedmaxdepth,
                                     logger,
                                     err);
@@ -677,75 +690,177 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
     }
     if (!haserr)
     {
-      for (tagnumber = 0; !haserr; tagnumber++)
+      TgrTagwithlength *tagbatch;
+      Mbtab *boundsbatch = NULL;
+      const Mbtab **exactbounds;
+      const GtUchar **patterns = NULL;
+      GtUword *patternlengths = NULL, numoftags, tagidx;
+      uint64_t batchstart;
+      bool endofinput = false, readerror, taglengtherror, batchsearch;
+
+      /* exact matches in a packed index are searched for a whole batch
+         of tags at once, if exact matches are searched for at all, i.e.
+         for distance 0 or as the first step of the search for the best
+         matches. The online and compare modes do not use them. */
+      batchsearch = limdfsresources != NULL && !tageratoroptions->withesa &&
+                    !tageratoroptions->doonline &&
+                    !tageratoroptions->docompare &&
+                    (tageratoroptions->userdefinedmaxdistance == 0 ||
+                     (tageratoroptions->userdefinedmaxdistance > 0 &&
+                      tageratoroptions->best));
+      tagbatch = gt_malloc(sizeof (*tagbatch) * TGR_BATCHSIZE);
+      exactbounds = gt_calloc((size_t) (2 * TGR_BATCHSIZE),
+                              sizeof (*exactbounds));
+      if (batchsearch)
       {
-        retval = gt_seq_iterator_next(seqit, &currenttag, &twl.taglen, &desc,
-                                     err);
-        if (retval != 1)
-        {
-          break;
-        }
-        if (dotransformtag(twl.transformedtag,
-                           symbolmap,
-                           currenttag,
-                           twl.taglen,
-                           tagnumber,
-                           tageratoroptions->replacewildcard,
-                           err) != 0)
-        {
-          haserr = true;
-          break;
-        }
-        gt_copy_reverse_complement(twl.rctransformedtag,twl.transformedtag,
-                                   twl.taglen);
-        twl.tagptr = twl.transformedtag;
-        firstitem = true;
-        printf("#");
-        if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
+        boundsbatch = gt_malloc(sizeof (*boundsbatch) * 2 * TGR_BATCHSIZE);
+        patterns = gt_malloc(sizeof (*patterns) * 2 * TGR_BATCHSIZE);
+        patternlengths = gt_malloc(sizeof (*patternlengths) *
+                                   2 * TGR_BATCHSIZE);
+      }
+      for (tagnumber = 0; !haserr && !endofinput; /* Nothing */)
+      {
+        readerror = taglengtherror = false;
+        batchstart = tagnumber;
+        for (numoftags = 0; numoftags < (GtUword) TGR_BATCHSIZE;
+             numoftags++, tagnumber++)
         {
-          printf("\t" Formatuint64_t,PRINTuint64_tcast(tagnumber));
-          firstitem = false;
+          TgrTagwithlength *twlptr = tagbatch + numoftags;
+
+          retval = gt_seq_iterator_next(seqit, &currenttag, &twlptr->taglen,
+                                        &desc, err);
+          if (retval != 1)
+          {
+            endofinput = true;
+            break;
+          }
+          if (dotransformtag(twlptr->transformedtag,
+                             symbolmap,
+                             currenttag,
+                             twlptr->taglen,
+                             tagnumber,
+                             tageratoroptions->replacewildcard,
+                             err) != 0)
+          {
+            readerror = true;
+            break;
+          }
+          gt_copy_reverse_complement(twlptr->rctransformedtag,
+                                     twlptr->transformedtag,
+                                     twlptr->taglen);
+          if (tageratoroptions->userdefinedmaxdistance > 0 &&
+              twlptr->taglen <= (GtUword)
+                                tageratoroptions->userdefinedmaxdistance)
+          {
+            gt_error_set(err,"tag \"%*.*s\" of length "GT_WU"; "
+                         "tags must be longer than the allowed number of "
+                         "errors (which is "GT_WD")",
+                         (int) twlptr->taglen,
+                         (int) twlptr->taglen,currenttag,
+                         twlptr->taglen,
+                         tageratoroptions->userdefinedmaxdistance);
+            /* the header of this tag is still shown */
+            taglengtherror = true;
+            numoftags++;
+            break;
+          }
         }
-        if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
+        if (batchsearch)
         {
-          ADDTABULATOR;
-          printf(""GT_WU"",twl.taglen);
+          GtUword numofpatterns = 0, searchedtags, patidx;
+
+          searchedtags = taglengtherror ? numoftags - 1 : numoftags;
+          for (tagidx = 0; tagidx < searchedtags; tagidx++)
+          {
+            exactbounds[2 * tagidx] = exactbounds[2 * tagidx + 1] = NULL;
+            if (tagbatch[tagidx].taglen > 0)
+            {
+              if (!tageratoroptions->nofwdmatch)
+              {
+                patterns[numofpatterns] = tagbatch[tagidx].transformedtag;
+                patternlengths[numofpatterns++] = tagbatch[tagidx].taglen;
+              }
+              if (!tageratoroptions->norcmatch)
+              {
+                patterns[numofpatterns] = tagbatch[tagidx].rctransformedtag;
+                patternlengths[numofpatterns++] = tagbatch[tagidx].taglen;
+              }
+            }
+          }
+          if (numofpatterns > 0)
+          {
+            gt_indexbasedexactpatternbounds(limdfsresources,patterns,
+                                            patternlengths,numofpatterns,
+                                            boundsbatch);
+          }
+          for (tagidx = 0, patidx = 0; tagidx < searchedtags; tagidx++)
+          {
+            if (tagbatch[tagidx].taglen > 0)
+            {
+              if (!tageratoroptions->nofwdmatch)
+              {
+                exactbounds[2 * tagidx] = boundsbatch + patidx++;
+              }
+              if (!tageratoroptions->norcmatch)
+              {
+                exactbounds[2 * tagidx + 1] = boundsbatch + patidx++;
+              }
+            }
+          }
         }
-        if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
+        for (tagidx = 0; tagidx < numoftags; tagidx++)
         {
-          ADDTABULATOR;
-          gt_alphabet_decode_seq_to_fp(alpha,stdout,twl.transformedtag,
-                                       twl.taglen);
+          twl = tagbatch[tagidx];
+          twl.tagptr = twl.transformedtag;
+          firstitem = true;
+          printf("#");
+          if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
+          {
+            printf("\t" Formatuint64_t,
+                   PRINTuint64_tcast(batchstart + tagidx));
+            firstitem = false;
+          }
+          if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
+          {
+            ADDTABULATOR;
+            printf(""GT_WU"",twl.taglen);
+          }
+          if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
+          {
+            ADDTABULATOR;
+            gt_alphabet_decode_seq_to_fp(alpha,stdout,twl.transformedtag,
+                                         twl.taglen);
+          }
+          printf("\n");
+          storeoffline.nextfreeTgrSimplematch = 0;
+          storeonline.nextfreeTgrSimplematch = 0;
+          if (taglengtherror && tagidx == numoftags - 1)
+          {
+            break;
+          }
+          gt_assert(tageratoroptions->userdefinedmaxdistance < 0 ||
+                    twl.taglen > (GtUword)
+                                 tageratoroptions->userdefinedmaxdistance);
+          searchoverstrands(tageratoroptions,
+                            &twl,
+                            dfst,
+                            mor,
+                            limdfsresources,
+                            &showmatchinfo,
+                            &storeonline,
+                            &storeoffline,
+                            exactbounds + 2 * tagidx);
         }
-        printf("\n");
-        storeoffline.nextfreeTgrSimplematch = 0;
-        storeonline.nextfreeTgrSimplematch = 0;
-        if (tageratoroptions->userdefinedmaxdistance > 0 &&
-            twl.taglen <= (GtUword)
-                          tageratoroptions->userdefinedmaxdistance)
+        if (readerror || taglengtherror)
         {
-          gt_error_set(err,"tag \"%*.*s\" of length "GT_WU"; "
-                       "tags must be longer than the allowed number of errors "
-                       "(which is "GT_WD")",
-                       (int) twl.taglen,
-                       (int) twl.taglen,currenttag,
-                       twl.taglen,
-                       tageratoroptions->userdefinedmaxdistance);
           haserr = true;
-          break;
         }
-        gt_assert(tageratoroptions->userdefinedmaxdistance < 0 ||
-                  twl.taglen > (GtUword)
-                               tageratoroptions->userdefinedmaxdistance);
-        searchoverstrands(tageratoroptions,
-                          &twl,
-                          dfst,
-                          mor,
-                          limdfsresources,
-                          &showmatchinfo,
-                          &storeonline,
-                          &storeoffline);
       }
+      gt_free(tagbatch);
+      gt_free(exactbounds);
+      gt_free(boundsbatch);
+      gt_free(patterns);
+      gt_free(patternlengths);
       gt_seq_iterator_delete(seqit);
     }
     GT_FREEARRAY(&storeonline,TgrSimplematch);
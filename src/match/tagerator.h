@@ -52,7 +52,8 @@ typedef struct
        norcmatch, /* do not perform matching on reverse complemented strand */
        nowildcards, /* ignore matches containing wildcards */
        skpp, /* Skip prefix of pattern without counting errors */
-       best; /* use best match mode, only for edit distance */
+       best, /* use best match mode, only for edit distance */
+       withsample; /* use sample of suffix array held in memory */
   GtWord userdefinedmaxdistance; /* maximal number of allowed differences */
   int userdefinedmaxdepth;   /* use pckbuckets only up to this depth */
   unsigned int outputmode;  /* mode of output of tag matches */
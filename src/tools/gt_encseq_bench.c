@@ -21,13 +21,14 @@
 #include "core/encseq.h"
 #include "core/encseq_metadata.h"
 #include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "core/showtime.h"
 #include "core/logger.h"
 #include "tools/gt_encseq_bench.h"
 
 typedef struct
 {
-  GtUword ccext;
+  GtUword ccext, bulk;
   bool sortlenprepare, verbose;
 } GtEncseqBenchArguments;
 
@@ -64,6 +65,14 @@ static GtOptionParser* gt_encseq_bench_option_parser_new(void *tool_arguments)
                                &arguments->ccext, 0UL);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_uword("bulk", "decode the complete sequence in "
+                                       "blocks of the given size, once "
+                                       "character by character and once by "
+                                       "bulk extraction, and compare the "
+                                       "results",
+                               &arguments->bulk, 0UL);
+  gt_option_parser_add_option(op, option);
+
   option = gt_option_new_bool("solepr", "prepare data structure for sequences "
                                          "ordered by their length",
                                &arguments->sortlenprepare, false);
@@ -102,6 +111,60 @@ static void gt_bench_character_extractions(const GtEncseq *encseq,
   }
 }
 
+static int gt_bench_bulk_extractions(const GtEncseq *encseq,
+                                     GtUword blocksize,
+                                     GtError *err)
+{
+  GtUword idx, frompos, ccsum = 0, bulksum = 0,
+          totallength = gt_encseq_total_length(encseq);
+  GtUchar *buffer = gt_malloc(sizeof (*buffer) * blocksize);
+  GtEncseqReader *esr;
+  GtTimer *timer = NULL;
+  int had_err = 0;
+
+  if (gt_showtime_enabled()) {
+    timer = gt_timer_new_with_progress_description("decode character by "
+                                                   "character");
+    gt_timer_start(timer);
+  }
+  esr = gt_encseq_create_reader_with_readmode(encseq,GT_READMODE_FORWARD,0);
+  for (frompos = 0; frompos < totallength; frompos += blocksize) {
+    GtUword width = MIN(blocksize,totallength - frompos);
+
+    for (idx = 0; idx < width; idx++) {
+      buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
+    }
+    for (idx = 0; idx < width; idx++) {
+      ccsum += (GtUword) buffer[idx] * (frompos + idx + 1);
+    }
+  }
+  if (timer != NULL) {
+    gt_timer_show_progress(timer, "decode by bulk extraction", stdout);
+  }
+  for (frompos = 0; frompos < totallength; frompos += blocksize) {
+    GtUword width = MIN(blocksize,totallength - frompos);
+
+    gt_encseq_extract_encoded_with_reader(esr,encseq,buffer,frompos,
+                                          frompos + width - 1);
+    for (idx = 0; idx < width; idx++) {
+      bulksum += (GtUword) buffer[idx] * (frompos + idx + 1);
+    }
+  }
+  gt_encseq_reader_delete(esr);
+  gt_free(buffer);
+  printf("ccsum="GT_WU"\n",ccsum);
+  if (timer != NULL) {
+    gt_timer_show_progress_final(timer, stdout);
+    gt_timer_delete(timer);
+  }
+  if (ccsum != bulksum) {
+    gt_error_set(err,"bulk extraction delivers checksum "GT_WU", "
+                     "but "GT_WU" is expected",bulksum,ccsum);
+    had_err = -1;
+  }
+  return had_err;
+}
+
 typedef struct
 {
   GtUword minlength, maxlength, numofdifferentseqlen, *seqlenseppos,
@@ -327,6 +390,10 @@ static int gt_encseq_bench_runner(GT_UNUSED int argc, const char **argv,
       gt_logger_log(logger,"perform character extractions");
       gt_bench_character_extractions(encseq,arguments->ccext);
     }
+    if (!had_err && arguments->bulk > 0) {
+      gt_logger_log(logger,"perform bulk extractions");
+      had_err = gt_bench_bulk_extractions(encseq,arguments->bulk,err);
+    }
   }
   gt_encseq_delete(encseq);
   gt_encseq_loader_delete(encseq_loader);
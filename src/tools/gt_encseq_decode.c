@@ -19,10 +19,12 @@
 #include <string.h>
 #include "core/ma.h"
 #include "core/chardef.h"
+#include "core/encseq.h"
 #include "core/encseq_api.h"
 #include "core/encseq_options.h"
 #include "core/fasta_separator.h"
 #include "core/log_api.h"
+#include "core/minmax.h"
 #include "core/readmode.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -31,7 +33,8 @@
 #include "tools/gt_encseq_decode.h"
 
 typedef struct {
-  bool singlechars;
+  bool singlechars,
+       locktables;
   GtStr *mode,
         *sepchar;
   GtRange rng,
@@ -93,6 +96,15 @@ static GtOptionParser* gt_encseq_decode_option_parser_new(void *tool_arguments)
   gt_option_is_extended_option(option);
   gt_option_parser_add_option(op, option);
 
+  /* -locktables */
+  option = gt_option_new_bool("locktables",
+                              "lock the sequence and description separator "
+                              "tables into memory",
+                              &arguments->locktables,
+                              false);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
   /* -seq */
   optionseq = gt_option_new_uword("seq",
                                   "extract sequence identified by its number",
@@ -175,6 +187,47 @@ int gt_encseq_decode_arguments_check(GT_UNUSED int rest_argc,
   return had_err;
 }
 
+/* Output the next <len> decoded characters of <esr> through a buffer,
+   replacing separators by <sepchar>. */
+static void output_decoded_chars(GtEncseqReader *esr, GtUword len,
+                                 char sepchar)
+{
+  char buffer[BUFSIZ];
+
+  while (len > 0) {
+    GtUword i, width = MIN(len, (GtUword) BUFSIZ);
+    gt_encseq_reader_next_decoded_chars(esr, buffer, width);
+    if (sepchar != (char) SEPARATOR) {
+      for (i = 0; i < width; i++) {
+        if (buffer[i] == (char) SEPARATOR)
+          buffer[i] = sepchar;
+      }
+    }
+    gt_xfwrite(buffer, 1, (size_t) width, stdout);
+    len -= width;
+  }
+}
+
+/* Initiate reading the parts of <encseq> required for the sequences <sfrom>
+   to <sto>-1 in readmode <rm>. */
+static void prefetch_sequences(const GtEncseq *encseq, GtUword sfrom,
+                               GtUword sto, GtReadmode rm)
+{
+  GtUword first = sfrom, last = sto - 1;
+  GtRange rng;
+
+  if (GT_ISDIRREVERSE(rm)) {
+    first = gt_encseq_num_of_sequences(encseq) - sto;
+    last = gt_encseq_num_of_sequences(encseq) - 1 - sfrom;
+  }
+  rng.start = gt_encseq_seqstartpos(encseq, first);
+  rng.end = gt_encseq_seqstartpos(encseq, last)
+            + gt_encseq_seqlength(encseq, last);
+  if (rng.end > rng.start)
+    rng.end--;
+  gt_encseq_prefetch(encseq, &rng, 1UL);
+}
+
 static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
                            const char *filename, GtError *err)
 {
@@ -219,6 +272,11 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
       sfrom = 0;
       sto = gt_encseq_num_of_sequences(encseq);
     }
+    if (sto - sfrom < gt_encseq_num_of_sequences(encseq)) {
+      gt_encseq_set_access_pattern(encseq, GT_ENCSEQ_ACCESS_RANDOM);
+      prefetch_sequences(encseq, sfrom, sto, args->rm);
+    } else
+      gt_encseq_set_access_pattern(encseq, GT_ENCSEQ_ACCESS_SEQUENTIAL);
     for (i = sfrom; i < sto; i++) {
       GtUword desclen, startpos, len;
       char buf[BUFSIZ];
@@ -257,8 +315,6 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
       gt_xfputc(GT_FASTA_SEPARATOR, stdout);
       gt_xfwrite(desc, 1, desclen, stdout);
       gt_xfputc('\n', stdout);
-      /* XXX: make this more efficient by writing in a buffer first and then
-         showing the result */
       if (args->singlechars) {
         for (j = 0; j < len; j++) {
            gt_xfputc(gt_encseq_get_decoded_char(encseq,
@@ -268,9 +324,7 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
         }
       } else {
         esr = gt_encseq_create_reader_with_readmode(encseq, args->rm, startpos);
-        for (j = 0; j < len; j++) {
-           gt_xfputc(gt_encseq_reader_next_decoded_char(esr), stdout);
-        }
+        output_decoded_chars(esr, len, (char) SEPARATOR);
         gt_encseq_reader_delete(esr);
       }
       gt_xfputc('\n', stdout);
@@ -288,10 +342,22 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
                      "("GT_WU")", args->rng.end, to);
       }
       if (!had_err) {
+        GtRange rng;
+
         from = args->rng.start;
         to = args->rng.end;
+        if (GT_ISDIRREVERSE(args->rm)) {
+          rng.start = gt_encseq_total_length(encseq) - 1 - to;
+          rng.end = gt_encseq_total_length(encseq) - 1 - from;
+        } else {
+          rng.start = from;
+          rng.end = to;
+        }
+        gt_encseq_set_access_pattern(encseq, GT_ENCSEQ_ACCESS_RANDOM);
+        gt_encseq_prefetch(encseq, &rng, 1UL);
       }
-    }
+    } else
+      gt_encseq_set_access_pattern(encseq, GT_ENCSEQ_ACCESS_SEQUENTIAL);
     if (!had_err) {
       if (args->singlechars) {
         for (j = from; j <= to; j++) {
@@ -303,12 +369,8 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
       } else {
         esr = gt_encseq_create_reader_with_readmode(encseq, args->rm, from);
         if (esr) {
-          for (j = from; j <= to; j++) {
-            char cc = gt_encseq_reader_next_decoded_char(esr);
-            if (cc == (char) SEPARATOR)
-              cc = gt_str_get(args->sepchar)[0];
-            gt_xfputc(cc, stdout);
-          }
+          output_decoded_chars(esr, to - from + 1,
+                               gt_str_get(args->sepchar)[0]);
           gt_encseq_reader_delete(esr);
         }
       }
@@ -341,6 +403,13 @@ static int decode_sequence_file(const char *seqfile,
     if (!had_err)
       had_err = gt_encseq_mirror(encseq, err);
   }
+  if (!had_err && args->locktables) {
+    GtError *lock_err = gt_error_new();
+    if (gt_encseq_lock_tables(encseq, lock_err) != 0)
+      gt_warning("%s; continuing without locked tables",
+                 gt_error_get(lock_err));
+    gt_error_delete(lock_err);
+  }
   if (!had_err)
     had_err = output_sequence(encseq, args, seqfile, err);
   gt_encseq_delete(encseq);
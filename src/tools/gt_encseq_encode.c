@@ -32,13 +32,15 @@ typedef struct {
   bool showstats,
        no_esq_header,
        verbose;
-  GtStr *indexname;
+  GtStr *indexname,
+        *append;
 } GtEncseqEncodeArguments;
 
 static void* gt_encseq_encode_arguments_new(void)
 {
   GtEncseqEncodeArguments *arguments = gt_calloc(1, sizeof *arguments);
   arguments->indexname = gt_str_new();
+  arguments->append = gt_str_new();
   return arguments;
 }
 
@@ -48,6 +50,7 @@ static void gt_encseq_encode_arguments_delete(void *tool_arguments)
   if (!arguments) return;
   gt_encseq_options_delete(arguments->eopts);
   gt_str_delete(arguments->indexname);
+  gt_str_delete(arguments->append);
   gt_free(arguments);
 }
 
@@ -79,6 +82,16 @@ static GtOptionParser* gt_encseq_encode_option_parser_new(void *tool_arguments)
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
+  /* -append */
+  option = gt_option_new_string("append",
+                                "append the given sequence files to the "
+                                "existing encoded sequence with the given "
+                                "name; the alphabet and the tables of the "
+                                "existing index are kept, the corresponding "
+                                "encoding options are ignored",
+                                arguments->append, NULL);
+  gt_option_parser_add_option(op, option);
+
   /* encoded sequence options */
   arguments->eopts = gt_encseq_options_register_encoding(op,
                                                          arguments->indexname,
@@ -95,7 +108,7 @@ static GtOptionParser* gt_encseq_encode_option_parser_new(void *tool_arguments)
 
 static int encode_sequence_files(GtStrArray *infiles, GtEncseqOptions *opts,
                                  const char *indexname, bool verbose,
-                                 bool esq_no_header,
+                                 bool esq_no_header, bool append,
                                  GtError *err)
 {
   GtEncseqEncoder *encseq_encoder;
@@ -113,7 +126,12 @@ static int encode_sequence_files(GtStrArray *infiles, GtEncseqOptions *opts,
     {
       gt_encseq_encoder_disable_esq_header(encseq_encoder);
     }
-    had_err = gt_encseq_encoder_encode(encseq_encoder, infiles, indexname, err);
+    if (append)
+      had_err = gt_encseq_encoder_append(encseq_encoder, infiles, indexname,
+                                         err);
+    else
+      had_err = gt_encseq_encoder_encode(encseq_encoder, infiles, indexname,
+                                         err);
   }
   gt_encseq_encoder_delete(encseq_encoder);
   gt_logger_delete(logger);
@@ -168,7 +186,14 @@ static int gt_encseq_encode_runner(GT_UNUSED int argc, const char **argv,
     gt_str_array_add_cstr(infiles, argv[i]);
   }
 
-  if (gt_str_length(arguments->indexname) == 0UL) {
+  if (gt_str_length(arguments->append) > 0UL) {
+    if (gt_str_length(arguments->indexname) > 0UL) {
+      gt_error_set(err, "option -append cannot be combined with option "
+                        "-indexname");
+      had_err = -1;
+    } else
+      gt_str_set(arguments->indexname, gt_str_get(arguments->append));
+  } else if (gt_str_length(arguments->indexname) == 0UL) {
     if (gt_str_array_size(infiles) > 1UL) {
       gt_error_set(err,"if more than one input file is given, then "
                        "option -indexname is mandatory");
@@ -188,6 +213,7 @@ static int gt_encseq_encode_runner(GT_UNUSED int argc, const char **argv,
                                     gt_str_get(arguments->indexname),
                                     arguments->verbose,
                                     arguments->no_esq_header,
+                                    gt_str_length(arguments->append) > 0UL,
                                     err);
   }
 
@@ -23,7 +23,9 @@
 #include "core/array_api.h"
 #include "core/output_file_api.h"
 #include "core/unused_api.h"
+#include "core/warning_api.h"
 #include "core/divmodmul.h"
+#include "core/xposix.h"
 #include "tools/gt_encseq_info.h"
 
 typedef struct {
@@ -31,7 +33,9 @@ typedef struct {
        mirror,
        noindexname,
        show_alphabet,
-       show_n50;
+       show_n50,
+       show_pagefaults,
+       locktables;
   GtOutputFileInfo *ofi;
   GtFile *outfp;
 } GtEncseqInfoArguments;
@@ -89,6 +93,20 @@ static GtOptionParser* gt_encseq_info_option_parser_new(void *tool_arguments)
                               &arguments->show_n50, false);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_bool("pagefaults", "show the number of page faults "
+                              "caused by mapping the encoded sequence and "
+                              "gathering the information",
+                              &arguments->show_pagefaults, false);
+  gt_option_parser_add_option(op, option);
+  gt_option_exclude(optionnomap, option);
+
+  option = gt_option_new_bool("locktables", "lock the sequence and "
+                              "description separator tables into memory",
+                              &arguments->locktables, false);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+  gt_option_exclude(optionnomap, option);
+
   /* output file options */
   gt_output_file_info_register_options(arguments->ofi, op, &arguments->outfp);
 
@@ -186,13 +204,22 @@ static int gt_encseq_info_runner(GT_UNUSED int argc, const char **argv,
   } else {
     GtEncseqLoader *encseq_loader;
     GtEncseq *encseq;
+    struct rusage startusage;
 
+    gt_xgetrusage(RUSAGE_SELF, &startusage);
     encseq_loader = gt_encseq_loader_new();
     if (arguments->mirror)
       gt_encseq_loader_mirror(encseq_loader);
     if (!(encseq = gt_encseq_loader_load(encseq_loader,
                                          argv[parsed_args], err)))
       had_err = -1;
+    if (!had_err && arguments->locktables) {
+      GtError *lock_err = gt_error_new();
+      if (gt_encseq_lock_tables(encseq, lock_err) != 0)
+        gt_warning("%s; continuing without locked tables",
+                   gt_error_get(lock_err));
+      gt_error_delete(lock_err);
+    }
 
     if (!had_err) {
       const GtStrArray *filenames;
@@ -417,6 +444,16 @@ static int gt_encseq_info_runner(GT_UNUSED int argc, const char **argv,
                                         gt_encseq_has_multiseq_support(encseq)
                                           ? "yes"
                                           : "no");
+
+      if (arguments->show_pagefaults) {
+        struct rusage usage;
+
+        gt_xgetrusage(RUSAGE_SELF, &usage);
+        gt_file_xprintf(arguments->outfp, "page faults: ");
+        gt_file_xprintf(arguments->outfp, "%ld minor, %ld major\n",
+                        usage.ru_minflt - startusage.ru_minflt,
+                        usage.ru_majflt - startusage.ru_majflt);
+      }
     }
     gt_encseq_delete(encseq);
     gt_encseq_loader_delete(encseq_loader);
@@ -18,8 +18,10 @@
 #include <string.h>
 #include "core/ma.h"
 #include "core/option_api.h"
+#include "core/parseutils_api.h"
 #include "core/output_file_api.h"
 #include "core/undef_api.h"
+#include "core/unused_api.h"
 #include "core/versionfunc.h"
 #include "extended/add_introns_stream_api.h"
 #include "extended/genome_node.h"
@@ -55,8 +57,8 @@ typedef struct {
        show,
        fixboundaries;
   GtWord offset;
-  GtStr *offsetfile, *newsource;
-  GtUword width;
+  GtStr *offsetfile, *newsource, *memlimitarg;
+  GtUword width, memlimit;
   GtTypecheckInfo *tci;
   GtXRFCheckInfo *xci;
   GtOutputFileInfo *ofi;
@@ -68,6 +70,7 @@ static void* gt_gff3_arguments_new(void)
   GFF3Arguments *arguments = gt_calloc(1, sizeof *arguments);
   arguments->newsource = gt_str_new();
   arguments->offsetfile = gt_str_new();
+  arguments->memlimitarg = gt_str_new();
   arguments->tci = gt_typecheck_info_new();
   arguments->xci = gt_xrfcheck_info_new();
   arguments->ofi = gt_output_file_info_new();
@@ -84,6 +87,7 @@ static void gt_gff3_arguments_delete(void *tool_arguments)
   gt_typecheck_info_delete(arguments->tci);
   gt_xrfcheck_info_delete(arguments->xci);
   gt_str_delete(arguments->offsetfile);
+  gt_str_delete(arguments->memlimitarg);
   gt_free(arguments);
 }
 
@@ -94,7 +98,7 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   GtOption *sort_option, *load_option, *strict_option, *tidy_option,
            *mergefeat_option, *addintrons_option, *offset_option,
            *offsetfile_option, *setsource_option, *sortlines_option,
-           *sortnum_option, *option;
+           *sortnum_option, *memlimit_option, *option;
   gt_assert(arguments);
 
   /* init */
@@ -123,6 +127,19 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, sortnum_option);
   gt_option_exclude(sortlines_option, sortnum_option);
 
+  /* -memlimit */
+  memlimit_option = gt_option_new_string("memlimit", "sort with about the "
+                                         "given amount of memory for the "
+                                         "features and use temporary files "
+                                         "for the rest (in bytes, the "
+                                         "keywords 'MB' and 'GB' are "
+                                         "allowed)",
+                                         arguments->memlimitarg, NULL);
+  gt_option_parser_add_option(op, memlimit_option);
+  gt_option_imply(memlimit_option, sort_option);
+  gt_option_exclude(memlimit_option, sortlines_option);
+  gt_option_exclude(memlimit_option, sortnum_option);
+
   /* -strict */
   strict_option = gt_option_new_bool("strict", "be very strict during GFF3 "
                                      "parsing (stricter than the specification "
@@ -243,6 +260,27 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   return op;
 }
 
+static int gt_gff3_arguments_check(GT_UNUSED int rest_argc,
+                                   void *tool_arguments, GtError *err)
+{
+  GFF3Arguments *arguments = tool_arguments;
+  gt_error_check(err);
+  gt_assert(arguments);
+  if (gt_str_length(arguments->memlimitarg)) {
+    /* a plain number is taken as bytes */
+    if (gt_parse_uword(&arguments->memlimit,
+                       gt_str_get(arguments->memlimitarg))) {
+      return gt_option_parse_spacespec(&arguments->memlimit, "memlimit",
+                                       arguments->memlimitarg, err);
+    }
+    if (!arguments->memlimit) {
+      gt_error_set(err, "argument to option -memlimit must be positive");
+      return -1;
+    }
+  }
+  return 0;
+}
+
 static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
                           void *tool_arguments, GtError *err)
 {
@@ -265,6 +303,7 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   /* create a gff3 input stream */
   gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
                                                   argv + parsed_args);
+  gt_gff3_in_stream_enable_arena_allocation(gff3_in_stream);
   if (arguments->verbose && arguments->outfp)
     gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
   if (arguments->checkids)
@@ -322,6 +361,10 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   if (!had_err && (arguments->sort || arguments->sortlines ||
                    arguments->sortnum)) {
     sort_stream = gt_sort_stream_new(last_stream);
+    if (arguments->memlimit) {
+      gt_sort_stream_set_memlimit((GtSortStream*) sort_stream,
+                                  arguments->memlimit);
+    }
     last_stream = sort_stream;
   }
 
@@ -402,6 +445,6 @@ GtTool* gt_gff3(void)
   return gt_tool_new(gt_gff3_arguments_new,
                      gt_gff3_arguments_delete,
                      gt_gff3_option_parser_new,
-                     NULL,
+                     gt_gff3_arguments_check,
                      gt_gff3_runner);
 }
@@ -89,6 +89,7 @@ static int gt_gff3validator_runner(int argc, const char **argv, int parsed_args,
   /* create a GFF3 input stream */
   gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
                                                   argv + parsed_args);
+  gt_gff3_in_stream_enable_arena_allocation(gff3_in_stream);
   gt_gff3_in_stream_check_id_attributes((GtGFF3InStream*) gff3_in_stream);
 
   /* set different type checker if necessary */
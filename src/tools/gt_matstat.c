@@ -55,7 +55,8 @@ typedef struct
   GtStr *indexname;
   GtStrArray *queryfilenames, *flagsoutputoption;
   Indextype indextype;
-  bool doms;
+  bool doms,
+       withsample;
   GtOption *optionmin, *optionmax, *optionoutput, *optionfmindex,
            *optionesaindex, *optionpckindex, *optionquery, *optionverify;
 } Gfmsubcallinfo;
@@ -97,6 +98,7 @@ static GtOptionParser* gt_matstat_option_parser_new(void *tool_arguments)
 {
   Gfmsubcallinfo *arguments = tool_arguments;
   GtOptionParser *op;
+  GtOption *option;
   gt_assert(arguments);
 
   op = gt_option_parser_new("[options ...] -query queryfile [...]",
@@ -164,6 +166,13 @@ static GtOptionParser* gt_matstat_option_parser_new(void *tool_arguments)
     arguments->verifywitnesspos = false;
   }
 
+  option = gt_option_new_bool("sample","use a sample of the suffix array and "
+                              "the bucket table to narrow the search (only "
+                              "relevant with option -esa)",
+                              &arguments->withsample,true);
+  gt_option_is_development_option(option);
+  gt_option_parser_add_option(op, option);
+
   gt_option_parser_refer_to_manual(op);
 
   return op;
@@ -332,6 +341,10 @@ static int gt_matstat_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
                    | SARR_BCKTAB
 #endif
                    ;
+      if (arguments->withsample)
+      {
+        mappedbits |= SARR_SUFSAMPLE;
+      }
     } else
     {
       if (dotestsequence(arguments))
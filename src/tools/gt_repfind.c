@@ -16,6 +16,7 @@
 */
 
 #include "core/error_api.h"
+#include "core/fileutils_api.h"
 #include "core/format64.h"
 #include "core/log_api.h"
 #include "core/logger.h"
@@ -59,7 +60,8 @@ typedef struct
           alignmentwidth; /* 0 for no alignment display and otherwidth number
                              of columns of alignment per line displayed. */
   bool scanfile, beverbose, forward, reverse, reverse_complement, searchspm,
-       check_extend_symmetry, silent, trimstat, noxpolish, verify_alignment;
+       check_extend_symmetry, silent, trimstat, noxpolish, verify_alignment,
+       binary;
   GtStr *indexname, *query_indexname, *cam_string; /* parse this using
                                     gt_greedy_extend_char_access*/
   GtStrArray *query_files;
@@ -226,7 +228,7 @@ static GtOptionParser *gt_repfind_option_parser_new(void *tool_arguments)
            *maxalilendiffoption, *leastlength_option, *char_access_mode_option,
            *check_extend_symmetry_option, *xdropbelowoption, *historyoption,
            *percmathistoryoption, *errorpercentageoption, *optiontrimstat,
-           *withalignmentoption,
+           *withalignmentoption, *displayoption, *binaryoption, *verboseoption,
            *optionnoxpolish, *verify_alignment_option, *option_query_indexname;
   GtMaxpairsoptions *arguments = tool_arguments;
 
@@ -390,10 +392,17 @@ static GtOptionParser *gt_repfind_option_parser_new(void *tool_arguments)
   gt_option_is_development_option(option);
 
   /* -display */
-  option = gt_option_new_string_array("display",
-                                      gt_querymatch_display_help(),
-                                      arguments->display_args);
-  gt_option_parser_add_option(op, option);
+  displayoption = gt_option_new_string_array("display",
+                                             gt_querymatch_display_help(),
+                                             arguments->display_args);
+  gt_option_parser_add_option(op, displayoption);
+
+  binaryoption = gt_option_new_bool("binary","output the matches as fixed "
+                                    "size binary records, use "
+                                    "gt dev show_seedext -binary to show "
+                                    "them as text",
+                                    &arguments->binary, false);
+  gt_option_parser_add_option(op, binaryoption);
 
   optionnoxpolish
     = gt_option_new_bool("noxpolish","do not polish X-drop extensions",
@@ -455,8 +464,8 @@ static GtOptionParser *gt_repfind_option_parser_new(void *tool_arguments)
                                   false);
   gt_option_parser_add_option(op, scanoption);
 
-  option = gt_option_new_verbose(&arguments->beverbose);
-  gt_option_parser_add_option(op, option);
+  verboseoption = gt_option_new_verbose(&arguments->beverbose);
+  gt_option_parser_add_option(op, verboseoption);
 
   gt_option_exclude(option_query_files,sampleoption);
   gt_option_exclude(option_query_files,scanoption);
@@ -470,6 +479,12 @@ static GtOptionParser *gt_repfind_option_parser_new(void *tool_arguments)
   gt_option_exclude(withalignmentoption,sampleoption);
   gt_option_exclude(withalignmentoption,spmoption);
   gt_option_exclude(optionnoxpolish,withalignmentoption);
+  gt_option_exclude(binaryoption,withalignmentoption);
+  gt_option_exclude(binaryoption,displayoption);
+  gt_option_exclude(binaryoption,sampleoption);
+  gt_option_exclude(binaryoption,spmoption);
+  gt_option_exclude(binaryoption,optiontrimstat);
+  gt_option_exclude(binaryoption,verboseoption);
   gt_option_imply(xdropbelowoption,extendxdropoption);
   gt_option_imply(historyoption,extendgreedyoption);
   gt_option_imply(maxalilendiffoption,extendgreedyoption);
@@ -567,6 +582,7 @@ static int gt_callenumquerymatches(bool selfmatch,
                                    const GtStr *query_indexname,
                                    GtReadmode query_readmode,
                                    unsigned int userdefinedleastlength,
+                                   bool binary,
                                    GtQuerymatchoutoptions *querymatchoutoptions,
                                    GtXdrop_extend_querymatch_func eqmf,
                                    void *eqmf_data,
@@ -643,6 +659,10 @@ static int gt_callenumquerymatches(bool selfmatch,
     {
       gt_querymatch_outoptions_set(exactseed,querymatchoutoptions);
     }
+    if (binary)
+    {
+      gt_querymatch_binary_set(exactseed);
+    }
     gt_querymatch_query_readmode_set(exactseed,query_readmode);
     while (!haserr &&
            (retval = gt_querysubstringmatchiterator_next(qsmi, err)) == 0)
@@ -898,6 +918,11 @@ static int gt_repfind_runner(int argc,
       gt_querymatch_verify_alignment_set(
         processinfo_and_querymatchspaceptr.querymatchspaceptr);
     }
+    if (arguments->binary)
+    {
+      gt_querymatch_binary_set(
+        processinfo_and_querymatchspaceptr.querymatchspaceptr);
+    }
     if (gt_option_is_set(arguments->refextendxdropoption))
     {
       eqmf = gt_xdrop_extend_querymatch_with_output;
@@ -923,8 +948,52 @@ static int gt_repfind_runner(int argc,
                 processinfo_and_querymatchspaceptr.karlin_altschul_stat,
                 gt_encseq_metadata_total_length(emd),
                 gt_encseq_metadata_num_of_sequences(emd));
+      /* the binary records store positions and lengths in 32 bits */
+      if (arguments->binary &&
+          gt_encseq_metadata_total_length(emd) > (GtUword) UINT32_MAX)
+      {
+        gt_error_set(err,"option -binary is only allowed for indexes of "
+                         "total length at most %" PRIu32,UINT32_MAX);
+        haserr = true;
+      }
       gt_encseq_metadata_delete(emd);
     }
+    if (!haserr && arguments->binary)
+    {
+      GtUword query_totallength = 0;
+
+      if (gt_str_length(arguments->query_indexname) > 0)
+      {
+        emd = gt_encseq_metadata_new(gt_str_get(arguments->query_indexname),
+                                     err);
+        if (emd == NULL)
+        {
+          haserr = true;
+        } else
+        {
+          query_totallength = gt_encseq_metadata_total_length(emd);
+          gt_encseq_metadata_delete(emd);
+        }
+      } else
+      {
+        if (gt_str_array_size(arguments->query_files) > 0)
+        {
+          /* the size of the files bounds the length of the sequences */
+          query_totallength
+            = (GtUword) gt_files_estimate_total_size(arguments->query_files);
+        }
+      }
+      if (!haserr && query_totallength > (GtUword) UINT32_MAX)
+      {
+        gt_error_set(err,"option -binary is only allowed for queries of "
+                         "total length at most %" PRIu32,UINT32_MAX);
+        haserr = true;
+      }
+    }
+    if (!haserr && arguments->binary)
+    {
+      gt_querymatch_binary_header_write(stdout);
+    }
     if (gt_str_array_size(arguments->query_files) == 0 &&
         gt_str_length(arguments->query_indexname) == 0)
     {
@@ -1001,6 +1070,7 @@ static int gt_repfind_runner(int argc,
                                           NULL,
                                           modes[mode],
                                           arguments->seedlength,
+                                          arguments->binary,
                                           querymatchoutoptions,
                                           eqmf,
                                           eqmf_data,
@@ -1030,6 +1100,7 @@ static int gt_repfind_runner(int argc,
                                   arguments->query_indexname,
                                   modes[mode],
                                   arguments->seedlength,
+                                  arguments->binary,
                                   querymatchoutoptions,
                                   eqmf,
                                   eqmf_data,
@@ -30,6 +30,7 @@
 #include "core/range_api.h"
 #include "core/showtime.h"
 #include "core/str_api.h"
+#include "core/thread_api.h"
 #include "match/diagbandseed.h"
 #include "match/seed-extend.h"
 #include "match/xdrop.h"
@@ -46,11 +47,17 @@ typedef struct {
   GtUword dbs_mincoverage;
   GtUword dbs_maxfreq;
   GtUword dbs_suppress;
+  GtUword dbs_minimizer;
+  unsigned int dbs_syncmer;
+  GtOption *dbs_option_minimizer;
+  GtOption *dbs_option_syncmer;
   GtUword dbs_memlimit;
+  GtUword dbs_spblockmem;
   GtUword dbs_parts;
   GtRange seedpairdistance;
   GtStr *dbs_pick_str;
   GtStr *dbs_memlimit_str;
+  GtStr *dbs_spblock_str;
   bool dbs_debug_kmer;
   bool dbs_debug_seedpair;
   bool dbs_verify;
@@ -80,10 +87,13 @@ typedef struct {
   bool norev;
   bool nofwd;
   bool benchmark;
+  GtStr *benchmark_json;
   bool verbose;
   bool use_apos;
   bool histogram;
   bool use_kmerfile;
+  bool use_kpos;
+  bool binary;
   unsigned int display_flag;
 } GtSeedExtendArguments;
 
@@ -94,7 +104,9 @@ static void* gt_seed_extend_arguments_new(void)
   arguments->dbs_queryname = gt_str_new();
   arguments->dbs_pick_str = gt_str_new();
   arguments->dbs_memlimit_str = gt_str_new();
+  arguments->dbs_spblock_str = gt_str_new();
   arguments->char_access_mode = gt_str_new();
+  arguments->benchmark_json = gt_str_new();
   arguments->display_args = gt_str_array_new();
   arguments->display_flag = 0;
   return arguments;
@@ -108,10 +120,14 @@ static void gt_seed_extend_arguments_delete(void *tool_arguments)
     gt_str_delete(arguments->dbs_queryname);
     gt_str_delete(arguments->dbs_pick_str);
     gt_str_delete(arguments->dbs_memlimit_str);
+    gt_str_delete(arguments->dbs_spblock_str);
     gt_str_delete(arguments->char_access_mode);
+    gt_str_delete(arguments->benchmark_json);
     gt_option_delete(arguments->se_option_greedy);
     gt_option_delete(arguments->se_option_xdrop);
     gt_option_delete(arguments->se_option_withali);
+    gt_option_delete(arguments->dbs_option_minimizer);
+    gt_option_delete(arguments->dbs_option_syncmer);
     gt_str_array_delete(arguments->display_args);
     gt_free(arguments);
   }
@@ -123,9 +139,10 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   GtOptionParser *op;
   GtOption *option, *op_gre, *op_xdr, *op_cam, *op_his, *op_dif, *op_pmh,
     *op_len, *op_err, *op_xbe, *op_sup, *op_frq, *op_mem, *op_ali, *op_bia,
-    *op_onl, *op_weakends, *op_relax_polish,
+    *op_onl, *op_min, *op_weakends, *op_relax_polish,
     *op_verify_alignment, *op_spdist, *op_display,
-    *op_norev, *op_nofwd, *op_part, *op_pick, *op_overl;
+    *op_norev, *op_nofwd, *op_part, *op_pick, *op_overl, *op_spblock,
+    *op_binary, *op_dbk, *op_dbs, *op_bench, *op_verbose;
 
   static GtRange seedpairdistance_defaults = {1UL, GT_UWORD_MAX};
   gt_assert(arguments != NULL);
@@ -200,6 +217,32 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   gt_option_is_development_option(op_sup);
   gt_option_parser_add_option(op, op_sup);
 
+  /* -minimizer */
+  op_min = gt_option_new_uword_min("minimizer",
+                                   "Only use the k-mers with the smallest "
+                                   "hash value in each window of the given "
+                                   "number of consecutive k-mers "
+                                   "(for filter)",
+                                   &arguments->dbs_minimizer,
+                                   10UL, 2UL);
+  gt_option_argument_is_optional(op_min);
+  gt_option_parser_add_option(op, op_min);
+  arguments->dbs_option_minimizer = gt_option_ref(op_min);
+
+  /* -syncmer */
+  option = gt_option_new_uint("syncmer",
+                              "Only use the k-mers whose first s-mer has the "
+                              "smallest hash value of all their s-mers, "
+                              "where s is the given value (for filter)\n"
+                              "default: seedlength - 4",
+                              &arguments->dbs_syncmer,
+                              UINT_MAX);
+  gt_option_argument_is_optional(option);
+  gt_option_exclude(option, op_min);
+  gt_option_hide_default(option);
+  gt_option_parser_add_option(op, option);
+  arguments->dbs_option_syncmer = gt_option_ref(option);
+
   /* -memlimit */
   op_mem = gt_option_new_string("memlimit",
                                 "Maximum memory usage to determine the maximum "
@@ -208,21 +251,34 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
                                 "");
   gt_option_parser_add_option(op, op_mem);
 
+  /* -seedpairblock */
+  op_spblock = gt_option_new_string("seedpairblock",
+                                    "Maximum memory for one block of seed "
+                                    "pairs; seed pairs are generated, sorted "
+                                    "and extended block by block. With "
+                                    "-memlimit, the blocks get the memory "
+                                    "left by the k-mer lists. A sequence "
+                                    "with more seed pairs forms a larger "
+                                    "block",
+                                    arguments->dbs_spblock_str,
+                                    "");
+  gt_option_parser_add_option(op, op_spblock);
+
   /* -debug-kmer */
-  option = gt_option_new_bool("debug-kmer",
+  op_dbk = gt_option_new_bool("debug-kmer",
                               "Output KmerPos lists",
                               &arguments->dbs_debug_kmer,
                               false);
-  gt_option_is_development_option(option);
-  gt_option_parser_add_option(op, option);
+  gt_option_is_development_option(op_dbk);
+  gt_option_parser_add_option(op, op_dbk);
 
   /* -debug-seedpair */
-  option = gt_option_new_bool("debug-seedpair",
+  op_dbs = gt_option_new_bool("debug-seedpair",
                               "Output SeedPair lists",
                               &arguments->dbs_debug_seedpair,
                               false);
-  gt_option_is_development_option(option);
-  gt_option_parser_add_option(op, option);
+  gt_option_is_development_option(op_dbs);
+  gt_option_parser_add_option(op, op_dbs);
 
   /* -verify */
   option = gt_option_new_bool("verify",
@@ -389,6 +445,19 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
                                           arguments->display_args);
   gt_option_parser_add_option(op, op_display);
 
+  /* -binary */
+  op_binary = gt_option_new_bool("binary",
+                                 "output the matches as fixed size binary "
+                                 "records, use gt dev show_seedext -binary "
+                                 "to show them as text",
+                                 &arguments->binary,
+                                 false);
+  gt_option_exclude(op_binary, op_ali);
+  gt_option_exclude(op_binary, op_display);
+  gt_option_exclude(op_binary, op_dbk);
+  gt_option_exclude(op_binary, op_dbs);
+  gt_option_parser_add_option(op, op_binary);
+
   /* -no-reverse */
   op_norev = gt_option_new_bool("no-reverse",
                                 "do not compute matches on reverse "
@@ -425,10 +494,20 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, op_spdist);
 
   /* -benchmark */
-  option = gt_option_new_bool("benchmark",
-                              "Measure total running time and be silent",
-                              &arguments->benchmark,
-                              false);
+  op_bench = gt_option_new_bool("benchmark",
+                                "Measure total running time and be silent",
+                                &arguments->benchmark,
+                                false);
+  gt_option_exclude(op_bench, op_binary);
+  gt_option_is_development_option(op_bench);
+  gt_option_parser_add_option(op, op_bench);
+
+  /* -benchmark-json */
+  option = gt_option_new_string("benchmark-json",
+                                "Measure time, space and throughput of each "
+                                "stage and write them as JSON to the given "
+                                "file",
+                                arguments->benchmark_json, NULL);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
@@ -484,10 +563,20 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
                               true);
   gt_option_parser_add_option(op, option);
 
-  /* -v */
-  option = gt_option_new_verbose(&arguments->verbose);
+  /* -kpos */
+  option = gt_option_new_bool("kpos",
+                              "Map the sorted k-mers of the sequences given "
+                              "by -ii from index file <indexname>.kpos, "
+                              "create it if it does not exist",
+                              &arguments->use_kpos,
+                              false);
   gt_option_parser_add_option(op, option);
 
+  /* -v */
+  op_verbose = gt_option_new_verbose(&arguments->verbose);
+  gt_option_exclude(op_verbose, op_binary);
+  gt_option_parser_add_option(op, op_verbose);
+
   return op;
 }
 
@@ -526,6 +615,21 @@ static int gt_seed_extend_arguments_check(int rest_argc, void *tool_arguments,
     }
   }
 
+  /* parse seedpairblock argument */
+  arguments->dbs_spblockmem = GT_UWORD_MAX;
+  if (!had_err && strcmp(gt_str_get(arguments->dbs_spblock_str), "") != 0) {
+    had_err = gt_option_parse_spacespec(&arguments->dbs_spblockmem,
+                                        "seedpairblock",
+                                        arguments->dbs_spblock_str,
+                                        err);
+    if (!had_err && arguments->dbs_spblockmem == 0) {
+      gt_error_set(err,
+                   "argument to option \"-seedpairblock\" must be at least "
+                   "1MB");
+      had_err = -1;
+    }
+  }
+
   /* minimum maxfreq value for 1 input file */
   if (!had_err && arguments->dbs_maxfreq == 1 &&
       strcmp(gt_str_get(arguments->dbs_queryname), "") == 0) {
@@ -681,7 +785,8 @@ static int gt_seed_extend_runner(int argc,
   bool extendxdrop, extendgreedy = true;
   unsigned int maxseedlength = 0, nchars = 0;
   GtUwordPair pick = {GT_UWORD_MAX, GT_UWORD_MAX};
-  GtUword maxseqlength = 0;
+  GtUword maxseqlength = 0, samplingparam = 0;
+  GtDiagbandseedSampling sampling = GT_DIAGBANDSEED_SAMPLE_ALL;
   int had_err = 0;
   gt_error_check(err);
   gt_assert(arguments != NULL);
@@ -826,6 +931,26 @@ static int gt_seed_extend_runner(int argc,
     had_err = -1;
   }
 
+  /* Set k-mer sampling */
+  if (!had_err && gt_option_is_set(arguments->dbs_option_minimizer)) {
+    sampling = GT_DIAGBANDSEED_SAMPLE_MINIMIZER;
+    samplingparam = arguments->dbs_minimizer;
+  } else if (!had_err && gt_option_is_set(arguments->dbs_option_syncmer)) {
+    sampling = GT_DIAGBANDSEED_SAMPLE_SYNCMER;
+    if (arguments->dbs_syncmer == UINT_MAX) {
+      arguments->dbs_syncmer = arguments->dbs_seedlength > 5
+                                 ? arguments->dbs_seedlength - 4 : 1;
+    }
+    if (arguments->dbs_syncmer == 0 ||
+        arguments->dbs_syncmer >= arguments->dbs_seedlength) {
+      gt_error_set(err, "argument to option \"-syncmer\" must be an integer "
+                   "between 1 and seedlength - 1 = %u",
+                   arguments->dbs_seedlength - 1);
+      had_err = -1;
+    }
+    samplingparam = (GtUword) arguments->dbs_syncmer;
+  }
+
   /* Set mincoverage */
   if (!had_err && arguments->dbs_mincoverage == GT_UWORD_MAX) {
     arguments->dbs_mincoverage = (GtUword) (2.5 * arguments->dbs_seedlength);
@@ -846,6 +971,15 @@ static int gt_seed_extend_runner(int argc,
     }
   }
 
+  /* The binary records store positions and lengths in 32 bits */
+  if (!had_err && arguments->binary &&
+      (gt_encseq_total_length(aencseq) > (GtUword) UINT32_MAX ||
+       gt_encseq_total_length(bencseq) > (GtUword) UINT32_MAX)) {
+    gt_error_set(err, "option -binary is only allowed for sequences of total "
+                 "length at most %" PRIu32, UINT32_MAX);
+    had_err = -1;
+  }
+
   /* Parse pick option */
   if (!had_err && strcmp(gt_str_get(arguments->dbs_pick_str),
                          "use all combinations successively") != 0) {
@@ -904,6 +1038,7 @@ static int gt_seed_extend_runner(int argc,
   if (!had_err) {
     GtDiagbandseedExtendParams *extp = NULL;
     GtDiagbandseedInfo *info = NULL;
+    GtDiagbandseedStats *stats = NULL;
     GtUword sensitivity = 0;
     GtUwordPair numparts = {arguments->dbs_parts, arguments->dbs_parts};
     GtRange *aseqranges = (GtRange *)gt_malloc(numparts.a * sizeof *aseqranges);
@@ -963,13 +1098,17 @@ static int gt_seed_extend_runner(int argc,
                                              arguments->benchmark,
                                              arguments->se_alignmentwidth,
                                              !arguments->relax_polish,
-                                             arguments->verify_alignment);
+                                             arguments->verify_alignment,
+                                             arguments->binary);
 
     info = gt_diagbandseed_info_new(aencseq,
                                     bencseq,
                                     arguments->dbs_maxfreq,
                                     arguments->dbs_memlimit,
+                                    arguments->dbs_spblockmem,
                                     arguments->dbs_seedlength,
+                                    sampling,
+                                    samplingparam,
                                     arguments->norev,
                                     arguments->nofwd,
                                     &arguments->seedpairdistance,
@@ -978,22 +1117,38 @@ static int gt_seed_extend_runner(int argc,
                                     arguments->dbs_debug_kmer,
                                     arguments->dbs_debug_seedpair,
                                     arguments->use_kmerfile,
+                                    arguments->use_kpos,
                                     extp,
                                     numparts.a,
                                     numparts.b);
 
+    if (gt_str_length(arguments->benchmark_json) > 0) {
+      stats = gt_diagbandseed_stats_new();
+      gt_diagbandseed_info_stats_set(info, stats);
+    }
+
     /* Start algorithm */
+    if (arguments->binary) {
+      gt_querymatch_binary_header_write(stdout);
+    }
     had_err = gt_diagbandseed_run(info,
                                   aseqranges,
                                   bseqranges,
                                   &pick,
                                   err);
+    if (!had_err && stats != NULL) {
+      had_err = gt_diagbandseed_stats_write_json(stats,
+                                                 gt_str_get(arguments->
+                                                            benchmark_json),
+                                                 gt_jobs, err);
+    }
 
     /* clean up */
     gt_free(aseqranges);
     gt_free(bseqranges);
     gt_diagbandseed_extend_params_delete(extp);
     gt_diagbandseed_info_delete(info);
+    gt_diagbandseed_stats_delete(stats);
   }
   gt_encseq_delete(aencseq);
   gt_encseq_delete(bencseq);
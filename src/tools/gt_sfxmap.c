@@ -42,6 +42,7 @@
 #include "match/sfx-lwcheck.h"
 #include "match/twobits2kmers.h"
 #include "match/esa-fileend.h"
+#include "match/esa-addlcp.h"
 #include "tools/gt_sfxmap.h"
 
 typedef struct
@@ -66,11 +67,13 @@ typedef struct
        wholeleafcheck,
        compressedesa,
        compresslcp,
+       addlcp,
        spmitv,
        ownencseq2file;
   GtUword delspranges;
   GtStr *esaindexname,
-        *pckindexname;
+        *pckindexname,
+        *addlcpmemlimit;
   unsigned int sortmaxdepth,
                scanesa;
   GtStrArray *algbounds,
@@ -131,6 +134,7 @@ static void *gt_sfxmap_arguments_new(void)
   arguments = gt_malloc(sizeof (*arguments));
   arguments->esaindexname = gt_str_new();
   arguments->pckindexname = gt_str_new();
+  arguments->addlcpmemlimit = gt_str_new();
   arguments->streamesq = gt_str_array_new();
   arguments->algbounds = gt_str_array_new();
   return arguments;
@@ -144,6 +148,7 @@ static void gt_sfxmap_arguments_delete(void *tool_arguments)
   {
     gt_str_delete(arguments->esaindexname);
     gt_str_delete(arguments->pckindexname);
+    gt_str_delete(arguments->addlcpmemlimit);
     gt_str_array_delete(arguments->streamesq);
     gt_str_array_delete(arguments->algbounds);
     gt_free(arguments);
@@ -163,7 +168,7 @@ static GtOptionParser* gt_sfxmap_option_parser_new(void *tool_arguments)
          *optionenumlcpitvs, *optionenumlcpitvtree, *optionenumlcpitvtreeBU,
          *optionscanesa, *optionspmitv, *optionownencseq2file,
          *optionbfcheck, *optioncompressedesa,
-         *optioncompresslcp;
+         *optioncompresslcp, *optionaddlcp, *optionaddlcpmemlimit;
 
   gt_assert(arguments != NULL);
   op = gt_option_parser_new("[options]",
@@ -331,11 +336,32 @@ static GtOptionParser* gt_sfxmap_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, optioncompresslcp);
   gt_option_imply(optioncompresslcp, optionesaindex);
 
+  optionaddlcp = gt_option_new_bool("addlcp",
+                                    "compute the lcp table from the suffix "
+                                    "array and the encoded sequence and add "
+                                    "it to the index",
+                                    &arguments->addlcp,
+                                    false);
+  gt_option_parser_add_option(op, optionaddlcp);
+  gt_option_imply(optionaddlcp, optionesaindex);
+
+  optionaddlcpmemlimit = gt_option_new_string("addlcpmemlimit",
+                                  "maximal amount of memory for the table "
+                                  "used by option -addlcp; the sequence is "
+                                  "processed in blocks if required (in "
+                                  "bytes, the keywords 'MB' and 'GB' are "
+                                  "allowed)",
+                                  arguments->addlcpmemlimit, NULL);
+  gt_option_parser_add_option(op, optionaddlcpmemlimit);
+  gt_option_imply(optionaddlcpmemlimit, optionaddlcp);
+
   optionverbose = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, optionverbose);
 
   gt_option_exclude(optionenumlcpitvs,optionenumlcpitvtree);
   gt_option_exclude(optioncompresslcp,optioncompressedesa);
+  gt_option_exclude(optionaddlcp,optioncompressedesa);
+  gt_option_exclude(optionaddlcp,optioncompresslcp);
   gt_option_exclude(optionenumlcpitvs,optionenumlcpitvtreeBU);
   gt_option_exclude(optionenumlcpitvtree,optionenumlcpitvtreeBU);
   gt_option_imply(optionlcp,optionsuf);
@@ -1403,6 +1429,22 @@ static int gt_sfxmap_run_diffcover_check(const Sfxmapoptions *arguments,
   return had_err;
 }
 
+static int gt_sfxmap_addlcp(const Sfxmapoptions *arguments,
+                            GtLogger *logger,GtError *err)
+{
+  GtUword maximumspace = 0;
+
+  gt_error_check(err);
+  if (gt_str_length(arguments->addlcpmemlimit) > 0 &&
+      gt_option_parse_spacespec(&maximumspace,"addlcpmemlimit",
+                                arguments->addlcpmemlimit,err) != 0)
+  {
+    return -1;
+  }
+  return gt_esa_addlcp(gt_str_get(arguments->esaindexname),maximumspace,
+                       logger,err);
+}
+
 static int showlcpinterval(GT_UNUSED void *data,const Lcpinterval *lcpinterval)
 {
   printf("N "GT_WU" "GT_WU" "GT_WU"\n",lcpinterval->offset,
@@ -1424,27 +1466,36 @@ static int gt_sfxmap_runner(GT_UNUSED int argc,
   logger = gt_logger_new(arguments->verbose, GT_LOGGER_DEFLT_PREFIX, stdout);
   if (gt_str_length(arguments->esaindexname) > 0)
   {
-    if (arguments->compressedesa)
+    if (arguments->addlcp)
     {
-      if (gt_sfxmap_compressedesa(gt_str_get(arguments->esaindexname),
-                                   err) != 0)
+      if (gt_sfxmap_addlcp(arguments,logger,err) != 0)
       {
         haserr = true;
       }
     } else
     {
-      if (arguments->compresslcp)
+      if (arguments->compressedesa)
       {
-        if (gt_sfxmap_compresslcp(gt_str_get(arguments->esaindexname),
-                                  logger,err) != 0)
+        if (gt_sfxmap_compressedesa(gt_str_get(arguments->esaindexname),
+                                     err) != 0)
         {
           haserr = true;
         }
       } else
       {
-        if (gt_sfxmap_esa(arguments,logger,err) != 0)
+        if (arguments->compresslcp)
         {
-          haserr = true;
+          if (gt_sfxmap_compresslcp(gt_str_get(arguments->esaindexname),
+                                    logger,err) != 0)
+          {
+            haserr = true;
+          }
+        } else
+        {
+          if (gt_sfxmap_esa(arguments,logger,err) != 0)
+          {
+            haserr = true;
+          }
         }
       }
     }
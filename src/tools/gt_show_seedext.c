@@ -39,8 +39,9 @@ typedef struct
        relax_polish,
        sortmatches,
        showeoplist,
-       seed_extend;
-  GtStr *matchfilename;
+       seed_extend,
+       binary;
+  GtStr *matchfilename, *indexname, *query_indexname;
   GtStrArray *display_args;
 } GtShowSeedextArguments;
 
@@ -48,6 +49,8 @@ static void* gt_show_seedext_arguments_new(void)
 {
   GtShowSeedextArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
   arguments->matchfilename = gt_str_new();
+  arguments->indexname = gt_str_new();
+  arguments->query_indexname = gt_str_new();
   arguments->display_args = gt_str_array_new();
   return arguments;
 }
@@ -58,6 +61,8 @@ static void gt_show_seedext_arguments_delete(void *tool_arguments)
   if (arguments != NULL) {
     gt_str_array_delete(arguments->display_args);
     gt_str_delete(arguments->matchfilename);
+    gt_str_delete(arguments->indexname);
+    gt_str_delete(arguments->query_indexname);
     gt_free(arguments);
   }
 }
@@ -67,7 +72,8 @@ static GtOptionParser* gt_show_seedext_option_parser_new(void *tool_arguments)
   GtShowSeedextArguments *arguments = tool_arguments;
   GtOptionParser *op;
   GtOption *op_ali, *option_filename, *op_relax_polish,
-           *op_seed_extend, *op_sortmatches, *op_showeoplist, *op_display;
+           *op_seed_extend, *op_sortmatches, *op_showeoplist, *op_display,
+           *op_binary, *op_ii, *op_qii;
 
   gt_assert(arguments);
   /* init */
@@ -125,8 +131,33 @@ static GtOptionParser* gt_show_seedext_option_parser_new(void *tool_arguments)
   gt_option_is_mandatory(option_filename);
   gt_option_parser_add_option(op, option_filename);
 
+  /* -binary */
+  op_binary = gt_option_new_bool("binary",
+                                 "read the matches from a file written with "
+                                 "option -binary and show them in text format",
+                                 &arguments->binary,false);
+  gt_option_parser_add_option(op, op_binary);
+
+  /* -ii */
+  op_ii = gt_option_new_string("ii","index of the database sequences, "
+                               "required for -binary -display seqlength",
+                               arguments->indexname,NULL);
+  gt_option_parser_add_option(op, op_ii);
+  gt_option_imply(op_ii, op_binary);
+
+  /* -qii */
+  op_qii = gt_option_new_string("qii","index of the query sequences, if "
+                                "they are not those of option -ii",
+                                arguments->query_indexname,NULL);
+  gt_option_parser_add_option(op, op_qii);
+  gt_option_imply(op_qii, op_ii);
+
   gt_option_exclude(op_seed_extend, op_sortmatches);
   gt_option_exclude(op_relax_polish, op_seed_extend);
+  gt_option_exclude(op_binary, op_ali);
+  gt_option_exclude(op_binary, op_seed_extend);
+  gt_option_exclude(op_binary, op_sortmatches);
+  gt_option_exclude(op_binary, op_showeoplist);
   return op;
 }
 
@@ -258,15 +289,101 @@ static void gt_show_seed_extend_encseq(GtQuerymatch *querymatchptr,
   }
 }
 
-static int gt_show_seedext_runner(GT_UNUSED int argc,
-                                  GT_UNUSED const char **argv,
-                                  GT_UNUSED int parsed_args,
-                                  void *tool_arguments,
+static int gt_show_seedext_binary(const GtShowSeedextArguments *arguments,
                                   GtError *err)
+{
+  GtQuerymatchBinaryReader *reader = NULL;
+  GtEncseqLoader *encseq_loader = NULL;
+  GtEncseq *dbencseq = NULL, *queryencseq = NULL;
+  unsigned int display_flag = 0;
+  int had_err = 0;
+
+  gt_error_check(err);
+  if (gt_querymatch_eval_display_args(&display_flag,
+                                      arguments->display_args,
+                                      err) != 0)
+  {
+    return -1;
+  }
+  /* the records do not store the sequence lengths */
+  if (gt_querymatch_seqlength_display(display_flag))
+  {
+    if (gt_str_length(arguments->indexname) == 0)
+    {
+      gt_error_set(err,"option -binary with -display seqlength requires "
+                       "option -ii");
+      return -1;
+    }
+    encseq_loader = gt_encseq_loader_new();
+    gt_encseq_loader_enable_autosupport(encseq_loader);
+    dbencseq = gt_encseq_loader_load(encseq_loader,
+                                     gt_str_get(arguments->indexname),err);
+    if (dbencseq == NULL)
+    {
+      had_err = -1;
+    } else
+    {
+      if (gt_str_length(arguments->query_indexname) > 0)
+      {
+        queryencseq
+          = gt_encseq_loader_load(encseq_loader,
+                                  gt_str_get(arguments->query_indexname),err);
+        if (queryencseq == NULL)
+        {
+          had_err = -1;
+        }
+      } else
+      {
+        queryencseq = gt_encseq_ref(dbencseq);
+      }
+    }
+    gt_encseq_loader_delete(encseq_loader);
+  }
+  if (!had_err)
+  {
+    reader = gt_querymatch_binary_reader_new(gt_str_get(arguments->
+                                                        matchfilename),
+                                             err);
+    if (reader == NULL)
+    {
+      had_err = -1;
+    }
+  }
+  if (!had_err)
+  {
+    const GtQuerymatchRecord
+      *records = gt_querymatch_binary_reader_records(reader);
+    const GtUword
+      numofrecords = gt_querymatch_binary_reader_numofrecords(reader);
+    GtUword idx;
+
+    for (idx = 0; idx < numofrecords; idx++)
+    {
+      if (dbencseq != NULL &&
+          (records[idx].dbseqnum >= gt_encseq_num_of_sequences(dbencseq) ||
+           records[idx].queryseqnum
+             >= gt_encseq_num_of_sequences(queryencseq)))
+      {
+        gt_error_set(err,"binary match file %s does not match the indexes",
+                     gt_str_get(arguments->matchfilename));
+        had_err = -1;
+        break;
+      }
+      gt_querymatch_record_out(records + idx,display_flag,dbencseq,
+                               queryencseq,stdout);
+    }
+  }
+  gt_querymatch_binary_reader_delete(reader);
+  gt_encseq_delete(dbencseq);
+  gt_encseq_delete(queryencseq);
+  return had_err;
+}
+
+static int gt_show_seedext_matchfile(const GtShowSeedextArguments *arguments,
+                                     GtError *err)
 {
   int had_err = 0;
   GtUword alignmentwidth;
-  GtShowSeedextArguments *arguments = tool_arguments;
   GtSeedextendMatchIterator *semi;
   unsigned int display_flag = 0;
   const GtEncseq *aencseq = NULL, *bencseq = NULL;
@@ -427,6 +544,23 @@ static int gt_show_seedext_runner(GT_UNUSED int argc,
   return had_err;
 }
 
+static int gt_show_seedext_runner(GT_UNUSED int argc,
+                                  GT_UNUSED const char **argv,
+                                  GT_UNUSED int parsed_args,
+                                  void *tool_arguments,
+                                  GtError *err)
+{
+  GtShowSeedextArguments *arguments = tool_arguments;
+
+  gt_error_check(err);
+  gt_assert(arguments != NULL);
+  if (arguments->binary)
+  {
+    return gt_show_seedext_binary(arguments,err);
+  }
+  return gt_show_seedext_matchfile(arguments,err);
+}
+
 GtTool* gt_show_seedext(void)
 {
   return gt_tool_new(gt_show_seedext_arguments_new,
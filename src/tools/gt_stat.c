@@ -134,6 +134,7 @@ static int gt_stat_runner(int argc, const char **argv, int parsed_args,
   /* create a gff3 input stream */
   gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
                                                   argv + parsed_args);
+  gt_gff3_in_stream_enable_arena_allocation(gff3_in_stream);
   if (arguments->verbose)
     gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
 
@@ -124,6 +124,13 @@ static GtOptionParser* gt_tagerator_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, optionmaxdepth);
   gt_option_is_development_option(optionmaxdepth);
 
+  option = gt_option_new_bool("sample","Use a sample of the suffix array "
+                              "and the bucket table to narrow the search "
+                              "(only relevant with option -esa)",
+                              &arguments->withsample, true);
+  gt_option_parser_add_option(op, option);
+  gt_option_is_development_option(option);
+
   optiononline = gt_option_new_bool("online","Perform online searches",
                                     &arguments->doonline, false);
   gt_option_parser_add_option(op, optiononline);
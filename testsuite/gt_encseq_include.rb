@@ -255,6 +255,32 @@ Test do
   run "diff mirr.info rev.info"
 end
 
+Name "gt encseq info page faults"
+Keywords "encseq gt_encseq_info pagefaults"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname foo #{$testdata}Atinsert.fna"
+  run_test "#{$bin}gt encseq info -pagefaults foo"
+  grep last_stdout, /^page faults: \d+ minor, \d+ major$/
+  run_test "#{$bin}gt encseq info -nomap -pagefaults foo", :retval => 1
+end
+
+Name "gt encseq locked tables"
+Keywords "encseq gt_encseq_decode gt_encseq_info locktables"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname foo #{$testdata}Atinsert.fna"
+  run_test "#{$bin}gt encseq decode foo"
+  run "mv #{last_stdout} default_run.out"
+  run_test "#{$bin}gt encseq decode -locktables foo"
+  run "cmp default_run.out #{last_stdout}"
+  run_test "#{$bin}gt encseq info -locktables foo"
+  run_test "#{$bin}gt encseq info -nomap -locktables foo", :retval => 1
+  run "ulimit -l 0; #{$bin}gt encseq decode -locktables foo"
+  if RUBY_PLATFORM =~ /linux/ and Process.uid != 0
+    grep last_stderr, /cannot lock.*continuing without locked tables/
+  end
+  run "cmp default_run.out #{last_stdout}"
+end
+
 Name "gt encseq decode single sequence"
 Keywords "encseq gt_encseq_decode single"
 Test do
@@ -328,6 +354,26 @@ Test do
   grep last_stderr, /can only be used with the/
 end
 
+[[["bit", "uchar", "ushort", "uint32"],
+  ["Atinsert.fna", "RandomN.fna", "TTT-small.fna"]],
+ [["eqlen"], ["trna_glutamine.fna"]],
+ [["direct"], ["Atinsert.fna", "sw100K1.fsa"]],
+ [["bytecompress"], ["sw100K1.fsa"]]].each do |sats, files|
+  sats.each do |sat|
+    Name "gt encseq bench bulk extraction #{sat}"
+    Keywords "encseq gt_encseq_bench"
+    Test do
+      files.each do |file|
+        run "#{$bin}gt encseq encode -sat #{sat} -indexname es " +
+            "#{$testdata}#{file}"
+        [1, 31, 4096].each do |blocksize|
+          run_test "#{$bin}gt encseq bench -bulk #{blocksize} es"
+        end
+      end
+    end
+  end
+end
+
 Name "gt encseq Lua bindings"
 Keywords "encseq gt_scripts "
 Test do
@@ -413,6 +459,78 @@ end
   end
 end
 
+["bit", "uchar", "uint32"].each do |sat|
+  Name "gt encseq encode multiple files in parallel #{sat}"
+  Keywords "encseq gt_encseq threads"
+  Test do
+    files = ["Atinsert.fna", "Random.fna", "U89959_genomic.fas",
+             "Duplicate.fna"].map { |fn| "#{$testdata}#{fn}" }.join(" ")
+    ["1", "3"].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} encseq encode -sat #{sat} -des -sds " +
+               "-md5 -ssp -indexname idx#{jobs} #{files}"
+    end
+    ["esq", "des", "sds", "md5", "ssp"].each do |suffix|
+      run "cmp idx1.#{suffix} idx3.#{suffix}"
+    end
+  end
+end
+
+[["", ["des", "sds", "md5", "ssp"]],
+ ["-lossless", ["esq", "des", "sds", "md5", "ssp", "ois"]]].each do |opt, sfx|
+  Name "gt encseq encode -append #{opt}".strip
+  Keywords "encseq gt_encseq append"
+  Test do
+    files = ["Atinsert.fna", "U89959_genomic.fas",
+             "Random.fna"].map { |fn| "#{$testdata}#{fn}" }
+    run_test "#{$bin}gt encseq encode #{opt} -indexname all #{files.join(" ")}"
+    run_test "#{$bin}gt encseq encode #{opt} -indexname idx #{files[0]}"
+    run_test "#{$bin}gt encseq encode -append idx #{files[1..2].join(" ")}"
+    sfx.each do |suffix|
+      run "cmp all.#{suffix} idx.#{suffix}"
+    end
+    run_test "#{$bin}gt encseq decode -lossless #{opt == "" ? "no" : "yes"} " +
+             "all > all.out"
+    run_test "#{$bin}gt encseq decode -lossless #{opt == "" ? "no" : "yes"} " +
+             "idx > idx.out"
+    run "cmp all.out idx.out"
+  end
+end
+
+Name "gt encseq encode -append failure"
+Keywords "encseq gt_encseq append"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname idx #{$testdata}Atinsert.fna"
+  run "cp idx.esq idx.esq.orig"
+  run_test "#{$bin}gt encseq encode -append idx #{$testdata}sw100K1.fsa",
+           :retval => 1
+  grep last_stderr, /illegal character/
+  run "cmp idx.esq idx.esq.orig"
+  run_test "#{$bin}gt encseq encode -append idx -indexname foo " +
+           "#{$testdata}U89959_genomic.fas", :retval => 1
+  grep last_stderr, /cannot be combined/
+end
+
+Name "gt encseq encode -append rename failure"
+Keywords "encseq gt_encseq append"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname idx #{$testdata}Atinsert.fna"
+  suffixes = ["esq", "des", "sds", "md5", "ssp"]
+  suffixes.each do |suffix|
+    run "cp idx.#{suffix} orig.#{suffix}"
+  end
+  # the old separator table cannot be moved to its backup name, after the
+  # sequence table has already been moved
+  run "mkdir -p idx.backup.ssp/blocker"
+  run_test "#{$bin}gt encseq encode -append idx " +
+           "#{$testdata}U89959_genomic.fas", :retval => 1
+  grep last_stderr, /cannot rename/
+  suffixes.each do |suffix|
+    run "cmp idx.#{suffix} orig.#{suffix}"
+  end
+  run "test -z \"`ls idx.append.* idx.backup.esq 2>/dev/null`\""
+  run_test "#{$bin}gt encseq decode idx"
+end
+
 Name "gt encseq MD5 index w/o MD5 support"
 Keywords "encseq gt_encseq md5"
 Test do
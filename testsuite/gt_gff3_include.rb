@@ -1035,6 +1035,111 @@ Test do
   run_test "#{$bin}gt gff3 out.gff3 | diff #{$testdata}dynbuf.gff3 -"
 end
 
+Name "gt gff3 lines longer than the read buffer (CRLF)"
+Keywords "gt_gff3"
+Test do
+  lines = File.readlines("#{$testdata}gff3_file_1_short.txt")
+  File.open("long.gff3", "w") do |f|
+    f.print lines[0]
+    f.puts "#" + "x" * 300000
+    lines[1..-1].each {|line| f.print line}
+  end
+  File.open("longcrlf.gff3", "w") do |f|
+    File.readlines("long.gff3").each {|line| f.print line.chomp + "\r\n"}
+  end
+  run_test "#{$bin}gt gff3 long.gff3"
+  run "mv #{last_stdout} long.out"
+  if not File.readlines("long.out").include?("#" + "x" * 300000 + "\n")
+    failtest("long comment line is missing in output")
+  end
+  run_test "#{$bin}gt gff3 longcrlf.gff3"
+  run "diff #{last_stdout} long.out"
+  run_test "#{$bin}gt gff3 - < longcrlf.gff3"
+  run "diff #{last_stdout} long.out"
+end
+
+def write_parallel_gff3(filename, genes, errorline = nil)
+  File.open(filename, "w") do |f|
+    f.puts "##gff-version 3"
+    lines = 1
+    genes.times do |g|
+      start = 1000 + g * 1000
+      strand = (errorline and lines >= errorline) ? "x" : "+"
+      errorline = nil if strand == "x"
+      f.puts "ctg#{g % 3}\t.\tgene\t#{start}\t#{start + 800}\t.\t#{strand}\t." +
+             "\tID=gene#{g};Name=G%3B#{g};"
+      f.puts "ctg#{g % 3}\t.\tmRNA\t#{start}\t#{start + 800}\t.\t+\t." +
+             "\tID=mrna#{g};Parent=gene#{g}; note=x"
+      f.puts "ctg#{g % 3}\t.\texon\t#{start + 800}\t#{start}\t.\t+\t." +
+             "\tParent=mrna#{g}" if g % 97 == 0
+      f.puts "ctg#{g % 3}\t.\tCDS\t#{start}\t#{start + 299}\t0.5\t+\t0" +
+             "\tParent=mrna#{g};Foo=bar" if g % 89 == 0
+      f.puts "ctg#{g % 3}\t.\tCDS\t#{start + 400}\t#{start + 699}\t.\t+\t0" +
+             "\tParent=mrna#{g};ID=cds#{g}"
+      f.puts "###" if g % 1000 == 999
+      lines += 3 + (g % 97 == 0 ? 1 : 0) + (g % 89 == 0 ? 1 : 0)
+    end
+    f.puts "##FASTA"
+    3.times do |c|
+      f.puts ">ctg#{c}"
+      f.puts "acgt" * 20
+    end
+  end
+end
+
+Name "gt gff3 parallel tokenizing"
+Keywords "gt_gff3 gff3_parallel"
+Test do
+  write_parallel_gff3("par.gff3", 8000)
+  run_test "#{$bin}gt gff3 -tidy par.gff3"
+  run "mv #{last_stdout} seq.out"
+  run "mv #{last_stderr} seq.err"
+  run_test "#{$bin}gt -j 3 gff3 -tidy par.gff3"
+  run "diff #{last_stdout} seq.out"
+  run "diff #{last_stderr} seq.err"
+  run_test "#{$bin}gt -j 3 gff3 -tidy - < par.gff3"
+  run "diff #{last_stdout} seq.out"
+end
+
+Name "gt gff3 parallel tokenizing (error)"
+Keywords "gt_gff3 gff3_parallel"
+Test do
+  write_parallel_gff3("par.gff3", 8000, 20000)
+  run_test "#{$bin}gt gff3 -tidy par.gff3", :retval => 1
+  run "mv #{last_stderr} seq.err"
+  run_test "#{$bin}gt -j 3 gff3 -tidy par.gff3", :retval => 1
+  grep(last_stderr, /strand 'x' on line 20\d\d\d/)
+  run "diff #{last_stderr} seq.err"
+end
+
+Name "gt gff3 -sort -memlimit"
+Keywords "gt_gff3 gff3_memlimit"
+Test do
+  write_parallel_gff3("par.gff3", 3000)
+  ["par.gff3", "#{$testdata}multiple_top_level_parents.gff3",
+   "#{$testdata}standard_gene_as_dag.gff3",
+   "#{$testdata}encode_known_genes_Mar07.gff3"].each do |file|
+    run_test "#{$bin}gt gff3 -sort -tidy -retainids #{file}"
+    run "mv #{last_stdout} sorted.out"
+    ["1", "20000", "1MB"].each do |memlimit|
+      run_test "#{$bin}gt gff3 -sort -memlimit #{memlimit} -tidy -retainids " +
+               "#{file}"
+      run "diff #{last_stdout} sorted.out"
+    end
+  end
+end
+
+Name "gt gff3 -memlimit (invalid argument)"
+Keywords "gt_gff3 gff3_memlimit"
+Test do
+  run_test "#{$bin}gt gff3 -sort -memlimit 10KB #{$testdata}eden.gff3",
+           :retval => 1
+  grep(last_stderr, /option -memlimit must have/)
+  run_test "#{$bin}gt gff3 -sort -memlimit 0 #{$testdata}eden.gff3",
+           :retval => 1
+  grep(last_stderr, /must be positive/)
+end
+
 Name "gt gff3 print very long attributes (-gzip)"
 Keywords "gt_gff3"
 Test do
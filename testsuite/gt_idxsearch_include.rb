@@ -176,3 +176,79 @@ Test do
            :retval => 1
   run "rm -f sfx.* fmi.* pck.*"
 end
+
+Name "gt matstat/uniquesub/tagerator sample at1MB U8"
+Keywords "gt_greedyfwdmat gt_tagerator sample"
+Test do
+  run "#{$bin}gt suffixerator -indexname sfx -tis -suf -ssp -dna -bck " +
+      "-pl 6 -db #{$testdata}at1MB"
+  run "#{$bin}gt shredder -minlength 12 -maxlength 15 " +
+      "#{$testdata}U89959_genomic.fas | " +
+      "#{$bin}gt seqfilter -minlength 12 - | " +
+      "sed -e \'s/^>.*/>/\' > patternfile"
+  ["yes","no"].each do |sample|
+    [false,true].each do |ms|
+      run_test(makegreedyfwdmatcall("#{$testdata}U89959_genomic.fas",
+                                    "-esa sfx -sample #{sample}",ms),
+               :maxtime => 600)
+      run "mv #{last_stdout} tmp.#{ms}.#{sample}"
+    end
+    run_test("#{$bin}gt tagerator -rw -e 0 -esa sfx -q patternfile " +
+             "-sample #{sample} -output tagnum dbstartpos",:maxtime => 240)
+    run "mv #{last_stdout} tmp.tag.#{sample}"
+  end
+  run "diff tmp.false.yes tmp.false.no"
+  run "diff tmp.true.yes tmp.true.no"
+  run "diff tmp.tag.yes tmp.tag.no"
+  # a bucket table not fitting to the index is not used
+  run "#{$bin}gt suffixerator -indexname sfx -tis -suf -ssp -dna -bck " +
+      "-pl 3 -db #{$testdata}Atinsert.fna"
+  run "mv sfx.bck stale.bck"
+  run "#{$bin}gt suffixerator -indexname sfx -tis -suf -ssp -dna -bck " +
+      "-pl 6 -db #{$testdata}at1MB"
+  run "mv stale.bck sfx.bck"
+  run_test(makegreedyfwdmatcall("#{$testdata}U89959_genomic.fas",
+                                "-esa sfx",false),:maxtime => 600)
+  run "diff #{last_stdout} tmp.false.no"
+end
+
+def tagmatchsets(filename)
+  matches = Hash.new
+  tagnum = nil
+  File.open(filename).each_line do |line|
+    if m = line.match(/^#\t(\d+)/)
+      tagnum = m[1]
+      matches[tagnum] = []
+    elsif !line.start_with?("#") and !tagnum.nil?
+      matches[tagnum].push(line)
+    end
+  end
+  matches.each_value {|lines| lines.sort!}
+  return matches
+end
+
+Name "gt tagerator batched search in packed index"
+Keywords "gt_tagerator"
+Test do
+  run "#{$bin}gt suffixerator -indexname sfx -tis -suf -ssp -dna " +
+      "-db #{$testdata}at1MB", :maxtime => 300
+  run "#{$bin}gt packedindex mkindex -tis -ssp -indexname pck -dna -pl " +
+      "-sprank -bsize 10 -locfreq 32 -dir rev -db #{$testdata}at1MB",
+      :maxtime => 300
+  run_test "#{$bin}gt prebwt -maxdepth 4 -pck pck", :maxtime => 180
+  run "#{$bin}gt shredder -minlength 12 -maxlength 20 " +
+      "#{$testdata}U89959_genomic.fas | " +
+      "#{$bin}gt seqfilter -minlength 12 - | " +
+      "sed -e \'s/^>.*/>/\' > patternfile"
+  ["-e 0", "-e 1", "-e 1 -best"].each do |maxdist|
+    ["esa sfx", "pck pck"].each do |index|
+      run_test("#{$bin}gt tagerator -rw #{maxdist} -#{index} " +
+               "-q patternfile -output tagnum dbstartpos strand",
+               :maxtime => 600)
+      run "mv #{last_stdout} tmp.#{index.split[1]}"
+    end
+    if tagmatchsets("tmp.sfx") != tagmatchsets("tmp.pck")
+      failtest("matches in packed index differ for #{maxdist}")
+    end
+  end
+end
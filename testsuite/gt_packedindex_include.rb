@@ -156,6 +156,20 @@ Test do
                          :chkintegrity => 800, :chksearch => 400 })
 end
 
+Name "gt packedindex mkindex parallel"
+Keywords "gt_packedindex"
+Test do
+  ["-sprank", "-bsize 10 -blbuck 20"].each do |opt|
+    ["seq", "par"].each do |name|
+      jobs = (name == "par") ? 4 : 1
+      run_test "#{$bin}gt -j #{jobs} packedindex mkindex -tis -des " +
+               "-indexname #{name} #{opt} -db #{$testdata}at1MB",
+               :maxtime => 400
+    end
+    run "cmp seq.bdx par.bdx"
+  end
+end
+
 if $gttestdata then
   Name "gt packedindex check tools for chr01 yeast"
   Keywords "gt_packedindex"
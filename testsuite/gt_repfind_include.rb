@@ -248,6 +248,27 @@ Test do
   run "#{$bin}gt repfind -samples 1000 -l 6 -ii sfx",:maxtime => 600
 end
 
+Name "gt repfind binary output"
+Keywords "gt_repfind binary"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}at1MB " +
+           "-indexname at1MB -dna -tis -suf -lcp"
+  run_test "#{$bin}gt suffixerator -db #{$testdata}Atinsert.fna " +
+           "-indexname Atinsert -dna -tis -suf -lcp"
+  ["-l 30 -f -r -p", "-l 50 -extendxdrop", "-l 50 -extendgreedy -p",
+   "-l 30 -qii Atinsert",
+   "-l 700 -seedlength 15 -extendgreedy -q #{$testdata}Atinsert.fna"].
+   each do |options|
+    run_test "#{$bin}gt repfind -ii at1MB #{options}"
+    run "grep -v '^#' #{last_stdout}"
+    run "mv #{last_stdout} text.out"
+    run_test "#{$bin}gt repfind -ii at1MB #{options} -binary"
+    run "mv #{last_stdout} binary.out"
+    run_test "#{$bin}gt dev show_seedext -binary -f binary.out"
+    run "cmp text.out #{last_stdout}"
+  end
+  run_test "#{$bin}gt repfind -ii at1MB -binary -spm", :retval => 1
+end
 if $gttestdata then
   extendexception = ["hs5hcmvcg.fna","Wildcards.fna","at1MB"]
   repfindtestfiles.each do |reffile|
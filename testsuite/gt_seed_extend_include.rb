@@ -181,6 +181,88 @@ Test do
   grep last_stderr, /cannot open file 'not-existing-file.esq': No such file/
 end
 
+# Memory mapped k-mer index of the first sequence set
+Name "gt seed_extend: kpos index"
+Keywords "gt_seed_extend kpos"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("U89959_genomic", "#{$testdata}U89959_genomic.fas")
+  for query in ["", " -qii U89959_genomic"]
+    for parts in [1, 2]
+      run_test "#{$bin}gt seed_extend -ii at1MB#{query} -parts #{parts} " +
+               "-kmerfile no"
+      run "mv #{last_stdout} default_run.out"
+      # the first run creates the index, the second one maps it
+      for run in [1, 2]
+        run_test "#{$bin}gt seed_extend -ii at1MB#{query} -parts #{parts} " +
+                 "-kmerfile no -kpos"
+        run "cmp default_run.out #{last_stdout}"
+      end
+      if parts == 1
+        run_test "#{$bin}gt -j 2 seed_extend -ii at1MB#{query} -kpos"
+        run "cmp default_run.out #{last_stdout}"
+      end
+      run "rm -f at1MB*.kpos"
+    end
+  end
+  run_test "#{$bin}gt seed_extend -ii at1MB -qii U89959_genomic -kpos " +
+           "-maxfreq 10"
+  run_test "#{$bin}gt seed_extend -ii at1MB -qii U89959_genomic -kpos " +
+           "-maxfreq 20", :retval => 1
+  grep last_stderr, /only contains k-mers occurring at most 10 times/
+  run_test "#{$bin}gt seed_extend -ii at1MB -qii U89959_genomic -kpos " +
+           "-maxfreq 10 -seedlength 12", :retval => 1
+  grep last_stderr, /was built for seedlength 9, but seedlength is 12/
+end
+
+# Minimizer and syncmer sampling of the k-mers
+Name "gt seed_extend: k-mer sampling"
+Keywords "gt_seed_extend minimizer syncmer"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("U89959_genomic", "#{$testdata}U89959_genomic.fas")
+  for sampling in ["-minimizer", "-minimizer 4", "-syncmer", "-syncmer 3"]
+    for query in ["", " -qii U89959_genomic"]
+      run_test "#{$bin}gt seed_extend -ii at1MB#{query} #{sampling} " +
+               "-only-seeds -verify -kmerfile no"
+      run_test "#{$bin}gt seed_extend -ii at1MB#{query} #{sampling} " +
+               "-kmerfile no"
+      run "mv #{last_stdout} default_run.out"
+      # k-mer files are kept separately for each sampling
+      for run in [1, 2]
+        run_test "#{$bin}gt seed_extend -ii at1MB#{query} #{sampling}"
+        run "cmp default_run.out #{last_stdout}"
+      end
+      run_test "#{$bin}gt -j 2 seed_extend -ii at1MB#{query} #{sampling} " +
+               "-kmerfile no"
+      run "cmp default_run.out #{last_stdout}"
+    end
+  end
+  run_test "#{$bin}gt seed_extend -ii at1MB -v -minimizer -kmerfile no"
+  grep last_stdout, /sampled [0-9]+ of [0-9]+ 10-mers/
+  run_test "#{$bin}gt seed_extend -ii at1MB -syncmer 10 -kmerfile no",
+           :retval => 1
+  grep last_stderr, /must be an integer between 1 and seedlength - 1 = 9/
+  run_test "#{$bin}gt seed_extend -ii at1MB -syncmer -minimizer", :retval => 1
+  for seed in seeds do
+    run "#{$scriptsdir}gen-randseq.rb --minidentity 90 " +
+        "--seedlength 14 --length 1000 --mode seeded --seed #{seed} " +
+        "--seedcoverage 35 --long 10000  --reverse-complement > longseeded.fasta"
+    run_test build_encseq("longseeded", "longseeded.fasta")
+    for sampling in ["-minimizer 5", "-syncmer"]
+      run_test "#{$bin}gt seed_extend -extendgreedy -l 900 #{sampling} " +
+               "-minidentity 90 -ii longseeded -kmerfile no"
+      numalignments = `wc -l #{last_stdout}`.to_i
+      run "head -1 longseeded.fasta"
+      run "grep -o '|' #{last_stdout}"
+      numseeds = `wc -l #{last_stdout}`.to_i + 1
+      if numalignments < numseeds then
+        raise TestFailed, "did not find all alignments"
+      end
+    end
+  end
+end
+
 # Find synthetic alignments
 Name "gt seed_extend: artificial sequences"
 Keywords "gt_seed_extend artificial"
@@ -257,6 +339,50 @@ Test do
   grep last_stdout, /23 418 127 P 24 2 68 35 4 82.98/
 end
 
+# Blocks of seed pairs
+Name "gt seed_extend: seedpairblock"
+Keywords "gt_seed_extend seedpairblock"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("U89959_genomic", "#{$testdata}U89959_genomic.fas")
+  for query in ["", " -qii U89959_genomic"]
+    run_test "#{$bin}gt seed_extend -ii at1MB#{query} -kmerfile no " +
+             "-verify-alignment"
+    run "mv #{last_stdout} default.out"
+    run_test "#{$bin}gt seed_extend -ii at1MB#{query} -kmerfile no " +
+             "-seedpairblock 1MB -verify -verify-alignment"
+    run "cmp default.out #{last_stdout}"
+  end
+  run_test "#{$bin}gt seed_extend -ii at1MB -seedpairblock 1MB -v"
+  grep last_stdout, /collected 725386 seed pairs in 12 runs/
+  grep last_stdout, /Process block 7 \(sequences 1384...1951\)/
+  # the k-mer lists take 20MB of the memory limit
+  run_test "#{$bin}gt seed_extend -ii at1MB -kmerfile no"
+  run "grep -v '^#' #{last_stdout}"
+  run "mv #{last_stdout} default.out"
+  run_test "#{$bin}gt seed_extend -ii at1MB -kmerfile no " +
+           "-seedpairblock 1MB -memlimit 20MB -v"
+  grep last_stdout, /block size is 64842/
+  run "grep -v '^#' #{last_stdout}"
+  run "cmp default.out #{last_stdout}"
+  run_test "#{$bin}gt seed_extend -ii at1MB -seedpairblock 1MB " +
+           "-memlimit 10MB", :retval => 1
+  grep last_stderr, /option -memlimit too strict: need at least 20MB/
+  # the seed pair stage takes less space
+  peak = Hash.new
+  ["", " -seedpairblock 1MB"].each do |block|
+    run_test "env GT_MEM_BOOKKEEPING=on #{$bin}gt seed_extend -ii at1MB " +
+             "-kmerfile no -benchmark-json report.json#{block}"
+    stage = File.read("report.json").
+              match(/"name": "seedpairs".*?"peak_growth_bytes": (\d+)/m)
+    raise TestFailedError if stage.nil?
+    peak[block] = stage[1].to_i
+  end
+  raise TestFailedError if peak[" -seedpairblock 1MB"] * 3 > peak[""]
+  run_test "#{$bin}gt seed_extend -ii at1MB -seedpairblock 0MB", :retval => 1
+  grep last_stderr, /argument to option "-seedpairblock" must be at least 1MB/
+end
+
 # Threading
 Name "gt seed_extend: threading"
 Keywords "gt_seed_extend thread"
@@ -285,3 +411,127 @@ Test do
     end
   end
 end
+
+# Threaded seed extension keeps the output order
+Name "gt seed_extend: threaded extension"
+Keywords "gt_seed_extend thread extension"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("U89959_genomic", "#{$testdata}U89959_genomic.fas")
+  for query in ["", " -qii U89959_genomic"]
+    for ext in ["-extendgreedy", "-extendxdrop -a"]
+      run_test "#{$bin}gt seed_extend -ii at1MB#{query} #{ext}"
+      run "mv #{last_stdout} default_run.out"
+      for jobs in [2, 4] do
+        run_test "#{$bin}gt -j #{jobs} seed_extend -ii at1MB#{query} #{ext}"
+        run "cmp default_run.out #{last_stdout}"
+      end
+      run_test "#{$bin}gt -j 3 seed_extend -ii at1MB#{query} #{ext} " +
+               "-seedpairblock 1MB"
+      run "cmp default_run.out #{last_stdout}"
+    end
+  end
+end
+
+# Threads which cannot be created leave their seed pairs and k-mers to the
+# other threads; a huge stack size in a small address space lets thread
+# creation fail
+Name "gt seed_extend: thread creation failure"
+Keywords "gt_seed_extend thread extension kmer failure"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test "#{$bin}gt seed_extend -ii at1MB -kmerfile no"
+  run "mv #{last_stdout} default_run.out"
+  run "ulimit -s 4194304; ulimit -v 1048576; " +
+      "#{$bin}gt -j 4 seed_extend -ii at1MB -kmerfile no"
+  if RUBY_PLATFORM =~ /linux/
+    grep last_stderr, /cannot create thread.*extended by the other threads/
+  end
+  run "cmp default_run.out #{last_stdout}"
+  run_test "#{$bin}gt seed_extend -ii at1MB -kmerfile no -debug-kmer " +
+           "-only-seeds"
+  run "mv #{last_stdout} default_run.out"
+  run "ulimit -s 4194304; ulimit -v 1048576; " +
+      "#{$bin}gt -j 4 seed_extend -ii at1MB -kmerfile no -debug-kmer " +
+      "-only-seeds"
+  if RUBY_PLATFORM =~ /linux/
+    grep last_stderr, /cannot create thread.*collected by the calling thread/
+  end
+  run "cmp default_run.out #{last_stdout}"
+end
+
+# K-mers of a sequence set are collected by several threads in the same order
+Name "gt seed_extend: threaded k-mer collection"
+Keywords "gt_seed_extend thread kmer"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("paired", "#{$testdata}readjoiner/paired_reads_1.fas")
+  for dataset in ["at1MB", "paired"] do
+    for sampling in ["", " -minimizer", " -syncmer"]
+      run_test "#{$bin}gt seed_extend -ii #{dataset}#{sampling} " +
+               "-debug-kmer -kmerfile no"
+      run "mv #{last_stdout} default_run.out"
+      for jobs in [2, 3, 8] do
+        run_test "#{$bin}gt -j #{jobs} seed_extend -ii #{dataset}" +
+                 "#{sampling} -debug-kmer -kmerfile no"
+        run "cmp default_run.out #{last_stdout}"
+      end
+    end
+  end
+end
+
+# Binary match records show the same matches as the text output
+Name "gt seed_extend: binary output"
+Keywords "gt_seed_extend binary"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("U89959_genomic", "#{$testdata}U89959_genomic.fas")
+  for query in ["", " -qii U89959_genomic"]
+    for ext in ["-extendgreedy", "-extendxdrop"]
+      for jobs in [1, 3] do
+        for parts in ["", " -parts 2"] do
+          options = "-ii at1MB#{query} #{ext}#{parts}"
+          run_test "#{$bin}gt -j #{jobs} seed_extend #{options} " +
+                   "-display seqlength"
+          run "grep -v '^#' #{last_stdout}"
+          run "mv #{last_stdout} text.out"
+          run_test "#{$bin}gt -j #{jobs} seed_extend #{options} -binary"
+          run "mv #{last_stdout} binary.out"
+          run_test "#{$bin}gt dev show_seedext -binary -f binary.out " +
+                   "-display seqlength -ii at1MB#{query}"
+          run "cmp text.out #{last_stdout}"
+        end
+      end
+    end
+  end
+  run_test "#{$bin}gt seed_extend -ii at1MB -binary -a", :retval => 1
+  run "head -c 100 binary.out > truncated.out"
+  run_test "#{$bin}gt dev show_seedext -binary -f truncated.out",
+           :retval => 1
+  grep last_stderr, /is truncated/
+  run_test "#{$bin}gt dev show_seedext -binary -f text.out", :retval => 1
+  run_test "#{$bin}gt dev show_seedext -binary -f binary.out " +
+           "-display seqlength", :retval => 1
+  grep last_stderr, /requires option -ii/
+end
+
+Name "gt seed_extend: benchmark report"
+Keywords "gt_seed_extend benchmark"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  for jobs in [1, 2] do
+    run_test "#{$bin}gt -j #{jobs} seed_extend -ii at1MB -kmerfile no " +
+             "-benchmark-json report.json"
+    matches = File.readlines(last_stdout).count {|l| not l.start_with?("#")}
+    report = File.read("report.json")
+    ["kmers", "sort", "seedpairs", "filter", "extend",
+     "output"].each do |stage|
+      grep "report.json", /"name": "#{stage}"/
+    end
+    grep "report.json", /"threads": #{jobs},/
+    extend = report.match(/"name": "extend".*"items_out": (\d+)/)
+    raise TestFailedError if extend.nil? or extend[1].to_i != matches
+  end
+  run_test "#{$bin}gt seed_extend -ii at1MB -benchmark-json nodir/report.json",
+           :retval => 1
+end
@@ -601,3 +601,127 @@ Test do
   run "#{$bin}/gt dev sfxmap -enumlcpitvtree -esa sfx > noBU.txt"
   run "diff withBU.txt noBU.txt"
 end
+
+Name "gt sain parallel induced sorting"
+Keywords "gt_suffixerator sain threads"
+Test do
+  run "cp #{$testdata}/at1MB at1MB.fas"
+  ["-file at1MB.fas", "-fasta at1MB.fas -dna"].each do |input|
+    [1, 3].each do |jobs|
+      run_test "#{$bin}/gt -j #{jobs} dev sain #{input} -suf -fcheck -icheck"
+      run "mv at1MB.fas.suf sain#{jobs}.suf"
+    end
+    run "cmp sain1.suf sain3.suf"
+  end
+  run_test "#{$bin}/gt encseq encode -indexname at1MB #{$testdata}/at1MB"
+  ["fwd", "cpl", "rev", "rcl"].each do |dir|
+    run_test "#{$bin}/gt -j 3 dev sain -esq at1MB -dir #{dir} -fcheck -icheck"
+  end
+end
+
+# Threads which cannot be created leave their ranges to the calling thread;
+# a huge stack size in a small address space lets thread creation fail
+Name "gt sain thread creation failure"
+Keywords "gt_suffixerator sain threads failure"
+Test do
+  run "cp #{$testdata}/at1MB at1MB.fas"
+  run_test "#{$bin}/gt dev sain -file at1MB.fas -suf"
+  run "mv at1MB.fas.suf sain1.suf"
+  run "ulimit -s 4194304; ulimit -v 1048576; " +
+      "#{$bin}/gt -j 3 dev sain -file at1MB.fas -suf -fcheck -icheck"
+  if RUBY_PLATFORM =~ /linux/
+    grep last_stderr, /cannot create thread.*processed by the calling thread/
+  end
+  run "cmp sain1.suf at1MB.fas.suf"
+end
+
+Name "gt sfxmap addlcp"
+Keywords "gt_suffixerator gt_sfxmap addlcp"
+Test do
+  [["at1MB", "fwd"], ["at1MB", "rcl"], ["Atinsert.fna", "cpl"],
+   ["sw100K1.fsa", "fwd"]].each do |file, dir|
+    run_test "#{$bin}gt suffixerator -db #{$testdata}/#{file} -suf -lcp " +
+             "-tis -dir #{dir} -indexname ref"
+    ["", "-addlcpmemlimit 1MB"].each do |memlimit|
+      run_test "#{$bin}gt suffixerator -db #{$testdata}/#{file} -suf " +
+               "-tis -dir #{dir} -indexname addlcp"
+      run_test "#{$bin}gt -j 2 dev sfxmap -esa addlcp -addlcp #{memlimit}"
+      run "cmp ref.lcp addlcp.lcp"
+      run "cmp ref.llv addlcp.llv"
+      run "grep -v 'indexname\\|averagelcp' ref.prj > ref.prj.cmp"
+      run "grep -v 'indexname\\|averagelcp' addlcp.prj > addlcp.prj.cmp"
+      run "cmp ref.prj.cmp addlcp.prj.cmp"
+    end
+  end
+  run_test "#{$bin}gt dev sfxmap -esa addlcp -addlcp -compressedesa", \
+           :retval => 1
+end
+
+# Threads which cannot be created leave their lcp values to the calling
+# thread; a huge stack size in a small address space lets thread creation
+# fail
+Name "gt sfxmap addlcp thread creation failure"
+Keywords "gt_suffixerator gt_sfxmap addlcp threads failure"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}/at1MB -suf -lcp " +
+           "-tis -indexname ref"
+  run_test "#{$bin}gt suffixerator -db #{$testdata}/at1MB -suf " +
+           "-tis -indexname addlcp"
+  run "ulimit -s 4194304; ulimit -v 1048576; " +
+      "#{$bin}gt -j 4 dev sfxmap -esa addlcp -addlcp"
+  if RUBY_PLATFORM =~ /linux/
+    grep last_stderr, /cannot create thread.*computed by the calling thread/
+  end
+  run "cmp ref.lcp addlcp.lcp"
+  run "cmp ref.llv addlcp.llv"
+end
+
+Name "gt suffixerator spilled parts"
+Keywords "gt_suffixerator spillparts"
+Test do
+  ["fwd", "rcl"].each do |dir|
+    run_test "#{$bin}gt suffixerator -db #{$testdata}/at1MB -suf -lcp " +
+             "-dir #{dir} -parts 4 -indexname ref"
+    run_test "#{$bin}gt suffixerator -db #{$testdata}/at1MB -suf -lcp " +
+             "-dir #{dir} -parts 4 -spillparts -indexname spill -v"
+    grep(last_stdout, /spilled \d+ suffixes in \d+ runs: [1-9]\d* bytes/)
+    grep(last_stdout, /written to and [1-9]\d* bytes read from/)
+    run "cmp ref.suf spill.suf"
+    run "cmp ref.lcp spill.lcp"
+  end
+  run_test "#{$bin}gt suffixerator -db #{$testdata}/sw100K1.fsa -suf -lcp " +
+           "-parts 3 -indexname ref"
+  run_test "#{$bin}gt suffixerator -db #{$testdata}/sw100K1.fsa -suf -lcp " +
+           "-parts 3 -spillparts -indexname spill"
+  run "cmp ref.suf spill.suf"
+  run "cmp ref.lcp spill.lcp"
+  run_test "#{$bin}gt suffixerator -db #{$testdata}/at1MB -suf -lcp " +
+           "-spillparts", :retval => 1
+  grep(last_stderr, /option "-spillparts" requires option/)
+end
+
+Name "gt suffixerator spilled parts memlimit"
+Keywords "gt_suffixerator spillparts memlimit"
+Test do
+  [2, 3].each do |limit|
+    run_test "#{$bin}gt suffixerator -db #{$testdata}/at1MB -suf -lcp " +
+             "-memlimit #{limit}MB -indexname ref"
+    run_test "env GT_MEM_BOOKKEEPING=on GT_ENV_OPTIONS=-spacepeak " +
+             "#{$bin}gt suffixerator -db #{$testdata}/at1MB -suf -lcp " +
+             "-memlimit #{limit}MB -spillparts -indexname spill -v"
+    grep(last_stdout, /spilled \d+ suffixes in \d+ runs/)
+    File.open(last_stdout) do |f|
+      out = f.read
+      if m = out.match(/combined space peak in megabytes: ([.0-9]+)/) then
+        mysize = m[1].to_f
+      else
+        raise "could not get actual space peak!"
+      end
+      if mysize > limit and mysize - limit > (mysize/10) then
+        raise "required size (#{mysize}) was higher than limit (#{limit})"
+      end
+    end
+    run "cmp ref.suf spill.suf"
+    run "cmp ref.lcp spill.lcp"
+  end
+end